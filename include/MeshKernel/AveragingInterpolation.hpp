@@ -29,6 +29,7 @@
 
 #include <MeshKernel/SpatialTrees.hpp>
 #include <MeshKernel/Constants.hpp>
+#include <MeshKernel/SampleTiles.hpp>
 
 namespace meshkernel
 {
@@ -66,9 +67,37 @@ namespace meshkernel
                                         bool useClosestSampleIfNoneAvailable,
                                         bool subtractSampleValues);
 
+        /// @brief Interpolation based on averaging, with the samples stored on disk in tiles
+        ///
+        /// The locations are processed tile by tile. Only the samples of the tiles overlapping the search polygons
+        /// of the locations of a tile are loaded, so the memory used does not depend on the total number of samples.
+        /// If no sample is found the closest sample is searched among the loaded samples only.
+        /// @param[in] mesh The input mesh
+        /// @param[in] sampleTiles The samples stored in tiles
+        /// @param[in] method The averaging method to use
+        /// @param[in] locationType The location type (faces, edges, nodes).
+        /// @param[in] relativeSearchRadius The relative search radius, used to enlarge the search area when looking for samples.
+        /// @param[in] useClosestSampleIfNoneAvailable If no sample are found use the closest one.
+        explicit AveragingInterpolation(std::shared_ptr<Mesh> mesh,
+                                        std::shared_ptr<SampleTiles> sampleTiles,
+                                        Method method,
+                                        InterpolationLocation locationType,
+                                        double relativeSearchRadius,
+                                        bool useClosestSampleIfNoneAvailable);
+
+        AveragingInterpolation(const AveragingInterpolation&) = delete;
+
         /// @brief Compute interpolation
         void Compute();
 
+        /// @brief Sets whether the locations are interpolated in parallel
+        ///
+        /// In parallel the results are computed with the original sample values. The samples found by the locations
+        /// with a positive result are decremented once afterwards, so they do not depend on the number of threads.
+        /// Serially the decremented samples are used by the following locations, as before.
+        /// @param[in] parallel Whether the locations are interpolated in parallel
+        void SetParallel(bool parallel) { m_parallel = parallel; }
+
         /// @brief Get the result values
         /// @return the results
         [[nodiscard]] const auto& GetResults() const
@@ -80,22 +109,48 @@ namespace meshkernel
         /// @brief[in] Compute The averaging results in polygon
         /// @param[in] polygon The bounding polygon where the samples are included
         /// @param[in] interpolationPoint The interpolation point
+        /// @param[in,out] queryContext The query context of the samples R-tree, receiving the samples found
+        /// @param[in,out] searchPolygon The cache of the enlarged polygon
         /// @param[out] result The resulting value
         void ComputeOnPolygon(const std::vector<Point>& polygon,
                               Point interpolationPoint,
-                              double& result);
+                              SpatialTrees::RTree::QueryContext& queryContext,
+                              std::vector<Point>& searchPolygon,
+                              double& result) const;
+
+        /// @brief Makes the enlarged polygon of the samples searched for a location
+        /// @param[in] polygon The bounding polygon of the location
+        /// @param[in] interpolationPoint The interpolation point
+        /// @param[out] searchPolygon The search polygon
+        void MakeSearchPolygon(const std::vector<Point>& polygon,
+                               Point interpolationPoint,
+                               std::vector<Point>& searchPolygon) const;
+
+        /// @brief Makes the bounding polygon of a location (the face or the dual face of the node)
+        /// @param[in] location The face or node index
+        /// @param[out] polygon The bounding polygon
+        /// @param[out] interpolationPoint The interpolation point of the location
+        void MakeLocationPolygon(int location, std::vector<Point>& polygon, Point& interpolationPoint) const;
+
+        /// @brief Compute the interpolated results on designed locations, with the samples in the samples R-tree
+        /// @param[in] locations The face or node indices
+        /// @param[in,out] interpolatedResults The interpolated results of all locations
+        void ComputeOnLocations(const std::vector<int>& locations, std::vector<double>& interpolatedResults);
 
-        /// @brief Compute the interpolated results on designed location
-        /// @return the interpolated results
-        [[nodiscard]] std::vector<double> ComputeOnLocations();
+        /// @brief Compute the interpolated results on all locations, loading the samples tile by tile
+        /// @param[in,out] interpolatedResults The interpolated results of all locations
+        void ComputeOnSampleTiles(std::vector<double>& interpolatedResults);
 
         const std::shared_ptr<Mesh> m_mesh;
+        std::vector<Sample> m_loadedSamples; // The samples loaded from the sample tiles
         std::vector<Sample>& m_samples;
+        std::shared_ptr<SampleTiles> m_sampleTiles = nullptr;
         Method m_method;
         InterpolationLocation m_interpolationLocation;
         double m_relativeSearchRadius;
         bool m_useClosestSampleIfNoneAvailable = false;
         bool m_transformSamples = false;
+        bool m_parallel = false;
 
         SpatialTrees::RTree m_samplesRtree;
         std::vector<double> m_results;
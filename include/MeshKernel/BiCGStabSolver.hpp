@@ -0,0 +1,95 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <vector>
+
+namespace meshkernel
+{
+    class SparseMatrix;
+
+    /// @brief Solves sparse non-symmetric linear systems with the stabilized bi-conjugate gradient method (BiCGStab).
+    ///
+    /// The system is right-preconditioned with the inverse of its diagonal (Jacobi preconditioner).
+    /// The preconditioner is computed by SetPreconditioner and kept for all solves with the same matrix.
+    /// The matrix-vector products, the vector updates and the dot products run in parallel.
+    /// The work vectors are kept between solves.
+    class BiCGStabSolver
+    {
+    public:
+        /// @brief Computes the Jacobi preconditioner of a matrix, to be called each time the matrix is assembled
+        /// @param[in] matrix The system matrix
+        void SetPreconditioner(const SparseMatrix& matrix);
+
+        /// @brief Solves the linear system
+        /// @param[in] matrix The system matrix, its diagonal terms must be non-zero. SetPreconditioner must have been called for it
+        /// @param[in] rhs The right hand side
+        /// @param[in] relativeTolerance The convergence tolerance on the residual norm, relative to the right hand side norm
+        /// @param[in] residualReduction The solve also stops when the residual norm is reduced by this factor from the initial guess (0 to disable)
+        /// @param[in] maxIterations The maximum number of iterations
+        /// @param[in,out] solution The initial guess on input, the solution on output
+        /// @returns The number of iterations performed
+        int Solve(const SparseMatrix& matrix,
+                  const std::vector<double>& rhs,
+                  double relativeTolerance,
+                  double residualReduction,
+                  int maxIterations,
+                  std::vector<double>& solution);
+
+        /// @brief Gets the residual norm at the end of the last solve, relative to the right hand side norm
+        [[nodiscard]] double GetRelativeResidual() const { return m_relativeResidual; }
+
+        /// @brief Inquires if the last solve reached the tolerance or the residual reduction
+        [[nodiscard]] bool IsConverged() const { return m_isConverged; }
+
+    private:
+        /// @brief Computes the dot product of two vectors
+        /// @param[in] first The first vector
+        /// @param[in] second The second vector
+        /// @returns The dot product
+        [[nodiscard]] static double Dot(const std::vector<double>& first, const std::vector<double>& second);
+
+        /// @brief Applies the Jacobi preconditioner
+        /// @param[in] vector The vector to precondition
+        /// @param[out] result The preconditioned vector
+        void Precondition(const std::vector<double>& vector, std::vector<double>& result) const;
+
+        std::vector<double> m_inverseDiagonal;        // The Jacobi preconditioner
+        std::vector<double> m_residual;               // The residual r
+        std::vector<double> m_shadowResidual;         // The initial residual, used as shadow residual
+        std::vector<double> m_searchDirection;        // The search direction p
+        std::vector<double> m_preconditionedSearch;   // The preconditioned search direction
+        std::vector<double> m_matrixTimesSearch;      // The product of the matrix with the preconditioned search direction
+        std::vector<double> m_intermediateResidual;   // The intermediate residual s
+        std::vector<double> m_preconditionedResidual; // The preconditioned intermediate residual
+        std::vector<double> m_matrixTimesResidual;    // The product of the matrix with the preconditioned intermediate residual
+        double m_relativeResidual = 0.0;              // The relative residual norm at the end of the last solve
+        bool m_isConverged = false;                   // If the last solve reached the tolerance
+    };
+} // namespace meshkernel
@@ -0,0 +1,252 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace meshkernel
+{
+    /// @brief Compressed sparse row (CSR) storage of an adjacency relation (e.g. the edges connected to each node).
+    ///
+    /// The entries of all rows are stored in one buffer, row r occupies m_sizes[r] positions starting at m_offsets[r].
+    /// Build packs the rows contiguously. Reserve and Append fill the rows directly, without intermediate rows, AddRow and AppendToLastRow assemble rows of unknown size one after the other. After a local mesh edit only the modified rows are rewritten with SetRow:
+    /// a row is overwritten in place when it fits in its reserved room, otherwise it is moved to the end of the buffer.
+    /// The buffer is compacted once more than half of it is unused, so updates stay proportional to the modified rows.
+    class CompressedSparseRow
+    {
+    public:
+        /// @brief Builds the storage from rows, taking the first rowSizes[r] entries of each row
+        /// @param[in] rows The rows
+        /// @param[in] rowSizes The number of entries to take from each row
+        /// @param[in] numRows The number of rows to store
+        void Build(const std::vector<std::vector<int>>& rows, const std::vector<int>& rowSizes, int numRows)
+        {
+            m_offsets.resize(numRows);
+            m_sizes.resize(numRows);
+            m_capacities.resize(numRows);
+            int numEntries = 0;
+            for (int r = 0; r < numRows; ++r)
+            {
+                m_offsets[r] = numEntries;
+                m_sizes[r] = rowSizes[r];
+                m_capacities[r] = rowSizes[r];
+                numEntries += rowSizes[r];
+            }
+
+            m_indices.resize(numEntries);
+            for (int r = 0; r < numRows; ++r)
+            {
+                std::copy(rows[r].begin(), rows[r].begin() + rowSizes[r], m_indices.begin() + m_offsets[r]);
+            }
+            m_numUnusedEntries = 0;
+        }
+
+        /// @brief Builds the storage from rows, taking all entries of each row
+        /// @param[in] rows The rows
+        /// @param[in] numRows The number of rows to store
+        void Build(const std::vector<std::vector<int>>& rows, int numRows)
+        {
+            m_rowSizes.resize(numRows);
+            for (int r = 0; r < numRows; ++r)
+            {
+                m_rowSizes[r] = static_cast<int>(rows[r].size());
+            }
+            Build(rows, m_rowSizes, numRows);
+        }
+
+        /// @brief Reserves room for the entries of each row, all rows are empty. The rows are filled with Append
+        /// @param[in] rowCapacities The maximum number of entries of each row
+        /// @param[in] numRows The number of rows to store
+        void Reserve(const std::vector<int>& rowCapacities, int numRows)
+        {
+            m_offsets.resize(numRows);
+            m_sizes.assign(numRows, 0);
+            m_capacities.resize(numRows);
+            int numEntries = 0;
+            for (int r = 0; r < numRows; ++r)
+            {
+                m_offsets[r] = numEntries;
+                m_capacities[r] = rowCapacities[r];
+                numEntries += rowCapacities[r];
+            }
+            m_indices.resize(numEntries);
+            m_numUnusedEntries = 0;
+        }
+
+        /// @brief Appends an entry to a row, the row must have room left (see Reserve)
+        /// @param[in] row The row index
+        /// @param[in] value The entry to append
+        void Append(int row, int value)
+        {
+            m_indices[m_offsets[row] + m_sizes[row]] = value;
+            m_sizes[row]++;
+        }
+
+        /// @brief Adds an empty row at the end of the buffer, filled with AppendToLastRow
+        void AddRow()
+        {
+            m_offsets.emplace_back(static_cast<int>(m_indices.size()));
+            m_sizes.emplace_back(0);
+            m_capacities.emplace_back(0);
+        }
+
+        /// @brief Appends an entry to the last row, which must be the last one in the buffer (see AddRow)
+        /// @param[in] value The entry to append
+        void AppendToLastRow(int value)
+        {
+            m_indices.emplace_back(value);
+            m_sizes.back()++;
+            m_capacities.back()++;
+        }
+
+        /// @brief Removes all rows, keeping the capacity
+        void Clear()
+        {
+            m_offsets.clear();
+            m_sizes.clear();
+            m_capacities.clear();
+            m_indices.clear();
+            m_numUnusedEntries = 0;
+        }
+
+        /// @brief Changes the number of rows. The rows beyond the new number are discarded, the added rows are empty
+        /// @param[in] numRows The new number of rows
+        void Resize(int numRows)
+        {
+            for (int r = numRows; r < GetNumRows(); ++r)
+            {
+                m_numUnusedEntries += m_capacities[r];
+            }
+            m_offsets.resize(numRows, static_cast<int>(m_indices.size()));
+            m_sizes.resize(numRows, 0);
+            m_capacities.resize(numRows, 0);
+        }
+
+        /// @brief Replaces the entries of a row with the first size entries of a vector
+        /// @param[in] row The row index
+        /// @param[in] entries The new entries
+        /// @param[in] size The number of entries to take
+        void SetRow(int row, const std::vector<int>& entries, int size)
+        {
+            if (size > m_capacities[row])
+            {
+                m_numUnusedEntries += m_capacities[row];
+                m_offsets[row] = static_cast<int>(m_indices.size());
+                m_capacities[row] = size;
+                m_indices.resize(m_indices.size() + size);
+            }
+            std::copy(entries.begin(), entries.begin() + size, m_indices.begin() + m_offsets[row]);
+            m_sizes[row] = size;
+
+            if (2 * m_numUnusedEntries > static_cast<int>(m_indices.size()))
+            {
+                Compact();
+            }
+        }
+
+        /// @brief Replaces the entries of a row with all entries of a vector
+        /// @param[in] row The row index
+        /// @param[in] entries The new entries
+        void SetRow(int row, const std::vector<int>& entries)
+        {
+            SetRow(row, entries, static_cast<int>(entries.size()));
+        }
+
+        /// @brief Gets the number of rows
+        /// @returns The number of rows
+        [[nodiscard]] int GetNumRows() const { return static_cast<int>(m_sizes.size()); }
+
+        /// @brief Gets the number of entries of a row
+        /// @param[in] row The row index
+        /// @returns The number of entries
+        [[nodiscard]] int GetRowSize(int row) const { return m_sizes[row]; }
+
+        /// @brief Gets the position of the first entry of a row in the buffer, values associated to the entries can be stored at the same positions
+        /// @param[in] row The row index
+        /// @returns The position
+        [[nodiscard]] int GetRowOffset(int row) const { return m_offsets[row]; }
+
+        /// @brief Gets an entry
+        /// @param[in] row The row index
+        /// @param[in] position The position of the entry in the row
+        /// @returns The entry
+        [[nodiscard]] int operator()(int row, int position) const { return m_indices[m_offsets[row] + position]; }
+
+        /// @brief Gets an iterator to the first entry of a row
+        /// @param[in] row The row index
+        /// @returns The iterator
+        [[nodiscard]] std::vector<int>::iterator RowBegin(int row) { return m_indices.begin() + m_offsets[row]; }
+
+        /// @brief Gets an iterator past the last entry of a row
+        /// @param[in] row The row index
+        /// @returns The iterator
+        [[nodiscard]] std::vector<int>::iterator RowEnd(int row) { return RowBegin(row) + m_sizes[row]; }
+
+        /// @brief Finds the position of a value in a row, as FindIndex does for a vector
+        /// @param[in] row The row index
+        /// @param[in] value The value to find
+        /// @returns The position of the value in the row, 0 if the value is not found
+        [[nodiscard]] int FindIndex(int row, int value) const
+        {
+            const auto start = m_offsets[row];
+            for (int i = start; i < start + m_sizes[row]; ++i)
+            {
+                if (m_indices[i] == value)
+                {
+                    return i - start;
+                }
+            }
+            return 0;
+        }
+
+    private:
+        /// @brief Packs the rows contiguously, dropping the unused room left by moved and discarded rows
+        void Compact()
+        {
+            m_compactedIndices.resize(0);
+            for (int r = 0; r < GetNumRows(); ++r)
+            {
+                const auto start = m_offsets[r];
+                m_offsets[r] = static_cast<int>(m_compactedIndices.size());
+                m_capacities[r] = m_sizes[r];
+                m_compactedIndices.insert(m_compactedIndices.end(), m_indices.begin() + start, m_indices.begin() + start + m_sizes[r]);
+            }
+            std::swap(m_indices, m_compactedIndices);
+            m_numUnusedEntries = 0;
+        }
+
+        std::vector<int> m_offsets;          // The position of the first entry of each row
+        std::vector<int> m_sizes;            // The number of entries of each row
+        std::vector<int> m_capacities;       // The number of positions reserved for each row
+        std::vector<int> m_indices;          // The entries of all rows
+        std::vector<int> m_compactedIndices; // Buffer reused when compacting
+        std::vector<int> m_rowSizes;         // Buffer reused when building from rows of varying size
+        int m_numUnusedEntries = 0;          // The number of positions in m_indices not reserved by any row
+    };
+} // namespace meshkernel
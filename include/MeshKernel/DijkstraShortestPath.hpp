@@ -0,0 +1,113 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+
+namespace meshkernel
+{
+    /// @brief Dijkstra shortest path engine over the mesh edge graph.
+    ///
+    /// The nodes to settle are kept in an indexed binary heap, keyed on the distance and on the node index,
+    /// so ties are broken in favour of the lowest node index (as a linear search would do).
+    /// The distance, predecessor and visited buffers are kept between searches:
+    /// only the nodes touched by the previous search are reset when a new search starts.
+    /// The caller drives the search (settle a node, relax its edges, pop the next node),
+    /// so the edge costs can be computed with any information available at the call site.
+    class DijkstraShortestPath
+    {
+    public:
+        /// @brief Prepares a new search starting from a source node
+        /// @param[in] numNodes The number of nodes in the graph
+        /// @param[in] sourceNode The node where the search starts, its distance is set to zero
+        void Initialize(int numNodes, int sourceNode);
+
+        /// @brief Relaxes the distance of a node reached through an edge
+        /// @param[in] node The node reached
+        /// @param[in] edge The edge used to reach the node
+        /// @param[in] distance The distance of the node when reached through the edge
+        /// @param[in] canBeSettled If the node can be selected later on by \ref PopNearestNode
+        /// @returns If the distance of the node has been decreased
+        bool Relax(int node, int edge, double distance, bool canBeSettled);
+
+        /// @brief Removes from the queue the not visited node with the smallest distance
+        /// @returns The node index, -1 if no node is left in the queue
+        [[nodiscard]] int PopNearestNode();
+
+        /// @brief Marks a node as visited (settled)
+        /// @param[in] node The node index
+        void SetVisited(int node);
+
+        /// @brief Inquires if a node has been visited
+        /// @param[in] node The node index
+        /// @returns If the node has been visited
+        [[nodiscard]] bool IsVisited(int node) const { return m_isVisited[node]; }
+
+        /// @brief Gets the distance of a node from the source node
+        /// @param[in] node The node index
+        /// @returns The distance, std::numeric_limits<double>::max() if the node has not been reached
+        [[nodiscard]] double GetDistance(int node) const { return m_distances[node]; }
+
+        /// @brief Gets the edge used to reach a node along the shortest path
+        /// @param[in] node The node index
+        /// @returns The edge index, -1 for the source node and the nodes not reached
+        [[nodiscard]] int GetPredecessorEdge(int node) const { return m_predecessorEdges[node]; }
+
+    private:
+        /// @brief Compares the priority of two nodes
+        /// @param[in] firstNode The first node
+        /// @param[in] secondNode The second node
+        /// @returns If the first node has to be popped before the second node
+        [[nodiscard]] bool HasHigherPriority(int firstNode, int secondNode) const;
+
+        /// @brief Moves a heap entry up until the heap property is restored
+        /// @param[in] position The position in the heap
+        void SiftUp(int position);
+
+        /// @brief Moves a heap entry down until the heap property is restored
+        /// @param[in] position The position in the heap
+        void SiftDown(int position);
+
+        /// @brief Stores a node at a position in the heap, keeping the position map up to date
+        /// @param[in] position The position in the heap
+        /// @param[in] node The node index
+        void PlaceInHeap(int position, int node);
+
+        /// @brief Records a node as touched by the current search, so it can be reset by the next search
+        /// @param[in] node The node index
+        void Touch(int node);
+
+        std::vector<double> m_distances;       // The distances from the source node
+        std::vector<int> m_predecessorEdges;   // For each node, the edge used to reach it
+        std::vector<bool> m_isVisited;         // For each node, if it has been settled
+        std::vector<bool> m_isTouched;         // For each node, if it has been modified by the current search
+        std::vector<int> m_touchedNodes;       // The nodes modified by the current search
+        std::vector<int> m_heap;               // The binary heap, storing node indices
+        std::vector<int> m_heapPositions;      // For each node, its position in the heap (-1 if not in the heap)
+    };
+} // namespace meshkernel
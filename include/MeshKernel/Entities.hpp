@@ -164,6 +164,33 @@ namespace meshkernel
         double z;
     };
 
+    /// @brief A set of points stored as a structure of arrays, consumed by the batched geometry kernels
+    struct PointsArrays
+    {
+        std::vector<double> x;
+        std::vector<double> y;
+
+        /// @brief Resizes the coordinate arrays
+        /// @param[in] size The new number of points
+        void Resize(int size)
+        {
+            x.resize(size);
+            y.resize(size);
+        }
+
+        /// @brief Stores a point
+        /// @param[in] index The point index
+        /// @param[in] point The point coordinates
+        void Set(int index, const Point& point)
+        {
+            x[index] = point.x;
+            y[index] = point.y;
+        }
+
+        /// @brief Gets the number of points
+        [[nodiscard]] int Size() const { return static_cast<int>(x.size()); }
+    };
+
     struct Sample
     {
         double x;
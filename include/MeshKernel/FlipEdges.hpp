@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace meshkernel
 {
     // Forward declarations
@@ -50,9 +52,19 @@ namespace meshkernel
                   bool projectToLandBoundary);
 
         /// @brief Flip the edges
-        void Compute() const;
+        void Compute();
 
     private:
+        /// @brief The edges to visit in the current and in the next iteration of Compute
+        struct EdgesQueue
+        {
+            std::vector<int> currentIteration;      ///< The edges of the current iteration, sorted
+            std::vector<int> addedEdges;            ///< Min-heap of the edges added to the current iteration while visiting it
+            std::vector<int> nextIteration;         ///< The edges to visit in the next iteration
+            std::vector<bool> isInCurrentIteration; ///< For each edge, if it is in currentIteration or in addedEdges
+            std::vector<bool> isInNextIteration;    ///< For each edge, if it is in nextIteration
+        };
+
         /// @brief Computes the change in topology functional and gets the nodes involved (comp_ntopo)
         /// @param[in] edge The current edge
         /// @param[out] nodeLeft The node at the left side of the edge
@@ -78,9 +90,18 @@ namespace meshkernel
         /// @param[in] nodeIndex The index of the node to process
         void DeleteEdgeFromNode(int edgeIndex, int nodeIndex) const;
 
+        /// @brief Queues the internal edges whose topology functional depends on a node: its connected edges and
+        ///        the edges opposite to it in its triangles
+        /// @param[in] node The node whose number of connected edges changed
+        /// @param[in] currentEdge The edge being visited. Edges with a larger index are queued in the current iteration
+        /// @param[in,out] queue The edges to visit
+        void QueueEdgesAroundNode(int node, int currentEdge, EdgesQueue& queue) const;
+
         std::shared_ptr<Mesh> m_mesh;                     // A pointer to mesh
         std::shared_ptr<LandBoundaries> m_landBoundaries; // A pointer to land boundaries
 
+        std::vector<int> m_valenceDifferences; // For each node, the number of connected edges minus the optimal one, updated at each flip
+
         bool m_triangulateFaces = false;
         bool m_projectToLandBoundary = false;
     };
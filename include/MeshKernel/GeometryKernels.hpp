@@ -0,0 +1,95 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+namespace meshkernel
+{
+    /// @brief The instruction sets the batched geometry kernels are compiled for
+    enum class InstructionSet
+    {
+        Default, ///< The instruction set of the build (SSE2 on x86-64)
+        AVX2,    ///< AVX2, four doubles per instruction
+        AVX512   ///< AVX-512 foundation, eight doubles per instruction
+    };
+
+    /// @brief Checks if the batched geometry kernels of an instruction set were compiled and can run on this cpu
+    /// @param[in] instructionSet The instruction set
+    /// @returns True if the kernels can be used
+    [[nodiscard]] bool IsInstructionSetSupported(InstructionSet instructionSet);
+
+    /// @brief Gets the instruction set of the batched geometry kernels in use
+    ///
+    /// On x86-64 the kernels are compiled for each instruction set in separate translation units.
+    /// At the first call the best one supported by the cpu (cpuid) and the operating system (xgetbv) is selected.
+    /// @returns The instruction set
+    [[nodiscard]] InstructionSet GetInstructionSet();
+
+    /// @brief Selects the instruction set of the batched geometry kernels, to compare the kernels in tests and benchmarks
+    /// @param[in] instructionSet The instruction set
+    /// @throws std::invalid_argument if the instruction set is not supported (see IsInstructionSetSupported)
+    void SetInstructionSet(InstructionSet instructionSet);
+
+    /// @brief Computes the cartesian distances between pairs of points, same as ComputeDistance without branches
+    /// @param[in] size The number of pairs
+    /// @param[in] firstX The x coordinates of the first points
+    /// @param[in] firstY The y coordinates of the first points
+    /// @param[in] secondX The x coordinates of the second points
+    /// @param[in] secondY The y coordinates of the second points
+    /// @param[out] distances The distances, zero if one of the points is invalid
+    void ComputeCartesianDistances(int size, const double* firstX, const double* firstY, const double* secondX, const double* secondY, double* distances);
+
+    /// @brief Computes the edge centers, (first + second) * 0.5 in all projections.
+    ///
+    /// The nodes are read where they are (x and y of each node, as stored by a vector of Points), the gather is the cost of this kernel.
+    /// @param[in] numEdges The number of edges
+    /// @param[in] nodes The x and y coordinates of each node
+    /// @param[in] edges The first and second node of each edge (as stored by a vector of Edges), negative for the invalid edges
+    /// @param[out] edgesCenters The x and y coordinates of each edge center, missing values for the invalid edges
+    void ComputeEdgesCenters(int numEdges, const double* nodes, const int* edges, double* edgesCenters);
+
+    /// @brief Computes the circumcenters of cartesian triangles, same as CircumcenterOfTriangle without branches
+    /// @param[in] size The number of triangles
+    /// @param[in] firstX The x coordinates of the first nodes
+    /// @param[in] firstY The y coordinates of the first nodes
+    /// @param[in] secondX The x coordinates of the second nodes
+    /// @param[in] secondY The y coordinates of the second nodes
+    /// @param[in] thirdX The x coordinates of the third nodes
+    /// @param[in] thirdY The y coordinates of the third nodes
+    /// @param[out] circumcenterX The x coordinates of the circumcenters
+    /// @param[out] circumcenterY The y coordinates of the circumcenters
+    void ComputeCartesianTrianglesCircumcenters(int size,
+                                                const double* firstX,
+                                                const double* firstY,
+                                                const double* secondX,
+                                                const double* secondY,
+                                                const double* thirdX,
+                                                const double* thirdY,
+                                                double* circumcenterX,
+                                                double* circumcenterY);
+} // namespace meshkernel
@@ -29,6 +29,8 @@
 
 #include <vector>
 #include <MeshKernel/Entities.hpp>
+#include <MeshKernel/DijkstraShortestPath.hpp>
+#include <MeshKernel/SpatialTrees.hpp>
 
 namespace meshkernel
 {
@@ -186,7 +188,8 @@ namespace meshkernel
 
         /// <summary>
         /// Connect mesh nodes starting from startMeshNode, using Dijkstra's shortest path algorithm.
-        /// The distance of each edge is the edge length multiplied by the distance from the land boundary
+        /// The distance of each edge is the edge length multiplied by the distance from the land boundary.
+        /// The edges connecting the nodes are stored in m_shortestPath
         /// </summary>
         /// <param name="mesh"></param>
         /// <param name="polygons"></param>
@@ -195,16 +198,15 @@ namespace meshkernel
         /// <param name="endLandBoundaryIndex"></param>
         /// <param name="startMeshNode"></param>
         /// <param name="meshBoundOnly"></param>
-        /// <param name="connectedNodes"></param>
         /// <returns></returns>
         void ShortestPath(int landBoundarySegment,
                           int startLandBoundaryIndex,
                           int endLandBoundaryIndex,
                           int startMeshNode,
-                          bool meshBoundOnly,
-                          std::vector<int>& connectedNodes);
+                          bool meshBoundOnly);
 
-        /// @brief Compute the nearest node on the land boundary (toland)
+        /// @brief Compute the nearest node on the land boundary (toland).
+        /// For cartesian and spherical projections the candidate segments are taken from m_segmentsRTree
         /// @param projection
         /// @param node
         /// @param startLandBoundaryIndex
@@ -222,6 +224,23 @@ namespace meshkernel
                                      int& nearestLandBoundaryNodeIndex,
                                      double& edgeRatio);
 
+        /// @brief Updates the nearest land boundary segment with a candidate segment, if closer.
+        /// On equal distances the lowest segment index is retained
+        /// @param[in] projection The projection
+        /// @param[in] node The node
+        /// @param[in] segmentIndex The index of the first land boundary node of the candidate segment
+        /// @param[in,out] minimumDistance The distance to the nearest segment
+        /// @param[in,out] pointOnLandBoundary The projection of the node on the nearest segment
+        /// @param[in,out] nearestLandBoundaryNodeIndex The index of the nearest segment
+        /// @param[in,out] edgeRatio The ratio of the projected point along the nearest segment
+        void UpdateNearestLandBoundarySegment(const Projections& projection,
+                                              const Point& node,
+                                              int segmentIndex,
+                                              double& minimumDistance,
+                                              Point& pointOnLandBoundary,
+                                              int& nearestLandBoundaryNodeIndex,
+                                              double& edgeRatio) const;
+
         /// @brief (cellcrossedbyland)
         /// @param face
         /// @param startLandBoundaryIndex
@@ -248,6 +267,8 @@ namespace meshkernel
 
         // caches
         std::vector<double> m_nodesMinDistances;
+        DijkstraShortestPath m_shortestPath;         // shortest path engine, its buffers are reused by each MakePath call
+        SpatialTrees::SegmentsRTree m_segmentsRTree; // land boundary segments, built in Administrate
         const size_t m_allocationSize = 10000; // allocation size for allocateVector
 
         // Parameters
@@ -255,6 +276,7 @@ namespace meshkernel
         const double m_closeWholeMeshFactor = 1.0;      // close - to - landboundary tolerance, measured in number of meshwidths
         const double m_minDistanceFromLandFactor = 2.0;
         double m_closeFactor = 5.0;
+        const int m_numNearestSegmentsEstimate = 4; // number of segments used for the first estimate of the nearest segment distance
     };
 
 } // namespace meshkernel
@@ -0,0 +1,70 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace meshkernel
+{
+    /// @brief A read-only view of a file mapped in memory.
+    ///
+    /// The file is mapped on construction and unmapped on destruction, the data is paged in by the operating system when accessed.
+    class MemoryMappedFile
+    {
+    public:
+        /// @brief Maps a file in memory
+        /// @param[in] filePath The path of the file to map
+        explicit MemoryMappedFile(const std::string& filePath);
+
+        /// @brief Unmaps the file
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        /// @brief Gets the mapped data
+        /// @returns A pointer to the first byte of the file, nullptr if the file is empty
+        [[nodiscard]] const char* GetData() const { return m_data; }
+
+        /// @brief Gets the file size
+        /// @returns The number of bytes in the file
+        [[nodiscard]] size_t GetSize() const { return m_size; }
+
+    private:
+        const char* m_data = nullptr; // The mapped data
+        size_t m_size = 0;            // The file size
+#if defined(_WIN32)
+        void* m_file = nullptr;    // The file handle
+        void* m_mapping = nullptr; // The file mapping handle
+#else
+        int m_fileDescriptor = -1; // The file descriptor
+#endif
+    };
+} // namespace meshkernel
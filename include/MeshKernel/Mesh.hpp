@@ -27,9 +27,12 @@
 
 #pragma once
 
+#include <array>
+#include <string>
 #include <vector>
 #include <MeshKernel/MakeGridParametersNative.hpp>
 #include <MeshKernel/Entities.hpp>
+#include <MeshKernel/CompressedSparseRow.hpp>
 #include <MeshKernel/SpatialTrees.hpp>
 
 namespace meshkernel
@@ -86,8 +89,10 @@ namespace meshkernel
         /// <param name="nodes">Input nodes</param>
         /// <param name="polygons">Selection polygon</param>
         /// <param name="projection">Projection to use</param>
+        /// <param name="parallel">Triangulate slabs of the nodes and filter the triangles concurrently, the edges are numbered differently than in the serial triangulation.
+        /// The triangles are filtered with const member functions of the mesh and the polygons, which only read their members, so the polygons are shared by the threads</param>
         /// <returns></returns>
-        Mesh(std::vector<Point>& nodes, const Polygons& polygons, Projections projection);
+        Mesh(std::vector<Point>& nodes, const Polygons& polygons, Projections projection, bool parallel = false);
 
         /// <summary>
         /// Add meshes: result is a mesh composed of the additions
@@ -104,7 +109,21 @@ namespace meshkernel
         /// @param[in] administration Type of administration to perform
         void Set(const std::vector<Edge>& edges, const std::vector<Point>& nodes, Projections projection, AdministrationOptions administration = AdministrationOptions::AdministrateMeshEdgesAndFaces);
 
+        /// @brief Set the mesh starting from the edges and nodes, moving the vectors into the mesh.
+        ///
+        /// Only the vectors are moved, the nodes and edges stay in the mesh layout (arrays of Point and Edge).
+        /// Callers holding the coordinates in other layouts, such as the separate x and y arrays of the API, convert them first.
+        /// @param[in] edges The input edges
+        /// @param[in] nodes The input nodes
+        /// @param[in] projection Projection to use
+        /// @param[in] administration Type of administration to perform
+        void Set(std::vector<Edge>&& edges, std::vector<Point>&& nodes, Projections projection, AdministrationOptions administration = AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
         /// @brief Set internal flat copies of nodes and edges, so the pointer to the first entry is communicated with the front-end
+        ///
+        /// The administration and the copies are skipped if the mesh has not been administrated or modified since the last call.
+        /// The edges are administrated only in the region modified since the last administration (see AdministrateModifiedRegion),
+        /// the faces are administrated by Administrate, so the face numbering seen by the front-end does not change.
         /// @param administrationOption Type of administration to perform
         void SetFlatCopies(AdministrationOptions administrationOption);
 
@@ -112,7 +131,65 @@ namespace meshkernel
         /// @param administrationOption Type of administration to perform
         void Administrate(AdministrationOptions administrationOption);
 
+        /// @brief Perform mesh administration only in the neighbourhood of the nodes and edges modified since the last administration.
+        ///
+        /// The modifications are tracked by the editing methods (InsertNode, ConnectNodes, MergeTwoNodes, DeleteNode, DeleteEdge, MoveNode).
+        /// Algorithms changing m_nodes or m_edges directly must register the modified nodes and edges
+        /// (RegisterModifiedNode, RegisterModifiedEdge) before calling this method,
+        /// algorithms moving many nodes at once (e.g. in parallel loops) invalidate the administration instead (InvalidateAdministration).
+        /// The nodes and edges are numbered as by Administrate. The faces found again are appended,
+        /// so the face numbering can differ from the one produced by Administrate.
+        /// Falls back to Administrate if the previous administration is not valid anymore or if the modified region is large.
+        /// @param administrationOption Type of administration to perform
+        void AdministrateModifiedRegion(AdministrationOptions administrationOption);
+
+        /// @brief Registers a node modified outside of the editing methods, for AdministrateModifiedRegion
+        /// @param[in] node The node index
+        void RegisterModifiedNode(int node);
+
+        /// @brief Registers an edge modified outside of the editing methods, for AdministrateModifiedRegion
+        /// @param[in] edge The edge index
+        void RegisterModifiedEdge(int edge);
+
+        /// @brief Copies the edges of a node, edited in place in m_nodesEdges, to m_nodesEdgesCsr
+        /// @param[in] node The node index
+        void CopyNodeEdgesToCompressedRow(int node);
+
+        /// @brief Copies the nodes and edges of a face, edited in place in m_facesNodes and m_facesEdges, to m_facesNodesCsr and m_facesEdgesCsr
+        /// @param[in] face The face index
+        void CopyFaceToCompressedRows(int face);
+
+        /// @brief Checks that the compressed sparse rows hold the same node edges, face nodes and face edges as the nested vectors,
+        ///        after an administration of edges and faces
+        /// @returns True if m_nodesEdgesCsr, m_facesNodesCsr and m_facesEdgesCsr match m_nodesEdges, m_facesNodes and m_facesEdges
+        [[nodiscard]] bool IsCompressedConnectivityConsistent() const;
+
+        /// @brief Invalidates the current administration, the next administration will be a full one
+        void InvalidateAdministration()
+        {
+            m_administrationState = AdministrationState::None;
+            m_flatCopiesRequireUpdate = true;
+        }
+
+        /// @brief Saves the administrated mesh to a binary snapshot file
+        ///
+        /// The snapshot stores the nodes, the edges, the node-edge, edge-face and face connectivity, the face circumcenters,
+        /// mass centers and areas and the node types, so the mesh can be loaded without administration.
+        /// The mesh must have been administrated with AdministrateMeshEdgesAndFaces, with no pending modification.
+        /// @param[in] filePath The path of the file to write, overwritten if it exists
+        void SaveSnapshot(const std::string& filePath) const;
+
+        /// @brief Loads a mesh from a binary snapshot file written by SaveSnapshot
+        ///
+        /// The file is memory mapped and its sections are copied into the mesh storage,
+        /// the mesh is administrated with faces after loading.
+        /// @param[in] filePath The path of the file to read
+        void LoadSnapshot(const std::string& filePath);
+
         /// @brief Compute face circumcenters
+        ///
+        /// The circumcenters of the cartesian triangles are computed by the batched geometry kernels (see GeometryKernels.hpp),
+        /// the other faces one by one
         void ComputeFaceCircumcentersMassCentersAndAreas(bool computeMassCenters = false);
 
         /// <summary>
@@ -314,7 +391,7 @@ namespace meshkernel
         /// This threshold is the ration of the face area to the average area of neighboring faces.
         void RemoveSmallTrianglesAtBoundaries(double minFractionalAreaTriangles);
 
-        /// @brief Computes m_nodesNodes, see class members
+        /// @brief Computes m_nodesNodes and m_nodesNodesCsr, see class members
         void ComputeNodeNeighbours();
 
         /// @brief Get the orthogonality values, the inner product of edges and segments connecting the face circumcenters
@@ -345,7 +422,7 @@ namespace meshkernel
         /// @brief Make a dual face around the node, enlarged by a factor
         /// @param nodeIndex
         /// @return
-        bool MakeDualFace(int node, double enlargmentFactor, std::vector<Point>& dualFace);
+        bool MakeDualFace(int node, double enlargmentFactor, std::vector<Point>& dualFace) const;
 
         /// @brief Sorts the faces around a node, sorted in counter clock wise order
         /// @param[in] nodeIndex The node index
@@ -354,7 +431,7 @@ namespace meshkernel
 
         // nodes
         std::vector<Point> m_nodes;                 // The mesh nodes (xk, yk)
-        std::vector<std::vector<int>> m_nodesEdges; // For each node, the indices of connected edges (nod%lin)
+        std::vector<std::vector<int>> m_nodesEdges; // For each node, the indices of connected edges (nod%lin), copied from m_nodesEdgesCsr by the administration
         std::vector<int> m_nodesNumEdges;           // For each node, the number of connected edges (nmk)
         std::vector<int> m_nodeMask;                // The node mask (kc)
         std::vector<std::vector<int>> m_nodesNodes; // For each node, its neighbours
@@ -362,7 +439,7 @@ namespace meshkernel
 
         // edges
         std::vector<Edge> m_edges;                  // The edges, defined as first and second node(kn)
-        std::vector<std::vector<int>> m_edgesFaces; // For each edge, the shared face index (lne)
+        std::vector<std::array<int, 2>> m_edgesFaces; // For each edge, the shared face index, -1 if missing (lne)
         std::vector<int> m_edgesNumFaces;           // For each edge, the number of shared faces(lnn)
         std::vector<double> m_edgeLengths;          // The edge lengths
         std::vector<int> m_edgeMask;                // The edge mask (lc)
@@ -377,6 +454,15 @@ namespace meshkernel
         std::vector<double> m_faceArea;             // The face area
         std::vector<Point> m_polygonNodesCache;     // Cache to store the face nodes
 
+        // connectivity in compressed sparse row format, rebuilt by the mesh administration.
+        // The rows are stored next to the nested vectors above, not instead of them: Smoother, Orthogonalizer, MeshRefinement
+        // and AveragingInterpolation read the rows, the rest of the code still reads and writes the nested vectors.
+        // Algorithms editing the nested vectors in place copy the edited rows (CopyNodeEdgesToCompressedRow, CopyFaceToCompressedRows)
+        CompressedSparseRow m_nodesEdgesCsr; // For each node, the indices of connected edges (filled by NodeAdministration)
+        CompressedSparseRow m_nodesNodesCsr; // For each node, its neighbours (as m_nodesNodes, built by ComputeNodeNeighbours)
+        CompressedSparseRow m_facesNodesCsr; // The nodes composing the faces, in ccw order (as m_facesNodes)
+        CompressedSparseRow m_facesEdgesCsr; // The edge indices composing the faces (as m_facesEdges)
+
         // vectors for communicating with the client
         std::vector<double> m_nodex;               // The nodes x-coordinate
         std::vector<double> m_nodey;               // The nodes y-coordinate
@@ -395,33 +481,121 @@ namespace meshkernel
         int m_maxNumNeighbours = 0;
 
     private:
+        /// @brief Moves a face circumcenter outside of the face (shrunk towards its center of mass for weightCircumCenter < 1)
+        ///        onto the face boundary, along the segment from the center of mass. Used by ComputeFaceCircumenter
+        /// @param[in,out] polygon The closed face polygon, shrunk by the weight
+        /// @param[in] numNodes The number of face nodes
+        /// @param[in] centerOfMass The mean of the face nodes
+        /// @param[in] circumcenter The circumcenter
+        /// @param[in] weightCircumCenter Circumcenter weight
+        /// @returns The circumcenter kept inside the face
+        [[nodiscard]] Point KeepCircumcenterInFace(std::vector<Point>& polygon,
+                                                   int numNodes,
+                                                   const Point& centerOfMass,
+                                                   const Point& circumcenter,
+                                                   double weightCircumCenter) const;
+
+        /// @brief The state of the mesh administration
+        enum class AdministrationState
+        {
+            None,         // No valid administration
+            Edges,        // The node-edge connectivity is valid
+            EdgesAndFaces // The node-edge connectivity and the faces are valid
+        };
+
         /// @brief Node administration (setnodadmin)
+        ///
+        /// Fills m_nodesEdgesCsr directly, sorts its rows in counterclockwise order and copies them to m_nodesEdges.
         void NodeAdministration();
 
-        /// @brief Find cells recursive, works with an arbitrary number of edges
-        /// @param startingNode The starting node
-        /// @param node The current node
-        /// @param numEdges The number of edges visited so far
-        /// @param previousEdge The previously visited edge
-        /// @param edges The vector storing the current edges forming a face
-        /// @param nodes The vector storing the current nodes forming a face
-        /// @param sortedEdges The caching array used for sorting the edges, used to inquire if an edge has been already visited
-        /// @param sortedNodes The caching array used for sorting the nodes, used to inquire if a node has been already visited
-        void FindFacesRecursive(int startingNode,
-                                int node,
-                                int numEdges,
-                                int previousEdge,
-                                std::vector<int>& edges,
-                                std::vector<int>& nodes,
-                                std::vector<int>& sortedEdges,
-                                std::vector<int>& sortedNodes,
-                                std::vector<Point>& nodalValues);
+        /// @brief Sort the edges of a node in counterclockwise order
+        /// @param[in] node The node index
+        /// @param[in,out] nodeEdges The m_nodesNumEdges[node] edges of the node
+        void SortEdgesInCounterClockWiseOrder(int node, std::vector<int>::iterator nodeEdges);
+
+        /// @brief Rebuilds the compressed sparse row face connectivity from the administrated faces
+        /// @param[in] administrationOption Whether the face connectivity has been administrated
+        void BuildCompressedConnectivity(AdministrationOptions administrationOption);
+
+        /// @brief Rewrites the compressed sparse rows changed by a local administration, leaving the other rows untouched
+        /// @param[in] administrationOption Whether the face connectivity has been administrated
+        void UpdateCompressedConnectivity(AdministrationOptions administrationOption);
+
+        /// @brief Rebuilds the edges connected to a node from a list of candidate edges, as NodeAdministration does
+        /// @param[in] node The node index
+        /// @param[in] candidateEdges The edges possibly connected to the node, sorted
+        /// @returns False if an edge could not be administrated (duplicated edge or too many edges)
+        [[nodiscard]] bool NodeAdministration(int node, const std::vector<int>& candidateEdges);
+
+        /// @brief Removes a face, the last face takes its place
+        /// @param[in] face The face index
+        void RemoveFace(int face);
+
+        /// @brief Removes edges not belonging to any face and nodes without valid edges, the remaining ones keep their relative order
+        ///
+        /// The nodes and edges are numbered as a full administration would number them.
+        /// @param[in] nodes The node indices to remove
+        /// @param[in] edges The edge indices to remove
+        /// @param[in] updateFaces Whether the faces should be renumbered
+        /// @param[out] nodesIndices For each node, its new index or -1 if removed
+        void RemoveNodesAndEdges(const std::vector<int>& nodes, const std::vector<int>& edges, bool updateFaces, std::vector<int>& nodesIndices);
+
+        /// @brief Builds the nodes R-tree from all valid nodes
+        void BuildNodesRTree();
+
+        /// @brief Builds the edges R-tree from the centers of all valid edges, keyed on the edge index
+        void BuildEdgesRTree();
+
+        /// @brief Computes the center of an edge
+        /// @param[in] edge The edge index
+        /// @returns The edge center, missing values if the edge or its nodes are not valid
+        [[nodiscard]] Point GetEdgeCenter(int edge) const;
+
+        /// @brief Updates the entry of a node in the nodes R-tree, if the tree is built and up to date
+        /// @param[in] node The node index
+        void UpdateNodeInRTree(int node);
+
+        /// @brief Updates the entry of an edge in the edges R-tree, if the tree is built and up to date
+        /// @param[in] edge The edge index
+        void UpdateEdgeInRTree(int edge);
+
+        /// @brief Compute the circumcenter of a face, and optionally its area and mass center
+        /// @param[in] face The face index
+        /// @param[in] computeMassCenters Whether the area and the mass center should be computed
+        /// @param[in,out] middlePointsCache Caching array for the edges middle points
+        /// @param[in,out] normalsCache Caching array for normals
+        /// @param[in,out] numEdgeFacesCache Caching array for the number of faces sharing the face edges
+        void ComputeFaceCircumcenterMassCenterAndArea(int face,
+                                                      bool computeMassCenters,
+                                                      std::vector<Point>& middlePointsCache,
+                                                      std::vector<Point>& normalsCache,
+                                                      std::vector<int>& numEdgeFacesCache);
+
+        /// @brief Classifies a node, once m_nodesTypes contains the number of its boundary edges (or -1)
+        /// @param[in] node The node index
+        void ClassifyNode(int node);
+
+        /// @brief Follows the half-edges from a node, always taking the edge preceding the current one in the counterclockwise order,
+        /// until the starting node is reached again
+        /// @param[in] startingNode The starting node
+        /// @param[in] startingEdge The first edge, connected to the starting node
+        /// @param[out] edges The edges forming the face, sized to maximumNumberOfEdgesPerFace
+        /// @param[out] nodes The nodes forming the face, sized to maximumNumberOfEdgesPerFace
+        /// @returns The number of edges of the face, 0 if no face with distinct nodes and 3 to maximumNumberOfEdgesPerFace edges is found
+        [[nodiscard]] int TraceFace(int startingNode, int startingEdge, std::vector<int>& edges, std::vector<int>& nodes) const;
+
+        /// @brief Finds the faces starting from a set of nodes, adding them after the existing faces (findcells)
+        ///
+        /// The faces are traced in parallel, then added sequentially by number of edges, starting node and starting edge,
+        /// so the face numbering does not depend on the number of threads.
+        /// @param[in] startingNodes The nodes where the faces start, sorted
+        void FindFaces(const std::vector<int>& startingNodes);
 
         /// @brief Checks if a triangle has an acute angle (checktriangle)
         /// @param[in] faceNodes
         /// @param[in] nodes
         /// @returns If triangle is okay
-        [[nodiscard]] bool CheckTriangle(const std::vector<int>& faceNodes, const std::vector<Point>& nodes) const;
+        [[nodiscard]] bool CheckTriangle(const std::array<int, 3>& faceNodes, const std::vector<Point>& nodes) const;
 
         /// @brief Removes all invalid nodes and edges
         void RemoveInvalidNodesAndEdges();
@@ -433,5 +607,17 @@ namespace meshkernel
 
         bool m_nodesRTreeRequiresUpdate = false; //m_nodesRTree requires an update
         bool m_edgesRTreeRequiresUpdate = false; //m_edgesRTree requires an update
+
+        bool m_flatCopiesRequireUpdate = true;                                                           // The flat copies (m_nodex, m_edgeNodes, ...) require an update
+        AdministrationOptions m_flatCopiesAdministration = AdministrationOptions::AdministrateMeshEdges; // The administration used for the current flat copies
+
+        // incremental administration
+        AdministrationState m_administrationState = AdministrationState::None; // What the last administration computed
+        bool m_nodeAdministrationSkippedEdges = false;                         // Some edges were not administrated (duplicated edges or too many edges)
+        std::vector<int> m_modifiedNodes;                                      // The nodes modified since the last administration
+        std::vector<int> m_modifiedEdges;                                      // The edges modified since the last administration
+        std::vector<int> m_compressedNodesRowsToUpdate;                        // The node rows of the compressed connectivity changed by the local administration
+        std::vector<int> m_compressedFacesRowsToUpdate;                        // The face rows of the compressed connectivity changed by the local administration
+        static constexpr double m_maxModifiedNodesFraction = 0.1;              // Above this fraction of modified nodes a full administration is performed
     };
 } // namespace meshkernel
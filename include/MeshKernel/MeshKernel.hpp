@@ -30,6 +30,7 @@
 #include <MeshKernel/MeshGeometry.hpp>
 #include <MeshKernel/GeometryListNative.hpp>
 #include <MeshKernel/OrthogonalizationParametersNative.hpp>
+#include <MeshKernel/OrthogonalizationResultsNative.hpp>
 #include <MeshKernel/CurvilinearParametersNative.hpp>
 #include <MeshKernel/SplinesToCurvilinearParametersNative.hpp>
 #include <MeshKernel/MakeGridParametersNative.hpp>
@@ -71,6 +72,9 @@ namespace meshkernelapi
         MKERNEL_API int mkernel_delete_mesh(int meshKernelId, GeometryListNative& disposableGeometryList, int deletionOption, bool invertDeletion);
 
         /// @brief Set the grid state
+        ///
+        /// The caller arrays are copied once into the mesh node and edge vectors, they are neither adopted nor viewed
+        /// and can be released after the call.
         /// @param[in] meshKernelId Id of the grid state
         /// @param[in] meshGeometryDimensions Mesh dimensions
         /// @param[in] meshGeometry Mesh data
@@ -78,7 +82,24 @@ namespace meshkernelapi
         /// @returns Error code
         MKERNEL_API int mkernel_set_state(int meshKernelId, const MeshGeometryDimensions& meshGeometryDimensions, const MeshGeometry& meshGeometry, bool isGeographic);
 
+        /// @brief Sets the grid state from a UGRID NetCDF file
+        ///
+        /// The nodes and edges are read in chunks directly into the mesh, the projection is taken from the file.
+        /// @param[in] meshKernelId Id of the grid state
+        /// @param[in] filePath The path of the file to read
+        /// @returns Error code
+        MKERNEL_API int mkernel_read_state(int meshKernelId, const char* filePath);
+
+        /// @brief Writes the grid state to a UGRID NetCDF file
+        /// @param[in] meshKernelId Id of the grid state
+        /// @param[in] filePath The path of the file to write, overwritten if it exists
+        /// @returns Error code
+        MKERNEL_API int mkernel_write_state(int meshKernelId, const char* filePath);
+
         /// @brief Gets the mesh state as a <see cref="MeshGeometry"/> structure
+        ///
+        /// The returned arrays are owned by MeshKernel and must not be modified or released by the caller.
+        /// They remain valid until the next call modifying the mesh, and are only refreshed if the mesh changed since the previous call.
         /// @param[in] meshKernelId Id of the grid state
         /// @param[in,out] meshGeometryDimensions Mesh dimensions
         /// @param[in,out] meshGeometry Grid data
@@ -86,6 +107,8 @@ namespace meshkernelapi
         MKERNEL_API int mkernel_get_mesh(int meshKernelId, MeshGeometryDimensions& meshGeometryDimensions, MeshGeometry& meshGeometry);
 
         /// @brief Gets the mesh faces
+        ///
+        /// The returned arrays follow the same ownership rules as in mkernel_get_mesh.
         /// @param[in] meshKernelId Id of the mesh state
         /// @param[in,out] meshGeometryDimensions Grid dimensions
         /// @param[in,out] meshGeometry Mesh data (including face information)
@@ -109,6 +132,50 @@ namespace meshkernelapi
                                               const GeometryListNative& geometryListNativePolygon,
                                               const GeometryListNative& geometryListNativeLandBoundaries);
 
+        /// @brief Orthogonalization, the inner iterations stop once the node displacements drop below a tolerance
+        /// @param[in] meshKernelId Id of the mesh state
+        /// @param[in] isTriangulationRequired The option to triangulate also non triangular cells (if activated squares becomes triangles)
+        /// @param[in] isAccountingForLandBoundariesRequired The option to account for land boundaries
+        /// @param[in] projectToLandBoundaryOption The option to determine how to snap to land boundaries
+        /// @param[in] orthogonalizationParametersNative The structure containing the orthogonalization parameters
+        /// @param[in] convergenceTolerance The maximum node displacement of a converged inner iteration, in meters for spherical meshes (0 to perform all iterations)
+        /// @param[in] geometryListNativePolygon The polygon where to perform the orthogonalization
+        /// @param[in] geometryListNativeLandBoundaries The land boundaries to account for in the orthogonalization process
+        /// @param[out] orthogonalizationResultsNative The number of inner iterations performed and the final node displacements
+        /// @returns Error code
+        MKERNEL_API int mkernel_orthogonalize_with_tolerance(int meshKernelId,
+                                                             int isTriangulationRequired,
+                                                             int isAccountingForLandBoundariesRequired,
+                                                             int projectToLandBoundaryOption,
+                                                             const OrthogonalizationParametersNative& orthogonalizationParametersNative,
+                                                             double convergenceTolerance,
+                                                             const GeometryListNative& geometryListNativePolygon,
+                                                             const GeometryListNative& geometryListNativeLandBoundaries,
+                                                             OrthogonalizationResultsNative& orthogonalizationResultsNative);
+
+        /// @brief Orthogonalization with a tolerance, solving the linear system of each outer iteration with the selected method
+        /// @param[in] meshKernelId Id of the mesh state
+        /// @param[in] isTriangulationRequired The option to triangulate also non triangular cells (if activated squares becomes triangles)
+        /// @param[in] isAccountingForLandBoundariesRequired The option to account for land boundaries
+        /// @param[in] projectToLandBoundaryOption The option to determine how to snap to land boundaries
+        /// @param[in] orthogonalizationParametersNative The structure containing the orthogonalization parameters
+        /// @param[in] convergenceTolerance The maximum node displacement of a converged inner iteration, in meters for spherical meshes (0 to perform all iterations)
+        /// @param[in] linearSolver The method solving the linear system: 0 Jacobi point updates, 1 BiCGStab
+        /// @param[in] geometryListNativePolygon The polygon where to perform the orthogonalization
+        /// @param[in] geometryListNativeLandBoundaries The land boundaries to account for in the orthogonalization process
+        /// @param[out] orthogonalizationResultsNative The number of inner iterations performed and the final node displacements
+        /// @returns Error code
+        MKERNEL_API int mkernel_orthogonalize_with_linear_solver(int meshKernelId,
+                                                                 int isTriangulationRequired,
+                                                                 int isAccountingForLandBoundariesRequired,
+                                                                 int projectToLandBoundaryOption,
+                                                                 const OrthogonalizationParametersNative& orthogonalizationParametersNative,
+                                                                 double convergenceTolerance,
+                                                                 int linearSolver,
+                                                                 const GeometryListNative& geometryListNativePolygon,
+                                                                 const GeometryListNative& geometryListNativeLandBoundaries,
+                                                                 OrthogonalizationResultsNative& orthogonalizationResultsNative);
+
         /// @brief Orthogonalization initialization (first function to use in interactive mode)
         /// @param[in] meshKernelId Id of the mesh state
         /// @param[in] isTriangulationRequired The option to triangulate also non triangular cells (if activated squares becomes triangles)
@@ -126,6 +193,12 @@ namespace meshkernelapi
                                                          GeometryListNative& geometryListNativePolygon,
                                                          GeometryListNative& geometryListNativeLandBoundaries);
 
+        /// @brief Sets the samples the smoother adapts the mesh to, with the strength AdaptBeta of the orthogonalization parameters (interactive mode)
+        /// @param[in] meshKernelId Id of the mesh state
+        /// @param[in] geometryListNativeSamples The samples, with their values in the z coordinates (e.g. the bathymetry)
+        /// @returns Error code
+        MKERNEL_API int mkernel_orthogonalize_set_adaptation_samples(int meshKernelId, const GeometryListNative& geometryListNativeSamples);
+
         /// @brief Prepare outer orthogonalization iteration (interactive mode)
         /// @param[in] meshKernelId Id of the mesh state
         /// @returns Error code
@@ -141,6 +214,12 @@ namespace meshkernelapi
         /// @returns Error code
         MKERNEL_API int mkernel_orthogonalize_finalize_outer_iteration(int meshKernelId);
 
+        /// @brief Gets the number of inner iterations performed and the node displacements of the last one (interactive mode)
+        /// @param[in] meshKernelId Id of the mesh state
+        /// @param[out] orthogonalizationResultsNative The number of inner iterations performed and the node displacements
+        /// @returns Error code, Exception if the orthogonalization is not initialized
+        MKERNEL_API int mkernel_orthogonalize_get_results(int meshKernelId, OrthogonalizationResultsNative& orthogonalizationResultsNative);
+
         /// @brief Clean up back-end orthogonalization algorithm (interactive mode)
         /// @param[in] meshKernelId Id of the mesh state
         /// @returns Error code
@@ -224,6 +303,13 @@ namespace meshkernelapi
         /// @returns Error code
         MKERNEL_API int mkernel_make_mesh_from_samples(int meshKernelId, GeometryListNative& geometryListNative);
 
+        /// @brief Make a triangular mesh from samples, optionally triangulating slabs of the samples concurrently
+        /// @param[in] meshKernelId Id of the mesh state
+        /// @param[in] geometryListNative The samples where to triangulate
+        /// @param[in] parallel Triangulate slabs of the samples concurrently. The edges are numbered differently than in the serial triangulation
+        /// @returns Error code
+        MKERNEL_API int mkernel_make_mesh_from_samples_parallel(int meshKernelId, GeometryListNative& geometryListNative, bool parallel);
+
         /// @brief Retrieves the mesh boundary polygon
         /// @param[in] meshKernelId Id of the mesh state
         /// @param[in,out] geometryListNative The output network boundary polygon
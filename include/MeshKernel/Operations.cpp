@@ -29,9 +29,11 @@
 
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <MeshKernel/Entities.hpp>
 #include <MeshKernel/Constants.hpp>
+#include <MeshKernel/GeometryKernels.hpp>
 #include <MeshKernel/SpatialTrees.hpp>
 
 namespace meshkernel
@@ -979,6 +981,103 @@ namespace meshkernel
         return distance;
     }
 
+    /// @brief Computes the spherical distances between pairs of points, same as \ref ComputeDistance without branches
+    /// The cosine has no vector variant without fast math, so only the projection branch is hoisted here
+    /// @param[in] size The number of pairs
+    /// @param[in] firstX The x coordinates of the first points
+    /// @param[in] firstY The y coordinates of the first points
+    /// @param[in] secondX The x coordinates of the second points
+    /// @param[in] secondY The y coordinates of the second points
+    /// @param[out] distances The distances, zero if one of the points is invalid
+    static void ComputeSphericalDistances(int size, const double* firstX, const double* firstY, const double* secondX, const double* secondY, double* distances)
+    {
+        const double epsilon = std::numeric_limits<double>::epsilon();
+        for (int i = 0; i < size; ++i)
+        {
+            const bool isInvalid = (std::abs(firstX[i] - doubleMissingValue) < epsilon) | (std::abs(firstY[i] - doubleMissingValue) < epsilon) |
+                                   (std::abs(secondX[i] - doubleMissingValue) < epsilon) | (std::abs(secondY[i] - doubleMissingValue) < epsilon);
+
+            // GetDx: zero when the points are aligned or when only one of them is on a pole
+            const bool isFirstPointOnPole = std::abs(std::abs(firstY[i]) - 90.0) < absLatitudeAtPoles;
+            const bool isSecondPointOnPole = std::abs(std::abs(secondY[i]) - 90.0) < absLatitudeAtPoles;
+            const double deltaX = firstX[i] - secondX[i];
+            const double firstPointX = deltaX > 180.0 ? firstX[i] - 360.0 : (deltaX < -180.0 ? firstX[i] + 360.0 : firstX[i]);
+            const double firstPointY = firstY[i] * degrad_hp;
+            const double secondPointY = secondY[i] * degrad_hp;
+            const double cosPhi = std::cos(0.5 * (firstPointY + secondPointY));
+            double dx = earth_radius * cosPhi * (secondX[i] * degrad_hp - firstPointX * degrad_hp);
+            dx = std::abs(secondX[i] - firstX[i]) <= nearlyZero || isFirstPointOnPole != isSecondPointOnPole ? 0.0 : dx;
+
+            // GetDy
+            double dy = earth_radius * (secondPointY - firstPointY);
+            dy = std::abs(secondY[i] - firstY[i]) <= nearlyZero ? 0.0 : dy;
+
+            const double distance = std::sqrt(dx * dx + dy * dy);
+            distances[i] = isInvalid ? 0.0 : distance;
+        }
+    }
+
+    /// @brief Computes the distances between pairs of points stored as structures of arrays (batched dbdistance)
+    ///
+    /// The projection is resolved once for the whole batch, so the cartesian and spherical loops can be vectorized.
+    /// The cartesian pairs are computed by the kernel of the instruction set selected at run time (see GeometryKernels.hpp).
+    /// The results are identical to the ones of \ref ComputeDistance called on each pair.
+    /// @param[in] firstPoints The first point of each pair
+    /// @param[in] secondPoints The second point of each pair
+    /// @param[in] projection The coordinate system projection
+    /// @param[out] distances The distance of each pair
+    static void ComputeDistances(const PointsArrays& firstPoints, const PointsArrays& secondPoints, const Projections& projection, std::vector<double>& distances)
+    {
+        const auto size = firstPoints.Size();
+        distances.resize(size);
+        if (size == 0)
+        {
+            return;
+        }
+
+        if (projection == Projections::cartesian)
+        {
+            ComputeCartesianDistances(size, firstPoints.x.data(), firstPoints.y.data(), secondPoints.x.data(), secondPoints.y.data(), distances.data());
+            return;
+        }
+        if (projection == Projections::spherical)
+        {
+            ComputeSphericalDistances(size, firstPoints.x.data(), firstPoints.y.data(), secondPoints.x.data(), secondPoints.y.data(), distances.data());
+            return;
+        }
+
+        // sphericalAccurate goes through the 3D cartesian coordinates
+        for (int i = 0; i < size; ++i)
+        {
+            distances[i] = ComputeDistance({firstPoints.x[i], firstPoints.y[i]}, {secondPoints.x[i], secondPoints.y[i]}, projection);
+        }
+    }
+
+    /// @brief Gathers the coordinates of the edge nodes in structures of arrays, ready for the batched kernels
+    /// @param[in] numEdges The number of edges to gather
+    /// @param[in] nodes The nodes
+    /// @param[in] edges The edges
+    /// @param[out] firstNodes The coordinates of the first node of each edge, invalid for invalid edges
+    /// @param[out] secondNodes The coordinates of the second node of each edge, invalid for invalid edges
+    static void GatherEdgesNodes(int numEdges, const std::vector<Point>& nodes, const std::vector<Edge>& edges, PointsArrays& firstNodes, PointsArrays& secondNodes)
+    {
+        firstNodes.Resize(numEdges);
+        secondNodes.Resize(numEdges);
+        for (int e = 0; e < numEdges; e++)
+        {
+            auto const first = edges[e].first;
+            auto const second = edges[e].second;
+            if (first < 0 || second < 0)
+            {
+                firstNodes.Set(e, {doubleMissingValue, doubleMissingValue});
+                secondNodes.Set(e, {doubleMissingValue, doubleMissingValue});
+                continue;
+            }
+            firstNodes.Set(e, nodes[first]);
+            secondNodes.Set(e, nodes[second]);
+        }
+    }
+
     // dLINEDIS3
     // Computes the perpendicular distance from point to a line firstNode - secondNode.
     // normalPoint: coordinates of the projected point from point onto the line
@@ -1677,21 +1776,29 @@ namespace meshkernel
 
     [[nodiscard]] static auto ComputeEdgeCenters(int numEdges, const std::vector<Point>& nodes, const std::vector<Edge>& edges, std::vector<Point>& edgesCenters)
     {
-        edgesCenters.reserve(std::max(int(edgesCenters.capacity()), numEdges));
-        edgesCenters.clear();
+        static_assert(sizeof(Point) == 2 * sizeof(double) && sizeof(Edge) == 2 * sizeof(int), "The kernel reads the nodes and the edges as arrays of pairs");
 
-        for (int e = 0; e < numEdges; e++)
+        if (numEdges == 0 || nodes.empty())
         {
-            auto const first = edges[e].first;
-            auto const second = edges[e].second;
+            edgesCenters.clear();
+            return;
+        }
 
-            if (first < 0 || second < 0)
+        // the centers are computed in place by the batched kernel, the centers of the invalid edges are then removed
+        edgesCenters.resize(numEdges);
+        ComputeEdgesCenters(numEdges, &nodes[0].x, &edges[0].first, &edgesCenters[0].x);
+
+        int numValidEdges = 0;
+        for (int e = 0; e < numEdges; e++)
+        {
+            if (edges[e].first < 0 || edges[e].second < 0)
             {
                 continue;
             }
-
-            edgesCenters.emplace_back((nodes[first] + nodes[second]) * 0.5);
+            edgesCenters[numValidEdges] = edgesCenters[e];
+            numValidEdges++;
         }
+        edgesCenters.resize(numValidEdges);
     }
 
     template <typename T>
@@ -1722,6 +1829,65 @@ namespace meshkernel
         upperRight = {maxx, maxy};
     }
 
+    /// @brief Computes the distance along a Hilbert curve filling a square grid (xy2d)
+    /// @param[in] gridSize The number of cells along each direction of the grid, a power of two
+    /// @param[in] x The grid column
+    /// @param[in] y The grid row
+    /// @returns The position of the cell along the curve
+    [[nodiscard]] static std::uint64_t HilbertCurveDistance(std::uint64_t gridSize, std::uint64_t x, std::uint64_t y)
+    {
+        std::uint64_t distance = 0;
+        for (std::uint64_t s = gridSize / 2; s > 0; s /= 2)
+        {
+            const std::uint64_t rx = (x & s) > 0 ? 1 : 0;
+            const std::uint64_t ry = (y & s) > 0 ? 1 : 0;
+            distance += s * s * ((3 * rx) ^ ry);
+
+            // rotate the quadrant
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = gridSize - 1 - x;
+                    y = gridSize - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return distance;
+    }
+
+    /// @brief Sorts points along a Hilbert space-filling curve, so points close in space are also close in the ordering
+    /// @param[in] points The points
+    /// @returns The indices of the points along the curve, the invalid points are placed at the end
+    [[nodiscard]] static std::vector<int> SortPointsAlongHilbertCurve(const std::vector<Point>& points)
+    {
+        Point lowerLeft;
+        Point upperRight;
+        GetBoundingBox(points, lowerLeft, upperRight);
+
+        constexpr std::uint64_t gridSize = 1 << 16;
+        const double extent = std::max(upperRight.x - lowerLeft.x, upperRight.y - lowerLeft.y);
+        const double scale = extent > 0.0 ? double(gridSize - 1) / extent : 0.0;
+
+        std::vector<std::uint64_t> distances(points.size(), std::numeric_limits<std::uint64_t>::max());
+        for (int n = 0; n < points.size(); n++)
+        {
+            if (!points[n].IsValid())
+            {
+                continue;
+            }
+            const auto x = static_cast<std::uint64_t>((points[n].x - lowerLeft.x) * scale);
+            const auto y = static_cast<std::uint64_t>((points[n].y - lowerLeft.y) * scale);
+            distances[n] = HilbertCurveDistance(gridSize, x, y);
+        }
+
+        std::vector<int> indices(points.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::stable_sort(indices.begin(), indices.end(), [&distances](int first, int second) { return distances[first] < distances[second]; });
+        return indices;
+    }
+
     template <typename T>
     bool IsValueInBoundingBox(T point, Point lowerLeft, Point upperRight) //requires IsCoordinate<T>
     {
@@ -30,11 +30,14 @@
 #include <vector>
 #include <memory>
 #include <MeshKernel/OrthogonalizationParametersNative.hpp>
+#include <MeshKernel/SparseMatrix.hpp>
+#include <MeshKernel/BiCGStabSolver.hpp>
 
 namespace meshkernel
 {
     // Forward declare everything to reduce compile time dependency
     struct Point;
+    struct Sample;
     class Mesh;
     class Smoother;
     class Orthogonalizer;
@@ -49,6 +52,13 @@ namespace meshkernel
     {
 
     public:
+        /// @brief The methods solving the linear system of an outer iteration
+        enum class LinearSolver
+        {
+            Jacobi = 0,  // Relaxed point updates, one sweep per inner iteration (default)
+            BiCGStab = 1 // Jacobi preconditioned BiCGStab, the system is solved at each inner iteration
+        };
+
         /// Set the parameters
         /// @param[in] mesh The mesh to orthogonalize
         /// @param[in] smoother The mesh to smoother
@@ -81,6 +91,32 @@ namespace meshkernel
         /// @brief Finalize the outer iteration, computes new mu and face areas, masscenters, circumcenters
         void FinalizeOuterIteration();
 
+        /// @brief Sets the samples the smoother adapts the mesh to, with the strength AdaptBeta of the orthogonalization parameters.
+        /// The samples are averaged on the nodes by \ref Initialize, or by the next outer iteration if it is already initialized
+        /// @param[in] samples The samples with x,y locations and values (e.g. the bathymetry)
+        void SetAdaptationSamples(const std::vector<Sample>& samples);
+
+        /// @brief Sets the tolerance on the node displacements, \ref Compute stops the inner iterations once it is reached
+        /// @param[in] convergenceTolerance The maximum node displacement of a converged inner iteration (0 to perform all iterations)
+        void SetConvergenceTolerance(double convergenceTolerance) { m_convergenceTolerance = convergenceTolerance; }
+
+        /// @brief Sets the method solving the linear system, the sphericalAccurate projection always uses the Jacobi point updates
+        /// @param[in] linearSolver The linear solver
+        void SetLinearSolver(LinearSolver linearSolver) { m_linearSolver = linearSolver; }
+
+        /// @brief Inquires if the last inner iteration moved the nodes less than the convergence tolerance
+        /// @returns If the inner iterations have converged, always false when no tolerance is set
+        [[nodiscard]] bool IsConverged() const;
+
+        /// @brief Gets the number of inner iterations performed since the initialization
+        [[nodiscard]] int GetNumInnerIterations() const { return m_numInnerIterations; }
+
+        /// @brief Gets the maximum node displacement of the last inner iteration, in meters for spherical meshes
+        [[nodiscard]] double GetMaximumDisplacement() const { return m_maximumDisplacement; }
+
+        /// @brief Gets the root mean square node displacement of the last inner iteration, in meters for spherical meshes
+        [[nodiscard]] double GetRootMeanSquareDisplacement() const { return m_rootMeanSquareDisplacement; }
+
     private:
         /// @brief Project mesh nodes back to the original mesh boundary (orthonet_project_on_boundary)
         void ProjectOnOriginalMeshBoundary();
@@ -102,6 +138,20 @@ namespace meshkernel
         /// @param[in] nodeIndex
         void UpdateNodeCoordinates(int nodeIndex);
 
+        /// @brief Computes the maximum and root mean square node displacements of the last inner iteration
+        void ComputeNodeDisplacements();
+
+        /// @brief Inquires if the inner iterations solve the linear system with BiCGStab
+        /// @returns If BiCGStab is selected and the projection supports it
+        [[nodiscard]] bool IsLinearSystemSolved() const;
+
+        /// @brief Assembles the linear system of the internal nodes with the weights of the outer iteration.
+        /// The coefficients of the spherical projection are frozen at the current node positions
+        void AssembleLinearSystem();
+
+        /// @brief Solves the linear system of the internal nodes with BiCGStab, the boundary nodes use the point updates
+        void SolveLinearSystem();
+
         /// @brief Allocate linear system vectors
         void AllocateLinearSystem();
 
@@ -118,8 +168,9 @@ namespace meshkernel
 
         std::vector<int> m_localCoordinatesIndexes; // Used in sphericalAccurate projection (iloc)
         std::vector<Point> m_localCoordinates;      // Used in sphericalAccurate projection (xloc,yloc)
-        std::vector<Point> m_orthogonalCoordinates; // A copy of the mesh node, orthogonalized
+        std::vector<Point> m_orthogonalCoordinates; // The orthogonalized mesh nodes, swapped with the mesh nodes at each inner iteration
         std::vector<Point> m_originalNodes;         // The original mesh
+        std::vector<int> m_nodesOrder;              // The nodes sorted along a space-filling curve, the order of the sweeps
 
         // Linear system terms
         int m_nodeCacheSize = 0;
@@ -135,5 +186,35 @@ namespace meshkernel
         double m_mumax;
         double m_mu;
         bool m_keepCircumcentersAndMassCenters = false;
+
+        // convergence monitoring
+        double m_convergenceTolerance = 0.0;       // The maximum node displacement of a converged inner iteration, 0 if not used
+        int m_numInnerIterations = 0;              // The number of inner iterations performed
+        double m_maximumDisplacement = 0.0;        // The maximum node displacement of the last inner iteration
+        double m_rootMeanSquareDisplacement = 0.0; // The root mean square node displacement of the last inner iteration
+
+        // linear solver
+        LinearSolver m_linearSolver = LinearSolver::Jacobi;              // The method solving the linear system
+        static constexpr double m_linearSolverRelativeTolerance = 1e-10; // The relative residual of a fully solved linear system
+        static constexpr double m_linearSolverResidualReduction = 1e-2;  // The residual reduction of an inner iteration, the following ones continue the solve
+        static constexpr int m_linearSolverMaxIterations = 3;            // The BiCGStab iterations per inner iteration, the boundary nodes move in between
+        std::vector<int> m_unknownIndices;                               // For each node, its index in the linear system (-1 for the nodes held in place)
+        std::vector<int> m_unknownNodes;                                 // For each unknown of the linear system, its node
+        std::vector<int> m_fixedNodes;                                   // The nodes not moved, restarting from their original position
+        std::vector<int> m_boundaryNodes;                                // The boundary nodes, moved with the point updates
+        SparseMatrix m_matrixX;                                          // The linear system matrix for the x coordinates
+        SparseMatrix m_matrixY;                                          // The linear system matrix for the y coordinates
+        SparseMatrix m_heldNodesMatrixX;                                 // The weights of the nodes held in place, for the x coordinates
+        SparseMatrix m_heldNodesMatrixY;                                 // The weights of the nodes held in place, for the y coordinates
+        std::vector<double> m_constantRhsX;                              // The right hand side terms of the outer iteration for the x coordinates
+        std::vector<double> m_constantRhsY;                              // The right hand side terms of the outer iteration for the y coordinates
+        std::vector<double> m_nodesX;                                    // The x coordinates of all nodes at the start of the inner iteration
+        std::vector<double> m_nodesY;                                    // The y coordinates of all nodes at the start of the inner iteration
+        std::vector<double> m_rhsX;                                      // The linear system right hand side for the x coordinates
+        std::vector<double> m_rhsY;                                      // The linear system right hand side for the y coordinates
+        std::vector<double> m_solutionX;                                 // The x coordinates of the nodes in the linear system
+        std::vector<double> m_solutionY;                                 // The y coordinates of the nodes in the linear system
+        BiCGStabSolver m_bicgstabSolverX;                                // The BiCGStab solver of the x system, keeping its preconditioner and work vectors between solves
+        BiCGStabSolver m_bicgstabSolverY;                                // The BiCGStab solver of the y system
     };
 } // namespace meshkernel
@@ -39,7 +39,7 @@ namespace meshkernelapi
         double Circumormasscenter;
         double Smoothorarea;
         int AdaptMethod;
-        double AdaptBeta;
+        double AdaptBeta; // The adaptation strength of the smoother to the samples of mkernel_orthogonalize_set_adaptation_samples
         int AdaptNiterU;
         int AdaptNiterG;
         double OrthoPure;
@@ -0,0 +1,47 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+namespace meshkernelapi
+{
+    struct OrthogonalizationResultsNative
+    {
+        /// The number of inner iterations performed
+        int InnerIterations;
+
+        /// The maximum node displacement of the last inner iteration
+        double MaximumDisplacement;
+
+        /// The root mean square node displacement of the last inner iteration
+        double RootMeanSquareDisplacement;
+
+        /// If the maximum node displacement dropped below the convergence tolerance (1) or not (0)
+        int Converged;
+    };
+} // namespace meshkernelapi
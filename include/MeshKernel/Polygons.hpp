@@ -101,12 +101,12 @@ namespace meshkernel
         /// @return the number of polygon nodes
         [[nodiscard]] int GetNumNodes() const { return m_numNodes; }
 
-        std::vector<Point> m_nodes;              // The polygon nodes
-        Projections m_projection;                // The current projection
-        int m_numNodes = 0;                      // (npl)
-        int m_numAllocatedNodes = 0;             // The size of currently allocated nodes (maxpol)
-        std::vector<std::vector<int>> m_indices; // Start-end of polygon nodes in m_nodes
-        int m_allocationSize = 100;              // The pre-allocation size
+        std::vector<Point> m_nodes;                        // The polygon nodes
+        Projections m_projection = Projections::cartesian; // The current projection
+        int m_numNodes = 0;                                // (npl)
+        int m_numAllocatedNodes = 0;                       // The size of currently allocated nodes (maxpol)
+        std::vector<std::vector<int>> m_indices;           // Start-end of polygon nodes in m_nodes
+        int m_allocationSize = 100;                        // The pre-allocation size
 
     private:
         /// @brief Computes the maximum edge length
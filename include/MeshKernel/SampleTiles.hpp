@@ -0,0 +1,151 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <MeshKernel/Entities.hpp>
+
+namespace meshkernel
+{
+    /// @brief Samples stored on disk in square tiles, for sample sets that do not fit in memory.
+    ///
+    /// The samples are bucketed on a regular grid of tiles anchored at the origin. Each tile has its own file,
+    /// named after the file prefix and the tile column and row. The samples are buffered in memory and appended
+    /// to the tile files once the number of buffered samples reaches a maximum, so the memory used while ingesting
+    /// does not depend on the number of samples. The samples of the tiles overlapping a box can then be loaded.
+    /// For spherical projections longitudes differing by a multiple of 360 degrees are the same, so a box crossing the antimeridian
+    /// also selects the tiles on the other side of it.
+    class SampleTiles
+    {
+    public:
+        /// @brief Constructor, existing tile files with the same prefix are overwritten
+        /// @param[in] filePrefix The prefix of the tile file paths, including the directory
+        /// @param[in] tileSize The size of the square tiles
+        /// @param[in] projection The projection of the sample coordinates
+        /// @param[in] maxNumBufferedSamples The maximum number of samples kept in memory before writing them to the tile files
+        SampleTiles(const std::string& filePrefix, double tileSize, Projections projection, int maxNumBufferedSamples = 1 << 20);
+
+        /// @brief Removes the tile files, also when an exception unwinds the owner
+        ~SampleTiles();
+
+        SampleTiles(const SampleTiles&) = delete;
+        SampleTiles& operator=(const SampleTiles&) = delete;
+
+        /// @brief Adds samples, samples with missing coordinates are skipped
+        /// @param[in] samples The samples
+        void AddSamples(const std::vector<Sample>& samples);
+
+        /// @brief Adds the samples of a text file with a sample (x y value) per line, reading the file in chunks.
+        /// Blank lines are skipped, the other lines not starting with three numbers are rejected and counted
+        /// @param[in] filePath The file path
+        /// @returns The number of rejected lines
+        int ReadXyzFile(const std::string& filePath);
+
+        /// @brief Adds the samples of a binary file with the x, y and value of each sample as consecutive doubles, reading the file in chunks
+        /// @param[in] filePath The file path
+        void ReadBinaryFile(const std::string& filePath);
+
+        /// @brief Writes the buffered samples to the tile files
+        void Flush();
+
+        /// @brief Loads the samples of all tiles overlapping a box, the buffered samples are written first
+        /// @param[in] lowerLeft The lower left corner of the box
+        /// @param[in] upperRight The upper right corner of the box
+        /// @param[out] samples The samples of the overlapping tiles, in tile order. The samples keep their stored coordinates
+        void LoadSamples(const Point& lowerLeft, const Point& upperRight, std::vector<Sample>& samples);
+
+        /// @brief Removes the tile files and the buffered samples
+        void Clear();
+
+        /// @brief Gets the tile size
+        /// @returns The tile size
+        [[nodiscard]] double GetTileSize() const { return m_tileSize; }
+
+        /// @brief Gets the number of samples added
+        /// @returns The number of samples
+        [[nodiscard]] long long GetNumSamples() const { return m_numSamples; }
+
+        /// @brief Gets the number of lines rejected by \ref ReadXyzFile since the construction or the last \ref Clear
+        /// @returns The number of rejected lines
+        [[nodiscard]] long long GetNumRejectedLines() const { return m_numRejectedLines; }
+
+        /// @brief Gets the number of tiles containing samples
+        /// @returns The number of tiles
+        [[nodiscard]] int GetNumTiles() const { return static_cast<int>(m_tiles.size()); }
+
+        /// @brief Gets the bounding box of the samples added
+        /// @param[out] lowerLeft The lower left corner
+        /// @param[out] upperRight The upper right corner
+        void GetBoundingBox(Point& lowerLeft, Point& upperRight) const;
+
+        /// @brief Gets the tile containing a point
+        /// @param[in] point The point
+        /// @returns The tile column and row
+        [[nodiscard]] std::pair<int, int> GetTile(const Point& point) const;
+
+    private:
+        /// @brief A tile
+        struct Tile
+        {
+            std::vector<Sample> m_buffer; // The samples not written to the tile file yet
+            long long m_numSamples = 0;   // The number of samples in the tile file and in the buffer
+            bool m_hasFile = false;       // Whether the tile file has been created
+        };
+
+        /// @brief Gets the file path of a tile
+        /// @param[in] tile The tile column and row
+        /// @returns The file path
+        [[nodiscard]] std::string GetTileFilePath(const std::pair<int, int>& tile) const;
+
+        /// @brief Inquires if a tile overlaps a box
+        /// @param[in] tile The tile column and row
+        /// @param[in] lowerLeft The lower left corner of the box
+        /// @param[in] upperRight The upper right corner of the box
+        /// @returns If the tile overlaps the box, for spherical projections after shifting the tile by a multiple of 360 degrees
+        [[nodiscard]] bool IsTileOverlappingBox(const std::pair<int, int>& tile, const Point& lowerLeft, const Point& upperRight) const;
+
+        /// @brief Removes the tile files written so far
+        void RemoveTileFiles() const;
+
+        std::string m_filePrefix;                   // The prefix of the tile file paths
+        double m_tileSize;                          // The size of the square tiles
+        Projections m_projection;                   // The projection of the sample coordinates
+        int m_maxNumBufferedSamples;                // The maximum number of buffered samples
+        int m_numBufferedSamples = 0;               // The number of buffered samples
+        long long m_numSamples = 0;                 // The number of samples added
+        long long m_numRejectedLines = 0;           // The number of lines rejected by ReadXyzFile
+        std::map<std::pair<int, int>, Tile> m_tiles; // The tiles containing samples, sorted on column and row
+        Point m_lowerLeft{doubleMissingValue, doubleMissingValue};  // The lower left corner of the samples bounding box
+        Point m_upperRight{doubleMissingValue, doubleMissingValue}; // The upper right corner of the samples bounding box
+    };
+} // namespace meshkernel
@@ -0,0 +1,96 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <vector>
+
+#include <MeshKernel/Entities.hpp>
+#include <MeshKernel/SpatialTrees.hpp>
+
+namespace meshkernel
+{
+    /// @brief A Delaunay triangulation of samples, kept to locate points in its triangles.
+    ///
+    /// The triangles are stored in flat arrays, with three entries per triangle: the node indices and the
+    /// neighbouring triangle across the edge opposite each node (-1 on the boundary). Points are located with
+    /// a jump-and-walk: the walk starts from a given triangle (e.g. the one of the previous point) or, if
+    /// none is given, from the triangle with the nearest center. The triangulation only depends on the sample
+    /// coordinates, so it can be reused to interpolate several sample values at the same coordinates.
+    class SampleTriangulation
+    {
+    public:
+        /// @brief Triangulates the samples
+        /// @param[in] samples The samples
+        explicit SampleTriangulation(const std::vector<Sample>& samples);
+
+        /// @brief Finds the triangle containing a point
+        /// @param[in] point The point
+        /// @param[in] startFace The triangle the walk starts from, -1 to start from the triangle with the nearest center
+        /// @param[in,out] queryContext The query context of the triangle centers R-tree
+        /// @returns The triangle index, -1 if the point is outside the triangulation
+        [[nodiscard]] int FindFace(const Point& point, int startFace, SpatialTrees::RTree::QueryContext& queryContext) const;
+
+        /// @brief Gets the number of triangles
+        /// @returns The number of triangles
+        [[nodiscard]] int GetNumFaces() const { return static_cast<int>(m_faceNodes.size()) / 3; }
+
+        /// @brief Gets the number of triangulated nodes
+        /// @returns The number of nodes
+        [[nodiscard]] int GetNumNodes() const { return static_cast<int>(m_nodes.size()); }
+
+        /// @brief Gets a node of a triangle
+        /// @param[in] face The triangle index
+        /// @param[in] position The position of the node in the triangle (0, 1 or 2)
+        /// @returns The node index, the index of the sample
+        [[nodiscard]] int GetFaceNode(int face, int position) const { return m_faceNodes[3 * face + position]; }
+
+        /// @brief Gets the neighbouring triangle across the edge opposite a node of a triangle
+        /// @param[in] face The triangle index
+        /// @param[in] position The position of the node in the triangle (0, 1 or 2)
+        /// @returns The neighbouring triangle index, -1 on the boundary
+        [[nodiscard]] int GetFaceNeighbour(int face, int position) const { return m_faceNeighbours[3 * face + position]; }
+
+        /// @brief Gets the coordinates of a node
+        /// @param[in] node The node index
+        /// @returns The node coordinates
+        [[nodiscard]] const Point& GetNode(int node) const { return m_nodes[node]; }
+
+    private:
+        /// @brief Walks from a triangle towards a point, crossing the edges separating the triangle from the point
+        /// @param[in] point The point
+        /// @param[in] startFace The triangle the walk starts from
+        /// @returns The triangle containing the point, -1 if the walk leaves the triangulation
+        [[nodiscard]] int Walk(const Point& point, int startFace) const;
+
+        std::vector<Point> m_nodes;         // The triangulated nodes
+        std::vector<int> m_faceNodes;       // The three nodes of each triangle
+        std::vector<int> m_faceNeighbours;  // The neighbouring triangle across the edge opposite each node of each triangle
+        SpatialTrees::RTree m_centersRTree; // The R-tree of the triangle centers, to start the walks
+    };
+} // namespace meshkernel
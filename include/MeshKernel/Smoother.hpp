@@ -26,8 +26,12 @@
 //------------------------------------------------------------------------------
 
 #pragma once
+#include <array>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+
+#include <MeshKernel/Entities.hpp>
 
 namespace meshkernel
 {
@@ -50,15 +54,30 @@ namespace meshkernel
         /// @brief Computes the smoother weights
         void Compute();
 
+        /// @brief Sets a sample field clustering the mesh toward its steep gradients (orthonet_comp_Ginv)
+        ///
+        /// The samples are averaged on the nodes by \ref ComputeAdaptationNodeValues, or the first time the weights are computed.
+        /// The monitor matrix of a node is G = I + strength * g g^T / max|g|^2, with g the gradient of the node values,
+        /// so the mesh is compressed across the steepest features.
+        /// @param[in] samples The samples with x,y locations and values (e.g. the bathymetry)
+        /// @param[in] adaptationStrength The ratio of the largest monitor eigenvalue to the smallest, minus one. Zero disables the adaptation
+        void SetAdaptationSamples(const std::vector<Sample>& samples, double adaptationStrength);
+
+        /// @brief Averages the adaptation samples on the current mesh nodes.
+        ///
+        /// The node values are kept until the next call, so all the outer iterations adapt the mesh to the same field while its nodes move.
+        /// Call it again after the mesh topology changes.
+        void ComputeAdaptationNodeValues();
+
         /// <summary>
         /// Gets the weight for a certain node and connected node
         /// </summary>
         /// <param name="node"></param>
         /// <param name="connectedNode"></param>
         /// <returns></returns>
-        [[nodiscard]] inline auto GetWeight(int node, int connectedNode)
+        [[nodiscard]] inline auto GetWeight(int node, int connectedNode) const
         {
-            return m_weights[node][connectedNode];
+            return connectedNode < m_numConnectedNodes[node] ? m_weights[m_connectedNodesOffsets[node] + connectedNode] : 0.0;
         }
 
         /// <summary>
@@ -67,9 +86,9 @@ namespace meshkernel
         /// <param name="node"></param>
         /// <param name="connectedNode"></param>
         /// <returns></returns>
-        [[nodiscard]] inline auto GetCoonectedNodeIndex(int node, int connectedNode)
+        [[nodiscard]] inline auto GetCoonectedNodeIndex(int node, int connectedNode) const
         {
-            return m_connectedNodes[node][connectedNode];
+            return m_connectedNodes[m_connectedNodesOffsets[node] + connectedNode];
         }
 
         /// <summary>
@@ -77,12 +96,66 @@ namespace meshkernel
         /// </summary>
         /// <param name="node"></param>
         /// <returns></returns>
-        [[nodiscard]] inline auto GetNumConnectedNodes(int node)
+        [[nodiscard]] inline auto GetNumConnectedNodes(int node) const
         {
             return m_numConnectedNodes[node];
         }
 
+        /// @brief Gets the topology of a node, its index in the distinct topologies found by Compute
+        /// @param[in] node The node index
+        /// @returns The topology index
+        [[nodiscard]] int GetNodeTopology(int node) const
+        {
+            return m_nodeTopologyMapping[node];
+        }
+
+        /// @brief Gets the operators of all topologies, stored one after the other in the order of the topology indices
+        /// @returns The operator values
+        [[nodiscard]] const std::vector<double>& GetTopologyOperators() const
+        {
+            return m_topologyOperators;
+        }
+
     private:
+        /// @brief The operators of a topology, pointing in m_topologyOperators.
+        ///        The matrices are row major, with one row of numConnectedNodes values per shared face
+        template <typename T>
+        struct NodeOperators
+        {
+            T* Az;     ///< Coefficients to estimate values at cell circumcenters
+            T* Gxi;    ///< Node to edge xi derivative
+            T* Geta;   ///< Node to edge eta derivative
+            T* Divxi;  ///< Edge to node xi derivative
+            T* Diveta; ///< Edge to node eta derivative
+            T* Jxi;    ///< Node to node xi derivative (Jacobian)
+            T* Jeta;   ///< Node to node eta derivative (Jacobian)
+            T* ww2;    ///< Weights
+        };
+
+        /// @brief The local data of a node, from which its topology is determined
+        struct NodeTopologyCache
+        {
+            std::vector<int> sharedFaces;        ///< The faces around the node, -1 for the missing ones
+            std::vector<size_t> connectedNodes;  ///< The connected nodes, the first is the node itself
+            std::vector<size_t> faceNodeMapping; ///< The positions of the face nodes in connectedNodes, maximumNumberOfNodesPerFace per shared face
+            std::vector<double> xi;              ///< The xi coordinate of each connected node
+            std::vector<double> eta;             ///< The eta coordinate of each connected node
+            std::vector<double> thetaSquare;     ///< Scratch of ComputeNodeXiEta, the angles of the squared connected nodes
+            std::vector<bool> isSquareFace;      ///< Scratch of ComputeNodeXiEta, for each shared face if it is squared
+        };
+
+        /// @brief The scratch buffers of ComputeOperatorsNode, one per thread
+        struct OperatorsCache
+        {
+            std::vector<int> boundaryEdges;       ///< The first two boundary edges of the node
+            std::vector<double> leftXFaceCenter;  ///< The x coordinate of the left face center of each edge
+            std::vector<double> leftYFaceCenter;  ///< The y coordinate of the left face center of each edge
+            std::vector<double> rightXFaceCenter; ///< The x coordinate of the right face center of each edge
+            std::vector<double> rightYFaceCenter; ///< The y coordinate of the right face center of each edge
+            std::vector<double> xis;              ///< The xi coordinate of the center of each edge
+            std::vector<double> etas;             ///< The eta coordinate of the center of each edge
+        };
+
         /// @brief Initialize smoother topologies. A topology is determined by how many nodes are connected to the current node.
         ///        There are at maximum mesh.m_numNodes topologies, most likely much less
         void Initialize();
@@ -103,23 +176,40 @@ namespace meshkernel
         /// @brief Computes the smoother weights from the operators (orthonet_compweights_smooth)
         void ComputeWeights();
 
+        /// @brief Computes the inverse of the mesh monitor matrices from the adaptation samples (orthonet_comp_Ginv)
+        /// @param[out] Ginv The inverse monitor matrices, identity if there is no adaptation
+        void ComputeMonitorMatrices(std::vector<std::array<double, 4>>& Ginv);
+
+        /// @brief Makes the scratch buffers of ComputeOperatorsNode
+        /// @returns The operators cache
+        [[nodiscard]] static OperatorsCache MakeOperatorsCache();
+
         /// Computes operators of the elliptic smoother by node (orthonet_comp_operators)
         /// @param[in] currentNode
-        void ComputeOperatorsNode(int currentNode);
+        /// @param[in,out] cache The scratch buffers of the calling thread
+        void ComputeOperatorsNode(int currentNode, OperatorsCache& cache);
 
-        /// @brief Computes m_faceNodeMappingCache, m_sharedFacesCache, m_connectedNodes for the current node, required before computing xi and eta
+        /// @brief Makes a node cache with room for the largest supported node
+        /// @returns The node cache
+        [[nodiscard]] static NodeTopologyCache MakeNodeTopologyCache();
+
+        /// @brief Computes the face node mapping, the shared faces and the connected nodes of the current node, required before computing xi and eta
         /// @param[in] currentNode
+        /// @param[in,out] cache The node cache to fill
         /// @param[out] numSharedFaces
         /// @param[out] numConnectedNodes
         void NodeAdministration(int currentNode,
+                                NodeTopologyCache& cache,
                                 int& numSharedFaces,
                                 int& numConnectedNodes);
 
         /// @brief Compute compute current node xi and eta (orthonet_assign_xieta)
         /// @param[in] currentNode
+        /// @param[in,out] cache The node cache filled by NodeAdministration, receives xi and eta
         /// @param[in] numSharedFaces
         /// @param[in] numConnectedNodes
         void ComputeNodeXiEta(int currentNode,
+                              NodeTopologyCache& cache,
                               int numSharedFaces,
                               int numConnectedNodes);
 
@@ -136,22 +226,73 @@ namespace meshkernel
                                               double theta2 = -1.0,
                                               bool isBoundaryEdge = false) const;
 
-        /// @brief Allocate smoother operators
-        /// @param[in] topologyIndex
-        void AllocateNodeOperators(int topologyIndex);
+        /// @brief Gets the number of values of the operators of a topology
+        /// @param[in] numSharedFaces The number of shared faces of the topology
+        /// @param[in] numConnectedNodes The number of connected nodes of the topology
+        /// @returns The number of values
+        [[nodiscard]] static int NumNodeOperatorsValues(int numSharedFaces, int numConnectedNodes)
+        {
+            return 3 * numSharedFaces * numConnectedNodes + 2 * numSharedFaces + 3 * numConnectedNodes;
+        }
+
+        /// @brief Splits the operator values of a topology in the separate operators
+        /// @tparam T double or const double
+        /// @param[in] operators The first operator value of the topology
+        /// @param[in] numSharedFaces The number of shared faces of the topology
+        /// @param[in] numConnectedNodes The number of connected nodes of the topology
+        /// @returns The operators
+        template <typename T>
+        [[nodiscard]] static NodeOperators<T> MakeNodeOperators(T* operators, int numSharedFaces, int numConnectedNodes);
+
+        /// @brief Gets the operators of a topology
+        /// @param[in] topology The topology index
+        /// @returns The operators
+        [[nodiscard]] NodeOperators<double> GetNodeOperators(int topology);
+
+        /// @brief Gets the operators of a topology
+        /// @param[in] topology The topology index
+        /// @returns The operators
+        [[nodiscard]] NodeOperators<const double> GetNodeOperators(int topology) const;
 
         /// @brief If it is a new topology, save it
         /// @param[in] currentNode
         /// @param[in] numSharedFaces
         /// @param[in] numConnectedNodes
+        /// @param[in] xi The xi coordinates of the connected nodes
+        /// @param[in] eta The eta coordinates of the connected nodes
         void SaveNodeTopologyIfNeeded(int currentNode,
                                       int numSharedFaces,
-                                      int numConnectedNodes);
+                                      int numConnectedNodes,
+                                      const double* xi,
+                                      const double* eta);
+
+        /// @brief Finds the first saved topology whose angles are all within m_thetaTolerance of m_thetaCache.
+        ///        Only the topologies with the signature of m_thetaCache, or of its neighbouring quantizations, are compared
+        /// @param[in] numSharedFaces
+        /// @param[in] numConnectedNodes
+        /// @returns The topology index, -1 if no topology matches
+        [[nodiscard]] int FindTopology(int numSharedFaces, int numConnectedNodes);
+
+        /// @brief Checks if the angles in m_thetaCache are all within m_thetaTolerance of the angles of a topology
+        /// @param[in] topology
+        /// @param[in] numSharedFaces
+        /// @param[in] numConnectedNodes
+        /// @returns If the topology matches
+        [[nodiscard]] bool IsMatchingTopology(int topology, int numSharedFaces, int numConnectedNodes) const;
+
+        /// @brief Hashes the numbers of shared faces and connected nodes and the quantized angles of the connected nodes
+        /// @param[in] numSharedFaces
+        /// @param[in] numConnectedNodes
+        /// @param[in] quantizedTheta The quantized angles, the first (the node itself) is not used
+        /// @returns The signature
+        [[nodiscard]] static std::size_t TopologySignature(int numSharedFaces,
+                                                           int numConnectedNodes,
+                                                           const std::vector<long long>& quantizedTheta);
 
         /// @brief Computes local coordinates jacobian from the mapped jacobians m_Jxi and m_Jeta
         /// @param[in] currentNode
         /// @param[out] J
-        void ComputeJacobian(int currentNode, std::vector<double>& J) const;
+        void ComputeJacobian(int currentNode, std::array<double, 4>& J) const;
 
         /// <summary>
         /// Compute the matrix norm
@@ -160,58 +301,53 @@ namespace meshkernel
         /// <param name="y"></param>
         /// <param name="matCoefficents"></param>
         /// <returns></returns>
-        [[nodiscard]] double MatrixNorm(const std::vector<double>& x,
-                                        const std::vector<double>& y,
-                                        const std::vector<double>& matCoefficents) const;
+        [[nodiscard]] double MatrixNorm(const std::array<double, 2>& x,
+                                        const std::array<double, 2>& y,
+                                        const std::array<double, 4>& matCoefficents) const;
 
         // The mesh to smooth
         std::shared_ptr<Mesh> m_mesh;
 
-        // Smoother weights
-        std::vector<std::vector<double>> m_weights;
+        // Smoother weights, one row per node with the offsets of the connected nodes
+        std::vector<double> m_weights;
 
-        // Smoother operators
-        std::vector<std::vector<std::vector<double>>> m_Gxi;  // Node to edge xi derivative
-        std::vector<std::vector<std::vector<double>>> m_Geta; // Node to edge etha derivative
-        std::vector<std::vector<double>> m_Divxi;             // Edge to node xi derivative
-        std::vector<std::vector<double>> m_Diveta;            // Edge to node etha derivative
-        std::vector<std::vector<std::vector<double>>> m_Az;   // Coefficients to estimate values at cell circumcenters
-        std::vector<std::vector<double>> m_Jxi;               // Node to node xi derivative (Jacobian)
-        std::vector<std::vector<double>> m_Jeta;              // Node to node eta derivative (Jacobian)
-        std::vector<std::vector<double>> m_ww2;               // weights
+        // Smoother operators of all topologies, the operators of a topology are contiguous (see MakeNodeOperators)
+        std::vector<double> m_topologyOperators;
+        std::vector<int> m_topologyOperatorsOffsets;
 
         // Smoother local caches
-        std::vector<int> m_sharedFacesCache;
-        std::vector<size_t> m_connectedNodesCache;
-        std::vector<std::vector<size_t>> m_faceNodeMappingCache;
-        std::vector<double> m_xiCache;
-        std::vector<double> m_etaCache;
-        std::vector<int> m_boundaryEdgesCache;
-        std::vector<double> m_leftXFaceCenterCache;
-        std::vector<double> m_leftYFaceCenterCache;
-        std::vector<double> m_rightXFaceCenterCache;
-        std::vector<double> m_rightYFaceCenterCache;
-        std::vector<double> m_xisCache;
-        std::vector<double> m_etasCache;
-
-        // Smoother topologies
+        NodeTopologyCache m_nodeTopologyCache;
+        std::vector<double> m_thetaCache;
+        std::vector<long long> m_quantizedThetaCache;
+
+        // Smoother topologies, the data of a topology is stored at its node and face offsets
         int m_numTopologies = 0;
         std::vector<int> m_nodeTopologyMapping;
         std::vector<int> m_numTopologyNodes;
         std::vector<int> m_numTopologyFaces;
-        std::vector<std::vector<double>> m_topologyXi;
-        std::vector<std::vector<double>> m_topologyEta;
-        std::vector<std::vector<int>> m_topologySharedFaces;
-        std::vector<std::vector<std::vector<size_t>>> m_topologyFaceNodeMapping;
-        std::vector<std::vector<size_t>> m_topologyConnectedNodes;
+        std::vector<int> m_topologyNodesOffsets;
+        std::vector<int> m_topologyFacesOffsets;
+        std::vector<double> m_topologyXi;
+        std::vector<double> m_topologyEta;
+        std::vector<int> m_topologySharedFaces;
+        std::vector<size_t> m_topologyFaceNodeMapping; // maximumNumberOfNodesPerFace positions per shared face
+        std::vector<size_t> m_topologyConnectedNodes;
+        std::vector<double> m_topologyTheta;                                    // The angles of the connected nodes, at the node offsets
+        std::unordered_map<std::size_t, std::vector<int>> m_topologySignatures; // The topologies with the same signature, in increasing order
 
-        std::vector<int> m_numConnectedNodes;              // (nmk2)
-        std::vector<std::vector<size_t>> m_connectedNodes; // (kk2)
+        std::vector<int> m_numConnectedNodes;     // (nmk2)
+        std::vector<int> m_connectedNodesOffsets; // The offsets of the connected nodes and weights of each node
+        std::vector<size_t> m_connectedNodes;     // (kk2)
 
         // Class variables
         int m_maximumNumConnectedNodes = 0;
         int m_maximumNumSharedFaces = 0;
 
+        // Mesh adaptation
+        std::vector<Sample> m_adaptationSamples;
+        std::vector<double> m_adaptationNodeValues; // The samples averaged on the nodes, kept for all outer iterations
+        double m_adaptationStrength = 0.0;
+
         // nodes with errors
         std::vector<double> m_nodeXErrors;
         std::vector<double> m_nodeYErrors;
@@ -219,5 +355,8 @@ namespace meshkernel
 
         static constexpr int m_topologyInitialSize = 10;
         static constexpr double m_thetaTolerance = 1e-4;
+        static constexpr double m_thetaQuantization = 64.0 * m_thetaTolerance; // Width of the angle quantization of the signatures
+        static constexpr int m_maximumNumProbedAngles = 8;                     // Above this many angles close to a quantization step, topologies are compared one by one
+        static constexpr int m_topologyNodesBlockSize = 1024;                  // The nodes processed together when computing the topologies
     };
 } // namespace meshkernel
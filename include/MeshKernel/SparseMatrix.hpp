@@ -0,0 +1,115 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <vector>
+
+#include <MeshKernel/CompressedSparseRow.hpp>
+
+namespace meshkernel
+{
+    /// @brief A sparse matrix in compressed sparse row format, assembled row by row.
+    ///
+    /// The column indices are stored in a CompressedSparseRow, the values at the same positions in a separate buffer.
+    /// The buffers are reused when the matrix is assembled again, so no allocation takes place once their capacity is large enough.
+    class SparseMatrix
+    {
+    public:
+        /// @brief Constructs an empty matrix
+        SparseMatrix() { Clear(); }
+
+        /// @brief Removes all rows, keeping the capacity
+        void Clear()
+        {
+            m_columns.Clear();
+            m_columns.AddRow();
+            m_values.clear();
+        }
+
+        /// @brief Adds an entry to the row being assembled, entries with the same column are summed in the products
+        /// @param[in] column The column index
+        /// @param[in] value The value
+        void AddEntry(int column, double value)
+        {
+            m_columns.AppendToLastRow(column);
+            m_values.emplace_back(value);
+        }
+
+        /// @brief Closes the row being assembled
+        void FinalizeRow()
+        {
+            m_columns.AddRow();
+        }
+
+        /// @brief Gets the number of rows
+        /// @returns The number of rows
+        [[nodiscard]] int GetNumRows() const { return m_columns.GetNumRows() - 1; }
+
+        /// @brief Gets the diagonal term of a row
+        /// @param[in] row The row index
+        /// @returns The sum of the entries of the row on the diagonal
+        [[nodiscard]] double GetDiagonal(int row) const
+        {
+            double diagonal = 0.0;
+            const auto offset = m_columns.GetRowOffset(row);
+            for (int i = 0; i < m_columns.GetRowSize(row); ++i)
+            {
+                if (m_columns(row, i) == row)
+                {
+                    diagonal += m_values[offset + i];
+                }
+            }
+            return diagonal;
+        }
+
+        /// @brief Computes the product of the matrix with a vector
+        /// @param[in] vector The vector, with as many entries as columns
+        /// @param[out] result The product, resized to the number of rows
+        void Multiply(const std::vector<double>& vector, std::vector<double>& result) const
+        {
+            const auto numRows = GetNumRows();
+            result.resize(numRows);
+#pragma omp parallel for
+            for (int row = 0; row < numRows; ++row)
+            {
+                double sum = 0.0;
+                const auto offset = m_columns.GetRowOffset(row);
+                for (int i = 0; i < m_columns.GetRowSize(row); ++i)
+                {
+                    sum += m_values[offset + i] * vector[m_columns(row, i)];
+                }
+                result[row] = sum;
+            }
+        }
+
+    private:
+        CompressedSparseRow m_columns; // The column indices of the entries of each row, the last row is the one being assembled
+        std::vector<double> m_values;  // The value of each entry, at the position of its column index
+    };
+} // namespace meshkernel
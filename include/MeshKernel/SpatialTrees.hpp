@@ -39,6 +39,7 @@
 #include <vector>
 #include <utility>
 #include <stdexcept>
+#include <algorithm>
 
 // r-tree
 // https://gist.github.com/logc/10272165
@@ -52,7 +53,44 @@ namespace meshkernel
         namespace bg = boost::geometry;
         namespace bgi = boost::geometry::index;
         constexpr int QueryVectorCapacity = 100;
+        constexpr int BatchQueryBlockSize = 256; // The number of queries of a batch executed by a thread in one go
 
+        /// @brief The results of a batch of queries in compressed sparse row layout.
+        ///
+        /// The point indices found by query q are stored at the positions m_offsets[q] to m_offsets[q + 1] of m_indices.
+        class QueryResults
+        {
+        public:
+            /// @brief Gets the number of queries
+            /// @returns The number of queries
+            [[nodiscard]] int GetNumQueries() const { return m_offsets.empty() ? 0 : static_cast<int>(m_offsets.size()) - 1; }
+
+            /// @brief Gets the number of points found by a query
+            /// @param[in] query The query index
+            /// @returns The number of points found
+            [[nodiscard]] int GetQueryResultSize(int query) const { return m_offsets[query + 1] - m_offsets[query]; }
+
+            /// @brief Gets the index of a point found by a query
+            /// @param[in] query The query index
+            /// @param[in] position The position of the point in the query results
+            /// @returns The point index
+            [[nodiscard]] int GetQuerySampleIndex(int query, int position) const { return m_indices[m_offsets[query] + position]; }
+
+        private:
+            friend class RTree;
+            std::vector<int> m_offsets{0}; // The position of the first result of each query, plus the total number of results
+            std::vector<int> m_indices;    // The point indices found by all queries
+        };
+
+        /// @brief R-tree of points, keyed by the point index (e.g. the node or edge index).
+        ///
+        /// The tree can be bulk loaded (BuildTree) or updated incrementally (InsertNode, RemoveNode, MoveNode).
+        /// The entry of each index is kept, so a point can be removed or moved without searching the tree.
+        /// Incremental updates degrade the tree quality, so the tree is bulk loaded again from the stored entries
+        /// once the number of updates since the last bulk load exceeds a fraction of its size.
+        ///
+        /// The single point queries without a context store their results in the tree. The const queries taking a
+        /// QueryContext, and the batch queries returning QueryResults, can be called concurrently on the same tree.
         class RTree
         {
 
@@ -67,74 +105,238 @@ namespace meshkernel
             typedef bgi::rtree<value3D, bgi::linear<16>> RTree3D;
 
         public:
+            /// @brief Bulk loads the tree, the index of each point is its position, points with missing values are skipped
+            /// @param[in] nodes The points
             template <typename T>
-            void BuildTree(std::vector<T>& nodes) //requires IsCoordinate<T>
+            void BuildTree(const std::vector<T>& nodes) //requires IsCoordinate<T>
             {
-                m_points.reserve(m_points.size());
-                m_points.clear();
-                m_rtree2D.clear();
-
-                for (int n = 0; n < nodes.size(); ++n)
+                m_points.resize(nodes.size());
+                for (int n = 0; n < static_cast<int>(nodes.size()); ++n)
                 {
                     if (nodes[n].x != doubleMissingValue && nodes[n].y != doubleMissingValue)
                     {
-                        m_points.emplace_back(Point2D{nodes[n].x, nodes[n].y}, n);
+                        m_points[n] = {Point2D{nodes[n].x, nodes[n].y}, n};
+                    }
+                    else
+                    {
+                        m_points[n] = {Point2D{doubleMissingValue, doubleMissingValue}, -1};
                     }
                 }
-                m_rtree2D = RTree2D(m_points.begin(), m_points.end());
+                BulkLoad();
             }
 
+            /// @brief Buffers of a query, so concurrent callers can query the same tree each with its own context
+            class QueryContext
+            {
+            public:
+                [[nodiscard]] auto GetQueryResultSize() const
+                {
+                    return m_queryIndices.size();
+                }
+
+                [[nodiscard]] auto GetQuerySampleIndex(int index) const
+                {
+                    return m_queryIndices[index];
+                }
+
+            private:
+                friend class RTree;
+                std::vector<value2D> m_queryCache;
+                std::vector<int> m_queryIndices;
+            };
+
             void NearestNeighboursOnSquaredDistance(Point node, double searchRadiusSquared)
+            {
+                NearestNeighboursOnSquaredDistance(node, searchRadiusSquared, m_queryContext);
+            }
+
+            void NearestNeighbour(Point node)
+            {
+                NearestNeighbour(node, m_queryContext);
+            }
+
+            /// @brief Finds the points within a distance of a point, storing the results in a query context
+            /// @param[in] node The point
+            /// @param[in] searchRadiusSquared The squared search radius
+            /// @param[in,out] context The query context receiving the point indices
+            void NearestNeighboursOnSquaredDistance(Point node, double searchRadiusSquared, QueryContext& context) const
             {
                 double searchRadius = std::sqrt(searchRadiusSquared);
 
                 Box2D box(Point2D(node.x - searchRadius, node.y - searchRadius), Point2D(node.x + searchRadius, node.y + searchRadius));
                 Point2D nodeSought = Point2D(node.x, node.y);
 
-                m_queryCache.reserve(QueryVectorCapacity);
-                m_queryCache.clear();
+                context.m_queryCache.reserve(QueryVectorCapacity);
+                context.m_queryCache.clear();
                 m_rtree2D.query(
                     bgi::within(box) &&
                         bgi::satisfies([&nodeSought, &searchRadiusSquared](value2D const& v) { return bg::comparable_distance(v.first, nodeSought) <= searchRadiusSquared; }),
-                    std::back_inserter(m_queryCache));
-
-                m_queryIndices.reserve(m_queryCache.size());
-                m_queryIndices.clear();
-                for (const auto& v : m_queryCache)
-                {
-                    m_queryIndices.emplace_back(v.second);
-                }
+                    std::back_inserter(context.m_queryCache));
+                CopyQueryIndices(context);
             }
 
-            void NearestNeighbour(Point node)
+            /// @brief Finds the nearest point, storing the result in a query context
+            /// @param[in] node The point
+            /// @param[in,out] context The query context receiving the point index
+            void NearestNeighbour(Point node, QueryContext& context) const
             {
+                NearestNeighbours(node, 1, context);
+            }
 
-                m_queryCache.reserve(QueryVectorCapacity);
-                m_queryCache.clear();
+            /// @brief Finds the nearest points, sorted on increasing distance, storing the results in a query context
+            /// @param[in] node The point
+            /// @param[in] numNeighbours The maximum number of points to find
+            /// @param[in,out] context The query context receiving the point indices
+            void NearestNeighbours(Point node, int numNeighbours, QueryContext& context) const
+            {
+                context.m_queryCache.reserve(QueryVectorCapacity);
+                context.m_queryCache.clear();
                 Point2D nodeSought = Point2D(node.x, node.y);
-                m_rtree2D.query(bgi::nearest(nodeSought, 1), std::back_inserter(m_queryCache));
+                m_rtree2D.query(bgi::nearest(nodeSought, numNeighbours), std::back_inserter(context.m_queryCache));
+
+                // the nearest query returns the values in no particular order
+                std::sort(context.m_queryCache.begin(), context.m_queryCache.end(), [&nodeSought](value2D const& first, value2D const& second) {
+                    const auto firstDistance = bg::comparable_distance(first.first, nodeSought);
+                    const auto secondDistance = bg::comparable_distance(second.first, nodeSought);
+                    return firstDistance < secondDistance || (firstDistance == secondDistance && first.second < second.second);
+                });
+                CopyQueryIndices(context);
+            }
 
-                if (!m_queryCache.empty())
+            /// @brief Finds the points in a box, storing the results in a query context
+            /// @param[in] lowerLeft The lower left corner of the box
+            /// @param[in] upperRight The upper right corner of the box
+            /// @param[in,out] context The query context receiving the point indices
+            void PointsInBox(const Point& lowerLeft, const Point& upperRight, QueryContext& context) const
+            {
+                context.m_queryCache.reserve(QueryVectorCapacity);
+                context.m_queryCache.clear();
+                m_rtree2D.query(bgi::covered_by(Box2D(Point2D(lowerLeft.x, lowerLeft.y), Point2D(upperRight.x, upperRight.y))),
+                                std::back_inserter(context.m_queryCache));
+                CopyQueryIndices(context);
+            }
+
+            /// @brief Finds the nearest points of many points (k-nearest neighbours)
+            /// @param[in] nodes The points sought, points with missing values get no results
+            /// @param[in] numNeighbours The maximum number of points to find for each point sought
+            /// @param[out] results The point indices found for each point sought, sorted on increasing distance
+            /// @param[in] parallel Whether the queries are executed in parallel
+            template <typename T>
+            void NearestNeighbours(const std::vector<T>& nodes, int numNeighbours, QueryResults& results, bool parallel = false) const
+            {
+                BatchQuery(
+                    static_cast<int>(nodes.size()), results, parallel, [&nodes, numNeighbours, this](int q, QueryContext& context) {
+                        if (nodes[q].x == doubleMissingValue || nodes[q].y == doubleMissingValue)
+                        {
+                            return false;
+                        }
+                        NearestNeighbours({nodes[q].x, nodes[q].y}, numNeighbours, context);
+                        return true;
+                    });
+            }
+
+            /// @brief Finds the points within a distance of many points
+            /// @param[in] nodes The points sought, points with missing values get no results
+            /// @param[in] searchRadiusSquared The squared search radius
+            /// @param[out] results The point indices found for each point sought
+            /// @param[in] parallel Whether the queries are executed in parallel
+            template <typename T>
+            void NearestNeighboursOnSquaredDistance(const std::vector<T>& nodes, double searchRadiusSquared, QueryResults& results, bool parallel = false) const
+            {
+                BatchQuery(
+                    static_cast<int>(nodes.size()), results, parallel, [&nodes, searchRadiusSquared, this](int q, QueryContext& context) {
+                        if (nodes[q].x == doubleMissingValue || nodes[q].y == doubleMissingValue)
+                        {
+                            return false;
+                        }
+                        NearestNeighboursOnSquaredDistance({nodes[q].x, nodes[q].y}, searchRadiusSquared, context);
+                        return true;
+                    });
+            }
+
+            /// @brief Finds the points in many boxes
+            /// @param[in] lowerLeft The lower left corners of the boxes
+            /// @param[in] upperRight The upper right corners of the boxes
+            /// @param[out] results The point indices found in each box
+            /// @param[in] parallel Whether the queries are executed in parallel
+            void PointsInBox(const std::vector<Point>& lowerLeft, const std::vector<Point>& upperRight, QueryResults& results, bool parallel = false) const
+            {
+                if (lowerLeft.size() != upperRight.size())
                 {
-                    m_queryIndices.clear();
-                    m_queryIndices.emplace_back(m_queryCache[0].second);
+                    throw std::invalid_argument("SpatialTrees::PointsInBox: The number of lower left and upper right corners differ.");
                 }
+                BatchQuery(
+                    static_cast<int>(lowerLeft.size()), results, parallel, [&lowerLeft, &upperRight, this](int q, QueryContext& context) {
+                        if (!lowerLeft[q].IsValid() || !upperRight[q].IsValid())
+                        {
+                            return false;
+                        }
+                        PointsInBox(lowerLeft[q], upperRight[q], context);
+                        return true;
+                    });
             }
 
+            /// @brief Removes the point with a given index
+            /// @param[in] position The point index
             void RemoveNode(int position)
             {
-                const auto numberRemoved = m_rtree2D.remove(m_points[position]);
-                if (numberRemoved != 1)
+                if (!Contains(position) || m_rtree2D.remove(m_points[position]) != 1)
                 {
                     throw std::invalid_argument("SpatialTrees::RemoveNode: Could not remove node at given position.");
                 }
-                m_points[position] = {Point2D{doubleMissingValue, doubleMissingValue}, std::numeric_limits<size_t>::max()};
+                m_points[position] = {Point2D{doubleMissingValue, doubleMissingValue}, -1};
+                CountUpdate();
             }
 
+            /// @brief Adds a point, its index is one past the largest index
+            /// @param[in] node The point
             void InsertNode(const Point& node)
             {
-                m_points.emplace_back(Point2D{node.x, node.y}, m_points.size());
-                m_rtree2D.insert(m_points.end() - 1, m_points.end());
+                InsertNode(static_cast<int>(m_points.size()), node);
+            }
+
+            /// @brief Adds a point with a given index, replacing the existing point with the same index
+            ///
+            /// If the point has missing values the existing point is removed and nothing is added.
+            /// @param[in] position The point index
+            /// @param[in] node The point
+            void InsertNode(int position, const Point& node)
+            {
+                if (position < 0)
+                {
+                    throw std::invalid_argument("SpatialTrees::InsertNode: Invalid position.");
+                }
+                if (position >= static_cast<int>(m_points.size()))
+                {
+                    m_points.resize(position + 1, {Point2D{doubleMissingValue, doubleMissingValue}, -1});
+                }
+                if (Contains(position))
+                {
+                    m_rtree2D.remove(m_points[position]);
+                    m_points[position] = {Point2D{doubleMissingValue, doubleMissingValue}, -1};
+                }
+                if (node.x != doubleMissingValue && node.y != doubleMissingValue)
+                {
+                    m_points[position] = {Point2D{node.x, node.y}, position};
+                    m_rtree2D.insert(m_points[position]);
+                }
+                CountUpdate();
+            }
+
+            /// @brief Moves the point with a given index, adding it if it is not in the tree
+            /// @param[in] position The point index
+            /// @param[in] node The new point
+            void MoveNode(int position, const Point& node)
+            {
+                InsertNode(position, node);
+            }
+
+            /// @brief Inquires if the tree contains a point with a given index
+            /// @param[in] position The point index
+            /// @returns If the point is in the tree
+            [[nodiscard]] bool Contains(int position) const
+            {
+                return position >= 0 && position < static_cast<int>(m_points.size()) && m_points[position].second >= 0;
             }
 
             [[nodiscard]] auto Size() const
@@ -149,17 +351,224 @@ namespace meshkernel
 
             [[nodiscard]] auto GetQueryResultSize() const
             {
-                return m_queryCache.size();
+                return m_queryContext.GetQueryResultSize();
             }
 
             [[nodiscard]] auto GetQuerySampleIndex(int index) const
+            {
+                return m_queryContext.GetQuerySampleIndex(index);
+            }
+
+        private:
+            /// @brief Bulk loads the tree from the stored points
+            void BulkLoad()
+            {
+                auto& values = m_queryContext.m_queryCache;
+                values.clear();
+                for (const auto& point : m_points)
+                {
+                    if (point.second >= 0)
+                    {
+                        values.emplace_back(point);
+                    }
+                }
+                m_rtree2D = RTree2D(values.begin(), values.end());
+                values.clear();
+                m_numUpdates = 0;
+            }
+
+            static void CopyQueryIndices(QueryContext& context)
+            {
+                context.m_queryIndices.reserve(context.m_queryCache.size());
+                context.m_queryIndices.clear();
+                for (const auto& v : context.m_queryCache)
+                {
+                    context.m_queryIndices.emplace_back(v.second);
+                }
+            }
+
+            /// @brief Executes a query for each of the queries of a batch, storing the results in compressed sparse row layout
+            ///
+            /// The queries are split in blocks, each block is executed with its own query context and its own result buffer.
+            /// The buffers are then concatenated in query order, so the results do not depend on the number of threads.
+            /// @param[in] numQueries The number of queries
+            /// @param[out] results The results
+            /// @param[in] parallel Whether the blocks are executed in parallel
+            /// @param[in] query The query, executing query q in a context, returning false if the query has no results
+            template <typename Query>
+            static void BatchQuery(int numQueries, QueryResults& results, bool parallel, const Query& query)
+            {
+                const int numBlocks = (numQueries + BatchQueryBlockSize - 1) / BatchQueryBlockSize;
+                std::vector<std::vector<int>> blockIndices(numBlocks);
+                results.m_offsets.resize(numQueries + 1);
+                results.m_offsets[0] = 0;
+
+#pragma omp parallel for schedule(dynamic) if (parallel)
+                for (int b = 0; b < numBlocks; ++b)
+                {
+                    QueryContext context;
+                    const int endQuery = std::min(numQueries, (b + 1) * BatchQueryBlockSize);
+                    for (int q = b * BatchQueryBlockSize; q < endQuery; ++q)
+                    {
+                        int numResults = 0;
+                        if (query(q, context))
+                        {
+                            numResults = static_cast<int>(context.GetQueryResultSize());
+                            blockIndices[b].insert(blockIndices[b].end(), context.m_queryIndices.begin(), context.m_queryIndices.end());
+                        }
+                        // the counts are stored one position ahead, the prefix sum turns them into offsets
+                        results.m_offsets[q + 1] = numResults;
+                    }
+                }
+
+                for (int q = 0; q < numQueries; ++q)
+                {
+                    results.m_offsets[q + 1] += results.m_offsets[q];
+                }
+
+                results.m_indices.resize(results.m_offsets[numQueries]);
+#pragma omp parallel for if (parallel)
+                for (int b = 0; b < numBlocks; ++b)
+                {
+                    std::copy(blockIndices[b].begin(), blockIndices[b].end(), results.m_indices.begin() + results.m_offsets[b * BatchQueryBlockSize]);
+                }
+            }
+
+            /// @brief Counts an incremental update, bulk loading the tree again if too many updates took place
+            void CountUpdate()
+            {
+                m_numUpdates++;
+                if (m_numUpdates > m_minNumUpdatesBeforeBulkLoad && m_numUpdates > m_maxUpdatesFraction * static_cast<double>(m_rtree2D.size()))
+                {
+                    BulkLoad();
+                }
+            }
+
+            RTree2D m_rtree2D;
+            std::vector<value2D> m_points; // For each index, the point in the tree (index -1 if not in the tree)
+            QueryContext m_queryContext;   // The context of the queries storing their results in the tree
+            int m_numUpdates = 0;                                    // The number of incremental updates since the last bulk load
+            static constexpr int m_minNumUpdatesBeforeBulkLoad = 64; // Below this number of updates the tree is never bulk loaded again
+            static constexpr double m_maxUpdatesFraction = 0.25;     // Above this fraction of updates the tree is bulk loaded again
+        };
+
+        /// @brief R-tree of the segments of a polyline (consecutive valid nodes), indexed on their bounding boxes.
+        ///
+        /// A segment is identified by the index of its first node. The boxes are in coordinate space:
+        /// the callers are responsible for translating distances into search boxes for their projection.
+        class SegmentsRTree
+        {
+            typedef bg::model::point<double, 2, bg::cs::cartesian> Point2D;
+            typedef bg::model::box<Point2D> Box2D;
+            typedef std::pair<Box2D, int> value2D;
+            typedef bgi::rtree<value2D, bgi::linear<16>> RTree2D;
+
+        public:
+            /// @brief Builds the tree from all segments with valid nodes
+            /// @param[in] nodes The polyline nodes, separated by missing values
+            template <typename T>
+            void BuildTree(const std::vector<T>& nodes)
+            {
+                m_segments.clear();
+                m_rtree2D.clear();
+
+                for (int n = 0; n < static_cast<int>(nodes.size()) - 1; ++n)
+                {
+                    if (nodes[n].IsValid() && nodes[n + 1].IsValid())
+                    {
+                        m_segments.emplace_back(SegmentBox(nodes[n], nodes[n + 1]), n);
+                    }
+                }
+                m_rtree2D = RTree2D(m_segments.begin(), m_segments.end());
+            }
+
+            /// @brief Adds a segment to the tree
+            /// @param[in] nodes The polyline nodes
+            /// @param[in] segmentIndex The index of the first node of the segment
+            template <typename T>
+            void InsertSegment(const std::vector<T>& nodes, int segmentIndex)
+            {
+                if (segmentIndex < 0 || segmentIndex + 1 >= static_cast<int>(nodes.size()) ||
+                    !nodes[segmentIndex].IsValid() || !nodes[segmentIndex + 1].IsValid())
+                {
+                    throw std::invalid_argument("SpatialTrees::InsertSegment: Invalid segment.");
+                }
+                m_segments.emplace_back(SegmentBox(nodes[segmentIndex], nodes[segmentIndex + 1]), segmentIndex);
+                m_rtree2D.insert(m_segments.back());
+            }
+
+            /// @brief Finds the segments with the bounding boxes closest to a point, in coordinate space
+            /// @param[in] node The point
+            /// @param[in] numSegments The maximum number of segments to find
+            /// @param[in] startIndex The first segment index to consider
+            /// @param[in] endIndex The segment index past the last one to consider
+            void NearestSegments(const Point& node, int numSegments, int startIndex, int endIndex)
+            {
+                m_queryCache.reserve(QueryVectorCapacity);
+                m_queryCache.clear();
+                m_rtree2D.query(
+                    bgi::nearest(Point2D(node.x, node.y), numSegments) &&
+                        bgi::satisfies([startIndex, endIndex](value2D const& v) { return v.second >= startIndex && v.second < endIndex; }),
+                    std::back_inserter(m_queryCache));
+                CopyQueryIndices();
+            }
+
+            /// @brief Finds the segments with the bounding boxes intersecting a box
+            /// @param[in] lowerLeft The lower left corner of the box
+            /// @param[in] upperRight The upper right corner of the box
+            /// @param[in] startIndex The first segment index to consider
+            /// @param[in] endIndex The segment index past the last one to consider
+            void SegmentsInBox(const Point& lowerLeft, const Point& upperRight, int startIndex, int endIndex)
+            {
+                m_queryCache.reserve(QueryVectorCapacity);
+                m_queryCache.clear();
+                m_rtree2D.query(
+                    bgi::intersects(Box2D(Point2D(lowerLeft.x, lowerLeft.y), Point2D(upperRight.x, upperRight.y))) &&
+                        bgi::satisfies([startIndex, endIndex](value2D const& v) { return v.second >= startIndex && v.second < endIndex; }),
+                    std::back_inserter(m_queryCache));
+                CopyQueryIndices();
+            }
+
+            [[nodiscard]] auto Size() const
+            {
+                return m_rtree2D.size();
+            }
+
+            [[nodiscard]] auto Empty() const
+            {
+                return m_rtree2D.empty();
+            }
+
+            [[nodiscard]] auto GetQueryResultSize() const
+            {
+                return m_queryCache.size();
+            }
+
+            [[nodiscard]] auto GetQuerySegmentIndex(size_t index) const
             {
                 return m_queryIndices[index];
             }
 
         private:
+            template <typename T>
+            [[nodiscard]] static Box2D SegmentBox(const T& firstNode, const T& secondNode)
+            {
+                return Box2D(Point2D(std::min(firstNode.x, secondNode.x), std::min(firstNode.y, secondNode.y)),
+                             Point2D(std::max(firstNode.x, secondNode.x), std::max(firstNode.y, secondNode.y)));
+            }
+
+            void CopyQueryIndices()
+            {
+                m_queryIndices.reserve(m_queryCache.size());
+                m_queryIndices.clear();
+                for (const auto& v : m_queryCache)
+                {
+                    m_queryIndices.emplace_back(v.second);
+                }
+            }
+
             RTree2D m_rtree2D;
-            std::vector<std::pair<Point2D, size_t>> m_points;
+            std::vector<value2D> m_segments;
             std::vector<value2D> m_queryCache;
             std::vector<int> m_queryIndices;
         };
@@ -27,8 +27,10 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <MeshKernel/Entities.hpp>
+#include <MeshKernel/SampleTriangulation.hpp>
 
 namespace meshkernel
 {
@@ -44,9 +46,26 @@ namespace meshkernel
                                    const std::vector<Sample>& samples,
                                    Projections projection);
 
+        /// @brief Constructor reusing the triangulation of samples at the same coordinates (e.g. another field on the same sample set)
+        /// @param[in] locations interpolation points (where the values should be computed)
+        /// @param[in] samples  Values to use for the interpolation
+        /// @param[in] projection Projection to use (\ref Projections)
+        /// @param[in] triangulation The triangulation of the samples, built by \ref Compute if nullptr
+        TriangulationInterpolation(const std::vector<Point>& locations,
+                                   const std::vector<Sample>& samples,
+                                   Projections projection,
+                                   std::shared_ptr<SampleTriangulation> triangulation);
+
         /// @brief Compute results on the interpolation points
         void Compute();
 
+        /// @brief Get the triangulation of the samples, to reuse it for other samples at the same coordinates
+        /// @return The triangulation, nullptr before \ref Compute
+        [[nodiscard]] std::shared_ptr<SampleTriangulation> GetTriangulation() const
+        {
+            return m_triangulation;
+        }
+
         /// @brief Get the results
         /// @return
         [[nodiscard]] const auto& GetResults() const
@@ -58,6 +77,7 @@ namespace meshkernel
         const std::vector<Point>& m_locations;
         const std::vector<Sample>& m_samples;
         Projections m_projection;
+        std::shared_ptr<SampleTriangulation> m_triangulation = nullptr;
         std::vector<double> m_results;
     };
 
@@ -30,13 +30,10 @@
 
 namespace meshkernel
 {
-    extern "C"
-    {
-        void Triangulation(int* jatri, double* xs, double* ys, int* ns, int* indx, int* numtri, int* edgeidx, int* numedge, int* triedge, double* xs3, double* ys3, int* ns3, double* trisize);
-    }
-
     struct Point;
     struct Sample;
+
+    /// @brief Wrapper around the triangle library, storing its output in flat arrays sized exactly to the triangulation
     struct TriangulationWrapper
     {
         enum class TriangulationOptions
@@ -46,145 +43,98 @@ namespace meshkernel
             TriangulatePointsAndGenerateFaces = 3 // generate Delaunay triangulation from input nodes with m_faceEdges and m_edgeNodes
         };
 
-        std::vector<Point> m_nodes;
-        std::vector<std::vector<int>> m_faceNodes;
-        std::vector<std::vector<int>> m_faceEdges;
-        std::vector<std::vector<int>> m_edgeNodes;
-        std::vector<std::vector<int>> m_edgesFaces;
+        std::vector<Point> m_nodes;    ///< The generated nodes (only for \ref TriangulationOptions::GeneratePoints)
+        std::vector<int> m_faceNodes;  ///< The three nodes of each face
+        std::vector<int> m_faceEdges;  ///< The three edges of each face
+        std::vector<int> m_edgeNodes;  ///< The two nodes of each edge
+        std::vector<int> m_edgesFaces; ///< The two faces of each edge, the second one is intMissingValue on the boundary
 
-        int m_numEdges;
-        int m_numNodes;
-        int m_numFaces;
+        int m_numEdges = 0;
+        int m_numNodes = 0;
+        int m_numFaces = 0;
 
-        /// @brief
+        /// @brief Computes the triangulation
         /// @tparam T A type that contains x and y fields
         /// @param inputNodes The input points
         /// @param numPoints The number of input points
         /// @param triangulationOption Triangulation option, see \ref TriangulationOptions
         /// @param averageTriangleArea An estimation of the average area of triangles (required for option 2)
-        /// @param estimatedNumberOfTriangles An estimation of the average number of triangles (required for option 2)
         template <typename T>
         void Compute(const std::vector<T>& inputNodes,
                      int numPoints,
                      TriangulationOptions triangulationOption,
-                     double averageTriangleArea,
-                     int estimatedNumberOfTriangles)
+                     double averageTriangleArea)
         {
-            // TODO: move implementation to source files as soon as we can use modules (c++20)
-
-            std::vector<double> xLocalPolygon(inputNodes.size());
-            std::vector<double> yLocalPolygon(inputNodes.size());
-            for (int i = 0; i < inputNodes.size(); ++i)
-            {
-                xLocalPolygon[i] = inputNodes[i].x;
-                yLocalPolygon[i] = inputNodes[i].y;
-            }
-
-            m_numFaces = -1;
-            m_numEdges = 0;
-            m_numNodes = 0;
-            auto intTriangulationOption = static_cast<int>(triangulationOption);
-
-            std::vector<int> faceNodesFlat;
-            std::vector<int> edgeNodesFlat;
-            std::vector<int> faceEdgesFlat;
-            std::vector<double> xNodesFlat;
-            std::vector<double> yNodesFlat;
-
-            if (estimatedNumberOfTriangles <= 0)
-            {
-                estimatedNumberOfTriangles = static_cast<int>(inputNodes.size()) * 6 + 10;
-            }
-
-            // If the number of estimated triangles is not sufficient, triangulation must be repeated
-            while (m_numFaces < 0)
-            {
-                m_numFaces = estimatedNumberOfTriangles;
-                faceNodesFlat.resize(int(estimatedNumberOfTriangles) * 3);
-                edgeNodesFlat.resize(int(estimatedNumberOfTriangles) * 2);
-                faceEdgesFlat.resize(int(estimatedNumberOfTriangles) * 3);
-                xNodesFlat.resize(int(estimatedNumberOfTriangles) * 3, doubleMissingValue);
-                yNodesFlat.resize(int(estimatedNumberOfTriangles) * 3, doubleMissingValue);
-                Triangulation(&intTriangulationOption,
-                              &xLocalPolygon[0],
-                              &yLocalPolygon[0],
-                              &numPoints,
-                              &faceNodesFlat[0], // INDX
-                              &m_numFaces,
-                              &edgeNodesFlat[0], // EDGEINDX
-                              &m_numEdges,
-                              &faceEdgesFlat[0], // TRIEDGE
-                              &xNodesFlat[0],
-                              &yNodesFlat[0],
-                              &m_numNodes,
-                              &averageTriangleArea);
-                if (estimatedNumberOfTriangles)
-                {
-                    estimatedNumberOfTriangles = -m_numFaces;
-                }
-            }
-
-            // Create nodes
-            m_nodes.resize(m_numNodes);
-            for (int i = 0; i < m_numNodes; ++i)
-            {
-                m_nodes[i] = {xNodesFlat[i], yNodesFlat[i]};
-            }
-
-            // Create m_faceNodes
-            m_faceNodes.resize(m_numFaces, std::vector<int>(3, intMissingValue));
-            m_faceEdges.resize(m_numFaces, std::vector<int>(3, intMissingValue));
-            int faceCounter = 0;
-            for (int f = 0; f < m_numFaces; ++f)
-            {
-                m_faceNodes[f][0] = faceNodesFlat[faceCounter] - 1;
-                m_faceEdges[f][0] = faceEdgesFlat[faceCounter] - 1;
-                faceCounter++;
-                m_faceNodes[f][1] = faceNodesFlat[faceCounter] - 1;
-                m_faceEdges[f][1] = faceEdgesFlat[faceCounter] - 1;
-                faceCounter++;
-                m_faceNodes[f][2] = faceNodesFlat[faceCounter] - 1;
-                m_faceEdges[f][2] = faceEdgesFlat[faceCounter] - 1;
-                faceCounter++;
-            }
-
-            // Create edges
-            if (m_numEdges <= 0)
-            {
-                return;
-            }
-
-            m_edgeNodes.resize(m_numEdges, std::vector<int>(2, intMissingValue));
-            int edgeCounter = 0;
-            for (int e = 0; e < m_numEdges; ++e)
+            std::vector<double> pointList(2 * numPoints);
+            for (int i = 0; i < numPoints; ++i)
             {
-                m_edgeNodes[e][0] = edgeNodesFlat[edgeCounter] - 1;
-                edgeCounter++;
-                m_edgeNodes[e][1] = edgeNodesFlat[edgeCounter] - 1;
-                edgeCounter++;
+                pointList[2 * i] = inputNodes[i].x;
+                pointList[2 * i + 1] = inputNodes[i].y;
             }
+            ComputeFromPointList(pointList, triangulationOption, averageTriangleArea);
+        }
 
-            m_edgesFaces.resize(m_numEdges, std::vector<int>(2, intMissingValue));
-            edgeCounter = 0;
-            for (int f = 0; f < m_numFaces; ++f)
+        /// @brief Computes the Delaunay triangulation with faces and edges (as \ref TriangulationOptions::TriangulatePointsAndGenerateFaces),
+        /// triangulating vertical slabs of the points concurrently and merging them along the seams
+        /// @tparam T A type that contains x and y fields
+        /// @param inputNodes The input points
+        /// @param numPoints The number of input points
+        /// @param numSlabs The number of slabs, the points are triangulated at once if smaller than 2
+        template <typename T>
+        void ComputeInSlabs(const std::vector<T>& inputNodes,
+                            int numPoints,
+                            int numSlabs)
+        {
+            std::vector<double> pointList(2 * numPoints);
+            for (int i = 0; i < numPoints; ++i)
             {
-
-                for (int n = 0; n < 3; ++n)
-                {
-                    auto const edge = faceEdgesFlat[edgeCounter] - 1;
-                    edgeCounter++;
-                    // For each edge, the shared face index
-                    if (m_edgesFaces[edge][0] == intMissingValue)
-                    {
-                        m_edgesFaces[edge][0] = f;
-                    }
-                    else
-                    {
-                        m_edgesFaces[edge][1] = f;
-                    }
-                }
+                pointList[2 * i] = inputNodes[i].x;
+                pointList[2 * i + 1] = inputNodes[i].y;
             }
+            ComputeFromPointListInSlabs(pointList, numSlabs);
         }
+
+        /// @brief Gets a node of a face
+        /// @param[in] face The face index
+        /// @param[in] position The position of the node in the face (0, 1 or 2)
+        /// @returns The node index
+        [[nodiscard]] int GetFaceNode(int face, int position) const { return m_faceNodes[3 * face + position]; }
+
+        /// @brief Gets an edge of a face
+        /// @param[in] face The face index
+        /// @param[in] position The position of the edge in the face (0, 1 or 2)
+        /// @returns The edge index
+        [[nodiscard]] int GetFaceEdge(int face, int position) const { return m_faceEdges[3 * face + position]; }
+
+        /// @brief Gets a node of an edge
+        /// @param[in] edge The edge index
+        /// @param[in] position The position of the node in the edge (0 or 1)
+        /// @returns The node index
+        [[nodiscard]] int GetEdgeNode(int edge, int position) const { return m_edgeNodes[2 * edge + position]; }
+
+        /// @brief Gets a face of an edge
+        /// @param[in] edge The edge index
+        /// @param[in] position The position of the face in the edge (0 or 1)
+        /// @returns The face index, intMissingValue if the edge has no face at this position
+        [[nodiscard]] int GetEdgeFace(int edge, int position) const { return m_edgesFaces[2 * edge + position]; }
+
+    private:
+        /// @brief Calls the triangle library and copies its output
+        /// @param[in] pointList The interleaved x and y coordinates of the input points
+        /// @param[in] triangulationOption Triangulation option, see \ref TriangulationOptions
+        /// @param[in] averageTriangleArea The maximum triangle area when generating points
+        void ComputeFromPointList(std::vector<double>& pointList,
+                                  TriangulationOptions triangulationOption,
+                                  double averageTriangleArea);
+
+        /// @brief Triangulates the slabs, then the seams between them constrained by the edges bordering the slab triangles
+        /// @param[in] pointList The interleaved x and y coordinates of the input points
+        /// @param[in] numSlabs The number of slabs
+        void ComputeFromPointListInSlabs(std::vector<double>& pointList, int numSlabs);
+
+        /// @brief Fills m_edgesFaces from m_faceEdges and checks the triangulation is a planar subdivision of the convex hull
+        /// @returns If every edge has one or two faces and the Euler characteristic is one
+        [[nodiscard]] bool SetEdgesFacesAndValidate();
     };
 
 } // namespace meshkernel
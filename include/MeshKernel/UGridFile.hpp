@@ -0,0 +1,55 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <string>
+
+namespace meshkernel
+{
+    class Mesh;
+
+    /// @brief Reads a 2D mesh from a UGRID NetCDF file.
+    ///
+    /// The mesh topology variable is located by its cf_role and topology_dimension attributes,
+    /// files using the legacy NetNode_x, NetNode_y and NetLink variables are read as well.
+    /// The node coordinates and the edge nodes are read in chunks directly into the mesh storage,
+    /// then the mesh is administrated (faces are computed from the edges).
+    /// The projection is spherical if the x coordinate standard_name is longitude, cartesian otherwise.
+    /// @param[in] filePath The path of the file to read
+    /// @param[out] mesh The mesh to set
+    void ReadUGridMesh(const std::string& filePath, Mesh& mesh);
+
+    /// @brief Writes a 2D mesh to a UGRID 1.0 NetCDF file.
+    ///
+    /// The nodes, the edges and the faces are written in chunks, using 0-based indices.
+    /// Any existing file is overwritten.
+    /// @param[in] filePath The path of the file to write
+    /// @param[in] mesh The mesh to write
+    void WriteUGridMesh(const std::string& filePath, const Mesh& mesh);
+} // namespace meshkernel
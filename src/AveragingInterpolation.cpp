@@ -32,6 +32,9 @@
 #include <MeshKernel/SpatialTrees.hpp>
 #include <MeshKernel/AveragingInterpolation.hpp>
 #include <MeshKernel/Exceptions.hpp>
+#include <exception>
+#include <map>
+#include <numeric>
 #include <stdexcept>
 
 meshkernel::AveragingInterpolation::AveragingInterpolation(std::shared_ptr<Mesh> mesh,
@@ -50,18 +53,51 @@ meshkernel::AveragingInterpolation::AveragingInterpolation(std::shared_ptr<Mesh>
 {
 }
 
+meshkernel::AveragingInterpolation::AveragingInterpolation(std::shared_ptr<Mesh> mesh,
+                                                           std::shared_ptr<SampleTiles> sampleTiles,
+                                                           Method method,
+                                                           InterpolationLocation locationType,
+                                                           double relativeSearchRadius,
+                                                           bool useClosestSampleIfNoneAvailable) : m_mesh(mesh),
+                                                                                                   m_samples(m_loadedSamples),
+                                                                                                   m_sampleTiles(sampleTiles),
+                                                                                                   m_method(method),
+                                                                                                   m_interpolationLocation(locationType),
+                                                                                                   m_relativeSearchRadius(relativeSearchRadius),
+                                                                                                   m_useClosestSampleIfNoneAvailable(useClosestSampleIfNoneAvailable)
+{
+}
+
 void meshkernel::AveragingInterpolation::Compute()
 {
-    if (m_samples.empty())
+    if (m_sampleTiles != nullptr ? m_sampleTiles->GetNumSamples() == 0 : m_samples.empty())
     {
         throw AlgorithmError("TriangulationInterpolation::Compute: No samples available.");
     }
 
-    m_visitedSamples.resize(m_samples.size());
-    // build sample rtree for searches
-    m_samplesRtree.BuildTree(m_samples);
+    const bool isFaceLocation = m_interpolationLocation == InterpolationLocation::Faces;
+    if (!isFaceLocation)
+    {
+        // make sure edge centers are computed
+        m_mesh->ComputeEdgesCenters();
+    }
+    const auto numLocations = isFaceLocation ? m_mesh->GetNumFaces() : m_mesh->GetNumNodes();
+    std::vector<double> interpolatedResults(numLocations, doubleMissingValue);
 
-    auto interpolatedResults = ComputeOnLocations();
+    if (m_sampleTiles != nullptr)
+    {
+        ComputeOnSampleTiles(interpolatedResults);
+    }
+    else
+    {
+        m_visitedSamples.resize(m_samples.size());
+        // build sample rtree for searches
+        m_samplesRtree.BuildTree(m_samples);
+
+        std::vector<int> locations(numLocations);
+        std::iota(locations.begin(), locations.end(), 0);
+        ComputeOnLocations(locations, interpolatedResults);
+    }
 
     //for edges, an average of the nodal interpolated value is made
     if (m_interpolationLocation == InterpolationLocation::Edges)
@@ -98,89 +134,185 @@ void meshkernel::AveragingInterpolation::Compute()
     m_results = std::move(interpolatedResults);
 }
 
-std::vector<double> meshkernel::AveragingInterpolation::ComputeOnLocations()
+void meshkernel::AveragingInterpolation::ComputeOnSampleTiles(std::vector<double>& interpolatedResults)
 {
-    switch (m_interpolationLocation)
-    {
-    case InterpolationLocation::Faces:
+    // group the locations on the sample tile containing them
+    std::map<std::pair<int, int>, std::vector<int>> tilesLocations;
+    std::vector<Point> polygon;
+    Point interpolationPoint;
+    for (int l = 0; l < static_cast<int>(interpolatedResults.size()); ++l)
     {
-        std::vector<double> interpolatedResults(m_mesh->GetNumFaces(), doubleMissingValue);
-        std::vector<Point> polygonNodesCache(maximumNumberOfNodesPerFace + 1);
-        std::fill(m_visitedSamples.begin(), m_visitedSamples.end(), false);
-        for (int f = 0; f < m_mesh->GetNumFaces(); ++f)
+        MakeLocationPolygon(l, polygon, interpolationPoint);
+        if (interpolationPoint.IsValid())
         {
-            polygonNodesCache.clear();
-            const auto numFaceNodes = m_mesh->GetNumFaceEdges(f);
+            tilesLocations[m_sampleTiles->GetTile(interpolationPoint)].emplace_back(l);
+        }
+    }
 
-            for (int n = 0; n < numFaceNodes; ++n)
+    std::vector<Point> searchPolygon;
+    for (const auto& tileLocations : tilesLocations)
+    {
+        // the samples needed by the locations of the tile are inside the bounding box of their search polygons
+        Point lowerLeft{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        Point upperRight{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+        for (const auto l : tileLocations.second)
+        {
+            MakeLocationPolygon(l, polygon, interpolationPoint);
+            MakeSearchPolygon(polygon, interpolationPoint, searchPolygon);
+            for (const auto& value : searchPolygon)
             {
-                polygonNodesCache.emplace_back(m_mesh->m_facesMassCenters[f] + (m_mesh->m_nodes[m_mesh->m_facesNodes[f][n]] - m_mesh->m_facesMassCenters[f]) * m_relativeSearchRadius);
+                lowerLeft = {std::min(lowerLeft.x, value.x), std::min(lowerLeft.y, value.y)};
+                upperRight = {std::max(upperRight.x, value.x), std::max(upperRight.y, value.y)};
             }
-            polygonNodesCache.emplace_back(polygonNodesCache[0]);
+        }
 
-            double result = 0.0;
-            ComputeOnPolygon(polygonNodesCache, m_mesh->m_facesMassCenters[f], result);
+        // only the samples of the overlapping tiles are kept in memory
+        m_sampleTiles->LoadSamples(lowerLeft, upperRight, m_loadedSamples);
+        if (m_loadedSamples.empty())
+        {
+            continue;
+        }
+        m_samplesRtree.BuildTree(m_loadedSamples);
 
-            interpolatedResults[f] = result;
+        ComputeOnLocations(tileLocations.second, interpolatedResults);
+    }
 
-            if (m_transformSamples && result > 0)
-            {
-                // for certain algorithms we want to decrease the values of the samples (e.g. refinement)
-                // it is difficult to do it otherwise without sharing or caching the query result
-                for (int i = 0; i < m_samplesRtree.GetQueryResultSize(); i++)
-                {
-                    const auto sample = m_samplesRtree.GetQuerySampleIndex(i);
-                    if (!m_visitedSamples[sample])
-                    {
-                        m_visitedSamples[sample] = true;
-                        m_samples[sample].value -= 1;
-                    }
-                }
-            }
+    std::vector<Sample>().swap(m_loadedSamples);
+    m_samplesRtree.BuildTree(m_loadedSamples);
+}
+
+void meshkernel::AveragingInterpolation::MakeLocationPolygon(int location, std::vector<Point>& polygon, Point& interpolationPoint) const
+{
+    if (m_interpolationLocation == InterpolationLocation::Faces)
+    {
+        polygon.clear();
+        interpolationPoint = m_mesh->m_facesMassCenters[location];
+        const auto numFaceNodes = m_mesh->GetNumFaceEdges(location);
+        for (int n = 0; n < numFaceNodes; ++n)
+        {
+            polygon.emplace_back(interpolationPoint + (m_mesh->m_nodes[m_mesh->m_facesNodesCsr(location, n)] - interpolationPoint) * m_relativeSearchRadius);
         }
-        return interpolatedResults;
+        polygon.emplace_back(polygon[0]);
+        return;
     }
-    case InterpolationLocation::Nodes:
-    case InterpolationLocation::Edges:
-    {
-        std::vector<Point> dualFacePolygon;
-        std::vector<double> interpolatedResults(m_mesh->GetNumNodes(), doubleMissingValue);
-        // make sure edge centers are computed
-        m_mesh->ComputeEdgesCenters();
-        for (int n = 0; n < m_mesh->GetNumNodes(); ++n)
+
+    interpolationPoint = m_mesh->m_nodes[location];
+    m_mesh->MakeDualFace(location, m_relativeSearchRadius, polygon);
+}
+
+void meshkernel::AveragingInterpolation::ComputeOnLocations(const std::vector<int>& locations, std::vector<double>& interpolatedResults)
+{
+    const bool isFaceLocation = m_interpolationLocation == InterpolationLocation::Faces;
+    const auto numLocations = static_cast<int>(locations.size());
+    std::fill(m_visitedSamples.begin(), m_visitedSamples.end(), false);
+
+    // for certain algorithms we want to decrease the values of the samples found on faces (e.g. refinement)
+    const bool transformSamples = isFaceLocation && m_transformSamples;
+    const auto transformSample = [this](int sample) {
+        if (!m_visitedSamples[sample])
         {
-            m_mesh->MakeDualFace(n, m_relativeSearchRadius, dualFacePolygon);
+            m_visitedSamples[sample] = true;
+            m_samples[sample].value -= 1;
+        }
+    };
 
-            double result = 0.0;
-            ComputeOnPolygon(dualFacePolygon, m_mesh->m_nodes[n], result);
+    // interpolates one location, the visited samples are transformed directly or collected when computing in parallel
+    const auto computeOnLocation = [&](int l,
+                                       SpatialTrees::RTree::QueryContext& queryContext,
+                                       std::vector<Point>& polygonNodesCache,
+                                       std::vector<Point>& searchPolygonCache,
+                                       std::vector<int>& visitedSamples) {
+        Point interpolationPoint;
+        MakeLocationPolygon(l, polygonNodesCache, interpolationPoint);
 
-            // flag the visited samples
-            for (int i = 0; i < m_samplesRtree.GetQueryResultSize(); i++)
+        double result = 0.0;
+        ComputeOnPolygon(polygonNodesCache, interpolationPoint, queryContext, searchPolygonCache, result);
+        interpolatedResults[l] = result;
+
+        if (!transformSamples || result <= 0)
+        {
+            return;
+        }
+        for (int s = 0; s < queryContext.GetQueryResultSize(); s++)
+        {
+            const auto sample = queryContext.GetQuerySampleIndex(s);
+            if (m_parallel)
+            {
+                visitedSamples.emplace_back(sample);
+            }
+            else
             {
-                const auto sample = m_samplesRtree.GetQuerySampleIndex(i);
-                m_visitedSamples[sample] = true;
+                transformSample(sample);
             }
+        }
+    };
 
-            interpolatedResults[n] = result;
+    if (!m_parallel)
+    {
+        SpatialTrees::RTree::QueryContext queryContext;
+        std::vector<Point> polygonNodesCache;
+        polygonNodesCache.reserve(maximumNumberOfEdgesPerNode * 2 + 1);
+        std::vector<Point> searchPolygonCache;
+        std::vector<int> visitedSamples;
+        for (int i = 0; i < numLocations; ++i)
+        {
+            computeOnLocation(locations[i], queryContext, polygonNodesCache, searchPolygonCache, visitedSamples);
         }
-        return interpolatedResults;
+        return;
     }
+
+    // in parallel the samples to transform are collected by each thread and transformed after the loop,
+    // exceptions cannot leave the parallel region, so the first error is raised after the loop
+    std::vector<int> visitedSamples;
+    std::exception_ptr locationError = nullptr;
+
+#pragma omp parallel
+    {
+        SpatialTrees::RTree::QueryContext queryContext;
+        std::vector<Point> polygonNodesCache;
+        polygonNodesCache.reserve(maximumNumberOfEdgesPerNode * 2 + 1);
+        std::vector<Point> searchPolygonCache;
+        std::vector<int> threadVisitedSamples;
+
+#pragma omp for schedule(dynamic, 256)
+        for (int i = 0; i < numLocations; ++i)
+        {
+            try
+            {
+                computeOnLocation(locations[i], queryContext, polygonNodesCache, searchPolygonCache, threadVisitedSamples);
+            }
+            catch (...)
+            {
+#pragma omp critical(AveragingInterpolationErrors)
+                if (locationError == nullptr)
+                {
+                    locationError = std::current_exception();
+                }
+            }
+        }
+
+#pragma omp critical(AveragingInterpolationVisitedSamples)
+        visitedSamples.insert(visitedSamples.end(), threadVisitedSamples.begin(), threadVisitedSamples.end());
     }
-}
 
-void meshkernel::AveragingInterpolation::ComputeOnPolygon(const std::vector<Point>& polygon,
-                                                          Point interpolationPoint,
-                                                          double& result)
-{
+    if (locationError != nullptr)
+    {
+        std::rethrow_exception(locationError);
+    }
 
-    if (!interpolationPoint.IsValid())
+    // each sample is transformed once, so the result does not depend on the order of the threads
+    for (const auto sample : visitedSamples)
     {
-        throw std::invalid_argument("AveragingInterpolation::ComputeOnPolygon invalid interpolation point");
+        transformSample(sample);
     }
+}
 
+void meshkernel::AveragingInterpolation::MakeSearchPolygon(const std::vector<Point>& polygon,
+                                                           Point interpolationPoint,
+                                                           std::vector<Point>& searchPolygon) const
+{
     // increase polygon size
-    std::vector<Point> searchPolygon;
-    searchPolygon.reserve(polygon.size());
+    searchPolygon.clear();
     for (const auto& value : polygon)
     {
         searchPolygon.emplace_back(value * m_relativeSearchRadius + interpolationPoint * (1.0 - m_relativeSearchRadius));
@@ -193,19 +325,29 @@ void meshkernel::AveragingInterpolation::ComputeOnPolygon(const std::vector<Poin
     if (m_mesh->m_projection == Projections::spherical && upperRight.x - lowerLeft.x > 180.0)
     {
         const auto xmean = 0.5 * (upperRight.x + lowerLeft.x);
-        lowerLeft.x = std::numeric_limits<double>::max();
-        upperRight.x = std::numeric_limits<double>::lowest();
-
         for (auto& value : searchPolygon)
         {
             if (value.x < xmean)
             {
                 value.x = value.x + 360.0;
-                lowerLeft.x = std::min(lowerLeft.x, value.x);
-                upperRight.x = std::max(upperRight.x, value.x);
             }
         }
     }
+}
+
+void meshkernel::AveragingInterpolation::ComputeOnPolygon(const std::vector<Point>& polygon,
+                                                          Point interpolationPoint,
+                                                          SpatialTrees::RTree::QueryContext& queryContext,
+                                                          std::vector<Point>& searchPolygon,
+                                                          double& result) const
+{
+
+    if (!interpolationPoint.IsValid())
+    {
+        throw std::invalid_argument("AveragingInterpolation::ComputeOnPolygon invalid interpolation point");
+    }
+
+    MakeSearchPolygon(polygon, interpolationPoint, searchPolygon);
 
     result = doubleMissingValue;
     double searchRadiusSquared = std::numeric_limits<double>::lowest();
@@ -220,16 +362,16 @@ void meshkernel::AveragingInterpolation::ComputeOnPolygon(const std::vector<Poin
     }
 
     // Get the closest sample
-    m_samplesRtree.NearestNeighboursOnSquaredDistance(interpolationPoint, searchRadiusSquared);
-    if (m_samplesRtree.GetQueryResultSize() == 0)
+    m_samplesRtree.NearestNeighboursOnSquaredDistance(interpolationPoint, searchRadiusSquared, queryContext);
+    if (queryContext.GetQueryResultSize() == 0)
     {
         if (m_useClosestSampleIfNoneAvailable)
         {
             // use the closest sample if none available
-            m_samplesRtree.NearestNeighbour(interpolationPoint);
-            if (m_samplesRtree.GetQueryResultSize() > 0)
+            m_samplesRtree.NearestNeighbour(interpolationPoint, queryContext);
+            if (queryContext.GetQueryResultSize() > 0)
             {
-                const auto sampleIndex = m_samplesRtree.GetQuerySampleIndex(0);
+                const auto sampleIndex = queryContext.GetQuerySampleIndex(0);
                 if (sampleIndex >= 0)
                 {
                     result = m_samples[sampleIndex].value;
@@ -244,10 +386,10 @@ void meshkernel::AveragingInterpolation::ComputeOnPolygon(const std::vector<Poin
     bool firstValidSampleFound = false;
     double closestSquaredDistance = std::numeric_limits<double>::max();
 
-    for (int i = 0; i < m_samplesRtree.GetQueryResultSize(); i++)
+    for (int i = 0; i < queryContext.GetQueryResultSize(); i++)
     {
         //do stuff based on the averaging method
-        const auto sampleIndex = m_samplesRtree.GetQuerySampleIndex(i);
+        const auto sampleIndex = queryContext.GetQuerySampleIndex(i);
         const auto sampleValue = m_samples[sampleIndex].value;
         if (sampleValue <= doubleMissingValue)
         {
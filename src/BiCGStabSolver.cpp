@@ -0,0 +1,183 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <MeshKernel/BiCGStabSolver.hpp>
+#include <MeshKernel/SparseMatrix.hpp>
+
+double meshkernel::BiCGStabSolver::Dot(const std::vector<double>& first, const std::vector<double>& second)
+{
+    const auto size = static_cast<int>(first.size());
+    double result = 0.0;
+#pragma omp parallel for reduction(+ : result)
+    for (int i = 0; i < size; ++i)
+    {
+        result += first[i] * second[i];
+    }
+    return result;
+}
+
+void meshkernel::BiCGStabSolver::Precondition(const std::vector<double>& vector, std::vector<double>& result) const
+{
+    const auto size = static_cast<int>(vector.size());
+    result.resize(size);
+#pragma omp parallel for
+    for (int i = 0; i < size; ++i)
+    {
+        result[i] = m_inverseDiagonal[i] * vector[i];
+    }
+}
+
+void meshkernel::BiCGStabSolver::SetPreconditioner(const SparseMatrix& matrix)
+{
+    const auto size = matrix.GetNumRows();
+    m_inverseDiagonal.resize(size);
+#pragma omp parallel for
+    for (int i = 0; i < size; ++i)
+    {
+        const auto diagonal = matrix.GetDiagonal(i);
+        m_inverseDiagonal[i] = diagonal != 0.0 ? 1.0 / diagonal : 1.0;
+    }
+}
+
+int meshkernel::BiCGStabSolver::Solve(const SparseMatrix& matrix,
+                                      const std::vector<double>& rhs,
+                                      double relativeTolerance,
+                                      double residualReduction,
+                                      int maxIterations,
+                                      std::vector<double>& solution)
+{
+    const auto size = matrix.GetNumRows();
+    if (static_cast<int>(m_inverseDiagonal.size()) != size)
+    {
+        throw std::invalid_argument("BiCGStabSolver::Solve: The preconditioner has not been computed for this matrix.");
+    }
+    m_isConverged = false;
+    m_relativeResidual = 0.0;
+
+    // initial residual
+    matrix.Multiply(solution, m_residual);
+#pragma omp parallel for
+    for (int i = 0; i < size; ++i)
+    {
+        m_residual[i] = rhs[i] - m_residual[i];
+    }
+    m_shadowResidual = m_residual;
+
+    double rhsNorm = std::sqrt(Dot(rhs, rhs));
+    if (rhsNorm == 0.0)
+    {
+        rhsNorm = 1.0;
+    }
+    m_relativeResidual = std::sqrt(Dot(m_residual, m_residual)) / rhsNorm;
+    if (m_relativeResidual <= relativeTolerance)
+    {
+        m_isConverged = true;
+        return 0;
+    }
+    const double tolerance = std::max(relativeTolerance, residualReduction * m_relativeResidual);
+
+    m_searchDirection.assign(size, 0.0);
+    m_matrixTimesSearch.assign(size, 0.0);
+    m_intermediateResidual.resize(size);
+    double rho = 1.0;
+    double alpha = 1.0;
+    double omega = 1.0;
+    int iteration = 0;
+    while (iteration < maxIterations)
+    {
+        iteration++;
+
+        const double newRho = Dot(m_shadowResidual, m_residual);
+        if (newRho == 0.0 || omega == 0.0)
+        {
+            // breakdown, the current solution is kept
+            break;
+        }
+
+        const double beta = newRho / rho * (alpha / omega);
+#pragma omp parallel for
+        for (int i = 0; i < size; ++i)
+        {
+            m_searchDirection[i] = m_residual[i] + beta * (m_searchDirection[i] - omega * m_matrixTimesSearch[i]);
+        }
+        Precondition(m_searchDirection, m_preconditionedSearch);
+        matrix.Multiply(m_preconditionedSearch, m_matrixTimesSearch);
+
+        const double shadowDotMatrixTimesSearch = Dot(m_shadowResidual, m_matrixTimesSearch);
+        if (shadowDotMatrixTimesSearch == 0.0)
+        {
+            break;
+        }
+        alpha = newRho / shadowDotMatrixTimesSearch;
+
+#pragma omp parallel for
+        for (int i = 0; i < size; ++i)
+        {
+            m_intermediateResidual[i] = m_residual[i] - alpha * m_matrixTimesSearch[i];
+        }
+
+        m_relativeResidual = std::sqrt(Dot(m_intermediateResidual, m_intermediateResidual)) / rhsNorm;
+        if (m_relativeResidual <= tolerance)
+        {
+#pragma omp parallel for
+            for (int i = 0; i < size; ++i)
+            {
+                solution[i] += alpha * m_preconditionedSearch[i];
+            }
+            m_isConverged = true;
+            break;
+        }
+
+        Precondition(m_intermediateResidual, m_preconditionedResidual);
+        matrix.Multiply(m_preconditionedResidual, m_matrixTimesResidual);
+
+        const double matrixTimesResidualNorm = Dot(m_matrixTimesResidual, m_matrixTimesResidual);
+        omega = matrixTimesResidualNorm != 0.0 ? Dot(m_matrixTimesResidual, m_intermediateResidual) / matrixTimesResidualNorm : 0.0;
+
+#pragma omp parallel for
+        for (int i = 0; i < size; ++i)
+        {
+            solution[i] += alpha * m_preconditionedSearch[i] + omega * m_preconditionedResidual[i];
+            m_residual[i] = m_intermediateResidual[i] - omega * m_matrixTimesResidual[i];
+        }
+
+        m_relativeResidual = std::sqrt(Dot(m_residual, m_residual)) / rhsNorm;
+        if (m_relativeResidual <= tolerance)
+        {
+            m_isConverged = true;
+            break;
+        }
+        rho = newRho;
+    }
+
+    return iteration;
+}
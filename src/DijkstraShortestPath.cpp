@@ -0,0 +1,190 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <limits>
+#include <stdexcept>
+
+#include <MeshKernel/DijkstraShortestPath.hpp>
+
+void meshkernel::DijkstraShortestPath::Initialize(int numNodes, int sourceNode)
+{
+    if (sourceNode < 0 || sourceNode >= numNodes)
+    {
+        throw std::invalid_argument("DijkstraShortestPath::Initialize: Invalid source node.");
+    }
+
+    if (m_distances.size() != static_cast<std::size_t>(numNodes))
+    {
+        // the graph changed, reset everything
+        m_distances.assign(numNodes, std::numeric_limits<double>::max());
+        m_predecessorEdges.assign(numNodes, -1);
+        m_isVisited.assign(numNodes, false);
+        m_isTouched.assign(numNodes, false);
+        m_heapPositions.assign(numNodes, -1);
+        m_touchedNodes.clear();
+    }
+    else
+    {
+        // reset only the nodes modified by the previous search
+        for (const auto& node : m_touchedNodes)
+        {
+            m_distances[node] = std::numeric_limits<double>::max();
+            m_predecessorEdges[node] = -1;
+            m_isVisited[node] = false;
+            m_isTouched[node] = false;
+            m_heapPositions[node] = -1;
+        }
+        m_touchedNodes.clear();
+    }
+    m_heap.clear();
+
+    Touch(sourceNode);
+    m_distances[sourceNode] = 0.0;
+}
+
+bool meshkernel::DijkstraShortestPath::Relax(int node, int edge, double distance, bool canBeSettled)
+{
+    if (m_isVisited[node] || !(distance < m_distances[node]))
+    {
+        return false;
+    }
+
+    Touch(node);
+    m_distances[node] = distance;
+    m_predecessorEdges[node] = edge;
+
+    if (!canBeSettled)
+    {
+        return true;
+    }
+
+    if (m_heapPositions[node] < 0)
+    {
+        m_heap.emplace_back(node);
+        m_heapPositions[node] = static_cast<int>(m_heap.size()) - 1;
+    }
+    SiftUp(m_heapPositions[node]);
+
+    return true;
+}
+
+int meshkernel::DijkstraShortestPath::PopNearestNode()
+{
+    if (m_heap.empty())
+    {
+        return -1;
+    }
+
+    const auto nearestNode = m_heap.front();
+    m_heapPositions[nearestNode] = -1;
+
+    const auto lastNode = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+    {
+        PlaceInHeap(0, lastNode);
+        SiftDown(0);
+    }
+
+    return nearestNode;
+}
+
+void meshkernel::DijkstraShortestPath::SetVisited(int node)
+{
+    Touch(node);
+    m_isVisited[node] = true;
+}
+
+bool meshkernel::DijkstraShortestPath::HasHigherPriority(int firstNode, int secondNode) const
+{
+    if (m_distances[firstNode] < m_distances[secondNode])
+    {
+        return true;
+    }
+    if (m_distances[secondNode] < m_distances[firstNode])
+    {
+        return false;
+    }
+    return firstNode < secondNode;
+}
+
+void meshkernel::DijkstraShortestPath::SiftUp(int position)
+{
+    const auto node = m_heap[position];
+    while (position > 0)
+    {
+        const auto parentPosition = (position - 1) / 2;
+        const auto parentNode = m_heap[parentPosition];
+        if (!HasHigherPriority(node, parentNode))
+        {
+            break;
+        }
+        PlaceInHeap(position, parentNode);
+        position = parentPosition;
+    }
+    PlaceInHeap(position, node);
+}
+
+void meshkernel::DijkstraShortestPath::SiftDown(int position)
+{
+    const auto node = m_heap[position];
+    const auto heapSize = static_cast<int>(m_heap.size());
+    while (true)
+    {
+        auto childPosition = 2 * position + 1;
+        if (childPosition >= heapSize)
+        {
+            break;
+        }
+        if (childPosition + 1 < heapSize && HasHigherPriority(m_heap[childPosition + 1], m_heap[childPosition]))
+        {
+            childPosition++;
+        }
+        if (!HasHigherPriority(m_heap[childPosition], node))
+        {
+            break;
+        }
+        PlaceInHeap(position, m_heap[childPosition]);
+        position = childPosition;
+    }
+    PlaceInHeap(position, node);
+}
+
+void meshkernel::DijkstraShortestPath::PlaceInHeap(int position, int node)
+{
+    m_heap[position] = node;
+    m_heapPositions[node] = position;
+}
+
+void meshkernel::DijkstraShortestPath::Touch(int node)
+{
+    if (!m_isTouched[node])
+    {
+        m_isTouched[node] = true;
+        m_touchedNodes.emplace_back(node);
+    }
+}
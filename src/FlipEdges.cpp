@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include <MeshKernel/Operations.cpp>
 #include <MeshKernel/Entities.hpp>
@@ -61,7 +63,7 @@ meshkernel::FlipEdges::FlipEdges(std::shared_ptr<Mesh> mesh,
     }
 };
 
-void meshkernel::FlipEdges::Compute() const
+void meshkernel::FlipEdges::Compute()
 {
 
     m_mesh->Administrate(Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
@@ -74,30 +76,53 @@ void meshkernel::FlipEdges::Compute() const
 
     const int MaxIter = 10;
     const int numEdges = m_mesh->GetNumEdges();
-    int numFlippedEdges = intMissingValue;
+    int numFlippedEdges = 0;
 
-    for (int iter = 0; iter < MaxIter; iter++)
+    m_valenceDifferences.resize(m_mesh->GetNumNodes());
+    for (int n = 0; n < m_mesh->GetNumNodes(); n++)
     {
-        if (numFlippedEdges == 0)
-        {
-            break;
-        }
-        else
+        m_valenceDifferences[n] = m_mesh->m_nodesNumEdges[n] - OptimalNumberOfConnectedNodes(n);
+    }
+
+    // The first iteration visits all internal edges. The following iterations only visit the edges queued again after a flip
+    EdgesQueue queue;
+    queue.isInCurrentIteration.resize(numEdges, false);
+    queue.isInNextIteration.resize(numEdges, false);
+    for (int e = 0; e < numEdges; e++)
+    {
+        if (m_mesh->GetNumEdgesFaces(e) == 2)
         {
-            numFlippedEdges = 0;
+            queue.currentIteration.emplace_back(e);
+            queue.isInCurrentIteration[e] = true;
         }
+    }
+
+    for (int iter = 0; iter < MaxIter && !queue.currentIteration.empty(); iter++)
+    {
+        numFlippedEdges = 0;
 
-        for (int e = 0; e < numEdges; e++)
+        // the edges of an iteration are visited in increasing order, as in a sweep over all edges
+        std::size_t position = 0;
+        while (position < queue.currentIteration.size() || !queue.addedEdges.empty())
         {
+            int e;
+            if (!queue.addedEdges.empty() && (position == queue.currentIteration.size() || queue.addedEdges.front() < queue.currentIteration[position]))
+            {
+                std::pop_heap(queue.addedEdges.begin(), queue.addedEdges.end(), std::greater<>());
+                e = queue.addedEdges.back();
+                queue.addedEdges.pop_back();
+            }
+            else
+            {
+                e = queue.currentIteration[position];
+                position++;
+            }
+            queue.isInCurrentIteration[e] = false;
+
             // check if nodes have been masked
             auto const firstNode = m_mesh->m_edges[e].first;
             auto const secondNode = m_mesh->m_edges[e].second;
 
-            if (m_mesh->IsEdgeOnBoundary(e))
-            {
-                continue;
-            }
-
             // triangles only
             auto const leftFace = m_mesh->m_edgesFaces[e][0];
             auto const rightFace = m_mesh->m_edgesFaces[e][1];
@@ -106,7 +131,7 @@ void meshkernel::FlipEdges::Compute() const
             const auto NumEdgesRightFace = m_mesh->GetNumFaceEdges(rightFace);
             if (NumEdgesLeftFace != 3 || NumEdgesRightFace != 3)
             {
-                return;
+                continue;
             }
 
             int nodeLeft = -1;
@@ -141,6 +166,11 @@ void meshkernel::FlipEdges::Compute() const
                 // Flip the edges
                 m_mesh->m_edges[e].first = nodeLeft;
                 m_mesh->m_edges[e].second = nodeRight;
+                m_mesh->RegisterModifiedEdge(e);
+                m_mesh->RegisterModifiedNode(firstNode);
+                m_mesh->RegisterModifiedNode(secondNode);
+                m_mesh->RegisterModifiedNode(nodeLeft);
+                m_mesh->RegisterModifiedNode(nodeRight);
                 numFlippedEdges++;
 
                 // Find the other edges
@@ -227,6 +257,10 @@ void meshkernel::FlipEdges::Compute() const
                 m_mesh->m_nodesNumEdges[secondNode] = m_mesh->m_nodesNumEdges[secondNode] - 1;
                 m_mesh->m_nodesNumEdges[nodeLeft] = m_mesh->m_nodesNumEdges[nodeLeft] + 1;
                 m_mesh->m_nodesNumEdges[nodeRight] = m_mesh->m_nodesNumEdges[nodeRight] + 1;
+                m_valenceDifferences[firstNode]--;
+                m_valenceDifferences[secondNode]--;
+                m_valenceDifferences[nodeLeft]++;
+                m_valenceDifferences[nodeRight]++;
 
                 // Delete edge from m_mesh->m_nodesEdges[firstNode]
                 DeleteEdgeFromNode(e, firstNode);
@@ -251,8 +285,27 @@ void meshkernel::FlipEdges::Compute() const
                 }
                 m_mesh->m_nodesEdges[nodeRight][m_mesh->m_nodesNumEdges[nodeRight] - 1] = e;
                 m_mesh->SortEdgesInCounterClockWiseOrder(nodeRight);
+
+                // keep the compressed rows read by the other algorithms in line with the edited administration
+                m_mesh->CopyFaceToCompressedRows(leftFace);
+                m_mesh->CopyFaceToCompressedRows(rightFace);
+                m_mesh->CopyNodeEdgesToCompressedRow(firstNode);
+                m_mesh->CopyNodeEdgesToCompressedRow(secondNode);
+                m_mesh->CopyNodeEdgesToCompressedRow(nodeLeft);
+                m_mesh->CopyNodeEdgesToCompressedRow(nodeRight);
+
+                // only the functionals of the edges around the four nodes of the quadrilateral have changed
+                QueueEdgesAroundNode(firstNode, e, queue);
+                QueueEdgesAroundNode(secondNode, e, queue);
+                QueueEdgesAroundNode(nodeLeft, e, queue);
+                QueueEdgesAroundNode(nodeRight, e, queue);
             }
         }
+
+        queue.currentIteration.clear();
+        std::swap(queue.currentIteration, queue.nextIteration);
+        std::swap(queue.isInCurrentIteration, queue.isInNextIteration);
+        std::sort(queue.currentIteration.begin(), queue.currentIteration.end());
     }
 
     if (numFlippedEdges != 0)
@@ -264,6 +317,56 @@ void meshkernel::FlipEdges::Compute() const
     m_mesh->Administrate(Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
 }
 
+void meshkernel::FlipEdges::QueueEdgesAroundNode(int node, int currentEdge, EdgesQueue& queue) const
+{
+    const auto queueEdge = [&](int edge) {
+        if (m_mesh->GetNumEdgesFaces(edge) != 2)
+        {
+            return;
+        }
+
+        // the following edges are still visited in the current iteration, the others in the next one
+        if (edge > currentEdge)
+        {
+            if (!queue.isInCurrentIteration[edge])
+            {
+                queue.addedEdges.emplace_back(edge);
+                std::push_heap(queue.addedEdges.begin(), queue.addedEdges.end(), std::greater<>());
+                queue.isInCurrentIteration[edge] = true;
+            }
+        }
+        else if (!queue.isInNextIteration[edge])
+        {
+            queue.nextIteration.emplace_back(edge);
+            queue.isInNextIteration[edge] = true;
+        }
+    };
+
+    // the edges connected to the node, and the edges opposite to the node in its triangles
+    for (int i = 0; i < m_mesh->m_nodesNumEdges[node]; i++)
+    {
+        const auto edge = m_mesh->m_nodesEdges[node][i];
+        queueEdge(edge);
+
+        for (int f = 0; f < m_mesh->GetNumEdgesFaces(edge); f++)
+        {
+            const auto face = m_mesh->m_edgesFaces[edge][f];
+            if (m_mesh->GetNumFaceEdges(face) != 3)
+            {
+                continue;
+            }
+            for (int j = 0; j < 3; j++)
+            {
+                const auto faceEdge = m_mesh->m_facesEdges[face][j];
+                if (m_mesh->m_edges[faceEdge].first != node && m_mesh->m_edges[faceEdge].second != node)
+                {
+                    queueEdge(faceEdge);
+                }
+            }
+        }
+    }
+}
+
 void meshkernel::FlipEdges::DeleteEdgeFromNode(int edge, int firstNode) const
 {
     // Update nod, delete edge from m_mesh->m_nodesEdges[firstNode]
@@ -363,10 +466,10 @@ void meshkernel::FlipEdges::ComputeTopologyFunctional(int edge,
     }
 
     //  compute the change in functional
-    int n1 = m_mesh->m_nodesNumEdges[firstNode] - OptimalNumberOfConnectedNodes(firstNode);
-    int n2 = m_mesh->m_nodesNumEdges[secondNode] - OptimalNumberOfConnectedNodes(secondNode);
-    int nL = m_mesh->m_nodesNumEdges[nodeLeft] - OptimalNumberOfConnectedNodes(nodeLeft);
-    int nR = m_mesh->m_nodesNumEdges[nodeRight] - OptimalNumberOfConnectedNodes(nodeRight);
+    int n1 = m_valenceDifferences[firstNode];
+    int n2 = m_valenceDifferences[secondNode];
+    int nL = m_valenceDifferences[nodeLeft];
+    int nR = m_valenceDifferences[nodeRight];
 
     if (m_projectToLandBoundary)
     {
@@ -410,7 +513,7 @@ int meshkernel::FlipEdges::DifferenceFromOptimum(int nodeIndex, int firstNode, i
 {
     if (m_landBoundaries->m_meshNodesLandBoundarySegments[nodeIndex] < 0)
     {
-        return m_mesh->m_nodesNumEdges[nodeIndex] - OptimalNumberOfConnectedNodes(nodeIndex);
+        return m_valenceDifferences[nodeIndex];
     }
 
     // connected edges needs to be counterclockwise
@@ -0,0 +1,163 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <atomic>
+#include <stdexcept>
+
+#if defined(MESHKERNEL_WITH_X86_GEOMETRY_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <MeshKernel/GeometryKernels.hpp>
+
+#include "GeometryKernelsTable.hpp"
+
+namespace
+{
+    // Checks if the cpu and the operating system support an instruction set
+    bool IsSupportedByCpu(meshkernel::InstructionSet instructionSet)
+    {
+        if (instructionSet == meshkernel::InstructionSet::Default)
+        {
+            return true;
+        }
+#if defined(MESHKERNEL_WITH_X86_GEOMETRY_KERNELS) && defined(_MSC_VER)
+        int registers[4];
+        __cpuid(registers, 0);
+        if (registers[0] < 7)
+        {
+            return false;
+        }
+
+        // the operating system must save the ymm (and for AVX-512 the opmask and zmm) registers on context switches
+        __cpuid(registers, 1);
+        const bool isXsaveEnabled = (registers[2] & (1 << 27)) != 0;
+        const bool hasAvx = (registers[2] & (1 << 28)) != 0;
+        if (!isXsaveEnabled || !hasAvx)
+        {
+            return false;
+        }
+        const auto enabledStates = _xgetbv(0);
+        const bool areYmmStatesEnabled = (enabledStates & 0x6) == 0x6;
+        const bool areZmmStatesEnabled = (enabledStates & 0xe6) == 0xe6;
+
+        __cpuidex(registers, 7, 0);
+        if (instructionSet == meshkernel::InstructionSet::AVX2)
+        {
+            return areYmmStatesEnabled && (registers[1] & (1 << 5)) != 0;
+        }
+        return areZmmStatesEnabled && (registers[1] & (1 << 16)) != 0;
+#elif defined(MESHKERNEL_WITH_X86_GEOMETRY_KERNELS)
+        // also checks the operating system support (xgetbv)
+        __builtin_cpu_init();
+        if (instructionSet == meshkernel::InstructionSet::AVX2)
+        {
+            return __builtin_cpu_supports("avx2") != 0;
+        }
+        return __builtin_cpu_supports("avx512f") != 0;
+#else
+        return false;
+#endif
+    }
+
+    // The widest instruction set supported by the cpu
+    meshkernel::InstructionSet BestSupportedInstructionSet()
+    {
+        if (IsSupportedByCpu(meshkernel::InstructionSet::AVX512))
+        {
+            return meshkernel::InstructionSet::AVX512;
+        }
+        if (IsSupportedByCpu(meshkernel::InstructionSet::AVX2))
+        {
+            return meshkernel::InstructionSet::AVX2;
+        }
+        return meshkernel::InstructionSet::Default;
+    }
+
+    // The instruction set in use, the best supported one until SetInstructionSet is called
+    std::atomic<meshkernel::InstructionSet>& SelectedInstructionSet()
+    {
+        static std::atomic<meshkernel::InstructionSet> selectedInstructionSet{BestSupportedInstructionSet()};
+        return selectedInstructionSet;
+    }
+
+    const meshkernel::GeometryKernelsTable& SelectedKernels()
+    {
+        switch (SelectedInstructionSet().load(std::memory_order_relaxed))
+        {
+        case meshkernel::InstructionSet::AVX512:
+            return meshkernel::GetAVX512GeometryKernels();
+        case meshkernel::InstructionSet::AVX2:
+            return meshkernel::GetAVX2GeometryKernels();
+        default:
+            return meshkernel::GetDefaultGeometryKernels();
+        }
+    }
+} // namespace
+
+bool meshkernel::IsInstructionSetSupported(InstructionSet instructionSet)
+{
+    return IsSupportedByCpu(instructionSet);
+}
+
+meshkernel::InstructionSet meshkernel::GetInstructionSet()
+{
+    return SelectedInstructionSet().load(std::memory_order_relaxed);
+}
+
+void meshkernel::SetInstructionSet(InstructionSet instructionSet)
+{
+    if (!IsInstructionSetSupported(instructionSet))
+    {
+        throw std::invalid_argument("SetInstructionSet: The instruction set is not supported by this build or cpu.");
+    }
+    SelectedInstructionSet().store(instructionSet, std::memory_order_relaxed);
+}
+
+void meshkernel::ComputeCartesianDistances(int size, const double* firstX, const double* firstY, const double* secondX, const double* secondY, double* distances)
+{
+    SelectedKernels().computeCartesianDistances(size, firstX, firstY, secondX, secondY, distances);
+}
+
+void meshkernel::ComputeEdgesCenters(int numEdges, const double* nodes, const int* edges, double* edgesCenters)
+{
+    SelectedKernels().computeEdgesCenters(numEdges, nodes, edges, edgesCenters);
+}
+
+void meshkernel::ComputeCartesianTrianglesCircumcenters(int size,
+                                                        const double* firstX,
+                                                        const double* firstY,
+                                                        const double* secondX,
+                                                        const double* secondY,
+                                                        const double* thirdX,
+                                                        const double* thirdY,
+                                                        double* circumcenterX,
+                                                        double* circumcenterY)
+{
+    SelectedKernels().computeCartesianTrianglesCircumcenters(size, firstX, firstY, secondX, secondY, thirdX, thirdY, circumcenterX, circumcenterY);
+}
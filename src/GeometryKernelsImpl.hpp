@@ -0,0 +1,125 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+// The bodies of the batched geometry kernels, included by one translation unit per instruction set.
+// The including file defines MESHKERNEL_GEOMETRY_KERNELS_TABLE, the name of the function returning its kernels.
+//
+// The kernels have internal linkage and call only the C math functions, so no inline function compiled for
+// a wider instruction set can be shared with (and picked by the linker for) the other translation units.
+// Floating point contraction is disabled (here and with -ffp-contract=off in CMake), so the results are identical
+// to the ones of the scalar functions in Operations.cpp for all instruction sets.
+
+#include <math.h>
+
+#include <MeshKernel/Constants.hpp>
+
+#include "GeometryKernelsTable.hpp"
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+namespace
+{
+    void ComputeCartesianDistances(int size, const double* firstX, const double* firstY, const double* secondX, const double* secondY, double* distances)
+    {
+        const double epsilon = 2.220446049250313e-16; // std::numeric_limits<double>::epsilon()
+#pragma omp simd
+        for (int i = 0; i < size; ++i)
+        {
+            const bool isInvalid = (fabs(firstX[i] - meshkernel::doubleMissingValue) < epsilon) | (fabs(firstY[i] - meshkernel::doubleMissingValue) < epsilon) |
+                                   (fabs(secondX[i] - meshkernel::doubleMissingValue) < epsilon) | (fabs(secondY[i] - meshkernel::doubleMissingValue) < epsilon);
+
+            double dx = secondX[i] - firstX[i];
+            dx = fabs(dx) <= meshkernel::nearlyZero ? 0.0 : dx;
+            double dy = secondY[i] - firstY[i];
+            dy = fabs(dy) <= meshkernel::nearlyZero ? 0.0 : dy;
+
+            const double distance = sqrt(dx * dx + dy * dy);
+            distances[i] = isInvalid ? 0.0 : distance;
+        }
+    }
+
+    void ComputeEdgesCenters(int numEdges, const double* nodes, const int* edges, double* edgesCenters)
+    {
+#pragma omp simd
+        for (int e = 0; e < numEdges; ++e)
+        {
+            // the invalid edges read the first node and are then set to missing values
+            const bool isValid = (edges[2 * e] >= 0) & (edges[2 * e + 1] >= 0);
+            const int first = isValid ? edges[2 * e] : 0;
+            const int second = isValid ? edges[2 * e + 1] : 0;
+            const double x = (nodes[2 * first] + nodes[2 * second]) * 0.5;
+            const double y = (nodes[2 * first + 1] + nodes[2 * second + 1]) * 0.5;
+            edgesCenters[2 * e] = isValid ? x : meshkernel::doubleMissingValue;
+            edgesCenters[2 * e + 1] = isValid ? y : meshkernel::doubleMissingValue;
+        }
+    }
+
+    void ComputeCartesianTrianglesCircumcenters(int size,
+                                                const double* firstX,
+                                                const double* firstY,
+                                                const double* secondX,
+                                                const double* secondY,
+                                                const double* thirdX,
+                                                const double* thirdY,
+                                                double* circumcenterX,
+                                                double* circumcenterY)
+    {
+#pragma omp simd
+        for (int i = 0; i < size; ++i)
+        {
+            // GetDx and GetDy
+            double dx2 = secondX[i] - firstX[i];
+            dx2 = fabs(dx2) <= meshkernel::nearlyZero ? 0.0 : dx2;
+            double dy2 = secondY[i] - firstY[i];
+            dy2 = fabs(dy2) <= meshkernel::nearlyZero ? 0.0 : dy2;
+            double dx3 = thirdX[i] - firstX[i];
+            dx3 = fabs(dx3) <= meshkernel::nearlyZero ? 0.0 : dx3;
+            double dy3 = thirdY[i] - firstY[i];
+            dy3 = fabs(dy3) <= meshkernel::nearlyZero ? 0.0 : dy3;
+
+            // the division of the degenerated triangles is done by one and discarded
+            const double den = dy2 * dx3 - dy3 * dx2;
+            const bool isDegenerated = !(fabs(den) > 0.0);
+            const double z = (dx2 * (dx2 - dx3) + dy2 * (dy2 - dy3)) / (isDegenerated ? 1.0 : den);
+            const double zOrZero = isDegenerated ? 0.0 : z;
+
+            circumcenterX[i] = firstX[i] + 0.5 * (dx3 - zOrZero * dy3);
+            circumcenterY[i] = firstY[i] + 0.5 * (dy3 + zOrZero * dx3);
+        }
+    }
+} // namespace
+
+const meshkernel::GeometryKernelsTable& meshkernel::MESHKERNEL_GEOMETRY_KERNELS_TABLE()
+{
+    static const GeometryKernelsTable kernels{ComputeCartesianDistances, ComputeEdgesCenters, ComputeCartesianTrianglesCircumcenters};
+    return kernels;
+}
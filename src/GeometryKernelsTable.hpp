@@ -0,0 +1,57 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+namespace meshkernel
+{
+    /// @brief The batched geometry kernels compiled for one instruction set, see GeometryKernels.hpp for their documentation
+    struct GeometryKernelsTable
+    {
+        void (*computeCartesianDistances)(int size, const double* firstX, const double* firstY, const double* secondX, const double* secondY, double* distances);
+        void (*computeEdgesCenters)(int numEdges, const double* nodes, const int* edges, double* edgesCenters);
+        void (*computeCartesianTrianglesCircumcenters)(int size,
+                                                       const double* firstX,
+                                                       const double* firstY,
+                                                       const double* secondX,
+                                                       const double* secondY,
+                                                       const double* thirdX,
+                                                       const double* thirdY,
+                                                       double* circumcenterX,
+                                                       double* circumcenterY);
+    };
+
+    /// @brief Gets the kernels compiled for the instruction set of the build (GeometryKernelsDefault.cpp)
+    const GeometryKernelsTable& GetDefaultGeometryKernels();
+
+    /// @brief Gets the kernels compiled for AVX2 (GeometryKernelsAVX2.cpp)
+    const GeometryKernelsTable& GetAVX2GeometryKernels();
+
+    /// @brief Gets the kernels compiled for AVX-512 (GeometryKernelsAVX512.cpp)
+    const GeometryKernelsTable& GetAVX512GeometryKernels();
+} // namespace meshkernel
@@ -146,6 +146,9 @@ namespace meshkernel
                 m_segmentIndices.emplace_back(std::initializer_list<size_t>{split, endSegmentIndex});
             }
         }
+
+        // index the land boundary segments, used by NearestLandBoundaryNode
+        m_segmentsRTree.BuildTree(m_nodes);
     };
 
     void LandBoundaries::FindNearestMeshBoundary(int snapping)
@@ -396,6 +399,12 @@ namespace meshkernel
 
         // Update segment indices
         m_segmentIndices.push_back(std::initializer_list<size_t>{m_nodes.size() - 3, m_nodes.size() - 2});
+
+        // Update the segments tree, if in use
+        if (!m_segmentsRTree.Empty())
+        {
+            m_segmentsRTree.InsertSegment(m_nodes, int(m_nodes.size()) - 3);
+        }
     }
 
     void LandBoundaries::MakePath(int landBoundarySegment,
@@ -444,8 +453,7 @@ namespace meshkernel
             throw AlgorithmError("LandBoundaries::MakePath: Cannot not find valid mesh nodes.");
         }
 
-        std::vector<int> connectedNodes;
-        ShortestPath(landBoundarySegment, int(startLandBoundaryIndex), int(endLandBoundaryIndex), startMeshNode, meshBoundOnly, connectedNodes);
+        ShortestPath(landBoundarySegment, int(startLandBoundaryIndex), int(endLandBoundaryIndex), startMeshNode, meshBoundOnly);
 
         int lastSegment = m_meshNodesLandBoundarySegments[endMeshNode];
         int lastNode = -1;
@@ -534,7 +542,7 @@ namespace meshkernel
                 break;
             }
 
-            int nextEdgeIndex = connectedNodes[currentNode];
+            int nextEdgeIndex = m_shortestPath.GetPredecessorEdge(currentNode);
             if (nextEdgeIndex < 0 || nextEdgeIndex >= m_mesh->GetNumEdges())
             {
                 break;
@@ -1058,26 +1066,20 @@ namespace meshkernel
                                       int startLandBoundaryIndex,
                                       int endLandBoundaryIndex,
                                       int startMeshNode,
-                                      bool meshBoundOnly,
-                                      std::vector<int>& connectedNodes)
+                                      bool meshBoundOnly)
     {
         if (m_nodes.empty())
         {
             return;
         }
 
-        connectedNodes.resize(m_mesh->GetNumNodes(), -1);
-        std::fill(connectedNodes.begin(), connectedNodes.end(), -1);
-
-        // infinite distance for all nodes
-        std::vector<double> nodeDistances(m_mesh->GetNumNodes(), std::numeric_limits<double>::max());
-        std::vector<bool> isVisited(m_mesh->GetNumNodes(), false);
+        // infinite distance for all nodes, except the start node
+        m_shortestPath.Initialize(m_mesh->GetNumNodes(), startMeshNode);
 
         int currentNodeIndex = startMeshNode;
-        nodeDistances[startMeshNode] = 0.0;
         while (true)
         {
-            isVisited[currentNodeIndex] = true;
+            m_shortestPath.SetVisited(currentNodeIndex);
             Point currentNode = m_mesh->m_nodes[currentNodeIndex];
             Point currentNodeOnLandBoundary;
             int currentNodeLandBoundaryNodeIndex;
@@ -1098,7 +1100,7 @@ namespace meshkernel
 
                 int neighbouringNodeIndex = m_mesh->m_edges[edgeIndex].first + m_mesh->m_edges[edgeIndex].second - currentNodeIndex;
 
-                if (isVisited[neighbouringNodeIndex])
+                if (m_shortestPath.IsVisited(neighbouringNodeIndex))
                 {
                     continue;
                 }
@@ -1151,31 +1153,22 @@ namespace meshkernel
                     maximumDistance = 1e6 * maximumDistance;
 
                 double edgeLength = ComputeDistance(currentNode, neighbouringNode, m_mesh->m_projection);
-                double correctedDistance = nodeDistances[currentNodeIndex] + edgeLength * maximumDistance;
+                double correctedDistance = m_shortestPath.GetDistance(currentNodeIndex) + edgeLength * maximumDistance;
 
-                if (correctedDistance < nodeDistances[neighbouringNodeIndex])
-                {
-                    nodeDistances[neighbouringNodeIndex] = correctedDistance;
-                    connectedNodes[neighbouringNodeIndex] = edgeIndex;
-                }
+                // only the masked nodes can be selected as next node
+                m_shortestPath.Relax(neighbouringNodeIndex, edgeIndex, correctedDistance, m_nodeMask[neighbouringNodeIndex] == landBoundarySegment);
             }
 
-            // linear search with masking
-            currentNodeIndex = 0;
-            double minValue = std::numeric_limits<double>::max();
-            for (int n = 0; n < m_mesh->GetNumNodes(); n++)
+            // masked node with the smallest distance, if none is left the first mesh node is taken
+            currentNodeIndex = m_shortestPath.PopNearestNode();
+            if (currentNodeIndex < 0)
             {
-                if (m_nodeMask[n] == landBoundarySegment && !isVisited[n] && nodeDistances[n] < minValue)
-                {
-                    currentNodeIndex = n;
-                    minValue = nodeDistances[n];
-                }
+                currentNodeIndex = 0;
             }
 
-            if (currentNodeIndex < 0 ||
-                currentNodeIndex >= m_mesh->GetNumNodes() ||
-                nodeDistances[currentNodeIndex] == std::numeric_limits<double>::max() ||
-                isVisited[currentNodeIndex])
+            if (currentNodeIndex >= m_mesh->GetNumNodes() ||
+                m_shortestPath.GetDistance(currentNodeIndex) == std::numeric_limits<double>::max() ||
+                m_shortestPath.IsVisited(currentNodeIndex))
             {
                 break;
             }
@@ -1200,24 +1193,109 @@ namespace meshkernel
         nearestLandBoundaryNodeIndex = -1;
         edgeRatio = -1.0;
         pointOnLandBoundary = node;
-        for (int n = startLandBoundaryIndex; n < endLandBoundaryIndex; n++)
+
+        // first estimate of the minimum distance, from the segments with the closest bounding boxes
+        const bool useSegmentsRTree = !m_segmentsRTree.Empty() && projection != Projections::sphericalAccurate;
+        if (useSegmentsRTree)
         {
-            if (!m_nodes[n].IsValid() || !m_nodes[n + 1].IsValid())
+            m_segmentsRTree.NearestSegments(node, m_numNearestSegmentsEstimate, startLandBoundaryIndex, endLandBoundaryIndex);
+            for (size_t i = 0; i < m_segmentsRTree.GetQueryResultSize(); ++i)
             {
-                continue;
+                UpdateNearestLandBoundarySegment(projection, node, m_segmentsRTree.GetQuerySegmentIndex(i), minimumDistance, pointOnLandBoundary, nearestLandBoundaryNodeIndex, edgeRatio);
+            }
+        }
+
+        // no estimate available: inquire all segments
+        if (!useSegmentsRTree || nearestLandBoundaryNodeIndex < 0)
+        {
+            for (int n = startLandBoundaryIndex; n < endLandBoundaryIndex; n++)
+            {
+                if (!m_nodes[n].IsValid() || !m_nodes[n + 1].IsValid())
+                {
+                    continue;
+                }
+                UpdateNearestLandBoundarySegment(projection, node, n, minimumDistance, pointOnLandBoundary, nearestLandBoundaryNodeIndex, edgeRatio);
+            }
+            return;
+        }
+
+        // the segments at a distance smaller or equal than the estimate have their bounding box within the search box.
+        // the search box is slightly enlarged to account for round-off errors
+        const double searchDistance = minimumDistance * (1.0 + 1e-6);
+        if (projection == Projections::cartesian)
+        {
+            const double tolerance = 1e-12 * (std::abs(node.x) + std::abs(node.y));
+            m_segmentsRTree.SegmentsInBox({node.x - searchDistance - tolerance, node.y - searchDistance - tolerance},
+                                          {node.x + searchDistance + tolerance, node.y + searchDistance + tolerance},
+                                          startLandBoundaryIndex,
+                                          endLandBoundaryIndex);
+            for (size_t i = 0; i < m_segmentsRTree.GetQueryResultSize(); ++i)
+            {
+                UpdateNearestLandBoundarySegment(projection, node, m_segmentsRTree.GetQuerySegmentIndex(i), minimumDistance, pointOnLandBoundary, nearestLandBoundaryNodeIndex, edgeRatio);
             }
+            return;
+        }
 
-            Point normalPoint{doubleMissingValue, doubleMissingValue};
-            double ratio = 0.0;
-            const double distanceFromLandBoundary = DistanceFromLine(node, m_nodes[n], m_nodes[n + 1], normalPoint, ratio, projection);
+        // spherical: the latitude difference is bounded by the distance, the longitude difference by the distance
+        // scaled with the cosine of the largest latitude in the search box (see GetDx)
+        const double tolerance = 1e-12 * (std::abs(node.x) + std::abs(node.y)) + 1e-12;
+        const double deltaLatitude = searchDistance * one_over_earth_radius * raddeg_hp + tolerance;
+        const double maxLatitude = std::abs(node.y) + deltaLatitude;
+        const double cosMaxLatitude = maxLatitude < 90.0 ? std::cos(maxLatitude * degrad_hp) : 0.0;
+        double deltaLongitude = std::numeric_limits<double>::max();
+        if (cosMaxLatitude > 0.0)
+        {
+            deltaLongitude = searchDistance * one_over_earth_radius * raddeg_hp / cosMaxLatitude + tolerance;
+        }
 
-            if (distanceFromLandBoundary > 0.0 && distanceFromLandBoundary < minimumDistance)
+        // close to the poles or for large distances all longitudes are searched
+        if (deltaLongitude >= 180.0)
+        {
+            m_segmentsRTree.SegmentsInBox({std::numeric_limits<double>::lowest(), node.y - deltaLatitude},
+                                          {std::numeric_limits<double>::max(), node.y + deltaLatitude},
+                                          startLandBoundaryIndex,
+                                          endLandBoundaryIndex);
+            for (size_t i = 0; i < m_segmentsRTree.GetQueryResultSize(); ++i)
             {
-                minimumDistance = distanceFromLandBoundary;
-                pointOnLandBoundary = normalPoint;
-                nearestLandBoundaryNodeIndex = n;
-                edgeRatio = ratio;
+                UpdateNearestLandBoundarySegment(projection, node, m_segmentsRTree.GetQuerySegmentIndex(i), minimumDistance, pointOnLandBoundary, nearestLandBoundaryNodeIndex, edgeRatio);
             }
+            return;
+        }
+
+        // longitudes differing by 360 degrees are the same (see GetDx)
+        for (const auto& longitudeShift : {-360.0, 0.0, 360.0})
+        {
+            m_segmentsRTree.SegmentsInBox({node.x + longitudeShift - deltaLongitude, node.y - deltaLatitude},
+                                          {node.x + longitudeShift + deltaLongitude, node.y + deltaLatitude},
+                                          startLandBoundaryIndex,
+                                          endLandBoundaryIndex);
+            for (size_t i = 0; i < m_segmentsRTree.GetQueryResultSize(); ++i)
+            {
+                UpdateNearestLandBoundarySegment(projection, node, m_segmentsRTree.GetQuerySegmentIndex(i), minimumDistance, pointOnLandBoundary, nearestLandBoundaryNodeIndex, edgeRatio);
+            }
+        }
+    }
+
+    void LandBoundaries::UpdateNearestLandBoundarySegment(const Projections& projection,
+                                                          const Point& node,
+                                                          int segmentIndex,
+                                                          double& minimumDistance,
+                                                          Point& pointOnLandBoundary,
+                                                          int& nearestLandBoundaryNodeIndex,
+                                                          double& edgeRatio) const
+    {
+        Point normalPoint{doubleMissingValue, doubleMissingValue};
+        double ratio = 0.0;
+        const double distanceFromLandBoundary = DistanceFromLine(node, m_nodes[segmentIndex], m_nodes[segmentIndex + 1], normalPoint, ratio, projection);
+
+        if (distanceFromLandBoundary > 0.0 &&
+            (distanceFromLandBoundary < minimumDistance ||
+             (distanceFromLandBoundary == minimumDistance && segmentIndex < nearestLandBoundaryNodeIndex)))
+        {
+            minimumDistance = distanceFromLandBoundary;
+            pointOnLandBoundary = normalPoint;
+            nearestLandBoundaryNodeIndex = segmentIndex;
+            edgeRatio = ratio;
         }
     }
 
@@ -1291,5 +1369,6 @@ namespace meshkernel
                 m_mesh->m_nodes[n] = pointOnLandBoundary;
             }
         }
+        m_mesh->InvalidateAdministration();
     }
 }; // namespace meshkernel
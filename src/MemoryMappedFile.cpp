@@ -0,0 +1,136 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <MeshKernel/MemoryMappedFile.hpp>
+
+#if defined(_WIN32)
+
+meshkernel::MemoryMappedFile::MemoryMappedFile(const std::string& filePath)
+{
+    const auto file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not open " + filePath);
+    }
+    m_file = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not inquire the size of " + filePath);
+    }
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not map " + filePath);
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        CloseHandle(m_mapping);
+        CloseHandle(file);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not map " + filePath);
+    }
+}
+
+meshkernel::MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+    }
+    CloseHandle(m_file);
+}
+
+#else
+
+meshkernel::MemoryMappedFile::MemoryMappedFile(const std::string& filePath)
+{
+    m_fileDescriptor = open(filePath.c_str(), O_RDONLY);
+    if (m_fileDescriptor < 0)
+    {
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not open " + filePath);
+    }
+
+    struct stat fileStatus;
+    if (fstat(m_fileDescriptor, &fileStatus) != 0)
+    {
+        close(m_fileDescriptor);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not inquire the size of " + filePath);
+    }
+    m_size = static_cast<size_t>(fileStatus.st_size);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    const auto data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        close(m_fileDescriptor);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile: Could not map " + filePath);
+    }
+    m_data = static_cast<const char*>(data);
+}
+
+meshkernel::MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    close(m_fileDescriptor);
+}
+
+#endif
@@ -32,6 +32,15 @@
 #include <algorithm>
 #include <stdexcept>
 #include <initializer_list>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <MeshKernel/Mesh.hpp>
 #include <MeshKernel/Constants.hpp>
@@ -43,6 +52,7 @@
 #include <MeshKernel/MakeGridParametersNative.hpp>
 #include <MeshKernel/TriangulationWrapper.hpp>
 #include <MeshKernel/Exceptions.hpp>
+#include <MeshKernel/MemoryMappedFile.hpp>
 
 meshkernel::Mesh::Mesh()
 {
@@ -54,9 +64,19 @@ void meshkernel::Mesh::Set(const std::vector<Edge>& edges,
                            AdministrationOptions administration)
 {
     // copy edges and nodes
-    m_edges = edges;
-    m_nodes = nodes;
+    Set(std::vector<Edge>(edges), std::vector<Point>(nodes), projection, administration);
+}
+
+void meshkernel::Mesh::Set(std::vector<Edge>&& edges,
+                           std::vector<Point>&& nodes,
+                           Projections projection,
+                           AdministrationOptions administration)
+{
+    m_edges = std::move(edges);
+    m_nodes = std::move(nodes);
     m_projection = projection;
+    m_nodesRTreeRequiresUpdate = true;
+    m_edgesRTreeRequiresUpdate = true;
 
     Administrate(administration);
 
@@ -111,6 +131,10 @@ void meshkernel::Mesh::RemoveInvalidNodesAndEdges()
         return;
     }
 
+    // the numbering changes, the trees must be built again
+    m_nodesRTreeRequiresUpdate = true;
+    m_edgesRTreeRequiresUpdate = true;
+
     // Flag invalid nodes
     std::vector<int> validNodesIndices(m_nodes.size());
     std::fill(validNodesIndices.begin(), validNodesIndices.end(), -1);
@@ -154,42 +178,41 @@ void meshkernel::Mesh::RemoveInvalidNodesAndEdges()
 
 void meshkernel::Mesh::Administrate(AdministrationOptions administrationOption)
 {
+    m_flatCopiesRequireUpdate = true;
+
     RemoveInvalidNodesAndEdges();
 
+    // the numbering changed, the modifications are included in the full administration
+    m_modifiedNodes.clear();
+    m_modifiedEdges.clear();
+    m_administrationState = AdministrationState::None;
+
     if (m_nodesRTreeRequiresUpdate && !m_nodesRTree.Empty())
     {
-        m_nodesRTree.BuildTree(m_nodes);
-        m_nodesRTreeRequiresUpdate = false;
+        BuildNodesRTree();
     }
 
     if (m_edgesRTreeRequiresUpdate && !m_edgesRTree.Empty())
     {
-        ComputeEdgesCenters();
-        m_edgesRTree.BuildTree(m_edgesCenters);
-        m_edgesRTreeRequiresUpdate = false;
+        BuildEdgesRTree();
     }
 
     // return if there are no nodes or no edges
     if (m_numNodes == 0 || m_numEdges == 0)
     {
+        m_nodesEdgesCsr.Clear();
+        m_facesNodesCsr.Clear();
+        m_facesEdgesCsr.Clear();
         return;
     }
 
-    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesEdges);
-    std::fill(m_nodesEdges.begin(), m_nodesEdges.end(), std::vector<int>(maximumNumberOfEdgesPerNode, 0));
-
-    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesNumEdges);
-    std::fill(m_nodesNumEdges.begin(), m_nodesNumEdges.end(), 0);
-
+    // fills and sorts the compressed node-edge connectivity
     NodeAdministration();
 
-    for (int n = 0; n < GetNumNodes(); n++)
-    {
-        SortEdgesInCounterClockWiseOrder(n);
-    }
-
     if (administrationOption == AdministrationOptions::AdministrateMeshEdges)
     {
+        BuildCompressedConnectivity(administrationOption);
+        m_administrationState = AdministrationState::Edges;
         return;
     }
 
@@ -199,7 +222,7 @@ void meshkernel::Mesh::Administrate(AdministrationOptions administrationOption)
     std::fill(m_edgesNumFaces.begin(), m_edgesNumFaces.end(), 0);
 
     ResizeVectorIfNeeded(int(m_edges.size()), m_edgesFaces);
-    std::fill(m_edgesFaces.begin(), m_edgesFaces.end(), std::vector<int>(2, -1));
+    std::fill(m_edgesFaces.begin(), m_edgesFaces.end(), std::array<int, 2>{-1, -1});
 
     m_facesMassCenters.clear();
     m_faceArea.clear();
@@ -221,6 +244,825 @@ void meshkernel::Mesh::Administrate(AdministrationOptions administrationOption)
 
     // classify node types
     ClassifyNodes();
+
+    BuildCompressedConnectivity(administrationOption);
+    m_administrationState = AdministrationState::EdgesAndFaces;
+}
+
+void meshkernel::Mesh::AdministrateModifiedRegion(AdministrationOptions administrationOption)
+{
+    const bool administrateFaces = administrationOption == AdministrationOptions::AdministrateMeshEdgesAndFaces;
+    const bool isAdministrationValid = administrateFaces ? m_administrationState == AdministrationState::EdgesAndFaces : m_administrationState != AdministrationState::None;
+    if (!isAdministrationValid ||
+        m_nodeAdministrationSkippedEdges ||
+        static_cast<double>(m_modifiedNodes.size()) > m_maxModifiedNodesFraction * static_cast<double>(GetNumNodes()))
+    {
+        Administrate(administrationOption);
+        return;
+    }
+
+    if (m_modifiedNodes.empty() && m_modifiedEdges.empty())
+    {
+        return;
+    }
+    m_flatCopiesRequireUpdate = true;
+
+    // the administration vectors must cover the new nodes and edges
+    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesEdges);
+    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesNumEdges);
+    if (administrateFaces)
+    {
+        ResizeVectorIfNeeded(int(m_edges.size()), m_edgesNumFaces);
+        ResizeVectorIfNeeded(int(m_edges.size()), m_edgesFaces, std::array<int, 2>{-1, -1});
+    }
+
+    std::sort(m_modifiedNodes.begin(), m_modifiedNodes.end());
+    m_modifiedNodes.erase(std::unique(m_modifiedNodes.begin(), m_modifiedNodes.end()), m_modifiedNodes.end());
+
+    // the modified edges, including all edges previously connected to the modified nodes
+    auto modifiedEdges = m_modifiedEdges;
+    for (const auto& node : m_modifiedNodes)
+    {
+        for (int e = 0; e < m_nodesNumEdges[node]; ++e)
+        {
+            modifiedEdges.emplace_back(m_nodesEdges[node][e]);
+        }
+    }
+    std::sort(modifiedEdges.begin(), modifiedEdges.end());
+    modifiedEdges.erase(std::unique(modifiedEdges.begin(), modifiedEdges.end()), modifiedEdges.end());
+
+    // invalidate the edges connected to invalid nodes, the other nodes of the valid edges are part of the region to administrate
+    std::vector<int> regionNodes{m_modifiedNodes};
+    std::vector<int> deletedEdges;
+    for (const auto& e : modifiedEdges)
+    {
+        auto& edge = m_edges[e];
+        if (edge.first < 0 || edge.second < 0 || !m_nodes[edge.first].IsValid() || !m_nodes[edge.second].IsValid())
+        {
+            edge = {-1, -1};
+            deletedEdges.emplace_back(e);
+            continue;
+        }
+        regionNodes.emplace_back(edge.first);
+        regionNodes.emplace_back(edge.second);
+    }
+    std::sort(regionNodes.begin(), regionNodes.end());
+    regionNodes.erase(std::unique(regionNodes.begin(), regionNodes.end()), regionNodes.end());
+
+    // the faces to find again: the faces sharing the modified edges and the faces around the region nodes
+    std::vector<int> removedFaces;
+    if (administrateFaces)
+    {
+        const auto addEdgeFaces = [this, &removedFaces](int e) {
+            for (int f = 0; f < m_edgesNumFaces[e]; ++f)
+            {
+                removedFaces.emplace_back(m_edgesFaces[e][f]);
+            }
+        };
+        for (const auto& e : modifiedEdges)
+        {
+            addEdgeFaces(e);
+        }
+        for (const auto& node : regionNodes)
+        {
+            for (int e = 0; e < m_nodesNumEdges[node]; ++e)
+            {
+                addEdgeFaces(m_nodesEdges[node][e]);
+            }
+        }
+        std::sort(removedFaces.begin(), removedFaces.end());
+        removedFaces.erase(std::unique(removedFaces.begin(), removedFaces.end()), removedFaces.end());
+    }
+
+    // rebuild the edges of the modified nodes, before any renumbering takes place
+    std::vector<int> candidateEdges;
+    candidateEdges.reserve(modifiedEdges.size());
+    for (const auto& node : m_modifiedNodes)
+    {
+        candidateEdges.clear();
+        if (m_nodes[node].IsValid())
+        {
+            for (int e = 0; e < m_nodesNumEdges[node]; ++e)
+            {
+                candidateEdges.emplace_back(m_nodesEdges[node][e]);
+            }
+            for (const auto& e : modifiedEdges)
+            {
+                if (m_edges[e].first == node || m_edges[e].second == node)
+                {
+                    candidateEdges.emplace_back(e);
+                }
+            }
+            std::sort(candidateEdges.begin(), candidateEdges.end());
+            candidateEdges.erase(std::unique(candidateEdges.begin(), candidateEdges.end()), candidateEdges.end());
+        }
+
+        if (!NodeAdministration(node, candidateEdges))
+        {
+            // the local administration cannot reproduce the full one
+            Administrate(administrationOption);
+            return;
+        }
+    }
+
+    // the nodes of the removed faces are used for finding the faces again
+    std::vector<int> seedNodes{regionNodes};
+    for (auto f = removedFaces.rbegin(); f != removedFaces.rend(); ++f)
+    {
+        std::copy(m_facesNodes[*f].begin(), m_facesNodes[*f].end(), std::back_inserter(seedNodes));
+        RemoveFace(*f);
+    }
+
+    // remove the deleted edges and the nodes left without edges, renumbering the seed nodes
+    std::vector<int> removedNodes;
+    for (const auto& node : m_modifiedNodes)
+    {
+        if (node < GetNumNodes() && (!m_nodes[node].IsValid() || m_nodesNumEdges[node] == 0))
+        {
+            removedNodes.emplace_back(node);
+        }
+    }
+    const bool isRenumbered = !removedNodes.empty() || !deletedEdges.empty();
+    if (isRenumbered)
+    {
+        std::vector<int> nodesIndices;
+        RemoveNodesAndEdges(removedNodes, deletedEdges, administrateFaces, nodesIndices);
+        for (auto& seedNode : seedNodes)
+        {
+            seedNode = nodesIndices[seedNode];
+        }
+    }
+    std::sort(seedNodes.begin(), seedNodes.end());
+    seedNodes.erase(std::unique(seedNodes.begin(), seedNodes.end()), seedNodes.end());
+    seedNodes.erase(seedNodes.begin(), std::upper_bound(seedNodes.begin(), seedNodes.end(), -1));
+
+    for (const auto& node : seedNodes)
+    {
+        SortEdgesInCounterClockWiseOrder(node);
+    }
+    std::copy(seedNodes.begin(), seedNodes.end(), std::back_inserter(m_compressedNodesRowsToUpdate));
+
+    if (m_nodesRTreeRequiresUpdate && !m_nodesRTree.Empty())
+    {
+        BuildNodesRTree();
+    }
+
+    if (m_edgesRTreeRequiresUpdate && !m_edgesRTree.Empty())
+    {
+        BuildEdgesRTree();
+    }
+
+    m_modifiedNodes.clear();
+    m_modifiedEdges.clear();
+
+    if (!administrateFaces)
+    {
+        if (isRenumbered)
+        {
+            m_nodesEdgesCsr.Build(m_nodesEdges, m_nodesNumEdges, GetNumNodes());
+            BuildCompressedConnectivity(administrationOption);
+        }
+        else
+        {
+            UpdateCompressedConnectivity(administrationOption);
+        }
+        m_administrationState = AdministrationState::Edges;
+        return;
+    }
+
+    // find the faces starting from the seed nodes
+    const auto firstNewFace = GetNumFaces();
+    FindFaces(seedNodes);
+    for (int f = firstNewFace; f < GetNumFaces(); ++f)
+    {
+        std::copy(m_facesNodes[f].begin(), m_facesNodes[f].end(), std::back_inserter(seedNodes));
+        m_compressedFacesRowsToUpdate.emplace_back(f);
+    }
+    std::sort(seedNodes.begin(), seedNodes.end());
+    seedNodes.erase(std::unique(seedNodes.begin(), seedNodes.end()), seedNodes.end());
+
+    // the circumcenters depend on the number of faces sharing the face edges: update all faces around the seed nodes
+    std::vector<int> updatedFaces;
+    bool hasEdgesWithoutFaces = false;
+    for (const auto& n : seedNodes)
+    {
+        for (int e = 0; e < m_nodesNumEdges[n]; e++)
+        {
+            const auto edge = m_nodesEdges[n][e];
+            for (int f = 0; f < m_edgesNumFaces[edge]; ++f)
+            {
+                updatedFaces.emplace_back(m_edgesFaces[edge][f]);
+            }
+
+            // the classification of nodes close to edges without faces depends on the edge numbering
+            const auto otherNode = m_edges[edge].first + m_edges[edge].second - n;
+            for (int ee = 0; ee < m_nodesNumEdges[otherNode]; ee++)
+            {
+                hasEdgesWithoutFaces = hasEdgesWithoutFaces || m_edgesNumFaces[m_nodesEdges[otherNode][ee]] == 0;
+            }
+        }
+    }
+    std::sort(updatedFaces.begin(), updatedFaces.end());
+    updatedFaces.erase(std::unique(updatedFaces.begin(), updatedFaces.end()), updatedFaces.end());
+
+    m_facesCircumcenters.resize(GetNumFaces());
+    std::vector<Point> middlePointsCache(maximumNumberOfNodesPerFace);
+    std::vector<Point> normalsCache(maximumNumberOfNodesPerFace);
+    std::vector<int> numEdgeFacesCache(maximumNumberOfEdgesPerFace);
+    m_polygonNodesCache.resize(maximumNumberOfNodesPerFace + 1);
+    for (const auto& f : updatedFaces)
+    {
+        ComputeFaceCircumcenterMassCenterAndArea(f, false, middlePointsCache, normalsCache, numEdgeFacesCache);
+    }
+
+    // classify node types
+    if (hasEdgesWithoutFaces)
+    {
+        ClassifyNodes();
+    }
+    else
+    {
+        m_nodesTypes.resize(GetNumNodes(), 0);
+        for (const auto& n : seedNodes)
+        {
+            m_nodesTypes[n] = 0;
+            for (int e = 0; e < m_nodesNumEdges[n]; e++)
+            {
+                if (IsEdgeOnBoundary(m_nodesEdges[n][e]))
+                {
+                    m_nodesTypes[n] += 1;
+                }
+            }
+            ClassifyNode(n);
+        }
+    }
+
+    if (isRenumbered)
+    {
+        m_nodesEdgesCsr.Build(m_nodesEdges, m_nodesNumEdges, GetNumNodes());
+        BuildCompressedConnectivity(administrationOption);
+    }
+    else
+    {
+        UpdateCompressedConnectivity(administrationOption);
+    }
+    m_administrationState = AdministrationState::EdgesAndFaces;
+}
+
+void meshkernel::Mesh::BuildCompressedConnectivity(AdministrationOptions administrationOption)
+{
+    m_compressedNodesRowsToUpdate.clear();
+    m_compressedFacesRowsToUpdate.clear();
+    if (administrationOption == AdministrationOptions::AdministrateMeshEdges)
+    {
+        return;
+    }
+
+    m_facesNodesCsr.Build(m_facesNodes, GetNumFaces());
+    m_facesEdgesCsr.Build(m_facesEdges, GetNumFaces());
+}
+
+void meshkernel::Mesh::UpdateCompressedConnectivity(AdministrationOptions administrationOption)
+{
+    // the rows appended since the last update are rewritten as well, stale row indices beyond the number of rows are skipped
+    const auto updateRows = [](CompressedSparseRow& compressedSparseRow, std::vector<int>& rows, int numRows, const auto& setRow) {
+        for (int r = compressedSparseRow.GetNumRows(); r < numRows; ++r)
+        {
+            rows.emplace_back(r);
+        }
+        compressedSparseRow.Resize(numRows);
+
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+        for (const auto& r : rows)
+        {
+            if (r >= 0 && r < numRows)
+            {
+                setRow(r);
+            }
+        }
+        rows.clear();
+    };
+
+    updateRows(m_nodesEdgesCsr, m_compressedNodesRowsToUpdate, GetNumNodes(), [this](int n) { m_nodesEdgesCsr.SetRow(n, m_nodesEdges[n], m_nodesNumEdges[n]); });
+    if (administrationOption == AdministrationOptions::AdministrateMeshEdges)
+    {
+        m_compressedFacesRowsToUpdate.clear();
+        return;
+    }
+
+    // the face rows are shared by the face-node and face-edge connectivity
+    auto facesRowsToUpdate = m_compressedFacesRowsToUpdate;
+    updateRows(m_facesNodesCsr, m_compressedFacesRowsToUpdate, GetNumFaces(), [this](int f) { m_facesNodesCsr.SetRow(f, m_facesNodes[f]); });
+    updateRows(m_facesEdgesCsr, facesRowsToUpdate, GetNumFaces(), [this](int f) { m_facesEdgesCsr.SetRow(f, m_facesEdges[f]); });
+}
+
+void meshkernel::Mesh::RegisterModifiedNode(int node)
+{
+    if (node >= 0)
+    {
+        m_modifiedNodes.emplace_back(node);
+        m_flatCopiesRequireUpdate = true;
+    }
+}
+
+void meshkernel::Mesh::RegisterModifiedEdge(int edge)
+{
+    if (edge >= 0)
+    {
+        m_modifiedEdges.emplace_back(edge);
+        m_flatCopiesRequireUpdate = true;
+    }
+}
+
+void meshkernel::Mesh::CopyNodeEdgesToCompressedRow(int node)
+{
+    // the rows of the nodes added since the last administration are created by the next administration
+    if (node < m_nodesEdgesCsr.GetNumRows())
+    {
+        m_nodesEdgesCsr.SetRow(node, m_nodesEdges[node], m_nodesNumEdges[node]);
+    }
+}
+
+void meshkernel::Mesh::CopyFaceToCompressedRows(int face)
+{
+    if (face < m_facesNodesCsr.GetNumRows())
+    {
+        m_facesNodesCsr.SetRow(face, m_facesNodes[face], m_numFacesNodes[face]);
+        m_facesEdgesCsr.SetRow(face, m_facesEdges[face], m_numFacesNodes[face]);
+    }
+}
+
+bool meshkernel::Mesh::IsCompressedConnectivityConsistent() const
+{
+    const auto isRowEqual = [](const CompressedSparseRow& rows, int row, const std::vector<int>& entries, int size) {
+        if (rows.GetRowSize(row) != size)
+        {
+            return false;
+        }
+        for (int i = 0; i < size; ++i)
+        {
+            if (rows(row, i) != entries[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (m_nodesEdgesCsr.GetNumRows() != GetNumNodes())
+    {
+        return false;
+    }
+    for (int n = 0; n < GetNumNodes(); ++n)
+    {
+        if (!isRowEqual(m_nodesEdgesCsr, n, m_nodesEdges[n], m_nodesNumEdges[n]))
+        {
+            return false;
+        }
+    }
+
+    if (m_facesNodesCsr.GetNumRows() != GetNumFaces() || m_facesEdgesCsr.GetNumRows() != GetNumFaces())
+    {
+        return false;
+    }
+    for (int f = 0; f < GetNumFaces(); ++f)
+    {
+        if (!isRowEqual(m_facesNodesCsr, f, m_facesNodes[f], m_numFacesNodes[f]) ||
+            !isRowEqual(m_facesEdgesCsr, f, m_facesEdges[f], m_numFacesNodes[f]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+    // The header of the mesh snapshot files, followed by the mesh sections, each starting at a multiple of 8 bytes
+    struct MeshSnapshotHeader
+    {
+        char magic[8];               // The file identifier
+        std::uint32_t version;       // The format version
+        std::uint32_t byteOrderMark; // To detect files written on a platform with a different byte order
+        std::int32_t projection;     // The mesh projection
+        std::int32_t numNodes;       // The number of nodes
+        std::int32_t numEdges;       // The number of edges
+        std::int32_t numFaces;       // The number of faces
+        std::int32_t numNodesEdges;  // The number of entries of the node-edge connectivity
+        std::int32_t numFacesNodes;  // The number of entries of the face-node (and face-edge) connectivity
+        std::int32_t flags;          // Bit 0: some edges were skipped by the node administration
+        std::int32_t reserved;       // Padding, set to zero
+    };
+
+    const char meshSnapshotMagic[8]{'M', 'K', 'S', 'N', 'A', 'P', '\0', '\0'};
+    const std::uint32_t meshSnapshotVersion = 1;
+    const std::uint32_t meshSnapshotByteOrderMark = 0x01020304;
+    const size_t meshSnapshotAlignment = 8;
+
+    static_assert(sizeof(MeshSnapshotHeader) % meshSnapshotAlignment == 0, "The snapshot header must keep the sections aligned");
+    static_assert(std::is_trivially_copyable<meshkernel::Point>::value && sizeof(meshkernel::Point) == 2 * sizeof(double), "Points are stored as two doubles");
+
+    // Writes an array as a snapshot section, padded to the section alignment
+    template <typename T>
+    void WriteSnapshotSection(std::ofstream& stream, const T* data, size_t count)
+    {
+        const auto numBytes = count * sizeof(T);
+        if (numBytes > 0)
+        {
+            stream.write(reinterpret_cast<const char*>(data), numBytes);
+        }
+        const char padding[meshSnapshotAlignment]{};
+        stream.write(padding, (meshSnapshotAlignment - numBytes % meshSnapshotAlignment) % meshSnapshotAlignment);
+    }
+
+    // Writes the offsets and the entries of a connectivity, taking the first rowSizes[r] entries of each row
+    void WriteSnapshotRows(std::ofstream& stream, const std::vector<std::vector<int>>& rows, const std::vector<int>& rowSizes, int numRows)
+    {
+        std::vector<int> offsets(numRows + 1, 0);
+        for (int r = 0; r < numRows; ++r)
+        {
+            offsets[r + 1] = offsets[r] + rowSizes[r];
+        }
+        WriteSnapshotSection(stream, offsets.data(), offsets.size());
+
+        std::vector<int> entries(offsets[numRows]);
+        for (int r = 0; r < numRows; ++r)
+        {
+            std::copy(rows[r].begin(), rows[r].begin() + rowSizes[r], entries.begin() + offsets[r]);
+        }
+        WriteSnapshotSection(stream, entries.data(), entries.size());
+    }
+
+    // Reads the sections of a mapped snapshot file in sequence
+    class MeshSnapshotReader
+    {
+    public:
+        MeshSnapshotReader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+        // Gets the next section, throws if the file is too short
+        template <typename T>
+        const T* ReadSection(size_t count)
+        {
+            const auto numBytes = count * sizeof(T);
+            if (m_size - m_position < numBytes)
+            {
+                throw std::invalid_argument("Mesh::LoadSnapshot: The snapshot file is truncated.");
+            }
+            const auto section = reinterpret_cast<const T*>(m_data + m_position);
+            m_position += numBytes;
+            m_position = std::min(m_size, m_position + (meshSnapshotAlignment - numBytes % meshSnapshotAlignment) % meshSnapshotAlignment);
+            return section;
+        }
+
+        // Gets the next connectivity section as rows
+        void ReadRows(int numRows, int numEntries, int maxIndex, std::vector<std::vector<int>>& rows, std::vector<int>& rowSizes)
+        {
+            const auto offsets = ReadSection<std::int32_t>(numRows + 1);
+            const auto entries = ReadSection<std::int32_t>(numEntries);
+            if (offsets[0] != 0 || offsets[numRows] != numEntries)
+            {
+                throw std::invalid_argument("Mesh::LoadSnapshot: Invalid connectivity offsets.");
+            }
+
+            rows.resize(numRows);
+            rowSizes.resize(numRows);
+            for (int r = 0; r < numRows; ++r)
+            {
+                if (offsets[r + 1] < offsets[r] || offsets[r + 1] > numEntries)
+                {
+                    throw std::invalid_argument("Mesh::LoadSnapshot: Invalid connectivity offsets.");
+                }
+                rows[r].assign(entries + offsets[r], entries + offsets[r + 1]);
+                rowSizes[r] = offsets[r + 1] - offsets[r];
+            }
+            CheckIndices(entries, numEntries, maxIndex);
+        }
+
+        // Throws if an index is out of range, -1 marks a missing entry
+        static void CheckIndices(const std::int32_t* indices, size_t count, int maxIndex)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (indices[i] < -1 || indices[i] >= maxIndex)
+                {
+                    throw std::invalid_argument("Mesh::LoadSnapshot: Invalid index in the snapshot file.");
+                }
+            }
+        }
+
+    private:
+        const char* m_data;    // The mapped file
+        size_t m_size;         // The file size
+        size_t m_position = 0; // The position of the next section
+    };
+} // namespace
+
+void meshkernel::Mesh::SaveSnapshot(const std::string& filePath) const
+{
+    if (m_administrationState != AdministrationState::EdgesAndFaces || !m_modifiedNodes.empty() || !m_modifiedEdges.empty())
+    {
+        throw std::invalid_argument("Mesh::SaveSnapshot: The mesh faces have not been administrated.");
+    }
+
+    MeshSnapshotHeader header{};
+    std::copy(std::begin(meshSnapshotMagic), std::end(meshSnapshotMagic), header.magic);
+    header.version = meshSnapshotVersion;
+    header.byteOrderMark = meshSnapshotByteOrderMark;
+    header.projection = static_cast<std::int32_t>(m_projection);
+    header.numNodes = GetNumNodes();
+    header.numEdges = GetNumEdges();
+    header.numFaces = GetNumFaces();
+    header.numNodesEdges = std::accumulate(m_nodesNumEdges.begin(), m_nodesNumEdges.begin() + GetNumNodes(), 0);
+    header.numFacesNodes = std::accumulate(m_numFacesNodes.begin(), m_numFacesNodes.begin() + GetNumFaces(), 0);
+    header.flags = m_nodeAdministrationSkippedEdges ? 1 : 0;
+
+    std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        throw std::invalid_argument("Mesh::SaveSnapshot: Could not open " + filePath);
+    }
+    WriteSnapshotSection(stream, &header, 1);
+
+    // nodes
+    WriteSnapshotSection(stream, m_nodes.data(), GetNumNodes());
+    WriteSnapshotRows(stream, m_nodesEdges, m_nodesNumEdges, GetNumNodes());
+    WriteSnapshotSection(stream, m_nodesTypes.data(), GetNumNodes());
+
+    // edges
+    std::vector<int> edgeEntries(GetNumEdges() * 2);
+    for (int e = 0; e < GetNumEdges(); ++e)
+    {
+        edgeEntries[2 * e] = m_edges[e].first;
+        edgeEntries[2 * e + 1] = m_edges[e].second;
+    }
+    WriteSnapshotSection(stream, edgeEntries.data(), edgeEntries.size());
+    for (int e = 0; e < GetNumEdges(); ++e)
+    {
+        edgeEntries[2 * e] = m_edgesFaces[e][0];
+        edgeEntries[2 * e + 1] = m_edgesFaces[e][1];
+    }
+    WriteSnapshotSection(stream, edgeEntries.data(), edgeEntries.size());
+    WriteSnapshotSection(stream, m_edgesNumFaces.data(), GetNumEdges());
+
+    // faces
+    WriteSnapshotRows(stream, m_facesNodes, m_numFacesNodes, GetNumFaces());
+    WriteSnapshotRows(stream, m_facesEdges, m_numFacesNodes, GetNumFaces());
+    WriteSnapshotSection(stream, m_facesCircumcenters.data(), GetNumFaces());
+    WriteSnapshotSection(stream, m_facesMassCenters.data(), GetNumFaces());
+    WriteSnapshotSection(stream, m_faceArea.data(), GetNumFaces());
+
+    if (!stream)
+    {
+        throw std::invalid_argument("Mesh::SaveSnapshot: Could not write " + filePath);
+    }
+}
+
+void meshkernel::Mesh::LoadSnapshot(const std::string& filePath)
+{
+    const MemoryMappedFile file(filePath);
+    MeshSnapshotReader reader(file.GetData(), file.GetSize());
+
+    const auto& header = *reader.ReadSection<MeshSnapshotHeader>(1);
+    if (!std::equal(std::begin(meshSnapshotMagic), std::end(meshSnapshotMagic), header.magic))
+    {
+        throw std::invalid_argument("Mesh::LoadSnapshot: " + filePath + " is not a mesh snapshot.");
+    }
+    if (header.byteOrderMark != meshSnapshotByteOrderMark)
+    {
+        throw std::invalid_argument("Mesh::LoadSnapshot: The snapshot has been written with a different byte order.");
+    }
+    if (header.version != meshSnapshotVersion)
+    {
+        throw std::invalid_argument("Mesh::LoadSnapshot: Unsupported snapshot version " + std::to_string(header.version) + ".");
+    }
+    if (header.projection < static_cast<std::int32_t>(Projections::cartesian) ||
+        header.projection > static_cast<std::int32_t>(Projections::sphericalAccurate) ||
+        header.numNodes < 0 || header.numEdges < 0 || header.numFaces < 0 || header.numNodesEdges < 0 || header.numFacesNodes < 0)
+    {
+        throw std::invalid_argument("Mesh::LoadSnapshot: Invalid snapshot header.");
+    }
+
+    const auto numNodes = header.numNodes;
+    const auto numEdges = header.numEdges;
+    const auto numFaces = header.numFaces;
+
+    // nodes
+    const auto nodes = reader.ReadSection<Point>(numNodes);
+    m_nodes.assign(nodes, nodes + numNodes);
+    reader.ReadRows(numNodes, header.numNodesEdges, numEdges, m_nodesEdges, m_nodesNumEdges);
+    const auto nodesTypes = reader.ReadSection<std::int32_t>(numNodes);
+    m_nodesTypes.assign(nodesTypes, nodesTypes + numNodes);
+
+    // edges
+    const auto edges = reader.ReadSection<std::int32_t>(2 * size_t(numEdges));
+    MeshSnapshotReader::CheckIndices(edges, 2 * size_t(numEdges), numNodes);
+    m_edges.resize(numEdges);
+    for (int e = 0; e < numEdges; ++e)
+    {
+        m_edges[e] = {edges[2 * e], edges[2 * e + 1]};
+    }
+    const auto edgesFaces = reader.ReadSection<std::int32_t>(2 * size_t(numEdges));
+    MeshSnapshotReader::CheckIndices(edgesFaces, 2 * size_t(numEdges), numFaces);
+    m_edgesFaces.resize(numEdges);
+    for (int e = 0; e < numEdges; ++e)
+    {
+        m_edgesFaces[e] = {edgesFaces[2 * e], edgesFaces[2 * e + 1]};
+    }
+    const auto edgesNumFaces = reader.ReadSection<std::int32_t>(numEdges);
+    m_edgesNumFaces.assign(edgesNumFaces, edgesNumFaces + numEdges);
+
+    // faces
+    reader.ReadRows(numFaces, header.numFacesNodes, numNodes, m_facesNodes, m_numFacesNodes);
+    std::vector<int> numFacesEdges;
+    reader.ReadRows(numFaces, header.numFacesNodes, numEdges, m_facesEdges, numFacesEdges);
+    if (numFacesEdges != m_numFacesNodes)
+    {
+        throw std::invalid_argument("Mesh::LoadSnapshot: The face nodes and the face edges do not match.");
+    }
+    const auto facesCircumcenters = reader.ReadSection<Point>(numFaces);
+    m_facesCircumcenters.assign(facesCircumcenters, facesCircumcenters + numFaces);
+    const auto facesMassCenters = reader.ReadSection<Point>(numFaces);
+    m_facesMassCenters.assign(facesMassCenters, facesMassCenters + numFaces);
+    const auto faceArea = reader.ReadSection<double>(numFaces);
+    m_faceArea.assign(faceArea, faceArea + numFaces);
+
+    // the loaded mesh is administrated with faces
+    m_projection = static_cast<Projections>(header.projection);
+    m_numNodes = numNodes;
+    m_numEdges = numEdges;
+    m_numFaces = numFaces;
+    m_nodeAdministrationSkippedEdges = (header.flags & 1) != 0;
+    m_nodeMask.assign(numNodes, 1);
+    m_modifiedNodes.clear();
+    m_modifiedEdges.clear();
+    m_flatCopiesRequireUpdate = true;
+    m_nodesEdgesCsr.Build(m_nodesEdges, m_nodesNumEdges, GetNumNodes());
+    BuildCompressedConnectivity(AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    m_administrationState = AdministrationState::EdgesAndFaces;
+
+    m_nodesRTreeRequiresUpdate = true;
+    m_edgesRTreeRequiresUpdate = true;
+    if (!m_nodesRTree.Empty())
+    {
+        BuildNodesRTree();
+    }
+    if (!m_edgesRTree.Empty())
+    {
+        BuildEdgesRTree();
+    }
+}
+
+void meshkernel::Mesh::RemoveFace(int face)
+{
+    // detach the face from its edges
+    m_compressedFacesRowsToUpdate.emplace_back(face);
+    for (const auto& edge : m_facesEdges[face])
+    {
+        auto& edgeFaces = m_edgesFaces[edge];
+        if (m_edgesNumFaces[edge] > 1 && edgeFaces[0] == face)
+        {
+            edgeFaces[0] = edgeFaces[1];
+        }
+        edgeFaces[1] = -1;
+        if (m_edgesNumFaces[edge] == 1)
+        {
+            edgeFaces[0] = -1;
+        }
+        m_edgesNumFaces[edge] = std::max(m_edgesNumFaces[edge] - 1, 0);
+    }
+
+    // the last face takes the place of the removed one
+    const auto lastFace = GetNumFaces() - 1;
+    if (face != lastFace)
+    {
+        for (const auto& edge : m_facesEdges[lastFace])
+        {
+            for (int f = 0; f < m_edgesNumFaces[edge]; ++f)
+            {
+                if (m_edgesFaces[edge][f] == lastFace)
+                {
+                    m_edgesFaces[edge][f] = face;
+                }
+            }
+        }
+        m_facesNodes[face] = std::move(m_facesNodes[lastFace]);
+        m_facesEdges[face] = std::move(m_facesEdges[lastFace]);
+        m_numFacesNodes[face] = m_numFacesNodes[lastFace];
+        m_facesCircumcenters[face] = m_facesCircumcenters[lastFace];
+        m_facesMassCenters[face] = m_facesMassCenters[lastFace];
+        m_faceArea[face] = m_faceArea[lastFace];
+    }
+
+    m_facesNodes.pop_back();
+    m_facesEdges.pop_back();
+    m_numFacesNodes.pop_back();
+    m_facesCircumcenters.pop_back();
+    m_facesMassCenters.pop_back();
+    m_faceArea.pop_back();
+    m_numFaces--;
+}
+
+void meshkernel::Mesh::RemoveNodesAndEdges(const std::vector<int>& nodes, const std::vector<int>& edges, bool updateFaces, std::vector<int>& nodesIndices)
+{
+    // the remaining nodes and edges keep their relative order, as in RemoveInvalidNodesAndEdges
+    const auto compactIndices = [](int numEntries, const std::vector<int>& removedEntries, std::vector<int>& indices) {
+        indices.assign(numEntries, 0);
+        for (const auto& r : removedEntries)
+        {
+            indices[r] = -1;
+        }
+        int validIndex = 0;
+        for (auto& index : indices)
+        {
+            if (index >= 0)
+            {
+                index = validIndex;
+                validIndex++;
+            }
+        }
+        return validIndex;
+    };
+
+    std::vector<int> edgesIndices;
+    const auto numNodes = compactIndices(GetNumNodes(), nodes, nodesIndices);
+    const auto numEdges = compactIndices(GetNumEdges(), edges, edgesIndices);
+
+    for (int e = 0; e < GetNumEdges(); ++e)
+    {
+        const auto newEdge = edgesIndices[e];
+        if (newEdge < 0)
+        {
+            continue;
+        }
+        m_edges[newEdge] = {nodesIndices[m_edges[e].first], nodesIndices[m_edges[e].second]};
+        if (updateFaces && newEdge != e)
+        {
+            m_edgesFaces[newEdge] = std::move(m_edgesFaces[e]);
+            m_edgesNumFaces[newEdge] = m_edgesNumFaces[e];
+        }
+    }
+    for (int e = numEdges; e < GetNumEdges(); ++e)
+    {
+        m_edges[e] = {-1, -1};
+        if (updateFaces)
+        {
+            m_edgesFaces[e] = {-1, -1};
+            m_edgesNumFaces[e] = 0;
+        }
+    }
+
+    for (int n = 0; n < GetNumNodes(); ++n)
+    {
+        const auto newNode = nodesIndices[n];
+        if (newNode < 0)
+        {
+            continue;
+        }
+        for (int e = 0; e < m_nodesNumEdges[n]; ++e)
+        {
+            m_nodesEdges[n][e] = edgesIndices[m_nodesEdges[n][e]];
+        }
+        if (newNode == n)
+        {
+            continue;
+        }
+        m_nodes[newNode] = m_nodes[n];
+        m_nodesEdges[newNode] = std::move(m_nodesEdges[n]);
+        m_nodesNumEdges[newNode] = m_nodesNumEdges[n];
+        if (n < static_cast<int>(m_nodesTypes.size()))
+        {
+            m_nodesTypes[newNode] = m_nodesTypes[n];
+        }
+    }
+    for (int n = numNodes; n < GetNumNodes(); ++n)
+    {
+        m_nodes[n] = {doubleMissingValue, doubleMissingValue};
+        m_nodesEdges[n].clear();
+        m_nodesNumEdges[n] = 0;
+    }
+
+    if (updateFaces)
+    {
+        for (int f = 0; f < GetNumFaces(); ++f)
+        {
+            for (auto& node : m_facesNodes[f])
+            {
+                node = nodesIndices[node];
+            }
+            for (auto& edge : m_facesEdges[f])
+            {
+                edge = edgesIndices[edge];
+            }
+        }
+    }
+
+    m_numNodes = numNodes;
+    m_numEdges = numEdges;
+
+    // the numbering changed, the trees must be built again
+    m_nodesRTreeRequiresUpdate = true;
+    m_edgesRTreeRequiresUpdate = true;
 }
 
 meshkernel::Mesh::Mesh(const CurvilinearGrid& curvilinearGrid, Projections projection)
@@ -283,35 +1125,44 @@ meshkernel::Mesh::Mesh(const CurvilinearGrid& curvilinearGrid, Projections proje
     Set(edges, nodes, projection, AdministrationOptions::AdministrateMeshEdges);
 }
 
-meshkernel::Mesh::Mesh(std::vector<Point>& inputNodes, const Polygons& polygons, Projections projection) : m_projection(projection)
+meshkernel::Mesh::Mesh(std::vector<Point>& inputNodes, const Polygons& polygons, Projections projection, bool parallel) : m_projection(projection)
 {
-    // compute triangulation
+    // compute triangulation, in parallel one slab of points per thread
     TriangulationWrapper triangulationWrapper;
     const auto numPolygonNodes = static_cast<int>(inputNodes.size()); // open polygon
-    const auto numberOfTriangles = static_cast<int>(inputNodes.size()) * 6 + 10;
-    triangulationWrapper.Compute(inputNodes,
-                                 numPolygonNodes,
-                                 TriangulationWrapper::TriangulationOptions::TriangulatePointsAndGenerateFaces,
-                                 0.0,
-                                 numberOfTriangles);
+    int numSlabs = 1;
+#ifdef _OPENMP
+    if (parallel)
+    {
+        numSlabs = omp_get_max_threads();
+    }
+#endif
+    triangulationWrapper.ComputeInSlabs(inputNodes, numPolygonNodes, numSlabs);
 
     // For each triangle check
     // 1. Validity of its internal angles
     // 2. Is inside the polygon
-    // If so we mark the edges and we add them m_edges
-    std::vector<bool> edgeNodesFlag(triangulationWrapper.m_numEdges, false);
+    // CheckTriangle and Polygons::IsPointInPolygon are const and keep no state between calls, so the threads can share the mesh and the polygons
+    std::vector<char> isGoodTriangle(triangulationWrapper.m_numFaces, false);
+#pragma omp parallel for if (parallel)
     for (int i = 0; i < triangulationWrapper.m_numFaces; ++i)
     {
-        bool goodTriangle = CheckTriangle(triangulationWrapper.m_faceNodes[i], inputNodes);
-
-        if (!goodTriangle)
+        const std::array<int, 3> faceNodes{triangulationWrapper.GetFaceNode(i, 0),
+                                           triangulationWrapper.GetFaceNode(i, 1),
+                                           triangulationWrapper.GetFaceNode(i, 2)};
+        if (!CheckTriangle(faceNodes, inputNodes))
         {
             continue;
         }
-        Point approximateCenter = (inputNodes[triangulationWrapper.m_faceNodes[i][0]] + inputNodes[triangulationWrapper.m_faceNodes[i][1]] + inputNodes[triangulationWrapper.m_faceNodes[i][2]]) * oneThird;
+        Point approximateCenter = (inputNodes[faceNodes[0]] + inputNodes[faceNodes[1]] + inputNodes[faceNodes[2]]) * oneThird;
+        isGoodTriangle[i] = polygons.IsPointInPolygon(approximateCenter, 0);
+    }
 
-        bool isTriangleInPolygon = polygons.IsPointInPolygon(approximateCenter, 0);
-        if (!isTriangleInPolygon)
+    // If so we mark the edges and we add them m_edges
+    std::vector<bool> edgeNodesFlag(triangulationWrapper.m_numEdges, false);
+    for (int i = 0; i < triangulationWrapper.m_numFaces; ++i)
+    {
+        if (!isGoodTriangle[i])
         {
             continue;
         }
@@ -319,7 +1170,7 @@ meshkernel::Mesh::Mesh(std::vector<Point>& inputNodes, const Polygons& polygons,
         // mark all edges of this triangle as good ones
         for (int j = 0; j < 3; ++j)
         {
-            edgeNodesFlag[triangulationWrapper.m_faceEdges[i][j]] = true;
+            edgeNodesFlag[triangulationWrapper.GetFaceEdge(i, j)] = true;
         }
     }
 
@@ -340,8 +1191,8 @@ meshkernel::Mesh::Mesh(std::vector<Point>& inputNodes, const Polygons& polygons,
         if (!edgeNodesFlag[i])
             continue;
 
-        edges[validEdgesCount].first = std::abs(triangulationWrapper.m_edgeNodes[i][0]);
-        edges[validEdgesCount].second = triangulationWrapper.m_edgeNodes[i][1];
+        edges[validEdgesCount].first = std::abs(triangulationWrapper.GetEdgeNode(i, 0));
+        edges[validEdgesCount].second = triangulationWrapper.GetEdgeNode(i, 1);
         validEdgesCount++;
     }
 
@@ -351,7 +1202,7 @@ meshkernel::Mesh::Mesh(std::vector<Point>& inputNodes, const Polygons& polygons,
     Set(edges, inputNodes, projection, AdministrationOptions::AdministrateMeshEdges);
 }
 
-bool meshkernel::Mesh::CheckTriangle(const std::vector<int>& faceNodes, const std::vector<Point>& nodes) const
+bool meshkernel::Mesh::CheckTriangle(const std::array<int, 3>& faceNodes, const std::vector<Point>& nodes) const
 {
     // Used for triangular grids
     constexpr double triangleMinimumAngle = 5.0;
@@ -360,7 +1211,7 @@ bool meshkernel::Mesh::CheckTriangle(const std::vector<int>& faceNodes, const st
     double phiMin = 1e3;
     double phiMax = 0.0;
 
-    static std::array<std::array<int, 3>, 3> nodePermutations{{{2, 0, 1}, {0, 1, 2}, {1, 2, 0}}};
+    static constexpr std::array<std::array<int, 3>, 3> nodePermutations{{{2, 0, 1}, {0, 1, 2}, {1, 2, 0}}};
 
     for (int i = 0; i < faceNodes.size(); ++i)
     {
@@ -382,7 +1233,22 @@ bool meshkernel::Mesh::CheckTriangle(const std::vector<int>& faceNodes, const st
 
 void meshkernel::Mesh::SetFlatCopies(AdministrationOptions administrationOption)
 {
-    Administrate(administrationOption);
+    // nothing changed since the last copies, which contain the faces if they are requested
+    if (!m_flatCopiesRequireUpdate &&
+        (administrationOption == m_flatCopiesAdministration || administrationOption == AdministrationOptions::AdministrateMeshEdges))
+    {
+        return;
+    }
+
+    // the face numbering of a local administration differs from the one of a full administration
+    if (administrationOption == AdministrationOptions::AdministrateMeshEdgesAndFaces)
+    {
+        Administrate(administrationOption);
+    }
+    else
+    {
+        AdministrateModifiedRegion(administrationOption);
+    }
 
     m_nodex.resize(GetNumNodes());
     m_nodey.resize(GetNumNodes());
@@ -457,10 +1323,31 @@ void meshkernel::Mesh::SetFlatCopies(AdministrationOptions administrationOption)
     {
         m_facesCircumcentersz.resize(1);
     }
+
+    m_flatCopiesRequireUpdate = false;
+    m_flatCopiesAdministration = administrationOption;
 }
 
 void meshkernel::Mesh::NodeAdministration()
 {
+    m_nodeAdministrationSkippedEdges = false;
+
+    // reserve room for the edges of each node, at most maximumNumberOfEdgesPerNode
+    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesNumEdges);
+    std::fill(m_nodesNumEdges.begin(), m_nodesNumEdges.end(), 0);
+    for (int e = 0; e < GetNumEdges(); e++)
+    {
+        const auto firstNode = m_edges[e].first;
+        const auto secondNode = m_edges[e].second;
+        if (firstNode >= 0 && secondNode >= 0)
+        {
+            m_nodesNumEdges[firstNode] = std::min(m_nodesNumEdges[firstNode] + 1, maximumNumberOfEdgesPerNode);
+            m_nodesNumEdges[secondNode] = std::min(m_nodesNumEdges[secondNode] + 1, maximumNumberOfEdgesPerNode);
+        }
+    }
+    m_nodesEdgesCsr.Reserve(m_nodesNumEdges, GetNumNodes());
+    std::fill(m_nodesNumEdges.begin(), m_nodesNumEdges.end(), 0);
+
     // assume no duplicated links
     for (int e = 0; e < GetNumEdges(); e++)
     {
@@ -474,6 +1361,7 @@ void meshkernel::Mesh::NodeAdministration()
 
         if (m_nodesNumEdges[firstNode] >= maximumNumberOfEdgesPerNode || m_nodesNumEdges[secondNode] >= maximumNumberOfEdgesPerNode)
         {
+            m_nodeAdministrationSkippedEdges = true;
             continue;
         }
 
@@ -481,7 +1369,7 @@ void meshkernel::Mesh::NodeAdministration()
         bool alreadyAddedEdge = false;
         for (int i = 0; i < m_nodesNumEdges[firstNode]; ++i)
         {
-            auto currentEdge = m_edges[m_nodesEdges[firstNode][i]];
+            auto currentEdge = m_edges[m_nodesEdgesCsr(firstNode, i)];
             if (currentEdge.first == secondNode || currentEdge.second == secondNode)
             {
                 alreadyAddedEdge = true;
@@ -490,15 +1378,19 @@ void meshkernel::Mesh::NodeAdministration()
         }
         if (!alreadyAddedEdge)
         {
-            m_nodesEdges[firstNode][m_nodesNumEdges[firstNode]] = e;
+            m_nodesEdgesCsr.Append(firstNode, e);
             m_nodesNumEdges[firstNode]++;
         }
+        else
+        {
+            m_nodeAdministrationSkippedEdges = true;
+        }
 
         // Search for previously connected edges
         alreadyAddedEdge = false;
         for (int i = 0; i < m_nodesNumEdges[secondNode]; ++i)
         {
-            auto currentEdge = m_edges[m_nodesEdges[secondNode][i]];
+            auto currentEdge = m_edges[m_nodesEdgesCsr(secondNode, i)];
             if (currentEdge.first == firstNode || currentEdge.second == firstNode)
             {
                 alreadyAddedEdge = true;
@@ -507,18 +1399,58 @@ void meshkernel::Mesh::NodeAdministration()
         }
         if (!alreadyAddedEdge)
         {
-            m_nodesEdges[secondNode][m_nodesNumEdges[secondNode]] = e;
+            m_nodesEdgesCsr.Append(secondNode, e);
             m_nodesNumEdges[secondNode]++;
         }
+        else
+        {
+            m_nodeAdministrationSkippedEdges = true;
+        }
     }
 
-    // resize
+    // sort the compressed rows, the edges of each node are then copied to m_nodesEdges
+    ResizeVectorIfNeeded(int(m_nodes.size()), m_nodesEdges);
     for (auto n = 0; n < GetNumNodes(); n++)
     {
-        m_nodesEdges[n].resize(m_nodesNumEdges[n]);
+        SortEdgesInCounterClockWiseOrder(n, m_nodesEdgesCsr.RowBegin(n));
+        m_nodesEdges[n].assign(m_nodesEdgesCsr.RowBegin(n), m_nodesEdgesCsr.RowEnd(n));
     }
 };
 
+bool meshkernel::Mesh::NodeAdministration(int node, const std::vector<int>& candidateEdges)
+{
+    m_nodesEdges[node].clear();
+    m_nodesNumEdges[node] = 0;
+
+    for (const auto& e : candidateEdges)
+    {
+        const auto firstNode = m_edges[e].first;
+        const auto secondNode = m_edges[e].second;
+        if (firstNode < 0 || secondNode < 0 || (firstNode != node && secondNode != node))
+        {
+            continue;
+        }
+
+        // duplicated edges and nodes with too many edges are administrated by the full administration only
+        const auto otherNode = firstNode + secondNode - node;
+        for (const auto& edge : m_nodesEdges[node])
+        {
+            if (m_edges[edge].first == otherNode || m_edges[edge].second == otherNode)
+            {
+                return false;
+            }
+        }
+        if (m_nodesNumEdges[node] >= maximumNumberOfEdgesPerNode)
+        {
+            return false;
+        }
+
+        m_nodesEdges[node].emplace_back(e);
+        m_nodesNumEdges[node]++;
+    }
+    return true;
+}
+
 void meshkernel::Mesh::SortEdgesInCounterClockWiseOrder(int node)
 {
     if (!m_nodes[node].IsValid())
@@ -526,6 +1458,12 @@ void meshkernel::Mesh::SortEdgesInCounterClockWiseOrder(int node)
         throw std::invalid_argument("Mesh::SortEdgesInCounterClockWiseOrder: Invalid nodes.");
     }
 
+    SortEdgesInCounterClockWiseOrder(node, m_nodesEdges[node].begin());
+}
+
+void meshkernel::Mesh::SortEdgesInCounterClockWiseOrder(int node, std::vector<int>::iterator nodeEdges)
+{
+
     double phi0 = 0.0;
     double phi;
     m_edgeAngles.resize(meshkernel::maximumNumberOfEdgesPerNode);
@@ -533,8 +1471,8 @@ void meshkernel::Mesh::SortEdgesInCounterClockWiseOrder(int node)
     for (auto edgeIndex = 0; edgeIndex < m_nodesNumEdges[node]; edgeIndex++)
     {
 
-        auto firstNode = m_edges[m_nodesEdges[node][edgeIndex]].first;
-        auto secondNode = m_edges[m_nodesEdges[node][edgeIndex]].second;
+        auto firstNode = m_edges[nodeEdges[edgeIndex]].first;
+        auto secondNode = m_edges[nodeEdges[edgeIndex]].second;
         if (firstNode < 0 || secondNode < 0)
         {
             continue;
@@ -578,13 +1516,13 @@ void meshkernel::Mesh::SortEdgesInCounterClockWiseOrder(int node)
 
     // Performing sorting
     std::vector<std::size_t> indexes(m_nodesNumEdges[node]);
-    std::vector<int> edgeNodeCopy{m_nodesEdges[node]};
+    std::vector<int> edgeNodeCopy(nodeEdges, nodeEdges + m_nodesNumEdges[node]);
     iota(indexes.begin(), indexes.end(), 0);
     sort(indexes.begin(), indexes.end(), [&](std::size_t i1, std::size_t i2) { return m_edgeAngles[i1] < m_edgeAngles[i2]; });
 
     for (std::size_t edgeIndex = 0; edgeIndex < m_nodesNumEdges[node]; edgeIndex++)
     {
-        m_nodesEdges[node][edgeIndex] = edgeNodeCopy[indexes[edgeIndex]];
+        nodeEdges[edgeIndex] = edgeNodeCopy[indexes[edgeIndex]];
     }
 }
 
@@ -648,156 +1586,185 @@ void meshkernel::Mesh::RemoveDegeneratedTriangles()
         MergeTwoNodes(thirdNode, firstNode);
     }
 
-    Administrate(AdministrationOptions::AdministrateMeshEdgesAndFaces);
-}
-
-void meshkernel::Mesh::FindFacesRecursive(int startingNode,
-                                          int node,
-                                          int index,
-                                          int previousEdge,
-                                          std::vector<int>& edges,
-                                          std::vector<int>& nodes,
-                                          std::vector<int>& sortedEdgesFaces,
-                                          std::vector<int>& sortedNodes,
-                                          std::vector<Point>& nodalValues)
-{
-    // The selected edge does not exist.
-    // TODO: It would make to throw an exception here, but then the test cases fail
-    if (index >= edges.size())
-        return;
-
-    if (m_edges[previousEdge].first < 0 || m_edges[previousEdge].second < 0)
-        throw std::invalid_argument("Mesh::FindFacesRecursive: The selected edge is invalid. This should not happen since all invalid edges should have been cleaned up.");
-
-    // Check if the faces are already found
-    if (m_edgesNumFaces[previousEdge] >= 2)
-        return;
-
-    edges[index] = previousEdge;
-    nodes[index] = node;
-    const int otherNode = m_edges[previousEdge].first + m_edges[previousEdge].second - node;
+    Administrate(AdministrationOptions::AdministrateMeshEdgesAndFaces);
+}
 
-    // enclosure found
-    if (otherNode == startingNode && index == edges.size() - 1)
+int meshkernel::Mesh::TraceFace(int startingNode, int startingEdge, std::vector<int>& edges, std::vector<int>& nodes) const
+{
+    int node = startingNode;
+    int edge = startingEdge;
+    for (int numFaceEdges = 0; numFaceEdges < maximumNumberOfEdgesPerFace; ++numFaceEdges)
     {
         // no duplicated nodes allowed
-        sortedNodes = nodes;
-        std::sort(sortedNodes.begin(), sortedNodes.end());
-        for (int n = 0; n < sortedNodes.size() - 1; n++)
+        if (std::find(nodes.begin(), nodes.begin() + numFaceEdges, node) != nodes.begin() + numFaceEdges)
         {
-            if (sortedNodes[n + 1] == sortedNodes[n])
-            {
-                return;
-            }
+            return 0;
         }
 
-        // we need to add a face when at least one edge has no faces
-        bool oneEdgeHasNoFace = false;
-        for (const auto& edge : edges)
+        edges[numFaceEdges] = edge;
+        nodes[numFaceEdges] = node;
+        const int otherNode = m_edges[edge].first + m_edges[edge].second - node;
+
+        // enclosure found
+        if (otherNode == startingNode)
         {
-            if (m_edgesNumFaces[edge] == 0)
-            {
-                oneEdgeHasNoFace = true;
-                break;
-            }
+            return numFaceEdges + 1 >= 3 ? numFaceEdges + 1 : 0;
         }
 
-        // check if least one edge has no face
-        if (!oneEdgeHasNoFace)
+        // the next edge precedes the current one in the counterclockwise order around the other node
+        int edgeIndexOtherNode = 0;
+        for (int e = 0; e < m_nodesNumEdges[otherNode]; e++)
         {
-            // is an internal face only if all edges have a different face
-            for (int ee = 0; ee < edges.size(); ee++)
-            {
-                sortedEdgesFaces[ee] = m_edgesFaces[edges[ee]][0];
-            }
-            std::sort(sortedEdgesFaces.begin(), sortedEdgesFaces.end());
-            for (int n = 0; n < sortedEdgesFaces.size() - 1; n++)
+            if (m_nodesEdges[otherNode][e] == edge)
             {
-                if (sortedEdgesFaces[n + 1] == sortedEdgesFaces[n])
-                    return;
+                edgeIndexOtherNode = e;
+                break;
             }
         }
+        edgeIndexOtherNode = NextCircularBackwardIndex(edgeIndexOtherNode, m_nodesNumEdges[otherNode]);
 
-        // the order of the edges in a new face must be counterclockwise
-        // in order to evaluate the clockwise order, the signed face area is computed
-        for (int n = 0; n < nodes.size(); n++)
-        {
-            nodalValues[n] = m_nodes[nodes[n]];
-        }
-        double area;
-        Point centerOfMass;
-        bool isCounterClockWise;
-        FaceAreaAndCenterOfMass(nodalValues, nodes.size(), m_projection, area, centerOfMass, isCounterClockWise);
-        if (!isCounterClockWise)
-        {
-            return;
-        }
-
-        // increase m_edgesNumFaces
-        m_numFaces += 1;
-        for (const auto& edge : edges)
-        {
-            m_edgesNumFaces[edge] += 1;
-            const int numFace = m_edgesNumFaces[edge];
-            m_edgesFaces[edge][numFace - 1] = m_numFaces - 1;
-        }
-
-        // store the result
-        m_facesNodes.emplace_back(nodes);
-        m_facesEdges.emplace_back(edges);
-        m_faceArea.emplace_back(area);
-        m_facesMassCenters.emplace_back(centerOfMass);
-
-        return;
+        edge = m_nodesEdges[otherNode][edgeIndexOtherNode];
+        node = otherNode;
     }
 
-    int edgeIndexOtherNode = 0;
-    for (int e = 0; e < m_nodesNumEdges[otherNode]; e++)
+    return 0;
+}
+
+void meshkernel::Mesh::FindFaces()
+{
+    std::vector<int> startingNodes;
+    startingNodes.reserve(GetNumNodes());
+    for (int n = 0; n < GetNumNodes(); n++)
     {
-        if (m_nodesEdges[otherNode][e] == previousEdge)
+        if (m_nodes[n].IsValid())
         {
-            edgeIndexOtherNode = e;
-            break;
+            startingNodes.emplace_back(n);
         }
     }
 
-    edgeIndexOtherNode = edgeIndexOtherNode - 1;
-    if (edgeIndexOtherNode < 0)
+    FindFaces(startingNodes);
+}
+
+void meshkernel::Mesh::FindFaces(const std::vector<int>& startingNodes)
+{
+    // each half-edge leaving a starting node is the first half-edge of at most one face
+    const auto numStartingNodes = static_cast<int>(startingNodes.size());
+    std::vector<int> halfEdgesOffsets(numStartingNodes + 1, 0);
+    for (int i = 0; i < numStartingNodes; ++i)
     {
-        edgeIndexOtherNode = edgeIndexOtherNode + m_nodesNumEdges[otherNode];
+        halfEdgesOffsets[i + 1] = halfEdgesOffsets[i] + m_nodesNumEdges[startingNodes[i]];
     }
-    if (edgeIndexOtherNode > m_nodesNumEdges[otherNode] - 1)
+    const auto numHalfEdges = halfEdgesOffsets.back();
+
+    std::vector<int> facesNumEdges(numHalfEdges, 0);
+    std::vector<int> facesEdges(numHalfEdges * maximumNumberOfEdgesPerFace);
+    std::vector<int> facesNodes(numHalfEdges * maximumNumberOfEdgesPerFace);
+    std::vector<double> facesArea(numHalfEdges);
+    std::vector<Point> facesMassCenters(numHalfEdges);
+
+    // trace the faces, the geometry of each face does not depend on the other faces
+#pragma omp parallel
     {
-        edgeIndexOtherNode = edgeIndexOtherNode - m_nodesNumEdges[otherNode];
-    }
+        std::vector<int> edges(maximumNumberOfEdgesPerFace);
+        std::vector<int> nodes(maximumNumberOfEdgesPerFace);
+        std::vector<Point> nodalValues(maximumNumberOfEdgesPerFace);
 
-    const int edge = m_nodesEdges[otherNode][edgeIndexOtherNode];
-    FindFacesRecursive(startingNode, otherNode, index + 1, edge, edges, nodes, sortedEdgesFaces, sortedNodes, nodalValues);
-}
+#pragma omp for
+        for (int i = 0; i < numStartingNodes; ++i)
+        {
+            const auto n = startingNodes[i];
+            for (int e = 0; e < m_nodesNumEdges[n]; e++)
+            {
+                const auto numFaceEdges = TraceFace(n, m_nodesEdges[n][e], edges, nodes);
+                if (numFaceEdges == 0)
+                {
+                    continue;
+                }
 
-void meshkernel::Mesh::FindFaces()
-{
+                // the order of the edges in a new face must be counterclockwise
+                // in order to evaluate the clockwise order, the signed face area is computed
+                for (int nn = 0; nn < numFaceEdges; nn++)
+                {
+                    nodalValues[nn] = m_nodes[nodes[nn]];
+                }
+                double area;
+                Point centerOfMass;
+                bool isCounterClockWise;
+                FaceAreaAndCenterOfMass(nodalValues, numFaceEdges, m_projection, area, centerOfMass, isCounterClockWise);
+                if (!isCounterClockWise)
+                {
+                    continue;
+                }
+
+                const auto halfEdge = halfEdgesOffsets[i] + e;
+                facesNumEdges[halfEdge] = numFaceEdges;
+                std::copy(edges.begin(), edges.begin() + numFaceEdges, facesEdges.begin() + halfEdge * maximumNumberOfEdgesPerFace);
+                std::copy(nodes.begin(), nodes.begin() + numFaceEdges, facesNodes.begin() + halfEdge * maximumNumberOfEdgesPerFace);
+                facesArea[halfEdge] = area;
+                facesMassCenters[halfEdge] = centerOfMass;
+            }
+        }
+    }
+
+    // add the faces in a deterministic order: by number of edges, starting node and starting edge
+    const auto firstNewFace = GetNumFaces();
+    std::vector<int> sortedEdgesFaces(maximumNumberOfEdgesPerFace);
     for (int numEdgesPerFace = 3; numEdgesPerFace <= maximumNumberOfEdgesPerFace; numEdgesPerFace++)
     {
-        std::vector<int> edges(numEdgesPerFace);
-        std::vector<int> nodes(numEdgesPerFace);
-        std::vector<int> sortedEdgesFaces(numEdgesPerFace);
-        std::vector<int> sortedNodes(numEdgesPerFace);
-        std::vector<Point> nodalValues(numEdgesPerFace);
-        for (int n = 0; n < GetNumNodes(); n++)
+        for (int halfEdge = 0; halfEdge < numHalfEdges; ++halfEdge)
         {
-            if (!m_nodes[n].IsValid())
+            if (facesNumEdges[halfEdge] != numEdgesPerFace)
+            {
                 continue;
+            }
 
-            for (int e = 0; e < m_nodesNumEdges[n]; e++)
+            const auto edgesBegin = facesEdges.begin() + halfEdge * maximumNumberOfEdgesPerFace;
+            const auto edgesEnd = edgesBegin + numEdgesPerFace;
+
+            // check if the faces are already found, we need to add a face when at least one edge has no faces
+            bool oneEdgeHasTwoFaces = false;
+            bool oneEdgeHasNoFace = false;
+            for (auto edge = edgesBegin; edge != edgesEnd; ++edge)
+            {
+                oneEdgeHasTwoFaces = oneEdgeHasTwoFaces || m_edgesNumFaces[*edge] >= 2;
+                oneEdgeHasNoFace = oneEdgeHasNoFace || m_edgesNumFaces[*edge] == 0;
+            }
+            if (oneEdgeHasTwoFaces)
+            {
+                continue;
+            }
+
+            // is an internal face only if all edges have a different face
+            if (!oneEdgeHasNoFace)
+            {
+                std::transform(edgesBegin, edgesEnd, sortedEdgesFaces.begin(), [this](int edge) { return m_edgesFaces[edge][0]; });
+                std::sort(sortedEdgesFaces.begin(), sortedEdgesFaces.begin() + numEdgesPerFace);
+                if (std::adjacent_find(sortedEdgesFaces.begin(), sortedEdgesFaces.begin() + numEdgesPerFace) != sortedEdgesFaces.begin() + numEdgesPerFace)
+                {
+                    continue;
+                }
+            }
+
+            // increase m_edgesNumFaces
+            m_numFaces += 1;
+            for (auto edge = edgesBegin; edge != edgesEnd; ++edge)
             {
-                FindFacesRecursive(n, n, 0, m_nodesEdges[n][e], edges, nodes, sortedEdgesFaces, sortedNodes, nodalValues);
+                m_edgesNumFaces[*edge] += 1;
+                const int numFace = m_edgesNumFaces[*edge];
+                m_edgesFaces[*edge][numFace - 1] = m_numFaces - 1;
             }
+
+            // store the result
+            const auto nodesBegin = facesNodes.begin() + halfEdge * maximumNumberOfEdgesPerFace;
+            m_facesNodes.emplace_back(nodesBegin, nodesBegin + numEdgesPerFace);
+            m_facesEdges.emplace_back(edgesBegin, edgesEnd);
+            m_faceArea.emplace_back(facesArea[halfEdge]);
+            m_facesMassCenters.emplace_back(facesMassCenters[halfEdge]);
         }
     }
 
     m_numFacesNodes.resize(m_numFaces);
-    for (int f = 0; f < m_numFaces; ++f)
+    for (int f = firstNewFace; f < m_numFaces; ++f)
     {
         m_numFacesNodes[f] = int(m_facesNodes[f].size());
     }
@@ -805,6 +1772,8 @@ void meshkernel::Mesh::FindFaces()
 
 void meshkernel::Mesh::ComputeFaceCircumcentersMassCentersAndAreas(bool computeMassCenters)
 {
+    m_flatCopiesRequireUpdate = true;
+
     m_facesCircumcenters.resize(GetNumFaces());
     m_faceArea.resize(GetNumFaces());
     m_facesMassCenters.resize(GetNumFaces());
@@ -813,50 +1782,130 @@ void meshkernel::Mesh::ComputeFaceCircumcentersMassCentersAndAreas(bool computeM
     std::vector<Point> normalsCache(maximumNumberOfNodesPerFace);
     std::vector<int> numEdgeFacesCache(maximumNumberOfEdgesPerFace);
     m_polygonNodesCache.resize(maximumNumberOfNodesPerFace + 1);
-    for (int f = 0; f < GetNumFaces(); f++)
+
+    // the circumcenters of the cartesian triangles with interior edges are computed in one batch after the loop,
+    // as ComputeFaceCircumenter does with CircumcenterOfTriangle. The other faces are computed one by one
+    std::vector<int> triangles;
+    PointsArrays firstNodes;
+    PointsArrays secondNodes;
+    PointsArrays thirdNodes;
+    if (m_projection == Projections::cartesian)
     {
-        //need to account for spherical coordinates. Build a polygon around a face
-        int numPolygonPoints;
-        FaceClosedPolygon(f, m_polygonNodesCache, numPolygonPoints);
+        triangles.reserve(GetNumFaces());
+        firstNodes.Resize(GetNumFaces());
+        secondNodes.Resize(GetNumFaces());
+        thirdNodes.Resize(GetNumFaces());
+    }
 
-        auto numberOfFaceNodes = GetNumFaceEdges(f);
+    for (int f = 0; f < GetNumFaces(); f++)
+    {
+        const bool isBatchedTriangle = m_projection == Projections::cartesian && GetNumFaceEdges(f) == 3 &&
+                                       (!IsEdgeOnBoundary(m_facesEdges[f][0]) || !IsEdgeOnBoundary(m_facesEdges[f][1]) || !IsEdgeOnBoundary(m_facesEdges[f][2]));
+        if (!isBatchedTriangle)
+        {
+            ComputeFaceCircumcenterMassCenterAndArea(f, computeMassCenters, middlePointsCache, normalsCache, numEdgeFacesCache);
+            continue;
+        }
 
         if (computeMassCenters)
         {
-            double area;
-            Point centerOfMass;
+            int numPolygonPoints;
+            FaceClosedPolygon(f, m_polygonNodesCache, numPolygonPoints);
             bool isCounterClockWise;
-            FaceAreaAndCenterOfMass(m_polygonNodesCache, numberOfFaceNodes, m_projection, area, centerOfMass, isCounterClockWise);
-            m_faceArea[f] = area;
-            m_facesMassCenters[f] = centerOfMass;
+            FaceAreaAndCenterOfMass(m_polygonNodesCache, 3, m_projection, m_faceArea[f], m_facesMassCenters[f], isCounterClockWise);
         }
 
-        int numberOfInteriorEdges = 0;
-        for (int n = 0; n < numberOfFaceNodes; n++)
-        {
-            if (!IsEdgeOnBoundary(m_facesEdges[f][n]))
-            {
-                numberOfInteriorEdges += 1;
-            }
-        }
-        if (numberOfInteriorEdges == 0)
-        {
-            m_facesCircumcenters[f] = m_facesMassCenters[f];
-            continue;
-        }
+        const auto triangle = static_cast<int>(triangles.size());
+        firstNodes.Set(triangle, m_nodes[m_facesNodes[f][0]]);
+        secondNodes.Set(triangle, m_nodes[m_facesNodes[f][1]]);
+        thirdNodes.Set(triangle, m_nodes[m_facesNodes[f][2]]);
+        triangles.emplace_back(f);
+    }
+
+    const auto numTriangles = static_cast<int>(triangles.size());
+    if (numTriangles == 0)
+    {
+        return;
+    }
+    PointsArrays circumcenters;
+    circumcenters.Resize(numTriangles);
+    ComputeCartesianTrianglesCircumcenters(numTriangles,
+                                           firstNodes.x.data(),
+                                           firstNodes.y.data(),
+                                           secondNodes.x.data(),
+                                           secondNodes.y.data(),
+                                           thirdNodes.x.data(),
+                                           thirdNodes.y.data(),
+                                           circumcenters.x.data(),
+                                           circumcenters.y.data());
+
+    // the circumcenters of the obtuse triangles are moved inside, as in ComputeFaceCircumenter.
+    // The gathered nodes are read again, sequentially
+    for (int t = 0; t < numTriangles; ++t)
+    {
+        m_polygonNodesCache[0] = {firstNodes.x[t], firstNodes.y[t]};
+        m_polygonNodesCache[1] = {secondNodes.x[t], secondNodes.y[t]};
+        m_polygonNodesCache[2] = {thirdNodes.x[t], thirdNodes.y[t]};
+        m_polygonNodesCache[3] = m_polygonNodesCache[0];
+        double xCenter = 0.0;
+        double yCenter = 0.0;
+        for (int n = 0; n < 3; n++)
+        {
+            xCenter += m_polygonNodesCache[n].x;
+            yCenter += m_polygonNodesCache[n].y;
+        }
+        const Point centerOfMass{xCenter / 3, yCenter / 3};
+        m_facesCircumcenters[triangles[t]] = KeepCircumcenterInFace(m_polygonNodesCache, 3, centerOfMass, {circumcenters.x[t], circumcenters.y[t]}, weightCircumCenter);
+    }
+}
+
+void meshkernel::Mesh::ComputeFaceCircumcenterMassCenterAndArea(int face,
+                                                                bool computeMassCenters,
+                                                                std::vector<Point>& middlePointsCache,
+                                                                std::vector<Point>& normalsCache,
+                                                                std::vector<int>& numEdgeFacesCache)
+{
+    //need to account for spherical coordinates. Build a polygon around a face
+    int numPolygonPoints;
+    FaceClosedPolygon(face, m_polygonNodesCache, numPolygonPoints);
+
+    auto numberOfFaceNodes = GetNumFaceEdges(face);
+
+    if (computeMassCenters)
+    {
+        double area;
+        Point centerOfMass;
+        bool isCounterClockWise;
+        FaceAreaAndCenterOfMass(m_polygonNodesCache, numberOfFaceNodes, m_projection, area, centerOfMass, isCounterClockWise);
+        m_faceArea[face] = area;
+        m_facesMassCenters[face] = centerOfMass;
+    }
 
-        for (int n = 0; n < numberOfFaceNodes; n++)
+    int numberOfInteriorEdges = 0;
+    for (int n = 0; n < numberOfFaceNodes; n++)
+    {
+        if (!IsEdgeOnBoundary(m_facesEdges[face][n]))
         {
-            numEdgeFacesCache[n] = m_edgesNumFaces[m_facesEdges[f][n]];
+            numberOfInteriorEdges += 1;
         }
+    }
+    if (numberOfInteriorEdges == 0)
+    {
+        m_facesCircumcenters[face] = m_facesMassCenters[face];
+        return;
+    }
 
-        m_facesCircumcenters[f] = ComputeFaceCircumenter(m_polygonNodesCache,
-                                                         middlePointsCache,
-                                                         normalsCache,
-                                                         numberOfFaceNodes,
-                                                         numEdgeFacesCache,
-                                                         weightCircumCenter);
+    for (int n = 0; n < numberOfFaceNodes; n++)
+    {
+        numEdgeFacesCache[n] = m_edgesNumFaces[m_facesEdges[face][n]];
     }
+
+    m_facesCircumcenters[face] = ComputeFaceCircumenter(m_polygonNodesCache,
+                                                        middlePointsCache,
+                                                        normalsCache,
+                                                        numberOfFaceNodes,
+                                                        numEdgeFacesCache,
+                                                        weightCircumCenter);
 }
 
 void meshkernel::Mesh::ClassifyNodes()
@@ -864,9 +1913,6 @@ void meshkernel::Mesh::ClassifyNodes()
     m_nodesTypes.resize(GetNumNodes(), 0);
     std::fill(m_nodesTypes.begin(), m_nodesTypes.end(), 0);
 
-    // threshold for corner points
-    const double cornerCosine = 0.25;
-
     for (int e = 0; e < GetNumEdges(); e++)
     {
         const auto firstNode = m_edges[e].first;
@@ -896,64 +1942,72 @@ void meshkernel::Mesh::ClassifyNodes()
 
     for (int n = 0; n < GetNumNodes(); n++)
     {
-        if (m_nodesTypes[n] == 1 || m_nodesTypes[n] == 2)
+        ClassifyNode(n);
+    }
+}
+
+void meshkernel::Mesh::ClassifyNode(int node)
+{
+    // threshold for corner points
+    const double cornerCosine = 0.25;
+
+    if (m_nodesTypes[node] == 1 || m_nodesTypes[node] == 2)
+    {
+        if (m_nodesNumEdges[node] == 2)
         {
-            if (m_nodesNumEdges[n] == 2)
-            {
-                //corner point
-                m_nodesTypes[n] = 3;
-            }
-            else
+            //corner point
+            m_nodesTypes[node] = 3;
+        }
+        else
+        {
+            int firstNode = 0;
+            int secondNode = 0;
+            for (int i = 0; i < m_nodesNumEdges[node]; i++)
             {
-                int firstNode = 0;
-                int secondNode = 0;
-                for (int i = 0; i < m_nodesNumEdges[n]; i++)
+                const int edgeIndex = m_nodesEdges[node][i];
+                if (IsEdgeOnBoundary(edgeIndex))
                 {
-                    const int edgeIndex = m_nodesEdges[n][i];
-                    if (IsEdgeOnBoundary(edgeIndex))
+                    if (firstNode == 0)
+                    {
+                        firstNode = m_edges[edgeIndex].first + m_edges[edgeIndex].second - node;
+                    }
+                    else
                     {
-                        if (firstNode == 0)
-                        {
-                            firstNode = m_edges[edgeIndex].first + m_edges[edgeIndex].second - n;
-                        }
-                        else
-                        {
-                            secondNode = m_edges[edgeIndex].first + m_edges[edgeIndex].second - n;
-                        }
+                        secondNode = m_edges[edgeIndex].first + m_edges[edgeIndex].second - node;
                     }
                 }
+            }
 
-                // point at the border
-                m_nodesTypes[n] = 2;
-                if (firstNode >= 0 && secondNode >= 0)
-                {
-                    double cosPhi =
-                        NormalizedInnerProductTwoSegments(m_nodes[n], m_nodes[firstNode], m_nodes[n], m_nodes[secondNode], m_projection);
+            // point at the border
+            m_nodesTypes[node] = 2;
+            if (firstNode >= 0 && secondNode >= 0)
+            {
+                double cosPhi =
+                    NormalizedInnerProductTwoSegments(m_nodes[node], m_nodes[firstNode], m_nodes[node], m_nodes[secondNode], m_projection);
 
-                    // void angle
-                    if (cosPhi > -cornerCosine)
-                    {
-                        m_nodesTypes[n] = 3;
-                    }
+                // void angle
+                if (cosPhi > -cornerCosine)
+                {
+                    m_nodesTypes[node] = 3;
                 }
             }
         }
-        else if (m_nodesTypes[n] > 2)
-        {
-            // corner point
-            m_nodesTypes[n] = 3;
-        }
-        else if (m_nodesTypes[n] != -1)
-        {
-            //internal node
-            m_nodesTypes[n] = 1;
-        }
+    }
+    else if (m_nodesTypes[node] > 2)
+    {
+        // corner point
+        m_nodesTypes[node] = 3;
+    }
+    else if (m_nodesTypes[node] != -1)
+    {
+        //internal node
+        m_nodesTypes[node] = 1;
+    }
 
-        if (m_nodesNumEdges[n] < 2)
-        {
-            //hanging node
-            m_nodesTypes[n] = -1;
-        }
+    if (m_nodesNumEdges[node] < 2)
+    {
+        //hanging node
+        m_nodesTypes[node] = -1;
     }
 }
 
@@ -1127,27 +2181,38 @@ void meshkernel::Mesh::MergeNodesInPolygon(const Polygons& polygon)
     SpatialTrees::RTree nodesRtree;
     nodesRtree.BuildTree(filteredNodes);
 
+    // find the close nodes of all nodes at once, the merged nodes are excluded afterwards
+    SpatialTrees::QueryResults closeNodes;
+    nodesRtree.NearestNeighboursOnSquaredDistance(filteredNodes, mergingDistanceSquared, closeNodes, true);
+    std::vector<bool> isMerged(filteredNodes.size(), false);
+
     // merge the closest nodes
     for (int i = 0; i < filteredNodes.size(); i++)
     {
-        nodesRtree.NearestNeighboursOnSquaredDistance(filteredNodes[i], mergingDistanceSquared);
+        int resultSize = 0;
+        for (int j = 0; j < closeNodes.GetQueryResultSize(i); j++)
+        {
+            if (!isMerged[closeNodes.GetQuerySampleIndex(i, j)])
+            {
+                resultSize++;
+            }
+        }
 
-        const auto resultSize = nodesRtree.GetQueryResultSize();
         if (resultSize > 1)
         {
-            for (int j = 0; j < nodesRtree.GetQueryResultSize(); j++)
+            for (int j = 0; j < closeNodes.GetQueryResultSize(i); j++)
             {
-                auto nodeIndexInFilteredNodes = nodesRtree.GetQuerySampleIndex(j);
-                if (nodeIndexInFilteredNodes != i)
+                auto nodeIndexInFilteredNodes = closeNodes.GetQuerySampleIndex(i, j);
+                if (nodeIndexInFilteredNodes != i && !isMerged[nodeIndexInFilteredNodes])
                 {
                     MergeTwoNodes(originalNodeIndices[i], originalNodeIndices[nodeIndexInFilteredNodes]);
-                    nodesRtree.RemoveNode(i);
+                    isMerged[i] = true;
                 }
             }
         }
     }
 
-    Administrate(AdministrationOptions::AdministrateMeshEdges);
+    AdministrateModifiedRegion(AdministrationOptions::AdministrateMeshEdges);
 }
 
 void meshkernel::Mesh::MergeTwoNodes(int firstNodeIndex, int secondNodeIndex)
@@ -1157,6 +2222,19 @@ void meshkernel::Mesh::MergeTwoNodes(int firstNodeIndex, int secondNodeIndex)
         throw std::invalid_argument("Mesh::MergeTwoNodes: Either the first or the second node-index is invalid.");
     }
 
+    // all edges of the two nodes are deleted or renumbered
+    const auto firstModifiedEdge = m_modifiedEdges.size();
+    RegisterModifiedNode(firstNodeIndex);
+    RegisterModifiedNode(secondNodeIndex);
+    for (auto n = 0; n < m_nodesNumEdges[firstNodeIndex]; n++)
+    {
+        RegisterModifiedEdge(m_nodesEdges[firstNodeIndex][n]);
+    }
+    for (auto n = 0; n < m_nodesNumEdges[secondNodeIndex]; n++)
+    {
+        RegisterModifiedEdge(m_nodesEdges[secondNodeIndex][n]);
+    }
+
     int edgeIndex;
     FindEdge(firstNodeIndex, secondNodeIndex, edgeIndex);
     if (edgeIndex >= 0)
@@ -1180,6 +2258,7 @@ void meshkernel::Mesh::MergeTwoNodes(int firstNodeIndex, int secondNodeIndex)
                 auto secondNodeSecondEdge = secondEdge.first + secondEdge.second - firstEdgeOtherNode;
                 if (secondNodeSecondEdge == secondNodeIndex)
                 {
+                    RegisterModifiedEdge(secondEdgeIndex);
                     m_edges[secondEdgeIndex].first = -1;
                     m_edges[secondEdgeIndex].second = -1;
                 }
@@ -1228,8 +2307,11 @@ void meshkernel::Mesh::MergeTwoNodes(int firstNodeIndex, int secondNodeIndex)
     m_nodesNumEdges[firstNodeIndex] = 0;
     m_nodes[firstNodeIndex] = {doubleMissingValue, doubleMissingValue};
 
-    m_nodesRTreeRequiresUpdate = true;
-    m_edgesRTreeRequiresUpdate = true;
+    UpdateNodeInRTree(firstNodeIndex);
+    for (auto e = firstModifiedEdge; e < m_modifiedEdges.size(); ++e)
+    {
+        UpdateEdgeInRTree(m_modifiedEdges[e]);
+    }
 }
 
 void meshkernel::Mesh::ConnectNodes(int startNode, int endNode, int& newEdgeIndex)
@@ -1248,7 +2330,11 @@ void meshkernel::Mesh::ConnectNodes(int startNode, int endNode, int& newEdgeInde
     m_edges[newEdgeIndex].second = endNode;
     m_numEdges++;
 
-    m_edgesRTreeRequiresUpdate = true;
+    RegisterModifiedNode(startNode);
+    RegisterModifiedNode(endNode);
+    RegisterModifiedEdge(newEdgeIndex);
+
+    UpdateEdgeInRTree(newEdgeIndex);
 }
 
 void meshkernel::Mesh::InsertNode(const Point& newPoint, int& newNodeIndex)
@@ -1266,7 +2352,9 @@ void meshkernel::Mesh::InsertNode(const Point& newPoint, int& newNodeIndex)
     m_nodeMask[newNodeIndex] = newNodeIndex;
     m_nodesNumEdges[newNodeIndex] = 0;
 
-    m_nodesRTreeRequiresUpdate = true;
+    RegisterModifiedNode(newNodeIndex);
+
+    UpdateNodeInRTree(newNodeIndex);
 }
 
 void meshkernel::Mesh::DeleteNode(int nodeIndex)
@@ -1282,9 +2370,11 @@ void meshkernel::Mesh::DeleteNode(int nodeIndex)
         DeleteEdge(edgeIndex);
     }
     m_nodes[nodeIndex] = {doubleMissingValue, doubleMissingValue};
-    m_numNodes--;
 
-    m_nodesRTreeRequiresUpdate = true;
+    // the node is removed by the next administration
+    RegisterModifiedNode(nodeIndex);
+
+    UpdateNodeInRTree(nodeIndex);
 }
 
 void meshkernel::Mesh::DeleteEdge(int edgeIndex)
@@ -1294,10 +2384,17 @@ void meshkernel::Mesh::DeleteEdge(int edgeIndex)
         throw std::invalid_argument("Mesh::DeleteEdge: The index of the edge to be deleted does not exist.");
     }
 
+    if (m_edges[edgeIndex].first >= 0 && m_edges[edgeIndex].second >= 0)
+    {
+        RegisterModifiedNode(m_edges[edgeIndex].first);
+        RegisterModifiedNode(m_edges[edgeIndex].second);
+    }
+    RegisterModifiedEdge(edgeIndex);
+
     m_edges[edgeIndex].first = intMissingValue;
     m_edges[edgeIndex].second = intMissingValue;
 
-    m_edgesRTreeRequiresUpdate = true;
+    UpdateEdgeInRTree(edgeIndex);
 }
 
 void meshkernel::Mesh::FaceClosedPolygon(int faceIndex, std::vector<Point>& polygonNodesCache, int& numClosedPolygonNodes) const
@@ -1363,14 +2460,10 @@ void meshkernel::Mesh::MaskNodesInPolygons(const Polygons& polygon, bool inside)
 
 void meshkernel::Mesh::ComputeEdgeLengths()
 {
-    auto const numEdges = GetNumEdges();
-    m_edgeLengths.resize(numEdges, doubleMissingValue);
-    for (int e = 0; e < numEdges; e++)
-    {
-        auto const first = m_edges[e].first;
-        auto const second = m_edges[e].second;
-        m_edgeLengths[e] = ComputeDistance(m_nodes[first], m_nodes[second], m_projection);
-    }
+    PointsArrays firstNodes;
+    PointsArrays secondNodes;
+    GatherEdgesNodes(GetNumEdges(), m_nodes, m_edges, firstNodes, secondNodes);
+    ComputeDistances(firstNodes, secondNodes, m_projection, m_edgeLengths);
 }
 
 void meshkernel::Mesh::ComputeEdgesCenters()
@@ -1378,6 +2471,56 @@ void meshkernel::Mesh::ComputeEdgesCenters()
     ComputeEdgeCenters(GetNumEdges(), m_nodes, m_edges, m_edgesCenters);
 }
 
+void meshkernel::Mesh::BuildNodesRTree()
+{
+    m_nodesRTree.BuildTree(m_nodes);
+    m_nodesRTreeRequiresUpdate = false;
+}
+
+void meshkernel::Mesh::BuildEdgesRTree()
+{
+    ComputeEdgesCenters();
+
+    // the tree is keyed on the edge index, so the centers of the invalid edges are kept as missing values
+    std::vector<Point> edgesCenters(GetNumEdges());
+    for (int e = 0; e < GetNumEdges(); ++e)
+    {
+        edgesCenters[e] = GetEdgeCenter(e);
+    }
+    m_edgesRTree.BuildTree(edgesCenters);
+    m_edgesRTreeRequiresUpdate = false;
+}
+
+meshkernel::Point meshkernel::Mesh::GetEdgeCenter(int edge) const
+{
+    const auto firstNode = m_edges[edge].first;
+    const auto secondNode = m_edges[edge].second;
+    if (firstNode < 0 || secondNode < 0 || !m_nodes[firstNode].IsValid() || !m_nodes[secondNode].IsValid())
+    {
+        return {doubleMissingValue, doubleMissingValue};
+    }
+    return (m_nodes[firstNode] + m_nodes[secondNode]) * 0.5;
+}
+
+void meshkernel::Mesh::UpdateNodeInRTree(int node)
+{
+    // the trees are only maintained once built, a tree requiring an update is built again later
+    if (m_nodesRTree.Empty() || m_nodesRTreeRequiresUpdate)
+    {
+        return;
+    }
+    m_nodesRTree.MoveNode(node, m_nodes[node]);
+}
+
+void meshkernel::Mesh::UpdateEdgeInRTree(int edge)
+{
+    if (m_edgesRTree.Empty() || m_edgesRTreeRequiresUpdate)
+    {
+        return;
+    }
+    m_edgesRTree.MoveNode(edge, GetEdgeCenter(edge));
+}
+
 bool meshkernel::Mesh::IsFullFaceNotInPolygon(int faceIndex) const
 {
     for (int n = 0; n < GetNumFaceEdges(faceIndex); n++)
@@ -1476,6 +2619,7 @@ void meshkernel::Mesh::OffsetSphericalCoordinates(double minx, double maxx)
                 m_nodes[n].x += 360.0;
             }
         }
+        InvalidateAdministration();
     }
 }
 
@@ -1486,11 +2630,10 @@ int meshkernel::Mesh::GetNodeIndex(Point point, double searchRadius)
         throw std::invalid_argument("Mesh::GetNodeIndex: There are no valid nodes.");
     }
 
-    // create rtree a first time
-    if (m_nodesRTree.Empty())
+    // create rtree a first time, or after the nodes have been renumbered
+    if (m_nodesRTree.Empty() || m_nodesRTreeRequiresUpdate)
     {
-        m_nodesRTree.BuildTree(m_nodes);
-        m_nodesRTreeRequiresUpdate = false;
+        BuildNodesRTree();
     }
 
     double const searchRadiusSquared = searchRadius * searchRadius;
@@ -1515,11 +2658,9 @@ int meshkernel::Mesh::FindEdgeCloseToAPoint(Point point)
         throw std::invalid_argument("Mesh::GetNodeIndex: There are no valid edges.");
     }
 
-    if (m_edgesRTree.Empty())
+    if (m_edgesRTree.Empty() || m_edgesRTreeRequiresUpdate)
     {
-        ComputeEdgesCenters();
-        m_edgesRTree.BuildTree(m_edgesCenters);
-        m_edgesRTreeRequiresUpdate = false;
+        BuildEdgesRTree();
     }
 
     m_edgesRTree.NearestNeighbour(point);
@@ -1729,6 +2870,7 @@ void meshkernel::Mesh::MoveNode(Point newPoint, int nodeindex)
     auto dy = GetDy(nodeToMove, newPoint, m_projection);
 
     double distanceNodeToMoveFromNewPoint = std::sqrt(dx * dx + dy * dy);
+    std::vector<bool> isNodeMoved(GetNumNodes(), false);
     for (int n = 0; n < GetNumNodes(); ++n)
     {
         auto nodeDx = GetDx(m_nodes[n], nodeToMove, m_projection);
@@ -1739,10 +2881,24 @@ void meshkernel::Mesh::MoveNode(Point newPoint, int nodeindex)
 
         m_nodes[n].x += dx * factor;
         m_nodes[n].y += dy * factor;
+
+        if (factor != 0.0)
+        {
+            RegisterModifiedNode(n);
+            UpdateNodeInRTree(n);
+            isNodeMoved[n] = true;
+        }
     }
 
-    m_nodesRTreeRequiresUpdate = true;
-    m_edgesRTreeRequiresUpdate = true;
+    // the centers of the edges connected to the moved nodes changed
+    for (int e = 0; e < GetNumEdges(); ++e)
+    {
+        const auto& edge = m_edges[e];
+        if (edge.first >= 0 && edge.second >= 0 && (isNodeMoved[edge.first] || isNodeMoved[edge.second]))
+        {
+            UpdateEdgeInRTree(e);
+        }
+    }
 }
 
 meshkernel::Mesh& meshkernel::Mesh::operator+=(Mesh const& rhs)
@@ -1915,6 +3071,16 @@ meshkernel::Point meshkernel::Mesh::ComputeFaceCircumenter(std::vector<Point>& p
         }
     }
 
+    return KeepCircumcenterInFace(polygon, numNodes, centerOfMass, result, weightCircumCenter);
+}
+
+meshkernel::Point meshkernel::Mesh::KeepCircumcenterInFace(std::vector<Point>& polygon,
+                                                           int numNodes,
+                                                           const Point& centerOfMass,
+                                                           const Point& circumcenter,
+                                                           double weightCircumCenter) const
+{
+    Point result = circumcenter;
     if (weightCircumCenter <= 1.0 && weightCircumCenter >= 0.0)
     {
         double localWeightCircumCenter = 1.0;
@@ -2172,6 +3338,7 @@ void meshkernel::Mesh::ComputeNodeNeighbours()
             m_nodesNodes[n][nn] = edge.first + edge.second - n;
         }
     }
+    m_nodesNodesCsr.Build(m_nodesNodes, m_nodesNumEdges, GetNumNodes());
 }
 
 void meshkernel::Mesh::GetOrthogonality(double* orthogonality)
@@ -2226,21 +3393,36 @@ void meshkernel::Mesh::GetSmoothness(double* smoothness)
 
 void meshkernel::Mesh::GetAspectRatios(std::vector<double>& aspectRatios)
 {
-    std::vector<std::vector<double>> averageEdgesLength(GetNumEdges(), std::vector<double>(2, doubleMissingValue));
-    std::vector<double> averageFlowEdgesLength(GetNumEdges(), doubleMissingValue);
-    std::vector<bool> curvilinearGridIndicator(GetNumNodes(), true);
-    std::vector<double> edgesLength(GetNumEdges(), 0.0);
-    aspectRatios.resize(GetNumEdges(), 0.0);
-
-    for (auto e = 0; e < GetNumEdges(); e++)
+    const auto numEdges = GetNumEdges();
+    std::vector<std::array<double, 2>> averageEdgesLength(numEdges, {doubleMissingValue, doubleMissingValue});
+    std::vector<double> averageFlowEdgesLength(numEdges, doubleMissingValue);
+    aspectRatios.resize(numEdges, 0.0);
+
+    // edge lengths and flow edge lengths are computed in batches, the centers are stored in structures of arrays
+    std::vector<double> edgesLength;
+    PointsArrays firstNodes;
+    PointsArrays secondNodes;
+    GatherEdgesNodes(GetNumEdges(), m_nodes, m_edges, firstNodes, secondNodes);
+    ComputeDistances(firstNodes, secondNodes, m_projection, edgesLength);
+
+    PointsArrays leftCenters;
+    PointsArrays rightCenters;
+    leftCenters.Resize(GetNumEdges());
+    rightCenters.Resize(GetNumEdges());
+    std::vector<char> isFlowEdge(numEdges, false);
+#pragma omp parallel for
+    for (int e = 0; e < numEdges; e++)
     {
         auto first = m_edges[e].first;
         auto second = m_edges[e].second;
 
         if (first == second)
+        {
+            edgesLength[e] = 0.0;
             continue;
-        double edgeLength = ComputeDistance(m_nodes[first], m_nodes[second], m_projection);
-        edgesLength[e] = edgeLength;
+        }
+        double edgeLength = edgesLength[e];
+        isFlowEdge[e] = true;
 
         Point leftCenter;
         Point rightCenter;
@@ -2270,50 +3452,67 @@ void meshkernel::Mesh::GetAspectRatios(std::vector<double>& aspectRatios)
             rightCenter.y = 2.0 * y0_bc - leftCenter.y;
         }
 
-        averageFlowEdgesLength[e] = ComputeDistance(leftCenter, rightCenter, m_projection);
+        leftCenters.Set(e, leftCenter);
+        rightCenters.Set(e, rightCenter);
     }
 
-    // Compute normal length
-    for (int f = 0; f < GetNumFaces(); f++)
+    std::vector<double> flowEdgesLength;
+    ComputeDistances(leftCenters, rightCenters, m_projection, flowEdgesLength);
+
+    // Compute normal length, each edge gathers the lengths of its faces in increasing face order
+#pragma omp parallel for
+    for (int e = 0; e < numEdges; e++)
     {
-        auto numberOfFaceNodes = GetNumFaceEdges(f);
-        if (numberOfFaceNodes < 3)
+        if (isFlowEdge[e])
+        {
+            averageFlowEdgesLength[e] = flowEdgesLength[e];
+        }
+
+        const auto numEdgeFaces = m_edgesNumFaces[e];
+        if (numEdgeFaces < 1)
+        {
             continue;
+        }
 
-        for (int n = 0; n < numberOfFaceNodes; n++)
+        std::array<int, 2> edgeFaces{m_edgesFaces[e][0], numEdgeFaces > 1 ? m_edgesFaces[e][1] : m_edgesFaces[e][0]};
+        if (edgeFaces[1] < edgeFaces[0])
         {
-            if (numberOfFaceNodes != 4)
-                curvilinearGridIndicator[m_facesNodes[f][n]] = false;
-            auto edgeIndex = m_facesEdges[f][n];
+            std::swap(edgeFaces[0], edgeFaces[1]);
+        }
 
-            if (m_edgesNumFaces[edgeIndex] < 1)
-            {
+        for (int i = 0; i < std::min(numEdgeFaces, 2); i++)
+        {
+            const auto f = edgeFaces[i];
+            const auto numberOfFaceNodes = GetNumFaceEdges(f);
+            if (numberOfFaceNodes < 3)
                 continue;
-            }
 
-            double edgeLength = edgesLength[edgeIndex];
+            double edgeLength = edgesLength[e];
             if (edgeLength != 0.0)
             {
-                aspectRatios[edgeIndex] = averageFlowEdgesLength[edgeIndex] / edgeLength;
+                aspectRatios[e] = averageFlowEdgesLength[e] / edgeLength;
             }
 
             //quads
-            if (numberOfFaceNodes == 4)
+            for (int n = 0; n < numberOfFaceNodes && numberOfFaceNodes == 4; n++)
             {
+                if (m_facesEdges[f][n] != e)
+                    continue;
                 int kkp2 = n + 2;
                 if (kkp2 >= numberOfFaceNodes)
                     kkp2 = kkp2 - numberOfFaceNodes;
                 auto klinkp2 = m_facesEdges[f][kkp2];
-                edgeLength = 0.5 * (edgesLength[edgeIndex] + edgesLength[klinkp2]);
+                edgeLength = 0.5 * (edgesLength[e] + edgesLength[klinkp2]);
+                break;
             }
 
-            if (IsEqual(averageEdgesLength[edgeIndex][0], doubleMissingValue))
+            if (IsEqual(averageEdgesLength[e][0], doubleMissingValue))
             {
-                averageEdgesLength[edgeIndex][0] = edgeLength;
+                averageEdgesLength[e][0] = edgeLength;
             }
             else
             {
-                averageEdgesLength[edgeIndex][1] = edgeLength;
+                averageEdgesLength[e][1] = edgeLength;
             }
         }
     }
@@ -2321,7 +3520,27 @@ void meshkernel::Mesh::GetAspectRatios(std::vector<double>& aspectRatios)
     if (curvilinearToOrthogonalRatio == 1.0)
         return;
 
-    for (auto e = 0; e < GetNumEdges(); e++)
+    // the nodes of non-quadrilateral faces are not curvilinear
+    std::vector<char> curvilinearGridIndicator(GetNumNodes(), true);
+#pragma omp parallel for
+    for (int n = 0; n < GetNumNodes(); n++)
+    {
+        for (int e = 0; e < m_nodesNumEdges[n] && curvilinearGridIndicator[n]; e++)
+        {
+            const auto edgeIndex = m_nodesEdges[n][e];
+            for (int i = 0; i < m_edgesNumFaces[edgeIndex]; i++)
+            {
+                const auto numberOfFaceNodes = GetNumFaceEdges(m_edgesFaces[edgeIndex][i]);
+                if (numberOfFaceNodes >= 3 && numberOfFaceNodes != 4)
+                {
+                    curvilinearGridIndicator[n] = false;
+                }
+            }
+        }
+    }
+
+#pragma omp parallel for
+    for (int e = 0; e < numEdges; e++)
     {
         auto first = m_edges[e].first;
         auto second = m_edges[e].second;
@@ -2375,11 +3594,9 @@ void meshkernel::Mesh::TriangulateFaces()
             ConnectNodes(indexFirstNode, nodeIndex, newEdgeIndex);
         }
     }
-
-    m_edgesRTreeRequiresUpdate = true;
 }
 
-bool meshkernel::Mesh::MakeDualFace(int node, double enlargmentFactor, std::vector<Point>& dualFace)
+bool meshkernel::Mesh::MakeDualFace(int node, double enlargmentFactor, std::vector<Point>& dualFace) const
 {
     const auto sortedFacesIndices = SortedFacesAroundNode(node);
     const auto numEdges = m_nodesNumEdges[node];
@@ -28,6 +28,7 @@
 #include <map>
 #include <stdexcept>
 #include <vector>
+#include <utility>
 
 #include <MeshKernel/MeshKernel.hpp>
 #include <MeshKernel/Constants.hpp>
@@ -49,6 +50,7 @@
 #include <MeshKernel/Splines.hpp>
 #include <MeshKernel/SplinesToCurvilinearParametersNative.hpp>
 #include <MeshKernel/TriangulationInterpolation.hpp>
+#include <MeshKernel/UGridFile.hpp>
 #include <MeshKernel/AveragingInterpolation.hpp>
 
 namespace meshkernelapi
@@ -250,18 +252,59 @@ namespace meshkernelapi
                 throw std::invalid_argument("MeshKernel: The selected mesh does not exist.");
             }
 
-            const auto edges = meshkernel::ConvertToEdgeNodesVector(meshGeometryDimensions.numedge, meshGeometry.edge_nodes);
-            const auto nodes = meshkernel::ConvertToNodesVector(meshGeometryDimensions.numnode, meshGeometry.nodex, meshGeometry.nodey);
+            // the caller arrays are copied once into the converted vectors, which are then moved into the mesh
+            auto edges = meshkernel::ConvertToEdgeNodesVector(meshGeometryDimensions.numedge, meshGeometry.edge_nodes);
+            auto nodes = meshkernel::ConvertToNodesVector(meshGeometryDimensions.numnode, meshGeometry.nodex, meshGeometry.nodey);
 
             // spherical or cartesian
             if (isGeographic)
             {
-                meshInstances[meshKernelId]->Set(edges, nodes, meshkernel::Projections::spherical);
+                meshInstances[meshKernelId]->Set(std::move(edges), std::move(nodes), meshkernel::Projections::spherical);
             }
             else
             {
-                meshInstances[meshKernelId]->Set(edges, nodes, meshkernel::Projections::cartesian);
+                meshInstances[meshKernelId]->Set(std::move(edges), std::move(nodes), meshkernel::Projections::cartesian);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            strcpy_s(exceptionMessage, sizeof exceptionMessage, e.what());
+            exitCode |= Exception;
+        }
+        return exitCode;
+    }
+
+    MKERNEL_API int mkernel_read_state(int meshKernelId, const char* filePath)
+    {
+        int exitCode = Success;
+        try
+        {
+            if (meshKernelId >= meshInstances.size())
+            {
+                throw std::invalid_argument("MeshKernel: The selected mesh does not exist.");
             }
+
+            meshkernel::ReadUGridMesh(filePath, *meshInstances[meshKernelId]);
+        }
+        catch (const std::exception& e)
+        {
+            strcpy_s(exceptionMessage, sizeof exceptionMessage, e.what());
+            exitCode |= Exception;
+        }
+        return exitCode;
+    }
+
+    MKERNEL_API int mkernel_write_state(int meshKernelId, const char* filePath)
+    {
+        int exitCode = Success;
+        try
+        {
+            if (meshKernelId >= meshInstances.size())
+            {
+                throw std::invalid_argument("MeshKernel: The selected mesh does not exist.");
+            }
+
+            meshkernel::WriteUGridMesh(filePath, *meshInstances[meshKernelId]);
         }
         catch (const std::exception& e)
         {
@@ -321,8 +364,54 @@ namespace meshkernelapi
                                           const OrthogonalizationParametersNative& orthogonalizationParametersNative,
                                           const GeometryListNative& geometryListNativePolygon,
                                           const GeometryListNative& geometryListNativeLandBoundaries)
+    {
+        OrthogonalizationResultsNative orthogonalizationResultsNative{};
+        return mkernel_orthogonalize_with_tolerance(meshKernelId,
+                                                    isTriangulationRequired,
+                                                    isAccountingForLandBoundariesRequired,
+                                                    projectToLandBoundaryOption,
+                                                    orthogonalizationParametersNative,
+                                                    0.0,
+                                                    geometryListNativePolygon,
+                                                    geometryListNativeLandBoundaries,
+                                                    orthogonalizationResultsNative);
+    }
+
+    MKERNEL_API int mkernel_orthogonalize_with_tolerance(int meshKernelId,
+                                                         int isTriangulationRequired,
+                                                         int isAccountingForLandBoundariesRequired,
+                                                         int projectToLandBoundaryOption,
+                                                         const OrthogonalizationParametersNative& orthogonalizationParametersNative,
+                                                         double convergenceTolerance,
+                                                         const GeometryListNative& geometryListNativePolygon,
+                                                         const GeometryListNative& geometryListNativeLandBoundaries,
+                                                         OrthogonalizationResultsNative& orthogonalizationResultsNative)
+    {
+        return mkernel_orthogonalize_with_linear_solver(meshKernelId,
+                                                        isTriangulationRequired,
+                                                        isAccountingForLandBoundariesRequired,
+                                                        projectToLandBoundaryOption,
+                                                        orthogonalizationParametersNative,
+                                                        convergenceTolerance,
+                                                        static_cast<int>(meshkernel::OrthogonalizationAndSmoothing::LinearSolver::Jacobi),
+                                                        geometryListNativePolygon,
+                                                        geometryListNativeLandBoundaries,
+                                                        orthogonalizationResultsNative);
+    }
+
+    MKERNEL_API int mkernel_orthogonalize_with_linear_solver(int meshKernelId,
+                                                             int isTriangulationRequired,
+                                                             int isAccountingForLandBoundariesRequired,
+                                                             int projectToLandBoundaryOption,
+                                                             const OrthogonalizationParametersNative& orthogonalizationParametersNative,
+                                                             double convergenceTolerance,
+                                                             int linearSolver,
+                                                             const GeometryListNative& geometryListNativePolygon,
+                                                             const GeometryListNative& geometryListNativeLandBoundaries,
+                                                             OrthogonalizationResultsNative& orthogonalizationResultsNative)
     {
         int exitCode = Success;
+        orthogonalizationResultsNative = OrthogonalizationResultsNative{};
         try
         {
             if (meshKernelId >= meshInstances.size())
@@ -363,8 +452,20 @@ namespace meshkernelapi
                                                                        landBoundary,
                                                                        projectToLandBoundaryOption,
                                                                        orthogonalizationParametersNative);
+            if (linearSolver != static_cast<int>(meshkernel::OrthogonalizationAndSmoothing::LinearSolver::Jacobi) &&
+                linearSolver != static_cast<int>(meshkernel::OrthogonalizationAndSmoothing::LinearSolver::BiCGStab))
+            {
+                throw std::invalid_argument("MeshKernel: Invalid linear solver.");
+            }
+            ortogonalization.SetConvergenceTolerance(convergenceTolerance);
+            ortogonalization.SetLinearSolver(static_cast<meshkernel::OrthogonalizationAndSmoothing::LinearSolver>(linearSolver));
             ortogonalization.Initialize();
             ortogonalization.Compute();
+
+            orthogonalizationResultsNative.InnerIterations = ortogonalization.GetNumInnerIterations();
+            orthogonalizationResultsNative.MaximumDisplacement = ortogonalization.GetMaximumDisplacement();
+            orthogonalizationResultsNative.RootMeanSquareDisplacement = ortogonalization.GetRootMeanSquareDisplacement();
+            orthogonalizationResultsNative.Converged = ortogonalization.IsConverged() ? 1 : 0;
         }
         catch (const std::exception& e)
         {
@@ -435,6 +536,39 @@ namespace meshkernelapi
         return exitCode;
     }
 
+    MKERNEL_API int mkernel_orthogonalize_set_adaptation_samples(int meshKernelId, const GeometryListNative& geometryListNativeSamples)
+    {
+        int exitCode = Success;
+        try
+        {
+            if (meshKernelId >= meshInstances.size())
+            {
+                throw std::invalid_argument("MeshKernel: The selected mesh does not exist.");
+            }
+
+            if (meshInstances[meshKernelId]->GetNumNodes() <= 0)
+            {
+                return exitCode;
+            }
+
+            const auto orthogonalization = orthogonalizationInstances.find(meshKernelId);
+            if (orthogonalization == orthogonalizationInstances.end())
+            {
+                throw std::invalid_argument("MeshKernel: The orthogonalization is not initialized.");
+            }
+
+            std::vector<meshkernel::Sample> samples;
+            ConvertGeometryListNativeToSampleVector(geometryListNativeSamples, samples);
+            orthogonalization->second->SetAdaptationSamples(samples);
+        }
+        catch (const std::exception& e)
+        {
+            strcpy_s(exceptionMessage, sizeof exceptionMessage, e.what());
+            exitCode |= Exception;
+        }
+        return exitCode;
+    }
+
     MKERNEL_API int mkernel_orthogonalize_prepare_outer_iteration(int meshKernelId)
     {
         int exitCode = Success;
@@ -510,6 +644,41 @@ namespace meshkernelapi
         return exitCode;
     }
 
+    MKERNEL_API int mkernel_orthogonalize_get_results(int meshKernelId, OrthogonalizationResultsNative& orthogonalizationResultsNative)
+    {
+        int exitCode = Success;
+        orthogonalizationResultsNative = OrthogonalizationResultsNative{};
+        try
+        {
+            if (meshKernelId < 0 || meshKernelId >= static_cast<int>(meshInstances.size()))
+            {
+                throw std::invalid_argument("MeshKernel: The selected mesh does not exist.");
+            }
+
+            if (meshInstances[meshKernelId]->GetNumNodes() <= 0)
+            {
+                return exitCode;
+            }
+
+            const auto orthogonalization = orthogonalizationInstances.find(meshKernelId);
+            if (orthogonalization == orthogonalizationInstances.end())
+            {
+                throw std::invalid_argument("MeshKernel: The orthogonalization is not initialized.");
+            }
+
+            orthogonalizationResultsNative.InnerIterations = orthogonalization->second->GetNumInnerIterations();
+            orthogonalizationResultsNative.MaximumDisplacement = orthogonalization->second->GetMaximumDisplacement();
+            orthogonalizationResultsNative.RootMeanSquareDisplacement = orthogonalization->second->GetRootMeanSquareDisplacement();
+            orthogonalizationResultsNative.Converged = orthogonalization->second->IsConverged() ? 1 : 0;
+        }
+        catch (const std::exception& e)
+        {
+            strcpy_s(exceptionMessage, sizeof exceptionMessage, e.what());
+            exitCode |= Exception;
+        }
+        return exitCode;
+    }
+
     MKERNEL_API int mkernel_orthogonalize_delete(int meshKernelId)
     {
         int exitCode = Success;
@@ -707,6 +876,11 @@ namespace meshkernelapi
     }
 
     MKERNEL_API int mkernel_make_mesh_from_samples(int meshKernelId, GeometryListNative& geometryListNative)
+    {
+        return mkernel_make_mesh_from_samples_parallel(meshKernelId, geometryListNative, false);
+    }
+
+    MKERNEL_API int mkernel_make_mesh_from_samples_parallel(int meshKernelId, GeometryListNative& geometryListNative, bool parallel)
     {
         int exitCode = Success;
         try
@@ -719,7 +893,7 @@ namespace meshkernelapi
             ConvertGeometryListNativeToPointVector(geometryListNative, samplePoints);
 
             meshkernel::Polygons polygon;
-            meshkernel::Mesh mesh(samplePoints, polygon, meshInstances[meshKernelId]->m_projection);
+            meshkernel::Mesh mesh(samplePoints, polygon, meshInstances[meshKernelId]->m_projection, parallel);
             *meshInstances[meshKernelId] += mesh;
         }
         catch (const std::exception& e)
@@ -1742,6 +1916,7 @@ namespace meshkernelapi
                                                          relativeSearchSize,
                                                          false,
                                                          false);
+            averaging.SetParallel(true);
             averaging.Compute();
 
             // Get the results and copy them to the result vector
@@ -151,7 +151,7 @@ void meshkernel::MeshRefinement::Refine(const Polygons& polygon,
                 bool activeNodeFound = false;
                 for (int n = 0; n < m_mesh->GetNumFaceEdges(f); ++n)
                 {
-                    const auto nodeIndex = m_mesh->m_facesNodes[f][n];
+                    const auto nodeIndex = m_mesh->m_facesNodesCsr(f, n);
                     if (m_mesh->m_nodeMask[nodeIndex] != 0 && m_mesh->m_nodeMask[nodeIndex] != -2)
                     {
                         activeNodeFound = true;
@@ -171,7 +171,7 @@ void meshkernel::MeshRefinement::Refine(const Polygons& polygon,
             {
                 for (int n = 0; n < m_mesh->GetNumFaceEdges(f); n++)
                 {
-                    const auto nodeIndex = m_mesh->m_facesNodes[f][n];
+                    const auto nodeIndex = m_mesh->m_facesNodesCsr(f, n);
                     if (m_mesh->m_nodeMask[nodeIndex] != 1)
                     {
                         m_faceMask[f] = 0;
@@ -275,6 +275,7 @@ int meshkernel::MeshRefinement::RemoveIsolatedHangingnodes()
                 {
                     throw AlgorithmError("MeshRefinement::RemoveIsolatedHangingnodes: Algorithm error.");
                 }
+                m_mesh->CopyFaceToCompressedRows(faceIndex);
             }
 
             const auto otherNodeIndex = m_mesh->m_edges[brotherEdgeIndex].first + m_mesh->m_edges[brotherEdgeIndex].second - commonNode;
@@ -288,6 +289,10 @@ int meshkernel::MeshRefinement::RemoveIsolatedHangingnodes()
             {
                 m_mesh->m_edges[e].second = otherNodeIndex;
             }
+            m_mesh->RegisterModifiedEdge(e);
+            m_mesh->RegisterModifiedEdge(brotherEdgeIndex);
+            m_mesh->RegisterModifiedNode(commonNode);
+            m_mesh->RegisterModifiedNode(otherNodeIndex);
 
             //change nod adm of other node
             for (int ee = 0; ee < m_mesh->m_nodesNumEdges[otherNodeIndex]; ++ee)
@@ -298,6 +303,7 @@ int meshkernel::MeshRefinement::RemoveIsolatedHangingnodes()
                     break;
                 }
             }
+            m_mesh->CopyNodeEdgesToCompressedRow(otherNodeIndex);
 
             //delete node
             m_mesh->DeleteNode(commonNode);
@@ -552,7 +558,7 @@ void meshkernel::MeshRefinement::RefineFacesBySplittingEdges(int numEdgesBeforeR
         bool isParentCrossed = false;
         for (int e = 0; e < numEdges; ++e)
         {
-            const auto n = m_mesh->m_facesNodes[f][e];
+            const auto n = m_mesh->m_facesNodesCsr(f, e);
             if (m_mesh->m_nodeMask[n] != 1)
             {
                 isParentCrossed = true;
@@ -574,13 +580,13 @@ void meshkernel::MeshRefinement::RefineFacesBySplittingEdges(int numEdgesBeforeR
             const auto secondEdge = NextCircularForwardIndex(e, numEdges);
 
             int mappedEdge = m_localNodeIndicesCache[e];
-            auto edgeIndex = m_mesh->m_facesEdges[f][mappedEdge];
+            auto edgeIndex = m_mesh->m_facesEdgesCsr(f, mappedEdge);
 
             mappedEdge = m_localNodeIndicesCache[firstEdge];
-            auto firstEdgeIndex = m_mesh->m_facesEdges[f][mappedEdge];
+            auto firstEdgeIndex = m_mesh->m_facesEdgesCsr(f, mappedEdge);
 
             mappedEdge = m_localNodeIndicesCache[secondEdge];
-            auto secondEdgeIndex = m_mesh->m_facesEdges[f][mappedEdge];
+            auto secondEdgeIndex = m_mesh->m_facesEdgesCsr(f, mappedEdge);
 
             if (edgeIndex < 0)
             {
@@ -718,6 +724,7 @@ void meshkernel::MeshRefinement::RefineFacesBySplittingEdges(int numEdgesBeforeR
             int newEdgeIndex;
             m_mesh->ConnectNodes(m_edgeMask[e], m_mesh->m_edges[e].second, newEdgeIndex);
             m_mesh->m_edges[e].second = m_edgeMask[e];
+            m_mesh->RegisterModifiedEdge(e);
             ResizeVectorIfNeeded(m_mesh->GetNumEdges(), m_brotherEdges);
             m_brotherEdges[newEdgeIndex] = e;
             m_brotherEdges[e] = newEdgeIndex;
@@ -733,7 +740,7 @@ void meshkernel::MeshRefinement::ComputeNodeMaskAtPolygonPerimeter()
         const auto numnodes = m_mesh->GetNumFaceEdges(f);
         for (int n = 0; n < numnodes; n++)
         {
-            int nodeIndex = m_mesh->m_facesNodes[f][n];
+            int nodeIndex = m_mesh->m_facesNodesCsr(f, n);
 
             if (m_mesh->m_nodeMask[nodeIndex] == 0)
             {
@@ -747,7 +754,7 @@ void meshkernel::MeshRefinement::ComputeNodeMaskAtPolygonPerimeter()
             m_faceMask[f] = 0;
             for (int n = 0; n < numnodes; n++)
             {
-                int nodeIndex = m_mesh->m_facesNodes[f][n];
+                int nodeIndex = m_mesh->m_facesNodesCsr(f, n);
                 if (m_mesh->m_nodeMask[nodeIndex] == 1)
                 {
                     m_mesh->m_nodeMask[nodeIndex] = -2;
@@ -797,7 +804,7 @@ void meshkernel::MeshRefinement::ComputeRefinementMasksFromSamples()
                     {
                         continue;
                     }
-                    int edgeIndex = m_mesh->m_facesEdges[f][node];
+                    int edgeIndex = m_mesh->m_facesEdgesCsr(f, node);
                     if (edgeIndex >= 0)
                     {
                         m_edgeMask[edgeIndex] = 1;
@@ -833,7 +840,7 @@ void meshkernel::MeshRefinement::FindHangingNodes(int face,
 
     for (int n = 0; n < numFaceNodes; n++)
     {
-        auto edgeIndex = m_mesh->m_facesEdges[face][n];
+        auto edgeIndex = m_mesh->m_facesEdgesCsr(face, n);
         if (m_edgeMask[edgeIndex] != 0)
         {
             numEdgesToRefine += 1;
@@ -844,8 +851,8 @@ void meshkernel::MeshRefinement::FindHangingNodes(int face,
         {
             const auto e = NextCircularBackwardIndex(n, numFaceNodes);
             const auto ee = NextCircularForwardIndex(n, numFaceNodes);
-            const auto firstEdgeIndex = m_mesh->m_facesEdges[face][e];
-            const auto secondEdgeIndex = m_mesh->m_facesEdges[face][ee];
+            const auto firstEdgeIndex = m_mesh->m_facesEdgesCsr(face, e);
+            const auto secondEdgeIndex = m_mesh->m_facesEdgesCsr(face, ee);
 
             int commonNode = intMissingValue;
             if (m_brotherEdges[edgeIndex] == firstEdgeIndex)
@@ -873,7 +880,7 @@ void meshkernel::MeshRefinement::FindHangingNodes(int face,
                 {
                     kknod = NextCircularForwardIndex(kknod, numFaceNodes);
 
-                    if (m_mesh->m_facesNodes[face][kknod] == commonNode && !m_isHangingNodeCache[kknod])
+                    if (m_mesh->m_facesNodesCsr(face, kknod) == commonNode && !m_isHangingNodeCache[kknod])
                     {
                         numHangingNodes++;
                         m_isHangingNodeCache[kknod] = true;
@@ -1009,10 +1016,10 @@ void meshkernel::MeshRefinement::ComputeEdgesRefinementMask()
                     const auto e = NextCircularBackwardIndex(n, numFaceNodes);
                     const auto ee = NextCircularForwardIndex(n, numFaceNodes);
 
-                    auto edgeIndex = m_mesh->m_facesEdges[f][n];
+                    auto edgeIndex = m_mesh->m_facesEdgesCsr(f, n);
 
-                    auto firstEdgeIndex = m_mesh->m_facesEdges[f][e];
-                    auto secondEdgeIndex = m_mesh->m_facesEdges[f][ee];
+                    auto firstEdgeIndex = m_mesh->m_facesEdgesCsr(f, e);
+                    auto secondEdgeIndex = m_mesh->m_facesEdgesCsr(f, ee);
 
                     //do not refine edges with an hanging node
                     if (m_brotherEdges[edgeIndex] != firstEdgeIndex && m_brotherEdges[edgeIndex] != secondEdgeIndex)
@@ -1027,7 +1034,7 @@ void meshkernel::MeshRefinement::ComputeEdgesRefinementMask()
                 int num = 0;
                 for (int n = 0; n < numFaceNodes; n++)
                 {
-                    auto edgeIndex = m_mesh->m_facesEdges[f][n];
+                    auto edgeIndex = m_mesh->m_facesEdgesCsr(f, n);
                     numOfEdges[n] = num;
 
                     if (m_edgeMask[edgeIndex] != 0)
@@ -1037,7 +1044,7 @@ void meshkernel::MeshRefinement::ComputeEdgesRefinementMask()
 
                     const auto ee = NextCircularForwardIndex(n, numFaceNodes);
 
-                    const auto secondEdgeIndex = m_mesh->m_facesEdges[f][ee];
+                    const auto secondEdgeIndex = m_mesh->m_facesEdgesCsr(f, ee);
 
                     if (n != numFaceNodes - 1 && m_brotherEdges[edgeIndex] != secondEdgeIndex)
                     {
@@ -1084,7 +1091,7 @@ void meshkernel::MeshRefinement::ComputeEdgesRefinementMask()
                 for (int n = 0; n < numFaceNodes; n++)
                 {
 
-                    auto edgeIndex = m_mesh->m_facesEdges[f][n];
+                    auto edgeIndex = m_mesh->m_facesEdgesCsr(f, n);
                     if (m_edgeMask[edgeIndex] > 0)
                     {
                         continue;
@@ -1160,7 +1167,7 @@ void meshkernel::MeshRefinement::ComputeIfFaceShouldBeSplit()
 
             for (int n = 0; n < numFaceNodes; n++)
             {
-                int edgeIndex = m_mesh->m_facesEdges[f][n];
+                int edgeIndex = m_mesh->m_facesEdgesCsr(f, n);
                 if (m_isHangingEdgeCache[n] && m_edgeMask[edgeIndex] > 0)
                 {
                     isSplittingRequired = true;
@@ -1195,7 +1202,7 @@ void meshkernel::MeshRefinement::ComputeIfFaceShouldBeSplit()
 
                 for (int n = 0; n < numFaceNodes; n++)
                 {
-                    int edgeIndex = m_mesh->m_facesEdges[f][n];
+                    int edgeIndex = m_mesh->m_facesEdgesCsr(f, n);
                     if (!m_isHangingEdgeCache[n] && m_edgeMask[edgeIndex] == 0)
                     {
                         m_edgeMask[edgeIndex] = 1;
@@ -1222,14 +1229,14 @@ void meshkernel::MeshRefinement::FindBrotherEdges()
         for (int e = 0; e < numEdgesNodes; e++)
         {
 
-            const auto firstEdgeIndex = m_mesh->m_nodesEdges[n][e];
+            const auto firstEdgeIndex = m_mesh->m_nodesEdgesCsr(n, e);
             if (m_mesh->GetNumEdgesFaces(firstEdgeIndex) < 1)
             {
                 continue;
             }
 
             const auto ee = NextCircularForwardIndex(e, numEdgesNodes);
-            const auto secondEdgeIndex = m_mesh->m_nodesEdges[n][ee];
+            const auto secondEdgeIndex = m_mesh->m_nodesEdgesCsr(n, ee);
             if (m_mesh->GetNumEdgesFaces(secondEdgeIndex) < 1)
             {
                 continue;
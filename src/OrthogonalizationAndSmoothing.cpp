@@ -74,10 +74,16 @@ void meshkernel::OrthogonalizationAndSmoothing::Initialize()
     // TODO: calculate volume weights for areal smoother
     m_mumax = (1.0 - m_orthogonalizationParametersNative.Smoothorarea) * 0.5;
     m_mu = std::min(1e-2, m_mumax);
+    m_numInnerIterations = 0;
+    m_maximumDisplacement = 0.0;
+    m_rootMeanSquareDisplacement = 0.0;
     m_orthogonalCoordinates.resize(m_mesh->GetNumNodes());
 
     // back-up original nodes, for projection on original mesh boundary
     m_originalNodes = m_mesh->m_nodes;
+
+    // the smoother adapts the mesh to the samples averaged on the original nodes
+    m_smoother->ComputeAdaptationNodeValues();
     m_orthogonalCoordinates = m_mesh->m_nodes;
 
     // project on land boundary
@@ -106,25 +112,44 @@ void meshkernel::OrthogonalizationAndSmoothing::Initialize()
     }
 }
 
+void meshkernel::OrthogonalizationAndSmoothing::SetAdaptationSamples(const std::vector<Sample>& samples)
+{
+    m_smoother->SetAdaptationSamples(samples, m_orthogonalizationParametersNative.AdaptBeta);
+}
+
 void meshkernel::OrthogonalizationAndSmoothing::Compute()
 {
     for (auto outerIter = 0; outerIter < m_orthogonalizationParametersNative.OuterIterations; outerIter++)
     {
         PrepareOuterIteration();
-        for (auto boundaryIter = 0; boundaryIter < m_orthogonalizationParametersNative.BoundaryIterations; boundaryIter++)
+        int numInnerIterations = 0;
+        bool isConverged = false;
+        for (auto boundaryIter = 0; boundaryIter < m_orthogonalizationParametersNative.BoundaryIterations && !isConverged; boundaryIter++)
         {
-            for (auto innerIter = 0; innerIter < m_orthogonalizationParametersNative.InnerIterations; innerIter++)
+            for (auto innerIter = 0; innerIter < m_orthogonalizationParametersNative.InnerIterations && !isConverged; innerIter++)
             {
                 InnerIteration();
-
+                numInnerIterations++;
+                isConverged = IsConverged();
             } // inner iteration
         }     // boundary iter
 
         //update mu
         FinalizeOuterIteration();
+
+        // the nodes did not move with the new weights, further outer iterations are not needed
+        if (isConverged && numInnerIterations == 1)
+        {
+            break;
+        }
     } // outer iter
 }
 
+bool meshkernel::OrthogonalizationAndSmoothing::IsConverged() const
+{
+    return m_convergenceTolerance > 0.0 && m_numInnerIterations > 0 && m_maximumDisplacement <= m_convergenceTolerance;
+}
+
 void meshkernel::OrthogonalizationAndSmoothing::PrepareOuterIteration()
 {
     // compute weights and rhs of orthogonalizer
@@ -138,6 +163,12 @@ void meshkernel::OrthogonalizationAndSmoothing::PrepareOuterIteration()
 
     // compute linear system terms for smoother and orthogonalizer
     ComputeLinearSystemTerms();
+
+    // the BiCGStab system keeps the weights of the outer iteration
+    if (IsLinearSystemSolved())
+    {
+        AssembleLinearSystem();
+    }
 }
 
 void meshkernel::OrthogonalizationAndSmoothing::AllocateLinearSystem()
@@ -154,7 +185,10 @@ void meshkernel::OrthogonalizationAndSmoothing::AllocateLinearSystem()
         m_compressedStartNodeIndex.resize(m_mesh->GetNumNodes());
         std::fill(m_compressedStartNodeIndex.begin(), m_compressedStartNodeIndex.end(), 0.0);
 
-        for (int n = 0; n < m_mesh->GetNumNodes(); n++)
+        // the nodes are swept along a space-filling curve, their linear system rows are stored in the same order
+        m_nodesOrder = SortPointsAlongHilbertCurve(m_mesh->m_nodes);
+        m_nodesOrder.resize(m_mesh->GetNumNodes());
+        for (const auto& n : m_nodesOrder)
         {
             m_compressedEndNodeIndex[n] = m_nodeCacheSize;
             m_nodeCacheSize += std::max(m_mesh->m_nodesNumEdges[n] + 1, m_smoother->GetNumConnectedNodes(n));
@@ -214,7 +248,7 @@ void meshkernel::OrthogonalizationAndSmoothing::ComputeLinearSystemTerms()
             {
                 wwx += atpfLoc * m_orthogonalizer->GetWeight(n, nn - 1);
                 wwy += atpfLoc * m_orthogonalizer->GetWeight(n, nn - 1);
-                m_compressedNodesNodes[cacheIndex] = m_mesh->m_nodesNodes[n][nn - 1];
+                m_compressedNodesNodes[cacheIndex] = m_mesh->m_nodesNodesCsr(n, nn - 1);
             }
             else
             {
@@ -233,14 +267,23 @@ void meshkernel::OrthogonalizationAndSmoothing::ComputeLinearSystemTerms()
 
 void meshkernel::OrthogonalizationAndSmoothing::InnerIteration()
 {
-#pragma omp parallel for
-    for (int n = 0; n < m_mesh->GetNumNodes(); n++)
+    if (IsLinearSystemSolved())
     {
-        UpdateNodeCoordinates(n);
+        SolveLinearSystem();
+    }
+    else
+    {
+        const auto numNodes = static_cast<int>(m_nodesOrder.size());
+#pragma omp parallel for
+        for (int i = 0; i < numNodes; i++)
+        {
+            UpdateNodeCoordinates(m_nodesOrder[i]);
+        }
     }
 
-    // update mesh node coordinates
-    m_mesh->m_nodes = m_orthogonalCoordinates;
+    // update mesh node coordinates by swapping the buffers, the face geometry is no longer valid
+    std::swap(m_mesh->m_nodes, m_orthogonalCoordinates);
+    m_mesh->InvalidateAdministration();
 
     // project on the original net boundary
     ProjectOnOriginalMeshBoundary();
@@ -254,19 +297,196 @@ void meshkernel::OrthogonalizationAndSmoothing::InnerIteration()
     {
         m_landBoundaries->SnapMeshToLandBoundaries();
     }
+
+    ComputeNodeDisplacements();
 }
 
-void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
+void meshkernel::OrthogonalizationAndSmoothing::ComputeNodeDisplacements()
 {
-    Point normalSecondPoint{doubleMissingValue, doubleMissingValue};
-    Point normalThirdPoint{doubleMissingValue, doubleMissingValue};
+    // after the swap, the buffer holds the node positions at the end of the previous inner iteration
+    const auto numNodes = static_cast<int>(m_nodesOrder.size());
+    double maximumSquaredDisplacement = 0.0;
+    double sumSquaredDisplacements = 0.0;
+#pragma omp parallel
+    {
+        double threadMaximumSquaredDisplacement = 0.0;
+#pragma omp for reduction(+ : sumSquaredDisplacements)
+        for (int i = 0; i < numNodes; i++)
+        {
+            const auto n = m_nodesOrder[i];
+            const auto squaredDisplacement = ComputeSquaredDistance(m_mesh->m_nodes[n], m_orthogonalCoordinates[n], m_mesh->m_projection);
+            sumSquaredDisplacements += squaredDisplacement;
+            threadMaximumSquaredDisplacement = std::max(threadMaximumSquaredDisplacement, squaredDisplacement);
+        }
+#pragma omp critical(ComputeNodeDisplacementsMaximum)
+        maximumSquaredDisplacement = std::max(maximumSquaredDisplacement, threadMaximumSquaredDisplacement);
+    }
+
+    m_numInnerIterations++;
+    m_maximumDisplacement = std::sqrt(maximumSquaredDisplacement);
+    m_rootMeanSquareDisplacement = numNodes > 0 ? std::sqrt(sumSquaredDisplacements / numNodes) : 0.0;
+}
 
+bool meshkernel::OrthogonalizationAndSmoothing::IsLinearSystemSolved() const
+{
+    return m_linearSolver == LinearSolver::BiCGStab && m_mesh->m_projection != Projections::sphericalAccurate;
+}
+
+void meshkernel::OrthogonalizationAndSmoothing::AssembleLinearSystem()
+{
+    const auto numNodes = m_mesh->GetNumNodes();
+
+    // the nodes not moved by the point updates are also fixed here, they restart from their original position.
+    // The boundary nodes keep the point updates, so they can slide along the original boundary,
+    // and are held at their current position in the system
+    m_unknownIndices.assign(numNodes, -1);
+    m_unknownNodes.clear();
+    m_fixedNodes.clear();
+    m_boundaryNodes.clear();
+    for (const auto& n : m_nodesOrder)
+    {
+        double dx0 = 0.0;
+        double dy0 = 0.0;
+        std::array<double, 2> increments{0.0, 0.0};
+        ComputeLocalIncrements(n, dx0, dy0, increments);
+        if (increments[0] <= 1e-8 || increments[1] <= 1e-8)
+        {
+            m_fixedNodes.emplace_back(n);
+            continue;
+        }
+        if (m_mesh->m_nodesTypes[n] == 2)
+        {
+            m_boundaryNodes.emplace_back(n);
+            continue;
+        }
+        m_unknownIndices[n] = static_cast<int>(m_unknownNodes.size());
+        m_unknownNodes.emplace_back(n);
+    }
+
+    // assemble the fixed point of the point updates: sum_j w_j (x_j - x_n) + rhs_n = 0,
+    // the terms of the nodes held in place are moved to the right hand side at each inner iteration
+    const auto numUnknowns = static_cast<int>(m_unknownNodes.size());
+    m_matrixX.Clear();
+    m_matrixY.Clear();
+    m_heldNodesMatrixX.Clear();
+    m_heldNodesMatrixY.Clear();
+    m_constantRhsX.resize(numUnknowns);
+    m_constantRhsY.resize(numUnknowns);
+    for (int unknownIndex = 0; unknownIndex < numUnknowns; unknownIndex++)
+    {
+        const auto n = m_unknownNodes[unknownIndex];
+        const auto& node = m_mesh->m_nodes[n];
+        double diagonalX = 0.0;
+        double diagonalY = 0.0;
+        const int numConnectedNodes = m_compressedStartNodeIndex[n] - m_compressedEndNodeIndex[n];
+        auto cacheIndex = m_compressedEndNodeIndex[n];
+        for (int nn = 1; nn < numConnectedNodes; nn++)
+        {
+            double wwx = m_compressedWeightX[cacheIndex];
+            double wwy = m_compressedWeightY[cacheIndex];
+            const auto currentNode = m_compressedNodesNodes[cacheIndex];
+            cacheIndex++;
+
+            if (m_mesh->m_projection == Projections::spherical)
+            {
+                wwx = wwx * earth_radius * degrad_hp * std::cos(0.5 * (node.y + m_mesh->m_nodes[currentNode].y) * degrad_hp);
+                wwy = wwy * earth_radius * degrad_hp;
+            }
+
+            diagonalX += wwx;
+            diagonalY += wwy;
+            if (m_unknownIndices[currentNode] >= 0)
+            {
+                m_matrixX.AddEntry(m_unknownIndices[currentNode], -wwx);
+                m_matrixY.AddEntry(m_unknownIndices[currentNode], -wwy);
+            }
+            else
+            {
+                m_heldNodesMatrixX.AddEntry(currentNode, wwx);
+                m_heldNodesMatrixY.AddEntry(currentNode, wwy);
+            }
+        }
+        m_matrixX.AddEntry(unknownIndex, diagonalX);
+        m_matrixY.AddEntry(unknownIndex, diagonalY);
+        m_matrixX.FinalizeRow();
+        m_matrixY.FinalizeRow();
+        m_heldNodesMatrixX.FinalizeRow();
+        m_heldNodesMatrixY.FinalizeRow();
+
+        m_constantRhsX[unknownIndex] = m_compressedRhs[n * 2];
+        m_constantRhsY[unknownIndex] = m_compressedRhs[n * 2 + 1];
+    }
+
+    m_bicgstabSolverX.SetPreconditioner(m_matrixX);
+    m_bicgstabSolverY.SetPreconditioner(m_matrixY);
+}
+
+void meshkernel::OrthogonalizationAndSmoothing::SolveLinearSystem()
+{
+    for (const auto& n : m_fixedNodes)
+    {
+        m_orthogonalCoordinates[n] = m_originalNodes[n];
+    }
+
+    const auto numBoundaryNodes = static_cast<int>(m_boundaryNodes.size());
+#pragma omp parallel for
+    for (int i = 0; i < numBoundaryNodes; i++)
+    {
+        UpdateNodeCoordinates(m_boundaryNodes[i]);
+    }
+
+    // the right hand side with the current position of the nodes held in place
+    const auto numNodes = m_mesh->GetNumNodes();
+    m_nodesX.resize(numNodes);
+    m_nodesY.resize(numNodes);
+#pragma omp parallel for
+    for (int n = 0; n < numNodes; n++)
+    {
+        m_nodesX[n] = m_mesh->m_nodes[n].x;
+        m_nodesY[n] = m_mesh->m_nodes[n].y;
+    }
+    m_heldNodesMatrixX.Multiply(m_nodesX, m_rhsX);
+    m_heldNodesMatrixY.Multiply(m_nodesY, m_rhsY);
+
+    // the current positions are the initial guess
+    const auto numUnknowns = static_cast<int>(m_unknownNodes.size());
+    m_solutionX.resize(numUnknowns);
+    m_solutionY.resize(numUnknowns);
+#pragma omp parallel for
+    for (int unknownIndex = 0; unknownIndex < numUnknowns; unknownIndex++)
+    {
+        m_rhsX[unknownIndex] += m_constantRhsX[unknownIndex];
+        m_rhsY[unknownIndex] += m_constantRhsY[unknownIndex];
+        m_solutionX[unknownIndex] = m_nodesX[m_unknownNodes[unknownIndex]];
+        m_solutionY[unknownIndex] = m_nodesY[m_unknownNodes[unknownIndex]];
+    }
+
+    m_bicgstabSolverX.Solve(m_matrixX, m_rhsX, m_linearSolverRelativeTolerance, m_linearSolverResidualReduction, m_linearSolverMaxIterations, m_solutionX);
+    m_bicgstabSolverY.Solve(m_matrixY, m_rhsY, m_linearSolverRelativeTolerance, m_linearSolverResidualReduction, m_linearSolverMaxIterations, m_solutionY);
+
+#pragma omp parallel for
+    for (int unknownIndex = 0; unknownIndex < numUnknowns; unknownIndex++)
+    {
+        m_orthogonalCoordinates[m_unknownNodes[unknownIndex]] = {m_solutionX[unknownIndex], m_solutionY[unknownIndex]};
+    }
+}
+
+void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
+{
     // in this case the nearest point is the point itself
     std::vector<int> nearestPoints(m_mesh->GetNumNodes(), 0);
     std::iota(nearestPoints.begin(), nearestPoints.end(), 0);
 
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+    // each node is projected independently, errors are raised after the parallel loop.
+    // The boundary nodes are moved directly, so the next administration is a full one
+    m_mesh->InvalidateAdministration();
+    bool isLeftNodeInvalid = false;
+    bool isRightNodeInvalid = false;
+    const auto numNodes = static_cast<int>(m_nodesOrder.size());
+#pragma omp parallel for
+    for (int i = 0; i < numNodes; i++)
     {
+        const auto n = m_nodesOrder[i];
         int nearestPointIndex = nearestPoints[n];
         if (m_mesh->m_nodesTypes[n] == 2 && m_mesh->m_nodesNumEdges[n] > 0 && m_mesh->m_nodesNumEdges[nearestPointIndex] > 0)
         {
@@ -293,7 +513,9 @@ void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
                         leftNode = m_mesh->m_nodesNodes[n][nn];
                         if (leftNode == intMissingValue)
                         {
-                            throw AlgorithmError("OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary: The left node is invalid.");
+#pragma omp critical(ProjectOnOriginalMeshBoundaryErrors)
+                            isLeftNodeInvalid = true;
+                            break;
                         }
                         secondPoint = m_originalNodes[leftNode];
                     }
@@ -302,7 +524,9 @@ void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
                         rightNode = m_mesh->m_nodesNodes[n][nn];
                         if (rightNode == intMissingValue)
                         {
-                            throw AlgorithmError("OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary: The right node is invalid.");
+#pragma omp critical(ProjectOnOriginalMeshBoundaryErrors)
+                            isRightNodeInvalid = true;
+                            break;
                         }
                         thirdPoint = m_originalNodes[rightNode];
                     }
@@ -315,6 +539,8 @@ void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
             }
 
             //Project the moved boundary point back onto the closest original edge (either between 0 and 2 or 0 and 3)
+            Point normalSecondPoint{doubleMissingValue, doubleMissingValue};
+            Point normalThirdPoint{doubleMissingValue, doubleMissingValue};
             double rl2 = 0.0;
             const auto dis2 = DistanceFromLine(firstPoint, m_originalNodes[nearestPointIndex], secondPoint, normalSecondPoint, rl2, m_mesh->m_projection);
 
@@ -339,6 +565,15 @@ void meshkernel::OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary()
             }
         }
     }
+
+    if (isLeftNodeInvalid)
+    {
+        throw AlgorithmError("OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary: The left node is invalid.");
+    }
+    if (isRightNodeInvalid)
+    {
+        throw AlgorithmError("OrthogonalizationAndSmoothing::ProjectOnOriginalMeshBoundary: The right node is invalid.");
+    }
 }
 
 void meshkernel::OrthogonalizationAndSmoothing::ComputeCoordinates() const
@@ -361,6 +596,8 @@ void meshkernel::OrthogonalizationAndSmoothing::UpdateNodeCoordinates(int nodeIn
 
     if (increments[0] <= 1e-8 || increments[1] <= 1e-8)
     {
+        // the node is not moved by the linear system, it restarts from its original position at each inner iteration
+        m_orthogonalCoordinates[nodeIndex] = m_originalNodes[nodeIndex];
         return;
     }
 
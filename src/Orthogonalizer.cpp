@@ -51,7 +51,9 @@ void meshkernel::Orthogonalizer::Compute()
     // Compute mesh aspect ratios
     m_mesh->GetAspectRatios(m_aspectRatios);
 
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+    // each node writes its own weights and right hand side
+#pragma omp parallel for
+    for (int n = 0; n < m_mesh->GetNumNodes(); n++)
     {
         if (m_mesh->m_nodesTypes[n] != 1 && m_mesh->m_nodesTypes[n] != 2)
         {
@@ -61,7 +63,7 @@ void meshkernel::Orthogonalizer::Compute()
         for (auto nn = 0; nn < m_mesh->m_nodesNumEdges[n]; nn++)
         {
 
-            const auto edgeIndex = m_mesh->m_nodesEdges[n][nn];
+            const auto edgeIndex = m_mesh->m_nodesEdgesCsr(n, nn);
             const auto aspectRatio = m_aspectRatios[edgeIndex];
             m_weights[n][nn] = 0.0;
 
@@ -76,7 +78,7 @@ void meshkernel::Orthogonalizer::Compute()
                     m_weights[n][nn] = 0.5 * aspectRatio;
 
                     // compute the edge length
-                    Point neighbouringNode = m_mesh->m_nodes[m_mesh->m_nodesNodes[n][nn]];
+                    Point neighbouringNode = m_mesh->m_nodes[m_mesh->m_nodesNodesCsr(n, nn)];
                     const auto neighbouringNodeDistance = ComputeDistance(neighbouringNode, m_mesh->m_nodes[n], m_mesh->m_projection);
 
                     const auto leftFace = m_mesh->m_edgesFaces[edgeIndex][0];
@@ -264,8 +264,7 @@ namespace meshkernel
             triangulationWrapper.Compute(localPolygon,
                                          numPolygonNodes,
                                          TriangulationWrapper::TriangulationOptions::GeneratePoints,
-                                         averageTriangleArea,
-                                         numberOfTriangles);
+                                         averageTriangleArea);
 
             generatedPoints[i] = std::move(triangulationWrapper.m_nodes);
         }
@@ -0,0 +1,284 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <MeshKernel/SampleTiles.hpp>
+
+namespace
+{
+    // the samples are written to and read from the tile files as arrays
+    static_assert(sizeof(meshkernel::Sample) == 3 * sizeof(double) && std::is_trivially_copyable<meshkernel::Sample>::value,
+                  "The samples must be stored as three consecutive doubles.");
+
+    constexpr int numSamplesPerChunk = 1 << 16; // The number of samples read from an input file at once
+} // namespace
+
+meshkernel::SampleTiles::SampleTiles(const std::string& filePrefix, double tileSize, Projections projection, int maxNumBufferedSamples)
+    : m_filePrefix(filePrefix),
+      m_tileSize(tileSize),
+      m_projection(projection),
+      m_maxNumBufferedSamples(maxNumBufferedSamples)
+{
+    if (tileSize <= 0.0)
+    {
+        throw std::invalid_argument("SampleTiles::SampleTiles: The tile size must be positive.");
+    }
+    if (maxNumBufferedSamples <= 0)
+    {
+        throw std::invalid_argument("SampleTiles::SampleTiles: The maximum number of buffered samples must be positive.");
+    }
+}
+
+meshkernel::SampleTiles::~SampleTiles()
+{
+    RemoveTileFiles();
+}
+
+std::pair<int, int> meshkernel::SampleTiles::GetTile(const Point& point) const
+{
+    return {static_cast<int>(std::floor(point.x / m_tileSize)), static_cast<int>(std::floor(point.y / m_tileSize))};
+}
+
+bool meshkernel::SampleTiles::IsTileOverlappingBox(const std::pair<int, int>& tile, const Point& lowerLeft, const Point& upperRight) const
+{
+    const auto lowerLeftTile = GetTile(lowerLeft);
+    const auto upperRightTile = GetTile(upperRight);
+    if (tile.second < lowerLeftTile.second || tile.second > upperRightTile.second)
+    {
+        return false;
+    }
+    if (m_projection == Projections::cartesian)
+    {
+        return tile.first >= lowerLeftTile.first && tile.first <= upperRightTile.first;
+    }
+
+    // the tile is shifted by the multiple of 360 degrees placing its right side just beyond the left side of the box
+    const double tileLeft = tile.first * m_tileSize;
+    const double tileRight = (tile.first + 1) * m_tileSize;
+    const double shift = (std::floor((lowerLeft.x - tileRight) / 360.0) + 1.0) * 360.0;
+    return tileLeft + shift <= upperRight.x;
+}
+
+std::string meshkernel::SampleTiles::GetTileFilePath(const std::pair<int, int>& tile) const
+{
+    return m_filePrefix + "_" + std::to_string(tile.first) + "_" + std::to_string(tile.second) + ".tile";
+}
+
+void meshkernel::SampleTiles::AddSamples(const std::vector<Sample>& samples)
+{
+    for (const auto& sample : samples)
+    {
+        if (IsEqual(sample.x, doubleMissingValue) || IsEqual(sample.y, doubleMissingValue))
+        {
+            continue;
+        }
+
+        const Point point{sample.x, sample.y};
+        auto& tile = m_tiles[GetTile(point)];
+        tile.m_buffer.emplace_back(sample);
+        tile.m_numSamples++;
+        m_numBufferedSamples++;
+        m_numSamples++;
+
+        if (m_numSamples == 1)
+        {
+            m_lowerLeft = point;
+            m_upperRight = point;
+        }
+        m_lowerLeft = {std::min(m_lowerLeft.x, point.x), std::min(m_lowerLeft.y, point.y)};
+        m_upperRight = {std::max(m_upperRight.x, point.x), std::max(m_upperRight.y, point.y)};
+
+        if (m_numBufferedSamples >= m_maxNumBufferedSamples)
+        {
+            Flush();
+        }
+    }
+}
+
+int meshkernel::SampleTiles::ReadXyzFile(const std::string& filePath)
+{
+    std::ifstream stream(filePath);
+    if (!stream)
+    {
+        throw std::invalid_argument("SampleTiles::ReadXyzFile: Could not open " + filePath);
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(numSamplesPerChunk);
+    std::string line;
+    int numRejectedLines = 0;
+    while (std::getline(stream, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        std::istringstream lineStream(line);
+        Sample sample;
+        if (!(lineStream >> sample.x >> sample.y >> sample.value))
+        {
+            numRejectedLines++;
+            continue;
+        }
+        samples.emplace_back(sample);
+        if (samples.size() == numSamplesPerChunk)
+        {
+            AddSamples(samples);
+            samples.clear();
+        }
+    }
+    AddSamples(samples);
+
+    m_numRejectedLines += numRejectedLines;
+    return numRejectedLines;
+}
+
+void meshkernel::SampleTiles::ReadBinaryFile(const std::string& filePath)
+{
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream)
+    {
+        throw std::invalid_argument("SampleTiles::ReadBinaryFile: Could not open " + filePath);
+    }
+
+    std::vector<Sample> samples(numSamplesPerChunk);
+    while (stream)
+    {
+        stream.read(reinterpret_cast<char*>(samples.data()), numSamplesPerChunk * sizeof(Sample));
+        const auto numBytesRead = static_cast<size_t>(stream.gcount());
+        if (numBytesRead % sizeof(Sample) != 0)
+        {
+            throw std::invalid_argument("SampleTiles::ReadBinaryFile: " + filePath + " does not contain a whole number of samples.");
+        }
+        samples.resize(numBytesRead / sizeof(Sample));
+        AddSamples(samples);
+        samples.resize(numSamplesPerChunk);
+    }
+}
+
+void meshkernel::SampleTiles::Flush()
+{
+    for (auto& tileEntry : m_tiles)
+    {
+        const auto& tileIndex = tileEntry.first;
+        auto& tile = tileEntry.second;
+        if (tile.m_buffer.empty())
+        {
+            continue;
+        }
+
+        const auto filePath = GetTileFilePath(tileIndex);
+        std::ofstream stream(filePath, std::ios::binary | (tile.m_hasFile ? std::ios::app : std::ios::trunc));
+        stream.write(reinterpret_cast<const char*>(tile.m_buffer.data()), tile.m_buffer.size() * sizeof(Sample));
+        if (!stream)
+        {
+            throw std::invalid_argument("SampleTiles::Flush: Could not write " + filePath);
+        }
+        tile.m_hasFile = true;
+
+        // release the memory of the buffer
+        std::vector<Sample>().swap(tile.m_buffer);
+    }
+    m_numBufferedSamples = 0;
+}
+
+void meshkernel::SampleTiles::LoadSamples(const Point& lowerLeft, const Point& upperRight, std::vector<Sample>& samples)
+{
+    Flush();
+
+    // count the samples first, so the samples are allocated once
+    long long numSamples = 0;
+    for (const auto& tileEntry : m_tiles)
+    {
+        const auto& tileIndex = tileEntry.first;
+        const auto& tile = tileEntry.second;
+        if (IsTileOverlappingBox(tileIndex, lowerLeft, upperRight))
+        {
+            numSamples += tile.m_numSamples;
+        }
+    }
+    samples.resize(numSamples);
+
+    size_t position = 0;
+    for (const auto& tileEntry : m_tiles)
+    {
+        const auto& tileIndex = tileEntry.first;
+        const auto& tile = tileEntry.second;
+        if (!IsTileOverlappingBox(tileIndex, lowerLeft, upperRight))
+        {
+            continue;
+        }
+
+        const auto filePath = GetTileFilePath(tileIndex);
+        std::ifstream stream(filePath, std::ios::binary);
+        stream.read(reinterpret_cast<char*>(samples.data() + position), tile.m_numSamples * sizeof(Sample));
+        if (!stream)
+        {
+            throw std::invalid_argument("SampleTiles::LoadSamples: Could not read " + filePath);
+        }
+        position += tile.m_numSamples;
+    }
+}
+
+void meshkernel::SampleTiles::RemoveTileFiles() const
+{
+    for (const auto& tileEntry : m_tiles)
+    {
+        const auto& tileIndex = tileEntry.first;
+        const auto& tile = tileEntry.second;
+        if (tile.m_hasFile)
+        {
+            std::remove(GetTileFilePath(tileIndex).c_str());
+        }
+    }
+}
+
+void meshkernel::SampleTiles::Clear()
+{
+    RemoveTileFiles();
+    m_tiles.clear();
+    m_numBufferedSamples = 0;
+    m_numSamples = 0;
+    m_numRejectedLines = 0;
+    m_lowerLeft = {doubleMissingValue, doubleMissingValue};
+    m_upperRight = {doubleMissingValue, doubleMissingValue};
+}
+
+void meshkernel::SampleTiles::GetBoundingBox(Point& lowerLeft, Point& upperRight) const
+{
+    lowerLeft = m_lowerLeft;
+    upperRight = m_upperRight;
+}
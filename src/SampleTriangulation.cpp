@@ -0,0 +1,145 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <MeshKernel/Exceptions.hpp>
+#include <MeshKernel/SampleTriangulation.hpp>
+#include <MeshKernel/TriangulationWrapper.hpp>
+
+meshkernel::SampleTriangulation::SampleTriangulation(const std::vector<Sample>& samples)
+{
+    TriangulationWrapper triangulationWrapper;
+    triangulationWrapper.Compute(samples,
+                                 static_cast<int>(samples.size()),
+                                 TriangulationWrapper::TriangulationOptions::TriangulatePointsAndGenerateFaces,
+                                 0.0);
+
+    if (triangulationWrapper.m_numFaces < 1)
+    {
+        throw AlgorithmError("SampleTriangulation::SampleTriangulation: Triangulation of samples produced no triangles.");
+    }
+
+    m_nodes.resize(samples.size());
+    for (int n = 0; n < static_cast<int>(samples.size()); ++n)
+    {
+        m_nodes[n] = {samples[n].x, samples[n].y};
+    }
+
+    const auto numFaces = triangulationWrapper.m_numFaces;
+    m_faceNodes = std::move(triangulationWrapper.m_faceNodes);
+    m_faceNeighbours.assign(3 * numFaces, -1);
+    std::vector<Point> faceCenters(numFaces);
+    for (int f = 0; f < numFaces; ++f)
+    {
+        // the neighbour across each edge is stored at the position of the opposite node
+        for (int e = 0; e < 3; ++e)
+        {
+            const auto edge = triangulationWrapper.GetFaceEdge(f, e);
+            const auto otherFace = triangulationWrapper.GetEdgeFace(edge, 0) == f ? triangulationWrapper.GetEdgeFace(edge, 1) : triangulationWrapper.GetEdgeFace(edge, 0);
+            if (otherFace < 0 || otherFace >= numFaces)
+            {
+                continue;
+            }
+            for (int n = 0; n < 3; ++n)
+            {
+                const auto node = m_faceNodes[3 * f + n];
+                if (node != triangulationWrapper.GetEdgeNode(edge, 0) && node != triangulationWrapper.GetEdgeNode(edge, 1))
+                {
+                    m_faceNeighbours[3 * f + n] = otherFace;
+                }
+            }
+        }
+
+        const auto& firstNode = m_nodes[m_faceNodes[3 * f]];
+        const auto& secondNode = m_nodes[m_faceNodes[3 * f + 1]];
+        const auto& thirdNode = m_nodes[m_faceNodes[3 * f + 2]];
+        faceCenters[f] = {(firstNode.x + secondNode.x + thirdNode.x) / 3.0, (firstNode.y + secondNode.y + thirdNode.y) / 3.0};
+    }
+
+    m_centersRTree.BuildTree(faceCenters);
+}
+
+int meshkernel::SampleTriangulation::FindFace(const Point& point, int startFace, SpatialTrees::RTree::QueryContext& queryContext) const
+{
+    if (startFace >= 0 && startFace < GetNumFaces())
+    {
+        const auto face = Walk(point, startFace);
+        if (face >= 0)
+        {
+            return face;
+        }
+    }
+
+    // jump to the triangle with the nearest center
+    m_centersRTree.NearestNeighbour(point, queryContext);
+    if (queryContext.GetQueryResultSize() == 0)
+    {
+        return -1;
+    }
+    return Walk(point, queryContext.GetQuerySampleIndex(0));
+}
+
+int meshkernel::SampleTriangulation::Walk(const Point& point, int startFace) const
+{
+    auto face = startFace;
+    const auto maxNumSteps = GetNumFaces();
+    for (int step = 0; step <= maxNumSteps; ++step)
+    {
+        // the edge examined first rotates, so degenerate configurations do not make the walk cycle
+        int nextFace = face;
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto n = (i + step) % 3;
+            const auto& oppositeNode = m_nodes[m_faceNodes[3 * face + n]];
+            const auto& firstNode = m_nodes[m_faceNodes[3 * face + (n + 1) % 3]];
+            const auto& secondNode = m_nodes[m_faceNodes[3 * face + (n + 2) % 3]];
+
+            const auto dx = secondNode.x - firstNode.x;
+            const auto dy = secondNode.y - firstNode.y;
+            const auto pointSide = dx * (point.y - firstNode.y) - dy * (point.x - firstNode.x);
+            const auto oppositeNodeSide = dx * (oppositeNode.y - firstNode.y) - dy * (oppositeNode.x - firstNode.x);
+
+            // the edge separates the point from the triangle
+            if (pointSide * oppositeNodeSide < 0.0)
+            {
+                nextFace = m_faceNeighbours[3 * face + n];
+                break;
+            }
+        }
+
+        if (nextFace == face)
+        {
+            return face;
+        }
+        if (nextFace < 0)
+        {
+            return -1;
+        }
+        face = nextFace;
+    }
+    return -1;
+}
@@ -27,10 +27,15 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
 #include <stdexcept>
 
+#include <MeshKernel/AveragingInterpolation.hpp>
 #include <MeshKernel/Exceptions.hpp>
 #include <MeshKernel/Operations.cpp>
 #include <MeshKernel/Constants.hpp>
@@ -42,6 +47,40 @@ meshkernel::Smoother::Smoother(std::shared_ptr<Mesh> mesh) : m_mesh(mesh)
 {
 }
 
+void meshkernel::Smoother::SetAdaptationSamples(const std::vector<Sample>& samples, double adaptationStrength)
+{
+    if (adaptationStrength < 0.0)
+    {
+        throw std::invalid_argument("Smoother::SetAdaptationSamples: The adaptation strength cannot be negative.");
+    }
+
+    m_adaptationSamples = samples;
+    m_adaptationStrength = adaptationStrength;
+    m_adaptationNodeValues.clear();
+}
+
+void meshkernel::Smoother::ComputeAdaptationNodeValues()
+{
+    m_adaptationNodeValues.clear();
+    if (m_adaptationSamples.empty())
+    {
+        return;
+    }
+
+    // the samples in the cell around each node, its search area slightly enlarged to include the samples on the cell edges
+    constexpr double relativeSearchRadius = 1.01;
+    AveragingInterpolation averaging(m_mesh,
+                                     m_adaptationSamples,
+                                     AveragingInterpolation::Method::SimpleAveraging,
+                                     InterpolationLocation::Nodes,
+                                     relativeSearchRadius,
+                                     true,
+                                     false);
+    averaging.SetParallel(true);
+    averaging.Compute();
+    m_adaptationNodeValues = averaging.GetResults();
+}
+
 void meshkernel::Smoother::Compute()
 {
     // compute smoother topologies
@@ -58,49 +97,103 @@ void meshkernel::Smoother::ComputeTopologies()
 {
     Initialize();
 
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+    // the node data is computed in parallel by blocks of nodes,
+    // the topologies are then saved in node order, so they do not depend on the number of threads
+    struct NodesBlock
+    {
+        std::vector<int> numSharedFaces;
+        std::vector<int> numConnectedNodes;
+        std::vector<size_t> connectedNodes;
+        std::vector<double> xi;
+        std::vector<double> eta;
+        std::exception_ptr error = nullptr;
+    };
+
+    const auto numNodes = m_mesh->GetNumNodes();
+    const auto numBlocks = (numNodes + m_topologyNodesBlockSize - 1) / m_topologyNodesBlockSize;
+    std::vector<NodesBlock> blocks(numBlocks);
+
+#pragma omp parallel
     {
-        int numSharedFaces = 0;
-        int numConnectedNodes = 0;
+        auto cache = MakeNodeTopologyCache();
 
-        std::fill(m_sharedFacesCache.begin(), m_sharedFacesCache.end(), -1);
-        std::fill(m_connectedNodesCache.begin(), m_connectedNodesCache.end(), 0);
-        NodeAdministration(n, numSharedFaces, numConnectedNodes);
+#pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < numBlocks; b++)
+        {
+            auto& block = blocks[b];
+            const auto lastNode = std::min(numNodes, (b + 1) * m_topologyNodesBlockSize);
+            try
+            {
+                for (auto n = b * m_topologyNodesBlockSize; n < lastNode; n++)
+                {
+                    int numSharedFaces = 0;
+                    int numConnectedNodes = 0;
+
+                    std::fill(cache.sharedFaces.begin(), cache.sharedFaces.end(), -1);
+                    std::fill(cache.connectedNodes.begin(), cache.connectedNodes.end(), 0);
+                    NodeAdministration(n, cache, numSharedFaces, numConnectedNodes);
+
+                    std::fill(cache.xi.begin(), cache.xi.end(), 0.0);
+                    std::fill(cache.eta.begin(), cache.eta.end(), 0.0);
+                    ComputeNodeXiEta(n, cache, numSharedFaces, numConnectedNodes);
+
+                    block.numSharedFaces.emplace_back(numSharedFaces);
+                    block.numConnectedNodes.emplace_back(numConnectedNodes);
+                    block.connectedNodes.insert(block.connectedNodes.end(), cache.connectedNodes.begin(), cache.connectedNodes.begin() + numConnectedNodes);
+                    block.xi.insert(block.xi.end(), cache.xi.begin(), cache.xi.begin() + numConnectedNodes);
+                    block.eta.insert(block.eta.end(), cache.eta.begin(), cache.eta.begin() + numConnectedNodes);
+                }
+            }
+            catch (...)
+            {
+                block.error = std::current_exception();
+            }
+        }
+    }
 
-        std::fill(m_xiCache.begin(), m_xiCache.end(), 0.0);
-        std::fill(m_etaCache.begin(), m_etaCache.end(), 0.0);
-        ComputeNodeXiEta(n, numSharedFaces, numConnectedNodes);
+    for (int b = 0; b < numBlocks; b++)
+    {
+        auto& block = blocks[b];
+        int offset = 0;
+        for (int i = 0; i < static_cast<int>(block.numSharedFaces.size()); i++)
+        {
+            const auto n = b * m_topologyNodesBlockSize + i;
+            const auto numSharedFaces = block.numSharedFaces[i];
+            const auto numConnectedNodes = block.numConnectedNodes[i];
+
+            SaveNodeTopologyIfNeeded(n, numSharedFaces, numConnectedNodes, block.xi.data() + offset, block.eta.data() + offset);
 
-        SaveNodeTopologyIfNeeded(n, numSharedFaces, numConnectedNodes);
+            m_connectedNodesOffsets[n + 1] = m_connectedNodesOffsets[n] + numConnectedNodes;
+            m_connectedNodes.insert(m_connectedNodes.end(), block.connectedNodes.begin() + offset, block.connectedNodes.begin() + offset + numConnectedNodes);
 
-        m_maximumNumConnectedNodes = std::max(m_maximumNumConnectedNodes, numConnectedNodes);
-        m_maximumNumSharedFaces = std::max(m_maximumNumSharedFaces, numSharedFaces);
+            m_maximumNumConnectedNodes = std::max(m_maximumNumConnectedNodes, numConnectedNodes);
+            m_maximumNumSharedFaces = std::max(m_maximumNumSharedFaces, numSharedFaces);
+            offset += numConnectedNodes;
+        }
+
+        if (block.error != nullptr)
+        {
+            std::rethrow_exception(block.error);
+        }
+        block = NodesBlock();
     }
 }
 
 void meshkernel::Smoother::ComputeOperators()
 {
-    // allocate local operators for unique topologies
-    m_Az.resize(m_numTopologies);
-    m_Gxi.resize(m_numTopologies);
-    m_Geta.resize(m_numTopologies);
-    m_Divxi.resize(m_numTopologies);
-    m_Diveta.resize(m_numTopologies);
-    m_Jxi.resize(m_numTopologies);
-    m_Jeta.resize(m_numTopologies);
-    m_ww2.resize(m_numTopologies);
-
-    // allocate caches
-    m_boundaryEdgesCache.resize(2, -1);
-    m_leftXFaceCenterCache.resize(maximumNumberOfEdgesPerNode, 0.0);
-    m_leftYFaceCenterCache.resize(maximumNumberOfEdgesPerNode, 0.0);
-    m_rightXFaceCenterCache.resize(maximumNumberOfEdgesPerNode, 0.0);
-    m_rightYFaceCenterCache.resize(maximumNumberOfEdgesPerNode, 0.0);
-    m_xisCache.resize(maximumNumberOfEdgesPerNode, 0.0);
-    m_etasCache.resize(maximumNumberOfEdgesPerNode, 0.0);
+    // allocate local operators for unique topologies, contiguous in one arena
+    m_topologyOperatorsOffsets.resize(m_numTopologies + 1);
+    m_topologyOperatorsOffsets[0] = 0;
+    for (int t = 0; t < m_numTopologies; t++)
+    {
+        m_topologyOperatorsOffsets[t + 1] = m_topologyOperatorsOffsets[t] + NumNodeOperatorsValues(m_numTopologyFaces[t], m_numTopologyNodes[t]);
+    }
+    m_topologyOperators.assign(m_topologyOperatorsOffsets.back(), 0.0);
 
+    // the operators are computed at the first node of each topology
+    std::vector<int> topologyNodes;
+    topologyNodes.reserve(m_numTopologies);
     std::vector<bool> isNewTopology(m_numTopologies, true);
-
     for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
     {
         if (m_mesh->m_nodesTypes[n] != 1 && m_mesh->m_nodesTypes[n] != 2 && m_mesh->m_nodesTypes[n] != 3 && m_mesh->m_nodesTypes[n] != 4)
@@ -109,26 +202,55 @@ void meshkernel::Smoother::ComputeOperators()
         }
 
         // for each node, the associated topology
-        int currentTopology = m_nodeTopologyMapping[n];
+        const int currentTopology = m_nodeTopologyMapping[n];
 
         if (isNewTopology[currentTopology])
         {
             isNewTopology[currentTopology] = false;
+            topologyNodes.emplace_back(n);
+        }
+    }
 
-            // Compute node operators
+    // each topology writes its own operators, the error of the first node is raised after the loop
+    const auto numTopologyNodes = static_cast<int>(topologyNodes.size());
+    int errorIndex = numTopologyNodes;
+    std::exception_ptr error = nullptr;
+#pragma omp parallel
+    {
+        auto cache = MakeOperatorsCache();
 
-            AllocateNodeOperators(currentTopology);
-            ComputeOperatorsNode(n);
+#pragma omp for schedule(dynamic, 16)
+        for (int i = 0; i < numTopologyNodes; i++)
+        {
+            try
+            {
+                ComputeOperatorsNode(topologyNodes[i], cache);
+            }
+            catch (...)
+            {
+#pragma omp critical(SmootherOperatorsErrors)
+                if (i < errorIndex)
+                {
+                    errorIndex = i;
+                    error = std::current_exception();
+                }
+            }
         }
     }
+
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
 }
 
 void meshkernel::Smoother::ComputeWeights()
 {
-    std::vector<std::vector<double>> J(m_mesh->GetNumNodes(), std::vector<double>(4, 0));    // Jacobian
-    std::vector<std::vector<double>> Ginv(m_mesh->GetNumNodes(), std::vector<double>(4, 0)); // Mesh monitor matrices
+    std::vector<std::array<double, 4>> J(m_mesh->GetNumNodes(), {0.0, 0.0, 0.0, 0.0}); // Jacobian
+    std::vector<std::array<double, 4>> Ginv(m_mesh->GetNumNodes());                   // Mesh monitor matrices
 
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+#pragma omp parallel for
+    for (int n = 0; n < m_mesh->GetNumNodes(); n++)
     {
         if (m_mesh->m_nodesTypes[n] != 1 && m_mesh->m_nodesTypes[n] != 2 && m_mesh->m_nodesTypes[n] != 4)
         {
@@ -137,156 +259,172 @@ void meshkernel::Smoother::ComputeWeights()
         ComputeJacobian(n, J[n]);
     }
 
-    // TODO: Account for samples: call orthonet_comp_Ginv(u, ops, J, Ginv)
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+    ComputeMonitorMatrices(Ginv);
+
+    // the weights of the previous computation are kept if the connected nodes did not change
+    if (m_weights.size() != m_connectedNodes.size())
     {
-        Ginv[n][0] = 1.0;
-        Ginv[n][1] = 0.0;
-        Ginv[n][2] = 0.0;
-        Ginv[n][3] = 1.0;
+        m_weights.assign(m_connectedNodes.size(), 0.0);
     }
 
-    m_weights.resize(m_mesh->GetNumNodes(), std::vector<double>(m_maximumNumConnectedNodes, 0.0));
-    std::vector<double> a1(2);
-    std::vector<double> a2(2);
-
-    // matrices for dicretization
-    std::vector<double> DGinvDxi(4, 0.0);
-    std::vector<double> DGinvDeta(4, 0.0);
-    std::vector<double> currentGinv(4, 0.0);
-    std::vector<double> GxiByDivxi(m_maximumNumConnectedNodes, 0.0);
-    std::vector<double> GxiByDiveta(m_maximumNumConnectedNodes, 0.0);
-    std::vector<double> GetaByDivxi(m_maximumNumConnectedNodes, 0.0);
-    std::vector<double> GetaByDiveta(m_maximumNumConnectedNodes, 0.0);
-    for (auto n = 0; n < m_mesh->GetNumNodes(); n++)
+    // each node writes its own weights, the scratch matrices are private to each thread
+#pragma omp parallel
     {
-
-        if (m_mesh->m_nodesNumEdges[n] < 2)
-            continue;
-
-        // Internal nodes and boundary nodes
-        if (m_mesh->m_nodesTypes[n] == 1 || m_mesh->m_nodesTypes[n] == 2)
+        std::array<double, 2> a1;
+        std::array<double, 2> a2;
+
+        // matrices for dicretization
+        std::array<double, 4> DGinvDxi;
+        std::array<double, 4> DGinvDeta;
+        std::vector<double> GxiByDivxi(m_maximumNumConnectedNodes, 0.0);
+        std::vector<double> GxiByDiveta(m_maximumNumConnectedNodes, 0.0);
+        std::vector<double> GetaByDivxi(m_maximumNumConnectedNodes, 0.0);
+        std::vector<double> GetaByDiveta(m_maximumNumConnectedNodes, 0.0);
+
+#pragma omp for schedule(dynamic, 1024)
+        for (int n = 0; n < m_mesh->GetNumNodes(); n++)
         {
-            const auto currentTopology = m_nodeTopologyMapping[n];
-
-            ComputeJacobian(n, J[n]);
+            if (m_mesh->m_nodesNumEdges[n] < 2)
+                continue;
 
-            //compute the contravariant base vectors
-            const double determinant = J[n][0] * J[n][3] - J[n][3] * J[n][1];
-            if (determinant == 0.0)
+            // Internal nodes and boundary nodes
+            if (m_mesh->m_nodesTypes[n] == 1 || m_mesh->m_nodesTypes[n] == 2)
             {
-                continue;
-            }
+                const auto currentTopology = m_nodeTopologyMapping[n];
+                const auto numConnectedNodes = m_numTopologyNodes[currentTopology];
+                const auto numSharedFaces = m_numTopologyFaces[currentTopology];
+                const auto operators = GetNodeOperators(currentTopology);
+                auto* weights = &m_weights[m_connectedNodesOffsets[n]];
+
+                //compute the contravariant base vectors
+                const double determinant = J[n][0] * J[n][3] - J[n][3] * J[n][1];
+                if (determinant == 0.0)
+                {
+                    continue;
+                }
 
-            a1[0] = J[n][3] / determinant;
-            a1[1] = -J[n][2] / determinant;
-            a2[0] = -J[n][1] / determinant;
-            a2[1] = J[n][0] / determinant;
+                a1[0] = J[n][3] / determinant;
+                a1[1] = -J[n][2] / determinant;
+                a2[0] = -J[n][1] / determinant;
+                a2[1] = J[n][0] / determinant;
 
-            std::fill(DGinvDxi.begin(), DGinvDxi.end(), 0.0);
-            std::fill(DGinvDeta.begin(), DGinvDeta.end(), 0.0);
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                DGinvDxi[0] += Ginv[m_topologyConnectedNodes[currentTopology][i]][0] * m_Jxi[currentTopology][i];
-                DGinvDxi[1] += Ginv[m_topologyConnectedNodes[currentTopology][i]][1] * m_Jxi[currentTopology][i];
-                DGinvDxi[2] += Ginv[m_topologyConnectedNodes[currentTopology][i]][2] * m_Jxi[currentTopology][i];
-                DGinvDxi[3] += Ginv[m_topologyConnectedNodes[currentTopology][i]][3] * m_Jxi[currentTopology][i];
-
-                DGinvDeta[0] += Ginv[m_topologyConnectedNodes[currentTopology][i]][0] * m_Jeta[currentTopology][i];
-                DGinvDeta[1] += Ginv[m_topologyConnectedNodes[currentTopology][i]][1] * m_Jeta[currentTopology][i];
-                DGinvDeta[2] += Ginv[m_topologyConnectedNodes[currentTopology][i]][2] * m_Jeta[currentTopology][i];
-                DGinvDeta[3] += Ginv[m_topologyConnectedNodes[currentTopology][i]][3] * m_Jeta[currentTopology][i];
-            }
+                DGinvDxi.fill(0.0);
+                DGinvDeta.fill(0.0);
+                for (int i = 0; i < numConnectedNodes; i++)
+                {
+                    const auto& connectedNodeGinv = Ginv[m_connectedNodes[m_connectedNodesOffsets[n] + i]];
+                    for (int k = 0; k < 4; k++)
+                    {
+                        DGinvDxi[k] += connectedNodeGinv[k] * operators.Jxi[i];
+                        DGinvDeta[k] += connectedNodeGinv[k] * operators.Jeta[i];
+                    }
+                }
 
-            // compute current Ginv
-            currentGinv[0] = Ginv[n][0];
-            currentGinv[1] = Ginv[n][1];
-            currentGinv[2] = Ginv[n][2];
-            currentGinv[3] = Ginv[n][3];
-
-            // compute small matrix operations
-            std::fill(GxiByDivxi.begin(), GxiByDivxi.end(), 0.0);
-            std::fill(GxiByDiveta.begin(), GxiByDiveta.end(), 0.0);
-            std::fill(GetaByDivxi.begin(), GetaByDivxi.end(), 0.0);
-            std::fill(GetaByDiveta.begin(), GetaByDiveta.end(), 0.0);
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                for (int j = 0; j < m_Divxi[currentTopology].size(); j++)
+                // compute current Ginv
+                const auto& currentGinv = Ginv[n];
+
+                // compute small matrix operations
+                std::fill(GxiByDivxi.begin(), GxiByDivxi.end(), 0.0);
+                std::fill(GxiByDiveta.begin(), GxiByDiveta.end(), 0.0);
+                std::fill(GetaByDivxi.begin(), GetaByDivxi.end(), 0.0);
+                std::fill(GetaByDiveta.begin(), GetaByDiveta.end(), 0.0);
+                for (int j = 0; j < numSharedFaces; j++)
                 {
-                    GxiByDivxi[i] += m_Gxi[currentTopology][j][i] * m_Divxi[currentTopology][j];
-                    GxiByDiveta[i] += m_Gxi[currentTopology][j][i] * m_Diveta[currentTopology][j];
-                    GetaByDivxi[i] += m_Geta[currentTopology][j][i] * m_Divxi[currentTopology][j];
-                    GetaByDiveta[i] += m_Geta[currentTopology][j][i] * m_Diveta[currentTopology][j];
+                    const auto* Gxi = &operators.Gxi[j * numConnectedNodes];
+                    const auto* Geta = &operators.Geta[j * numConnectedNodes];
+                    for (int i = 0; i < numConnectedNodes; i++)
+                    {
+                        GxiByDivxi[i] += Gxi[i] * operators.Divxi[j];
+                        GxiByDiveta[i] += Gxi[i] * operators.Diveta[j];
+                        GetaByDivxi[i] += Geta[i] * operators.Divxi[j];
+                        GetaByDiveta[i] += Geta[i] * operators.Diveta[j];
+                    }
                 }
-            }
 
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                m_weights[n][i] -= MatrixNorm(a1, a1, DGinvDxi) * m_Jxi[currentTopology][i] +
-                                   MatrixNorm(a1, a2, DGinvDeta) * m_Jxi[currentTopology][i] +
-                                   MatrixNorm(a2, a1, DGinvDxi) * m_Jeta[currentTopology][i] +
-                                   MatrixNorm(a2, a2, DGinvDeta) * m_Jeta[currentTopology][i];
-                m_weights[n][i] += MatrixNorm(a1, a1, currentGinv) * GxiByDivxi[i] +
-                                   MatrixNorm(a1, a2, currentGinv) * GxiByDiveta[i] +
-                                   MatrixNorm(a2, a1, currentGinv) * GetaByDivxi[i] +
-                                   MatrixNorm(a2, a2, currentGinv) * GetaByDiveta[i];
-            }
+                const auto a1a1DGinvDxi = MatrixNorm(a1, a1, DGinvDxi);
+                const auto a1a2DGinvDeta = MatrixNorm(a1, a2, DGinvDeta);
+                const auto a2a1DGinvDxi = MatrixNorm(a2, a1, DGinvDxi);
+                const auto a2a2DGinvDeta = MatrixNorm(a2, a2, DGinvDeta);
+                const auto a1a1Ginv = MatrixNorm(a1, a1, currentGinv);
+                const auto a1a2Ginv = MatrixNorm(a1, a2, currentGinv);
+                const auto a2a1Ginv = MatrixNorm(a2, a1, currentGinv);
+                const auto a2a2Ginv = MatrixNorm(a2, a2, currentGinv);
+                for (int i = 0; i < numConnectedNodes; i++)
+                {
+                    weights[i] -= a1a1DGinvDxi * operators.Jxi[i] +
+                                  a1a2DGinvDeta * operators.Jxi[i] +
+                                  a2a1DGinvDxi * operators.Jeta[i] +
+                                  a2a2DGinvDeta * operators.Jeta[i];
+                    weights[i] += a1a1Ginv * GxiByDivxi[i] +
+                                  a1a2Ginv * GxiByDiveta[i] +
+                                  a2a1Ginv * GetaByDivxi[i] +
+                                  a2a2Ginv * GetaByDiveta[i];
+                }
 
-            double alpha = 0.0;
-            for (int i = 1; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                alpha = std::max(alpha, -m_weights[n][i]) / std::max(1.0, m_ww2[currentTopology][i]);
-            }
+                double alpha = 0.0;
+                for (int i = 1; i < numConnectedNodes; i++)
+                {
+                    alpha = std::max(alpha, -weights[i]) / std::max(1.0, operators.ww2[i]);
+                }
 
-            double sumValues = 0.0;
-            for (int i = 1; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                m_weights[n][i] = m_weights[n][i] + alpha * std::max(1.0, m_ww2[currentTopology][i]);
-                sumValues += m_weights[n][i];
-            }
-            m_weights[n][0] = -sumValues;
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
-            {
-                m_weights[n][i] = -m_weights[n][i] / (-sumValues + 1e-8);
+                double sumValues = 0.0;
+                for (int i = 1; i < numConnectedNodes; i++)
+                {
+                    weights[i] = weights[i] + alpha * std::max(1.0, operators.ww2[i]);
+                    sumValues += weights[i];
+                }
+                weights[0] = -sumValues;
+                for (int i = 0; i < numConnectedNodes; i++)
+                {
+                    weights[i] = -weights[i] / (-sumValues + 1e-8);
+                }
             }
         }
     }
 }
 
-void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
+void meshkernel::Smoother::ComputeOperatorsNode(int currentNode, OperatorsCache& cache)
 {
     // the current topology index
     const int currentTopology = m_nodeTopologyMapping[currentNode];
+    const auto numSharedFaces = m_numTopologyFaces[currentTopology];
+    const auto numConnectedNodes = m_numTopologyNodes[currentTopology];
+    const auto* topologyXi = &m_topologyXi[m_topologyNodesOffsets[currentTopology]];
+    const auto* topologyEta = &m_topologyEta[m_topologyNodesOffsets[currentTopology]];
+    const auto* topologyConnectedNodes = &m_topologyConnectedNodes[m_topologyNodesOffsets[currentTopology]];
+    const auto* topologySharedFaces = &m_topologySharedFaces[m_topologyFacesOffsets[currentTopology]];
+    const auto* topologyFaceNodeMapping = &m_topologyFaceNodeMapping[m_topologyFacesOffsets[currentTopology] * maximumNumberOfNodesPerFace];
+    auto operators = GetNodeOperators(currentTopology);
 
-    for (int f = 0; f < m_numTopologyFaces[currentTopology]; f++)
+    for (int f = 0; f < numSharedFaces; f++)
     {
-        if (m_topologySharedFaces[currentTopology][f] < 0 || m_mesh->m_nodesTypes[currentNode] == 3)
+        if (topologySharedFaces[f] < 0 || m_mesh->m_nodesTypes[currentNode] == 3)
         {
             continue;
         }
 
         int edgeLeft = f + 1;
         int edgeRight = edgeLeft + 1;
-        if (edgeRight > m_numTopologyFaces[currentTopology])
+        if (edgeRight > numSharedFaces)
         {
-            edgeRight -= m_numTopologyFaces[currentTopology];
+            edgeRight -= numSharedFaces;
         }
 
-        const auto xiLeft = m_topologyXi[currentTopology][edgeLeft];
-        const auto xiRight = m_topologyXi[currentTopology][edgeRight];
-        const auto etaLeft = m_topologyEta[currentTopology][edgeLeft];
-        const auto etaRight = m_topologyEta[currentTopology][edgeRight];
+        const auto xiLeft = topologyXi[edgeLeft];
+        const auto xiRight = topologyXi[edgeRight];
+        const auto etaLeft = topologyEta[edgeLeft];
+        const auto etaRight = topologyEta[edgeRight];
 
         const double edgeLeftSquaredDistance = std::sqrt(xiLeft * xiLeft + etaLeft * etaLeft + 1e-16);
         const double edgeRightSquaredDistance = std::sqrt(xiRight * xiRight + etaRight * etaRight + 1e-16);
         const double cPhi = (xiLeft * xiRight + etaLeft * etaRight) / (edgeLeftSquaredDistance * edgeRightSquaredDistance);
-        const auto numFaceNodes = m_mesh->GetNumFaceEdges(m_topologySharedFaces[currentTopology][f]);
+        const auto numFaceNodes = m_mesh->GetNumFaceEdges(topologySharedFaces[f]);
 
         // the value of xi and eta needs to be estimated at the circumcenters, calculated the contributions of each node
         if (numFaceNodes == 3)
         {
             // for triangular faces
-            int nodeIndex = FindIndex(m_mesh->m_facesNodes[m_topologySharedFaces[currentTopology][f]], currentNode);
+            int nodeIndex = m_mesh->m_facesNodesCsr.FindIndex(topologySharedFaces[f], currentNode);
             const auto nodeLeft = NextCircularBackwardIndex(nodeIndex, numFaceNodes);
             const auto nodeRight = NextCircularForwardIndex(nodeIndex, numFaceNodes);
 
@@ -294,49 +432,50 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
             double alphaLeft = 0.5 * (1.0 - edgeLeftSquaredDistance / edgeRightSquaredDistance * cPhi) * alpha;
             double alphaRight = 0.5 * (1.0 - edgeRightSquaredDistance / edgeLeftSquaredDistance * cPhi) * alpha;
 
-            m_Az[currentTopology][f][m_topologyFaceNodeMapping[currentTopology][f][nodeIndex]] = 1.0 - (alphaLeft + alphaRight);
-            m_Az[currentTopology][f][m_topologyFaceNodeMapping[currentTopology][f][nodeLeft]] = alphaLeft;
-            m_Az[currentTopology][f][m_topologyFaceNodeMapping[currentTopology][f][nodeRight]] = alphaRight;
+            const auto* faceNodeMapping = &topologyFaceNodeMapping[f * maximumNumberOfNodesPerFace];
+            operators.Az[f * numConnectedNodes + faceNodeMapping[nodeIndex]] = 1.0 - (alphaLeft + alphaRight);
+            operators.Az[f * numConnectedNodes + faceNodeMapping[nodeLeft]] = alphaLeft;
+            operators.Az[f * numConnectedNodes + faceNodeMapping[nodeRight]] = alphaRight;
         }
         else
         {
             // for non-triangular faces
-            for (const auto& element : m_topologyFaceNodeMapping[currentTopology][f])
+            for (int n = 0; n < numFaceNodes; n++)
             {
-                m_Az[currentTopology][f][element] = 1.0 / static_cast<double>(numFaceNodes);
+                operators.Az[f * numConnectedNodes + topologyFaceNodeMapping[f * maximumNumberOfNodesPerFace + n]] = 1.0 / static_cast<double>(numFaceNodes);
             }
         }
     }
 
     // Initialize caches
-    std::fill(m_boundaryEdgesCache.begin(), m_boundaryEdgesCache.end(), -1);
-    std::fill(m_leftXFaceCenterCache.begin(), m_leftXFaceCenterCache.end(), 0.0);
-    std::fill(m_leftYFaceCenterCache.begin(), m_leftYFaceCenterCache.end(), 0.0);
-    std::fill(m_rightXFaceCenterCache.begin(), m_rightXFaceCenterCache.end(), 0.0);
-    std::fill(m_rightYFaceCenterCache.begin(), m_rightYFaceCenterCache.end(), 0.0);
-    std::fill(m_xisCache.begin(), m_xisCache.end(), 0.0);
-    std::fill(m_etasCache.begin(), m_etasCache.end(), 0.0);
+    std::fill(cache.boundaryEdges.begin(), cache.boundaryEdges.end(), -1);
+    std::fill(cache.leftXFaceCenter.begin(), cache.leftXFaceCenter.end(), 0.0);
+    std::fill(cache.leftYFaceCenter.begin(), cache.leftYFaceCenter.end(), 0.0);
+    std::fill(cache.rightXFaceCenter.begin(), cache.rightXFaceCenter.end(), 0.0);
+    std::fill(cache.rightYFaceCenter.begin(), cache.rightYFaceCenter.end(), 0.0);
+    std::fill(cache.xis.begin(), cache.xis.end(), 0.0);
+    std::fill(cache.etas.begin(), cache.etas.end(), 0.0);
 
     int faceRightIndex = 0;
     int faceLeftIndex = 0;
     double xiBoundary = 0.0;
     double etaBoundary = 0.0;
 
-    for (int f = 0; f < m_numTopologyFaces[currentTopology]; f++)
+    for (int f = 0; f < numSharedFaces; f++)
     {
-        auto edgeIndex = m_mesh->m_nodesEdges[currentNode][f];
+        auto edgeIndex = m_mesh->m_nodesEdgesCsr(currentNode, f);
         int otherNode = m_mesh->m_edges[edgeIndex].first + m_mesh->m_edges[edgeIndex].second - currentNode;
         int leftFace = m_mesh->m_edgesFaces[edgeIndex][0];
-        faceLeftIndex = FindIndex(m_topologySharedFaces[currentTopology], leftFace);
+        faceLeftIndex = static_cast<int>(std::find(topologySharedFaces, topologySharedFaces + numSharedFaces, leftFace) - topologySharedFaces);
 
-        if (m_topologySharedFaces[currentTopology][faceLeftIndex] != leftFace)
+        if (faceLeftIndex == numSharedFaces)
         {
             throw std::invalid_argument("Smoother::ComputeOperatorsNode: Face could not be found, this happens when the cell is outside of the polygon.");
         }
 
         //by construction
-        double xiOne = m_topologyXi[currentTopology][f + 1];
-        double etaOne = m_topologyEta[currentTopology][f + 1];
+        double xiOne = topologyXi[f + 1];
+        double etaOne = topologyEta[f + 1];
 
         double leftRightSwap = 1.0;
         double leftXi = 0.0;
@@ -347,13 +486,13 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
         if (m_mesh->IsEdgeOnBoundary(edgeIndex))
         {
             // Boundary face
-            if (m_boundaryEdgesCache[0] < 0)
+            if (cache.boundaryEdges[0] < 0)
             {
-                m_boundaryEdgesCache[0] = f;
+                cache.boundaryEdges[0] = f;
             }
             else
             {
-                m_boundaryEdgesCache[1] = f;
+                cache.boundaryEdges[1] = f;
             }
 
             // Swap left and right if the boundary is at the left
@@ -363,12 +502,12 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
             }
 
             // Compute the face circumcenter
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
+            for (int i = 0; i < numConnectedNodes; i++)
             {
-                leftXi += m_topologyXi[currentTopology][i] * m_Az[currentTopology][faceLeftIndex][i];
-                leftEta += m_topologyEta[currentTopology][i] * m_Az[currentTopology][faceLeftIndex][i];
-                m_leftXFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x * m_Az[currentTopology][faceLeftIndex][i];
-                m_leftYFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y * m_Az[currentTopology][faceLeftIndex][i];
+                leftXi += topologyXi[i] * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                leftEta += topologyEta[i] * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                cache.leftXFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].x * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                cache.leftYFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].y * operators.Az[faceLeftIndex * numConnectedNodes + i];
             }
 
             double alpha = leftXi * xiOne + leftEta * etaOne;
@@ -383,19 +522,19 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
 
             const double xBc = (1.0 - alpha) * m_mesh->m_nodes[currentNode].x + alpha * m_mesh->m_nodes[otherNode].x;
             const double yBc = (1.0 - alpha) * m_mesh->m_nodes[currentNode].y + alpha * m_mesh->m_nodes[otherNode].y;
-            m_leftYFaceCenterCache[f] = 2.0 * xBc - m_leftXFaceCenterCache[f];
-            m_rightYFaceCenterCache[f] = 2.0 * yBc - m_leftYFaceCenterCache[f];
+            cache.leftYFaceCenter[f] = 2.0 * xBc - cache.leftXFaceCenter[f];
+            cache.rightYFaceCenter[f] = 2.0 * yBc - cache.leftYFaceCenter[f];
         }
         else
         {
             faceLeftIndex = f;
-            faceRightIndex = NextCircularBackwardIndex(faceLeftIndex, m_numTopologyFaces[currentTopology]);
+            faceRightIndex = NextCircularBackwardIndex(faceLeftIndex, numSharedFaces);
 
             if (faceRightIndex < 0)
                 continue;
 
-            auto faceLeft = m_topologySharedFaces[currentTopology][faceLeftIndex];
-            auto faceRight = m_topologySharedFaces[currentTopology][faceRightIndex];
+            auto faceLeft = topologySharedFaces[faceLeftIndex];
+            auto faceRight = topologySharedFaces[faceRightIndex];
 
             if ((faceLeft != m_mesh->m_edgesFaces[edgeIndex][0] && faceLeft != m_mesh->m_edgesFaces[edgeIndex][1]) ||
                 (faceRight != m_mesh->m_edgesFaces[edgeIndex][0] && faceRight != m_mesh->m_edgesFaces[edgeIndex][1]))
@@ -403,22 +542,22 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
                 throw std::invalid_argument("Smoother::ComputeOperatorsNode: Invalid argument.");
             }
 
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
+            for (int i = 0; i < numConnectedNodes; i++)
             {
-                leftXi += m_topologyXi[currentTopology][i] * m_Az[currentTopology][faceLeftIndex][i];
-                leftEta += m_topologyEta[currentTopology][i] * m_Az[currentTopology][faceLeftIndex][i];
-                rightXi += m_topologyXi[currentTopology][i] * m_Az[currentTopology][faceRightIndex][i];
-                rightEta += m_topologyEta[currentTopology][i] * m_Az[currentTopology][faceRightIndex][i];
-
-                m_leftXFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x * m_Az[currentTopology][faceLeftIndex][i];
-                m_leftYFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y * m_Az[currentTopology][faceLeftIndex][i];
-                m_rightXFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x * m_Az[currentTopology][faceRightIndex][i];
-                m_rightYFaceCenterCache[f] += m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y * m_Az[currentTopology][faceRightIndex][i];
+                leftXi += topologyXi[i] * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                leftEta += topologyEta[i] * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                rightXi += topologyXi[i] * operators.Az[faceRightIndex * numConnectedNodes + i];
+                rightEta += topologyEta[i] * operators.Az[faceRightIndex * numConnectedNodes + i];
+
+                cache.leftXFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].x * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                cache.leftYFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].y * operators.Az[faceLeftIndex * numConnectedNodes + i];
+                cache.rightXFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].x * operators.Az[faceRightIndex * numConnectedNodes + i];
+                cache.rightYFaceCenter[f] += m_mesh->m_nodes[topologyConnectedNodes[i]].y * operators.Az[faceRightIndex * numConnectedNodes + i];
             }
         }
 
-        m_xisCache[f] = 0.5 * (leftXi + rightXi);
-        m_etasCache[f] = 0.5 * (leftEta + rightEta);
+        cache.xis[f] = 0.5 * (leftXi + rightXi);
+        cache.etas[f] = 0.5 * (leftEta + rightEta);
 
         const double exiLR = rightXi - leftXi;
         const double eetaLR = rightEta - leftEta;
@@ -450,104 +589,107 @@ void meshkernel::Smoother::ComputeOperatorsNode(int currentNode)
 
         int node1 = f + 1;
         int node0 = 0;
-        for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
+        for (int i = 0; i < numConnectedNodes; i++)
         {
-            m_Gxi[currentTopology][f][i] = facxiL * m_Az[currentTopology][faceLeftIndex][i];
-            m_Geta[currentTopology][f][i] = facetaL * m_Az[currentTopology][faceLeftIndex][i];
+            operators.Gxi[f * numConnectedNodes + i] = facxiL * operators.Az[faceLeftIndex * numConnectedNodes + i];
+            operators.Geta[f * numConnectedNodes + i] = facetaL * operators.Az[faceLeftIndex * numConnectedNodes + i];
             if (!m_mesh->IsEdgeOnBoundary(edgeIndex))
             {
-                m_Gxi[currentTopology][f][i] += facxiR * m_Az[currentTopology][faceRightIndex][i];
-                m_Geta[currentTopology][f][i] += facetaR * m_Az[currentTopology][faceRightIndex][i];
+                operators.Gxi[f * numConnectedNodes + i] += facxiR * operators.Az[faceRightIndex * numConnectedNodes + i];
+                operators.Geta[f * numConnectedNodes + i] += facetaR * operators.Az[faceRightIndex * numConnectedNodes + i];
             }
         }
 
-        m_Gxi[currentTopology][f][node1] += facxi1;
-        m_Geta[currentTopology][f][node1] += faceta1;
+        operators.Gxi[f * numConnectedNodes + node1] += facxi1;
+        operators.Geta[f * numConnectedNodes + node1] += faceta1;
 
-        m_Gxi[currentTopology][f][node0] += facxi0;
-        m_Geta[currentTopology][f][node0] += faceta0;
+        operators.Gxi[f * numConnectedNodes + node0] += facxi0;
+        operators.Geta[f * numConnectedNodes + node0] += faceta0;
 
         //fill the node-based gradient matrix
-        m_Divxi[currentTopology][f] = -eetaLR * leftRightSwap;
-        m_Diveta[currentTopology][f] = exiLR * leftRightSwap;
+        operators.Divxi[f] = -eetaLR * leftRightSwap;
+        operators.Diveta[f] = exiLR * leftRightSwap;
 
         // boundary link
         if (m_mesh->IsEdgeOnBoundary(edgeIndex))
         {
-            m_Divxi[currentTopology][f] = 0.5 * m_Divxi[currentTopology][f] + etaBoundary * leftRightSwap;
-            m_Diveta[currentTopology][f] = 0.5 * m_Diveta[currentTopology][f] - xiBoundary * leftRightSwap;
+            operators.Divxi[f] = 0.5 * operators.Divxi[f] + etaBoundary * leftRightSwap;
+            operators.Diveta[f] = 0.5 * operators.Diveta[f] - xiBoundary * leftRightSwap;
         }
     }
 
     double volxi = 0.0;
-    for (int i = 0; i < m_mesh->m_nodesNumEdges[currentNode]; i++)
+    for (int i = 0; i < numSharedFaces; i++)
     {
-        volxi += 0.5 * (m_Divxi[currentTopology][i] * m_xisCache[i] + m_Diveta[currentTopology][i] * m_etasCache[i]);
+        volxi += 0.5 * (operators.Divxi[i] * cache.xis[i] + operators.Diveta[i] * cache.etas[i]);
     }
     if (volxi == 0.0)
     {
         volxi = 1.0;
     }
 
-    for (int i = 0; i < m_mesh->m_nodesNumEdges[currentNode]; i++)
+    for (int i = 0; i < numSharedFaces; i++)
     {
-        m_Divxi[currentTopology][i] = m_Divxi[currentTopology][i] / volxi;
-        m_Diveta[currentTopology][i] = m_Diveta[currentTopology][i] / volxi;
+        operators.Divxi[i] = operators.Divxi[i] / volxi;
+        operators.Diveta[i] = operators.Diveta[i] / volxi;
     }
 
     //compute the node-to-node gradients
-    for (int f = 0; f < m_numTopologyFaces[currentTopology]; f++)
+    for (int f = 0; f < numSharedFaces; f++)
     {
         // internal edge
-        if (!m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdges[currentNode][f]))
+        if (!m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdgesCsr(currentNode, f)))
         {
             int rightNode = f - 1;
             if (rightNode < 0)
             {
-                rightNode += m_mesh->m_nodesNumEdges[currentNode];
+                rightNode += numSharedFaces;
             }
-            for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
+            for (int i = 0; i < numConnectedNodes; i++)
             {
-                m_Jxi[currentTopology][i] += m_Divxi[currentTopology][f] * 0.5 * (m_Az[currentTopology][f][i] + m_Az[currentTopology][rightNode][i]);
-                m_Jeta[currentTopology][i] += m_Diveta[currentTopology][f] * 0.5 * (m_Az[currentTopology][f][i] + m_Az[currentTopology][rightNode][i]);
+                operators.Jxi[i] += operators.Divxi[f] * 0.5 * (operators.Az[f * numConnectedNodes + i] + operators.Az[rightNode * numConnectedNodes + i]);
+                operators.Jeta[i] += operators.Diveta[f] * 0.5 * (operators.Az[f * numConnectedNodes + i] + operators.Az[rightNode * numConnectedNodes + i]);
             }
         }
         else
         {
-            m_Jxi[currentTopology][0] += m_Divxi[currentTopology][f] * 0.5;
-            m_Jxi[currentTopology][f + 1] += m_Divxi[currentTopology][f] * 0.5;
-            m_Jeta[currentTopology][0] += m_Diveta[currentTopology][f] * 0.5;
-            m_Jeta[currentTopology][f + 1] += m_Diveta[currentTopology][f] * 0.5;
+            operators.Jxi[0] += operators.Divxi[f] * 0.5;
+            operators.Jxi[f + 1] += operators.Divxi[f] * 0.5;
+            operators.Jeta[0] += operators.Diveta[f] * 0.5;
+            operators.Jeta[f + 1] += operators.Diveta[f] * 0.5;
         }
     }
 
     //compute the weights in the Laplacian smoother
-    std::fill(m_ww2[currentTopology].begin(), m_ww2[currentTopology].end(), 0.0);
-    for (int n = 0; n < m_mesh->m_nodesNumEdges[currentNode]; n++)
+    std::fill(operators.ww2, operators.ww2 + numConnectedNodes, 0.0);
+    for (int n = 0; n < numSharedFaces; n++)
     {
-        for (int i = 0; i < m_numTopologyNodes[currentTopology]; i++)
+        for (int i = 0; i < numConnectedNodes; i++)
         {
-            m_ww2[currentTopology][i] += m_Divxi[currentTopology][n] * m_Gxi[currentTopology][n][i] + m_Diveta[currentTopology][n] * m_Geta[currentTopology][n][i];
+            operators.ww2[i] += operators.Divxi[n] * operators.Gxi[n * numConnectedNodes + i] + operators.Diveta[n] * operators.Geta[n * numConnectedNodes + i];
         }
     }
 }
 
 void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
+                                            NodeTopologyCache& cache,
                                             int numSharedFaces,
                                             int numConnectedNodes)
 {
     // the angles for the squared nodes connected to the stencil nodes, first the ones directly connected, then the others
-    std::vector<double> thetaSquare(numConnectedNodes, doubleMissingValue);
+    auto& thetaSquare = cache.thetaSquare;
+    thetaSquare.assign(numConnectedNodes, doubleMissingValue);
     // for each shared face, a boolean indicating if it is squared or not
-    std::vector<bool> isSquareFace(numSharedFaces, false);
+    auto& isSquareFace = cache.isSquareFace;
+    isSquareFace.assign(numSharedFaces, false);
 
     int numNonStencilQuad = 0;
 
     //loop over the connected edges
     for (int f = 0; f < numSharedFaces; f++)
     {
-        auto edgeIndex = m_mesh->m_nodesEdges[currentNode][f];
-        auto nextNode = m_connectedNodesCache[f + 1]; // the first entry is always the stencil node
+        auto edgeIndex = m_mesh->m_nodesEdgesCsr(currentNode, f);
+        auto nextNode = cache.connectedNodes[f + 1]; // the first entry is always the stencil node
         int faceLeft = m_mesh->m_edgesFaces[edgeIndex][0];
         int faceRigth = faceLeft;
 
@@ -560,7 +702,7 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
         bool isSquare = true;
         for (int e = 0; e < m_mesh->m_nodesNumEdges[nextNode]; e++)
         {
-            auto edge = m_mesh->m_nodesEdges[nextNode][e];
+            auto edge = m_mesh->m_nodesEdgesCsr(nextNode, e);
             for (int ff = 0; ff < m_mesh->m_edgesNumFaces[edge]; ff++)
             {
                 auto face = m_mesh->m_edgesFaces[edge][ff];
@@ -602,11 +744,11 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
                 thetaSquare[f + 1] = 0.5 * M_PI;
             }
 
-            if (m_sharedFacesCache[f] > 1 && m_mesh->GetNumFaceEdges(m_sharedFacesCache[f]) == 4)
+            if (cache.sharedFaces[f] > 1 && m_mesh->GetNumFaceEdges(cache.sharedFaces[f]) == 4)
             {
                 numNonStencilQuad += 1;
             }
-            if (m_sharedFacesCache[leftFaceIndex] > 1 && m_mesh->GetNumFaceEdges(m_sharedFacesCache[leftFaceIndex]) == 4)
+            if (cache.sharedFaces[leftFaceIndex] > 1 && m_mesh->GetNumFaceEdges(cache.sharedFaces[leftFaceIndex]) == 4)
             {
                 numNonStencilQuad += 1;
             }
@@ -623,19 +765,19 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
     for (int f = 0; f < numSharedFaces; f++)
     {
         // boundary face
-        if (m_sharedFacesCache[f] < 0)
+        if (cache.sharedFaces[f] < 0)
             continue;
 
         // non boundary face
-        if (m_mesh->GetNumFaceEdges(m_sharedFacesCache[f]) == 4)
+        if (m_mesh->GetNumFaceEdges(cache.sharedFaces[f]) == 4)
         {
-            for (int n = 0; n < m_mesh->GetNumFaceEdges(m_sharedFacesCache[f]); n++)
+            for (int n = 0; n < m_mesh->GetNumFaceEdges(cache.sharedFaces[f]); n++)
             {
-                if (m_faceNodeMappingCache[f][n] <= numSharedFaces)
+                if (cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + n] <= numSharedFaces)
                 {
                     continue;
                 }
-                thetaSquare[m_faceNodeMappingCache[f][n]] = 0.5 * M_PI;
+                thetaSquare[cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + n]] = 0.5 * M_PI;
             }
         }
     }
@@ -651,12 +793,12 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
     for (int f = 0; f < numSharedFaces; f++)
     {
         // boundary face
-        if (m_sharedFacesCache[f] < 0)
+        if (cache.sharedFaces[f] < 0)
         {
             continue;
         }
 
-        auto numFaceNodes = m_mesh->GetNumFaceEdges(m_sharedFacesCache[f]);
+        auto numFaceNodes = m_mesh->GetNumFaceEdges(cache.sharedFaces[f]);
         double phi = OptimalEdgeAngle(numFaceNodes);
 
         if (isSquareFace[f] || numFaceNodes == 4)
@@ -667,7 +809,7 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
                 nextNode = nextNode - numSharedFaces;
             }
 
-            phi = OptimalEdgeAngle(numFaceNodes, thetaSquare[f + 1], thetaSquare[nextNode], m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdges[currentNode][f]));
+            phi = OptimalEdgeAngle(numFaceNodes, thetaSquare[f + 1], thetaSquare[nextNode], m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdgesCsr(currentNode, f)));
             if (numFaceNodes == 3)
             {
                 numSquaredTriangles += 1;
@@ -719,8 +861,11 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
     else if (numSharedFaces > 0)
     {
         //TODO: add cirr(xk(k0), yk(k0), ncolhl)
-        m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].x);
-        m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].y);
+#pragma omp critical(SmootherNodeErrors)
+        {
+            m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].x);
+            m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].y);
+        }
         throw AlgorithmError("Smoother::ComputeNodeXiEta: Fatal error (phiTot=0).");
     }
 
@@ -731,7 +876,7 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
     for (int f = 0; f < numSharedFaces; f++)
     {
         phi0 = phi0 + 0.5 * dPhi;
-        if (m_sharedFacesCache[f] < 0)
+        if (cache.sharedFaces[f] < 0)
         {
             if (m_mesh->m_nodesTypes[currentNode] == 2)
             {
@@ -744,15 +889,18 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
             else
             {
                 //TODO: add cirr(xk(k0), yk(k0), ncolhl)
-                m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].x);
-                m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].y);
+#pragma omp critical(SmootherNodeErrors)
+                {
+                    m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].x);
+                    m_nodeXErrors.emplace_back(m_mesh->m_nodes[currentNode].y);
+                }
                 throw AlgorithmError("Smoother::ComputeNodeXiEta: Inappropriate fictitious boundary cell.");
             }
             phi0 = phi0 + 0.5 * dPhi;
             continue;
         }
 
-        int numFaceNodes = m_mesh->GetNumFaceEdges(m_sharedFacesCache[f]);
+        int numFaceNodes = m_mesh->GetNumFaceEdges(cache.sharedFaces[f]);
         if (numFaceNodes > maximumNumberOfEdgesPerNode)
         {
             throw AlgorithmError("Smoother::ComputeNodeXiEta: The number of face nodes is greater than the maximum number of edges per node.");
@@ -767,7 +915,7 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
                 nextNode = nextNode - numSharedFaces;
             }
 
-            dPhi0 = OptimalEdgeAngle(numFaceNodes, thetaSquare[f + 1], thetaSquare[nextNode], m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdges[currentNode][f]));
+            dPhi0 = OptimalEdgeAngle(numFaceNodes, thetaSquare[f + 1], thetaSquare[nextNode], m_mesh->IsEdgeOnBoundary(m_mesh->m_nodesEdgesCsr(currentNode, f)));
             if (numFaceNodes == 3)
             {
                 dPhi0 = muSquaredTriangles * dPhi0;
@@ -782,7 +930,7 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
         phi0 = phi0 + 0.5 * dPhi;
 
         // determine the index of the current stencil node
-        const auto nodeIndex = FindIndex(m_mesh->m_facesNodes[m_sharedFacesCache[f]], currentNode);
+        const auto nodeIndex = m_mesh->m_facesNodesCsr.FindIndex(cache.sharedFaces[f], currentNode);
 
         // optimal angle
         dTheta = 2.0 * M_PI / double(numFaceNodes);
@@ -791,8 +939,8 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
         int previousNode = NextCircularForwardIndex(nodeIndex, numFaceNodes);
         int nextNode = NextCircularBackwardIndex(nodeIndex, numFaceNodes);
 
-        if ((m_faceNodeMappingCache[f][nextNode] - m_faceNodeMappingCache[f][previousNode]) == -1 ||
-            (m_faceNodeMappingCache[f][nextNode] - m_faceNodeMappingCache[f][previousNode]) == m_mesh->m_nodesNumEdges[currentNode])
+        if ((cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + nextNode] - cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + previousNode]) == -1 ||
+            (cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + nextNode] - cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + previousNode]) == m_mesh->m_nodesNumEdges[currentNode])
         {
             dTheta = -dTheta;
         }
@@ -800,19 +948,22 @@ void meshkernel::Smoother::ComputeNodeXiEta(int currentNode,
         double aspectRatio = (1.0 - std::cos(dTheta)) / std::sin(std::abs(dTheta)) * std::tan(0.5 * dPhi);
         double radius = std::cos(0.5 * dPhi) / (1.0 - cos(dTheta));
 
+        const double cosPhi0 = std::cos(phi0);
+        const double sinPhi0 = std::sin(phi0);
         for (int n = 0; n < numFaceNodes; n++)
         {
             double theta = dTheta * (n - nodeIndex);
             double xip = radius - radius * std::cos(theta);
             double ethap = -radius * std::sin(theta);
 
-            m_xiCache[m_faceNodeMappingCache[f][n]] = xip * std::cos(phi0) - aspectRatio * ethap * std::sin(phi0);
-            m_etaCache[m_faceNodeMappingCache[f][n]] = xip * std::sin(phi0) + aspectRatio * ethap * std::cos(phi0);
+            cache.xi[cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + n]] = xip * cosPhi0 - aspectRatio * ethap * sinPhi0;
+            cache.eta[cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + n]] = xip * sinPhi0 + aspectRatio * ethap * cosPhi0;
         }
     }
 }
 
 void meshkernel::Smoother::NodeAdministration(int currentNode,
+                                              NodeTopologyCache& cache,
                                               int& numSharedFaces,
                                               int& numConnectedNodes)
 {
@@ -828,7 +979,7 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
     int newFaceIndex = intMissingValue;
     for (int e = 0; e < m_mesh->m_nodesNumEdges[currentNode]; e++)
     {
-        const auto firstEdge = m_mesh->m_nodesEdges[currentNode][e];
+        const auto firstEdge = m_mesh->m_nodesEdgesCsr(currentNode, e);
 
         int secondEdgeIndex = e + 1;
         if (secondEdgeIndex >= m_mesh->m_nodesNumEdges[currentNode])
@@ -836,7 +987,7 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
             secondEdgeIndex = 0;
         }
 
-        const auto secondEdge = m_mesh->m_nodesEdges[currentNode][secondEdgeIndex];
+        const auto secondEdge = m_mesh->m_nodesEdgesCsr(currentNode, secondEdgeIndex);
         if (m_mesh->m_edgesNumFaces[firstEdge] < 1 || m_mesh->m_edgesNumFaces[secondEdge] < 1)
         {
             continue;
@@ -864,11 +1015,11 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
         }
 
         //corner face (already found in the first iteration)
-        if (m_mesh->m_nodesNumEdges[currentNode] == 2 && e == 1 && m_mesh->m_nodesTypes[currentNode] == 3 && m_sharedFacesCache[0] == newFaceIndex)
+        if (m_mesh->m_nodesNumEdges[currentNode] == 2 && e == 1 && m_mesh->m_nodesTypes[currentNode] == 3 && cache.sharedFaces[0] == newFaceIndex)
         {
             newFaceIndex = intMissingValue;
         }
-        m_sharedFacesCache[numSharedFaces] = newFaceIndex;
+        cache.sharedFaces[numSharedFaces] = newFaceIndex;
         numSharedFaces += 1;
     }
 
@@ -879,30 +1030,25 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
     }
 
     int connectedNodesIndex = 0;
-    m_connectedNodesCache[connectedNodesIndex] = currentNode;
+    cache.connectedNodes[connectedNodesIndex] = currentNode;
 
     // edge connected nodes
     for (int e = 0; e < m_mesh->m_nodesNumEdges[currentNode]; e++)
     {
-        const auto edgeIndex = m_mesh->m_nodesEdges[currentNode][e];
+        const auto edgeIndex = m_mesh->m_nodesEdgesCsr(currentNode, e);
         const auto node = m_mesh->m_edges[edgeIndex].first + m_mesh->m_edges[edgeIndex].second - currentNode;
         connectedNodesIndex++;
-        m_connectedNodesCache[connectedNodesIndex] = node;
-        if (int(m_connectedNodes[currentNode].size()) < connectedNodesIndex + 1)
-        {
-            m_connectedNodes[currentNode].resize(connectedNodesIndex);
-        }
-        m_connectedNodes[currentNode][connectedNodesIndex] = node;
+        cache.connectedNodes[connectedNodesIndex] = node;
     }
 
     // for each face store the positions of the its nodes in the connectedNodes (compressed array)
-    if (m_faceNodeMappingCache.size() < numSharedFaces)
+    if (cache.faceNodeMapping.size() < numSharedFaces * maximumNumberOfNodesPerFace)
     {
-        m_faceNodeMappingCache.resize(numSharedFaces, std::vector<size_t>(maximumNumberOfNodesPerFace, 0));
+        cache.faceNodeMapping.resize(numSharedFaces * maximumNumberOfNodesPerFace, 0);
     }
     for (int f = 0; f < numSharedFaces; f++)
     {
-        const auto faceIndex = m_sharedFacesCache[f];
+        const auto faceIndex = cache.sharedFaces[f];
         if (faceIndex < 0)
         {
             continue;
@@ -913,7 +1059,7 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
         const auto numFaceNodes = m_mesh->GetNumFaceEdges(faceIndex);
         for (int n = 0; n < numFaceNodes; n++)
         {
-            if (m_mesh->m_facesNodes[faceIndex][n] == currentNode)
+            if (m_mesh->m_facesNodesCsr(faceIndex, n) == currentNode)
             {
                 faceNodeIndex = n;
                 break;
@@ -928,15 +1074,15 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
                 faceNodeIndex -= numFaceNodes;
             }
 
-            const auto node = m_mesh->m_facesNodes[faceIndex][faceNodeIndex];
+            const auto node = m_mesh->m_facesNodesCsr(faceIndex, faceNodeIndex);
 
             bool isNewNode = true;
             for (int i = 0; i < connectedNodesIndex + 1; i++)
             {
-                if (node == m_connectedNodesCache[i])
+                if (node == cache.connectedNodes[i])
                 {
                     isNewNode = false;
-                    m_faceNodeMappingCache[f][faceNodeIndex] = i;
+                    cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + faceNodeIndex] = i;
                     break;
                 }
             }
@@ -944,13 +1090,8 @@ void meshkernel::Smoother::NodeAdministration(int currentNode,
             if (isNewNode)
             {
                 connectedNodesIndex++;
-                m_connectedNodesCache[connectedNodesIndex] = node;
-                m_faceNodeMappingCache[f][faceNodeIndex] = connectedNodesIndex;
-                if (int(m_connectedNodes[currentNode].size()) < connectedNodesIndex + 1)
-                {
-                    m_connectedNodes[currentNode].resize(connectedNodesIndex);
-                }
-                m_connectedNodes[currentNode][connectedNodesIndex] = node;
+                cache.connectedNodes[connectedNodesIndex] = node;
+                cache.faceNodeMapping[f * maximumNumberOfNodesPerFace + faceNodeIndex] = connectedNodesIndex;
             }
 
             //update node index
@@ -982,7 +1123,98 @@ double meshkernel::Smoother::OptimalEdgeAngle(int numFaceNodes, double theta1, d
     return angle;
 }
 
-double meshkernel::Smoother::MatrixNorm(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& matCoefficents) const
+void meshkernel::Smoother::ComputeMonitorMatrices(std::vector<std::array<double, 4>>& Ginv)
+{
+    std::fill(Ginv.begin(), Ginv.end(), std::array<double, 4>{1.0, 0.0, 0.0, 1.0});
+    if (m_adaptationStrength <= 0.0 || m_adaptationSamples.empty())
+    {
+        return;
+    }
+
+    // the node values are kept between outer iterations, the nodes move little
+    const auto numNodes = m_mesh->GetNumNodes();
+    if (m_adaptationNodeValues.empty())
+    {
+        ComputeAdaptationNodeValues();
+    }
+    if (static_cast<int>(m_adaptationNodeValues.size()) != numNodes)
+    {
+        throw std::invalid_argument("Smoother::ComputeMonitorMatrices: The adaptation samples were averaged on another mesh.");
+    }
+
+    // the gradient of the node values, from the node derivatives of the values and of the coordinates of the connected nodes
+    std::vector<std::array<double, 2>> gradients(numNodes, {0.0, 0.0});
+#pragma omp parallel for
+    for (int n = 0; n < numNodes; n++)
+    {
+        if (m_mesh->m_nodesTypes[n] != 1 && m_mesh->m_nodesTypes[n] != 2 && m_mesh->m_nodesTypes[n] != 4)
+        {
+            continue;
+        }
+
+        const auto currentTopology = m_nodeTopologyMapping[n];
+        const auto numConnectedNodes = m_numTopologyNodes[currentTopology];
+        const auto* connectedNodes = &m_connectedNodes[m_connectedNodesOffsets[n]];
+        const auto operators = GetNodeOperators(currentTopology);
+        const bool isSpherical = m_mesh->m_projection == Projections::spherical || m_mesh->m_projection == Projections::sphericalAccurate;
+        const double cosFactor = isSpherical ? std::cos(m_mesh->m_nodes[n].y * degrad_hp) : 1.0;
+
+        std::array<double, 4> nodeJ{0.0, 0.0, 0.0, 0.0};
+        double valueDxi = 0.0;
+        double valueDeta = 0.0;
+        bool isValid = true;
+        for (int i = 0; i < numConnectedNodes; i++)
+        {
+            const auto& node = m_mesh->m_nodes[connectedNodes[i]];
+            const auto value = m_adaptationNodeValues[connectedNodes[i]];
+            if (value == doubleMissingValue)
+            {
+                isValid = false;
+                break;
+            }
+            nodeJ[0] += operators.Jxi[i] * node.x * cosFactor;
+            nodeJ[1] += operators.Jxi[i] * node.y;
+            nodeJ[2] += operators.Jeta[i] * node.x * cosFactor;
+            nodeJ[3] += operators.Jeta[i] * node.y;
+            valueDxi += operators.Jxi[i] * value;
+            valueDeta += operators.Jeta[i] * value;
+        }
+
+        const double determinant = nodeJ[0] * nodeJ[3] - nodeJ[2] * nodeJ[1];
+        if (!isValid || determinant == 0.0)
+        {
+            continue;
+        }
+
+        gradients[n][0] = (valueDxi * nodeJ[3] - valueDeta * nodeJ[1]) / determinant;
+        gradients[n][1] = (-valueDxi * nodeJ[2] + valueDeta * nodeJ[0]) / determinant;
+    }
+
+    double maximumSquaredGradient = 0.0;
+    for (const auto& gradient : gradients)
+    {
+        maximumSquaredGradient = std::max(maximumSquaredGradient, gradient[0] * gradient[0] + gradient[1] * gradient[1]);
+    }
+    if (maximumSquaredGradient == 0.0)
+    {
+        return;
+    }
+
+    // G = I + c g g^T, its inverse is I - c g g^T / (1 + c |g|^2)
+    const double c = m_adaptationStrength / maximumSquaredGradient;
+#pragma omp parallel for
+    for (int n = 0; n < numNodes; n++)
+    {
+        const auto& gradient = gradients[n];
+        const double factor = c / (1.0 + c * (gradient[0] * gradient[0] + gradient[1] * gradient[1]));
+        Ginv[n] = {1.0 - factor * gradient[0] * gradient[0],
+                   -factor * gradient[0] * gradient[1],
+                   -factor * gradient[1] * gradient[0],
+                   1.0 - factor * gradient[1] * gradient[1]};
+    }
+}
+
+double meshkernel::Smoother::MatrixNorm(const std::array<double, 2>& x, const std::array<double, 2>& y, const std::array<double, 4>& matCoefficents) const
 {
     const double norm = (matCoefficents[0] * x[0] + matCoefficents[1] * x[1]) * y[0] + (matCoefficents[2] * x[0] + matCoefficents[3] * x[1]) * y[1];
     return norm;
@@ -994,23 +1226,19 @@ void meshkernel::Smoother::Initialize()
     m_numConnectedNodes.resize(m_mesh->GetNumNodes());
     std::fill(m_numConnectedNodes.begin(), m_numConnectedNodes.end(), 0.0);
 
-    m_connectedNodes.resize(m_mesh->GetNumNodes());
-    std::fill(m_connectedNodes.begin(), m_connectedNodes.end(), std::vector<size_t>(maximumNumberOfConnectedNodes, 0));
-
-    m_sharedFacesCache.resize(maximumNumberOfEdgesPerNode, -1);
-    std::fill(m_sharedFacesCache.begin(), m_sharedFacesCache.end(), -1);
+    m_connectedNodesOffsets.resize(m_mesh->GetNumNodes() + 1);
+    m_connectedNodesOffsets[0] = 0;
 
-    m_connectedNodesCache.resize(maximumNumberOfConnectedNodes, 0);
-    std::fill(m_connectedNodesCache.begin(), m_connectedNodesCache.end(), 0);
+    m_connectedNodes.clear();
+    m_connectedNodes.reserve(m_mesh->GetNumNodes() * maximumNumberOfConnectedNodes);
 
-    m_faceNodeMappingCache.resize(maximumNumberOfConnectedNodes);
-    std::fill(m_faceNodeMappingCache.begin(), m_faceNodeMappingCache.end(), std::vector<size_t>(maximumNumberOfNodesPerFace, 0));
+    m_nodeTopologyCache = MakeNodeTopologyCache();
 
-    m_xiCache.resize(maximumNumberOfConnectedNodes, 0.0);
-    std::fill(m_xiCache.begin(), m_xiCache.end(), 0.0);
+    m_thetaCache.resize(maximumNumberOfConnectedNodes, 0.0);
+    std::fill(m_thetaCache.begin(), m_thetaCache.end(), 0.0);
 
-    m_etaCache.resize(maximumNumberOfConnectedNodes, 0.0);
-    std::fill(m_etaCache.begin(), m_etaCache.end(), 0.0);
+    m_quantizedThetaCache.resize(maximumNumberOfConnectedNodes, 0);
+    std::fill(m_quantizedThetaCache.begin(), m_quantizedThetaCache.end(), 0);
 
     // topology
     m_numTopologies = 0;
@@ -1018,122 +1246,235 @@ void meshkernel::Smoother::Initialize()
     m_nodeTopologyMapping.resize(m_mesh->GetNumNodes());
     std::fill(m_nodeTopologyMapping.begin(), m_nodeTopologyMapping.end(), -1);
 
-    m_numTopologyNodes.resize(m_topologyInitialSize);
-    std::fill(m_numTopologyNodes.begin(), m_numTopologyNodes.end(), -1);
-
-    m_numTopologyFaces.resize(m_topologyInitialSize);
-    std::fill(m_numTopologyFaces.begin(), m_numTopologyFaces.end(), -1);
+    // the topology data is appended when a new topology is found
+    m_numTopologyNodes.clear();
+    m_numTopologyNodes.reserve(m_topologyInitialSize);
 
-    m_topologyXi.resize(m_topologyInitialSize);
-    std::fill(m_topologyXi.begin(), m_topologyXi.end(), std::vector<double>(maximumNumberOfConnectedNodes, 0.0));
+    m_numTopologyFaces.clear();
+    m_numTopologyFaces.reserve(m_topologyInitialSize);
 
-    m_topologyEta.resize(m_topologyInitialSize);
-    std::fill(m_topologyEta.begin(), m_topologyEta.end(), std::vector<double>(maximumNumberOfConnectedNodes, 0.0));
+    m_topologyNodesOffsets.clear();
+    m_topologyNodesOffsets.reserve(m_topologyInitialSize);
 
-    m_topologySharedFaces.resize(m_topologyInitialSize);
-    std::fill(m_topologySharedFaces.begin(), m_topologySharedFaces.end(), std::vector<int>(maximumNumberOfConnectedNodes, -1));
+    m_topologyFacesOffsets.clear();
+    m_topologyFacesOffsets.reserve(m_topologyInitialSize);
 
-    m_topologyConnectedNodes.resize(m_topologyInitialSize);
-    std::fill(m_topologyConnectedNodes.begin(), m_topologyConnectedNodes.end(), std::vector<size_t>(maximumNumberOfConnectedNodes, 0));
-
-    m_topologyFaceNodeMapping.resize(m_topologyInitialSize);
-    std::fill(m_topologyFaceNodeMapping.begin(), m_topologyFaceNodeMapping.end(), std::vector<std::vector<size_t>>(maximumNumberOfConnectedNodes, std::vector<size_t>(maximumNumberOfConnectedNodes, 0)));
+    m_topologyXi.clear();
+    m_topologyEta.clear();
+    m_topologySharedFaces.clear();
+    m_topologyConnectedNodes.clear();
+    m_topologyFaceNodeMapping.clear();
+    m_topologyTheta.clear();
+    m_topologySignatures.clear();
 }
 
-void meshkernel::Smoother::AllocateNodeOperators(int topologyIndex)
+meshkernel::Smoother::OperatorsCache meshkernel::Smoother::MakeOperatorsCache()
 {
-    const auto numSharedFaces = m_numTopologyFaces[topologyIndex];
-    const auto numConnectedNodes = m_numTopologyNodes[topologyIndex];
-
-    //// will reallocate only if necessary
-    m_Az[topologyIndex].resize(numSharedFaces);
-    std::fill(m_Az[topologyIndex].begin(), m_Az[topologyIndex].end(), std::vector<double>(numConnectedNodes, 0.0));
+    OperatorsCache cache;
+    cache.boundaryEdges.resize(2, -1);
+    cache.leftXFaceCenter.resize(maximumNumberOfEdgesPerNode, 0.0);
+    cache.leftYFaceCenter.resize(maximumNumberOfEdgesPerNode, 0.0);
+    cache.rightXFaceCenter.resize(maximumNumberOfEdgesPerNode, 0.0);
+    cache.rightYFaceCenter.resize(maximumNumberOfEdgesPerNode, 0.0);
+    cache.xis.resize(maximumNumberOfEdgesPerNode, 0.0);
+    cache.etas.resize(maximumNumberOfEdgesPerNode, 0.0);
+    return cache;
+}
 
-    m_Gxi[topologyIndex].resize(numSharedFaces);
-    std::fill(m_Gxi[topologyIndex].begin(), m_Gxi[topologyIndex].end(), std::vector<double>(numConnectedNodes, 0.0));
+meshkernel::Smoother::NodeTopologyCache meshkernel::Smoother::MakeNodeTopologyCache()
+{
+    NodeTopologyCache cache;
+    cache.sharedFaces.resize(maximumNumberOfEdgesPerNode, -1);
+    cache.connectedNodes.resize(maximumNumberOfConnectedNodes, 0);
+    cache.faceNodeMapping.resize(maximumNumberOfConnectedNodes * maximumNumberOfNodesPerFace, 0);
+    cache.xi.resize(maximumNumberOfConnectedNodes, 0.0);
+    cache.eta.resize(maximumNumberOfConnectedNodes, 0.0);
+    return cache;
+}
 
-    m_Geta[topologyIndex].resize(numSharedFaces);
-    std::fill(m_Geta[topologyIndex].begin(), m_Geta[topologyIndex].end(), std::vector<double>(numConnectedNodes, 0.0));
+template <typename T>
+meshkernel::Smoother::NodeOperators<T> meshkernel::Smoother::MakeNodeOperators(T* operators, int numSharedFaces, int numConnectedNodes)
+{
+    NodeOperators<T> result;
+    result.Az = operators;
+    result.Gxi = result.Az + numSharedFaces * numConnectedNodes;
+    result.Geta = result.Gxi + numSharedFaces * numConnectedNodes;
+    result.Divxi = result.Geta + numSharedFaces * numConnectedNodes;
+    result.Diveta = result.Divxi + numSharedFaces;
+    result.Jxi = result.Diveta + numSharedFaces;
+    result.Jeta = result.Jxi + numConnectedNodes;
+    result.ww2 = result.Jeta + numConnectedNodes;
+    return result;
+}
 
-    m_Divxi[topologyIndex].resize(numSharedFaces);
-    std::fill(m_Divxi[topologyIndex].begin(), m_Divxi[topologyIndex].end(), 0.0);
+meshkernel::Smoother::NodeOperators<double> meshkernel::Smoother::GetNodeOperators(int topology)
+{
+    return MakeNodeOperators(m_topologyOperators.data() + m_topologyOperatorsOffsets[topology], m_numTopologyFaces[topology], m_numTopologyNodes[topology]);
+}
 
-    m_Diveta[topologyIndex].resize(numSharedFaces);
-    std::fill(m_Diveta[topologyIndex].begin(), m_Diveta[topologyIndex].end(), 0.0);
+meshkernel::Smoother::NodeOperators<const double> meshkernel::Smoother::GetNodeOperators(int topology) const
+{
+    return MakeNodeOperators(m_topologyOperators.data() + m_topologyOperatorsOffsets[topology], m_numTopologyFaces[topology], m_numTopologyNodes[topology]);
+}
 
-    m_Jxi[topologyIndex].resize(numConnectedNodes);
-    std::fill(m_Jxi[topologyIndex].begin(), m_Jxi[topologyIndex].end(), 0.0);
+void meshkernel::Smoother::SaveNodeTopologyIfNeeded(int currentNode,
+                                                    int numSharedFaces,
+                                                    int numConnectedNodes,
+                                                    const double* xi,
+                                                    const double* eta)
+{
+    for (int n = 0; n < numConnectedNodes; n++)
+    {
+        m_thetaCache[n] = std::atan2(eta[n], xi[n]);
+    }
 
-    m_Jeta[topologyIndex].resize(numConnectedNodes);
-    std::fill(m_Jeta[topologyIndex].begin(), m_Jeta[topologyIndex].end(), 0.0);
+    const auto topology = FindTopology(numSharedFaces, numConnectedNodes);
+    if (topology >= 0)
+    {
+        m_nodeTopologyMapping[currentNode] = topology;
+        return;
+    }
 
-    m_ww2[topologyIndex].resize(numConnectedNodes);
-    std::fill(m_ww2[topologyIndex].begin(), m_ww2[topologyIndex].end(), 0.0);
+    // the shared faces and the face node mapping are only needed for new topologies, compute them again
+    int numNodeSharedFaces = 0;
+    int numNodeConnectedNodes = 0;
+    std::fill(m_nodeTopologyCache.sharedFaces.begin(), m_nodeTopologyCache.sharedFaces.end(), -1);
+    std::fill(m_nodeTopologyCache.connectedNodes.begin(), m_nodeTopologyCache.connectedNodes.end(), 0);
+    NodeAdministration(currentNode, m_nodeTopologyCache, numNodeSharedFaces, numNodeConnectedNodes);
+
+    const auto topologyIndex = m_numTopologies;
+    m_nodeTopologyMapping[currentNode] = topologyIndex;
+    m_numTopologies += 1;
+
+    m_numTopologyNodes.push_back(numConnectedNodes);
+    m_numTopologyFaces.push_back(numSharedFaces);
+    m_topologyNodesOffsets.push_back(static_cast<int>(m_topologyXi.size()));
+    m_topologyFacesOffsets.push_back(static_cast<int>(m_topologySharedFaces.size()));
+
+    m_topologyXi.insert(m_topologyXi.end(), xi, xi + numConnectedNodes);
+    m_topologyEta.insert(m_topologyEta.end(), eta, eta + numConnectedNodes);
+    m_topologyTheta.insert(m_topologyTheta.end(), m_thetaCache.begin(), m_thetaCache.begin() + numConnectedNodes);
+    m_topologyConnectedNodes.insert(m_topologyConnectedNodes.end(), m_nodeTopologyCache.connectedNodes.begin(), m_nodeTopologyCache.connectedNodes.begin() + numConnectedNodes);
+    m_topologySharedFaces.insert(m_topologySharedFaces.end(), m_nodeTopologyCache.sharedFaces.begin(), m_nodeTopologyCache.sharedFaces.begin() + numSharedFaces);
+    m_topologyFaceNodeMapping.insert(m_topologyFaceNodeMapping.end(), m_nodeTopologyCache.faceNodeMapping.begin(), m_nodeTopologyCache.faceNodeMapping.begin() + numSharedFaces * maximumNumberOfNodesPerFace);
+
+    for (int n = 1; n < numConnectedNodes; n++)
+    {
+        m_quantizedThetaCache[n] = static_cast<long long>(std::floor(m_thetaCache[n] / m_thetaQuantization));
+    }
+    m_topologySignatures[TopologySignature(numSharedFaces, numConnectedNodes, m_quantizedThetaCache)].emplace_back(topologyIndex);
 }
 
-void meshkernel::Smoother::SaveNodeTopologyIfNeeded(int currentNode,
-                                                    int numSharedFaces,
-                                                    int numConnectedNodes)
+int meshkernel::Smoother::FindTopology(int numSharedFaces, int numConnectedNodes)
 {
-    bool isNewTopology = true;
-    for (int topo = 0; topo < m_numTopologies; topo++)
+    // an angle closer than m_thetaTolerance to a quantization step can match an angle in the neighbouring quantization,
+    // for these angles both quantizations are probed
+    std::array<int, m_maximumNumProbedAngles> probedAngles{};
+    std::array<long long, m_maximumNumProbedAngles> ownQuantizedTheta{};
+    std::array<long long, m_maximumNumProbedAngles> neighbourQuantizedTheta{};
+    int numProbedAngles = 0;
+    for (int n = 1; n < numConnectedNodes; n++)
     {
-        if (numSharedFaces != m_numTopologyFaces[topo] || numConnectedNodes != m_numTopologyNodes[topo])
+        const double quantizedTheta = std::floor(m_thetaCache[n] / m_thetaQuantization);
+        m_quantizedThetaCache[n] = static_cast<long long>(quantizedTheta);
+
+        const double lowerDistance = m_thetaCache[n] - quantizedTheta * m_thetaQuantization;
+        const double upperDistance = (quantizedTheta + 1.0) * m_thetaQuantization - m_thetaCache[n];
+        if (lowerDistance > 2.0 * m_thetaTolerance && upperDistance > 2.0 * m_thetaTolerance)
         {
             continue;
         }
 
-        isNewTopology = false;
-        for (int n = 1; n < numConnectedNodes; n++)
+        if (numProbedAngles == m_maximumNumProbedAngles)
         {
-            double thetaLoc = std::atan2(m_etaCache[n], m_xiCache[n]);
-            double thetaTopology = std::atan2(m_topologyEta[topo][n], m_topologyXi[topo][n]);
-            if (std::abs(thetaLoc - thetaTopology) > m_thetaTolerance)
+            // too many combinations to probe, compare with all topologies
+            for (int t = 0; t < m_numTopologies; t++)
             {
-                isNewTopology = true;
-                break;
+                if (IsMatchingTopology(t, numSharedFaces, numConnectedNodes))
+                {
+                    return t;
+                }
             }
+            return -1;
+        }
+
+        probedAngles[numProbedAngles] = n;
+        ownQuantizedTheta[numProbedAngles] = m_quantizedThetaCache[n];
+        neighbourQuantizedTheta[numProbedAngles] = lowerDistance < upperDistance ? m_quantizedThetaCache[n] - 1 : m_quantizedThetaCache[n] + 1;
+        numProbedAngles++;
+    }
+
+    // the first matching topology, as if all topologies were compared in order
+    int result = -1;
+    for (int probe = 0; probe < 1 << numProbedAngles; probe++)
+    {
+        for (int i = 0; i < numProbedAngles; i++)
+        {
+            m_quantizedThetaCache[probedAngles[i]] = probe & 1 << i ? neighbourQuantizedTheta[i] : ownQuantizedTheta[i];
         }
 
-        if (!isNewTopology)
+        const auto signature = m_topologySignatures.find(TopologySignature(numSharedFaces, numConnectedNodes, m_quantizedThetaCache));
+        if (signature == m_topologySignatures.end())
         {
-            m_nodeTopologyMapping[currentNode] = topo;
-            break;
+            continue;
+        }
+        for (const auto topology : signature->second)
+        {
+            if (result >= 0 && topology > result)
+            {
+                break;
+            }
+            if (IsMatchingTopology(topology, numSharedFaces, numConnectedNodes))
+            {
+                result = topology;
+                break;
+            }
         }
     }
+    return result;
+}
 
-    if (isNewTopology)
+bool meshkernel::Smoother::IsMatchingTopology(int topology, int numSharedFaces, int numConnectedNodes) const
+{
+    if (numSharedFaces != m_numTopologyFaces[topology] || numConnectedNodes != m_numTopologyNodes[topology])
     {
-        m_numTopologies += 1;
+        return false;
+    }
 
-        if (m_numTopologies > m_numTopologyNodes.size())
+    const auto* topologyTheta = m_topologyTheta.data() + m_topologyNodesOffsets[topology];
+    for (int n = 1; n < numConnectedNodes; n++)
+    {
+        if (std::abs(m_thetaCache[n] - topologyTheta[n]) > m_thetaTolerance)
         {
-            m_numTopologyNodes.resize(int(m_numTopologies * 1.5), 0);
-            m_numTopologyFaces.resize(int(m_numTopologies * 1.5), 0);
-            m_topologyXi.resize(int(m_numTopologies * 1.5), std::vector<double>(maximumNumberOfConnectedNodes, 0));
-            m_topologyEta.resize(int(m_numTopologies * 1.5), std::vector<double>(maximumNumberOfConnectedNodes, 0));
-
-            m_topologySharedFaces.resize(int(m_numTopologies * 1.5), std::vector<int>(maximumNumberOfEdgesPerNode, -1));
-            m_topologyConnectedNodes.resize(int(m_numTopologies * 1.5), std::vector<size_t>(maximumNumberOfConnectedNodes, 0));
-            m_topologyFaceNodeMapping.resize(int(m_numTopologies * 1.5), std::vector<std::vector<size_t>>(maximumNumberOfConnectedNodes, std::vector<size_t>(maximumNumberOfConnectedNodes, 0)));
+            return false;
         }
+    }
+    return true;
+}
 
-        int topologyIndex = m_numTopologies - 1;
-        m_numTopologyNodes[topologyIndex] = numConnectedNodes;
-        m_topologyConnectedNodes[topologyIndex] = m_connectedNodesCache;
-        m_numTopologyFaces[topologyIndex] = numSharedFaces;
-        m_topologySharedFaces[topologyIndex] = m_sharedFacesCache;
-        m_topologyXi[topologyIndex] = m_xiCache;
-        m_topologyEta[topologyIndex] = m_etaCache;
-        m_topologyFaceNodeMapping[topologyIndex] = m_faceNodeMappingCache;
-        m_nodeTopologyMapping[currentNode] = topologyIndex;
+std::size_t meshkernel::Smoother::TopologySignature(int numSharedFaces,
+                                                    int numConnectedNodes,
+                                                    const std::vector<long long>& quantizedTheta)
+{
+    const auto combine = [](std::size_t seed, long long value) {
+        return seed ^ (std::hash<long long>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+
+    std::size_t signature = combine(0, numSharedFaces);
+    signature = combine(signature, numConnectedNodes);
+    for (int n = 1; n < numConnectedNodes; n++)
+    {
+        signature = combine(signature, quantizedTheta[n]);
     }
+    return signature;
 }
 
-void meshkernel::Smoother::ComputeJacobian(int currentNode, std::vector<double>& J) const
+void meshkernel::Smoother::ComputeJacobian(int currentNode, std::array<double, 4>& J) const
 {
     const auto currentTopology = m_nodeTopologyMapping[currentNode];
     const auto numNodes = m_numTopologyNodes[currentTopology];
+    const auto* topologyConnectedNodes = &m_topologyConnectedNodes[m_topologyNodesOffsets[currentTopology]];
+    const auto operators = GetNodeOperators(currentTopology);
     if (m_mesh->m_projection == Projections::cartesian)
     {
         J[0] = 0.0;
@@ -1142,10 +1483,10 @@ void meshkernel::Smoother::ComputeJacobian(int currentNode, std::vector<double>&
         J[3] = 0.0;
         for (int i = 0; i < numNodes; i++)
         {
-            J[0] += m_Jxi[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x;
-            J[1] += m_Jxi[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y;
-            J[2] += m_Jeta[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x;
-            J[3] += m_Jeta[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y;
+            J[0] += operators.Jxi[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].x;
+            J[1] += operators.Jxi[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].y;
+            J[2] += operators.Jeta[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].x;
+            J[3] += operators.Jeta[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].y;
         }
     }
     if (m_mesh->m_projection == Projections::spherical || m_mesh->m_projection == Projections::sphericalAccurate)
@@ -1157,10 +1498,10 @@ void meshkernel::Smoother::ComputeJacobian(int currentNode, std::vector<double>&
         J[3] = 0.0;
         for (int i = 0; i < numNodes; i++)
         {
-            J[0] += m_Jxi[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x * cosFactor;
-            J[1] += m_Jxi[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y;
-            J[2] += m_Jeta[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].x * cosFactor;
-            J[3] += m_Jeta[currentTopology][i] * m_mesh->m_nodes[m_topologyConnectedNodes[currentTopology][i]].y;
+            J[0] += operators.Jxi[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].x * cosFactor;
+            J[1] += operators.Jxi[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].y;
+            J[2] += operators.Jeta[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].x * cosFactor;
+            J[3] += operators.Jeta[i] * m_mesh->m_nodes[topologyConnectedNodes[i]].y;
         }
     }
 }
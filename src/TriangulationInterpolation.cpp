@@ -27,7 +27,6 @@
 
 #pragma once
 #include <MeshKernel/TriangulationInterpolation.hpp>
-#include <MeshKernel/TriangulationWrapper.hpp>
 
 #include <MeshKernel/Entities.hpp>
 #include <MeshKernel/Operations.cpp>
@@ -40,10 +39,18 @@ meshkernel::TriangulationInterpolation::TriangulationInterpolation(const std::ve
                                                                                              m_samples(samples),
                                                                                              m_projection(projection){};
 
+meshkernel::TriangulationInterpolation::TriangulationInterpolation(const std::vector<Point>& m_locations,
+                                                                   const std::vector<Sample>& samples,
+                                                                   Projections projection,
+                                                                   std::shared_ptr<SampleTriangulation> triangulation) : m_locations(m_locations),
+                                                                                                                         m_samples(samples),
+                                                                                                                         m_projection(projection),
+                                                                                                                         m_triangulation(triangulation){};
+
 void meshkernel::TriangulationInterpolation::Compute()
 {
     // allocate and initialize result vector
-    m_results.resize(m_locations.size(), doubleMissingValue);
+    m_results.assign(m_locations.size(), doubleMissingValue);
 
     // no samples available, return
     if (m_samples.empty())
@@ -51,122 +58,61 @@ void meshkernel::TriangulationInterpolation::Compute()
         throw AlgorithmError("TriangulationInterpolation::Compute: No samples available.");
     }
 
-    // triangulate samples
-    const auto numPolygonNodes = static_cast<int>(m_samples.size());
-    TriangulationWrapper triangulationWrapper;
-
-    triangulationWrapper.Compute(m_samples,
-                                 numPolygonNodes,
-                                 TriangulationWrapper::TriangulationOptions::TriangulatePointsAndGenerateFaces,
-                                 0.0,
-                                 0);
-
-    // no triangles formed, return
-    if (triangulationWrapper.m_numFaces < 1)
+    // triangulate samples, unless a triangulation is reused
+    if (m_triangulation == nullptr)
     {
-        throw AlgorithmError("TriangulationInterpolation::Compute: Triangulation of samples produced no triangles.");
+        m_triangulation = std::make_shared<SampleTriangulation>(m_samples);
     }
-
-    // for each triangle compute the bounding circumcenter, bounding closed polygon, and the values at the nodes of each triangle
-    std::vector<Point> trianglesCircumcenters(triangulationWrapper.m_numFaces, {doubleMissingValue, doubleMissingValue});
-    std::vector<std::vector<Point>> triangles(triangulationWrapper.m_numFaces, std::vector<Point>(4, {doubleMissingValue, doubleMissingValue}));
-    std::vector<std::vector<double>> values(triangulationWrapper.m_numFaces, std::vector<double>(4, doubleMissingValue));
-
-    for (int f = 0; f < triangulationWrapper.m_numFaces; ++f)
+    if (m_triangulation->GetNumNodes() != static_cast<int>(m_samples.size()))
     {
-        // compute triangle polygons
-        for (int n = 0; n < 3; ++n)
-        {
-            auto const node = triangulationWrapper.m_faceNodes[f][n];
-            triangles[f][n] = {m_samples[node].x, m_samples[node].y};
-            values[f][n] = m_samples[node].value;
-        }
-        triangles[f][3] = triangles[f][0];
-        values[f][3] = values[f][0];
-
-        trianglesCircumcenters[f] = ComputeAverageCoordinate(triangles[f], 3, m_projection);
+        throw std::invalid_argument("TriangulationInterpolation::Compute: The triangulation does not match the samples.");
     }
 
-    SpatialTrees::RTree samplesRtree;
-    samplesRtree.BuildTree(trianglesCircumcenters);
-
     // compute the sample bounding box
     Point lowerLeft;
     Point upperRight;
     GetBoundingBox(m_samples, lowerLeft, upperRight);
 
-    // loop over locations
-    for (int n = 0; n < m_locations.size(); ++n)
+    // consecutive locations along a Hilbert curve are close, so each walk starts from the triangle of the previous location
+    const auto locationsOrder = SortPointsAlongHilbertCurve(m_locations);
+    SpatialTrees::RTree::QueryContext queryContext;
+    std::vector<Point> triangle(3);
+    std::vector<double> values(3);
+    int previousTriangle = -1;
+    for (const auto n : locationsOrder)
     {
-        if (!IsValueInBoundingBox(m_locations[n], lowerLeft, upperRight) ||
-            !IsEqual(m_results[n], doubleMissingValue))
+        if (!m_locations[n].IsValid() || !IsValueInBoundingBox(m_locations[n], lowerLeft, upperRight))
         {
             continue;
         }
 
-        // find the nearest triangle
-        samplesRtree.NearestNeighbour(m_locations[n]);
-        if (samplesRtree.GetQueryResultSize() <= 0)
+        const auto face = m_triangulation->FindFace(m_locations[n], previousTriangle, queryContext);
+        if (face < 0)
         {
             continue;
         }
-        auto triangle = samplesRtree.GetQuerySampleIndex(0);
+        previousTriangle = face;
 
-        // search for the triangle where the location is included
-        bool isInTriangle = false;
-        int numFacesSearched = 0;
-        while (!isInTriangle && numFacesSearched < 2 * triangulationWrapper.m_numFaces && triangle >= 0 && triangle < triangulationWrapper.m_numFaces)
+        for (int i = 0; i < 3; ++i)
         {
+            const auto node = m_triangulation->GetFaceNode(face, i);
+            triangle[i] = m_triangulation->GetNode(node);
+            values[i] = m_samples[node].value;
+        }
 
-            isInTriangle = IsPointInPolygonNodes(m_locations[n], triangles[triangle], 0, 3, m_projection, trianglesCircumcenters[triangle]);
-
-            // valid triangle found, no need to search further
-            if (isInTriangle)
-            {
-                break;
-            }
-
-            // proceed to next triangle, which is adjacent to the edge that is cut by the line from the current triangle to the point location
-            numFacesSearched++;
-            for (int i = 0; i < 3; ++i)
+        // the triangles are located in coordinate space, check the other projections on the triangle itself
+        if (m_projection != Projections::cartesian)
+        {
+            triangle.emplace_back(triangle[0]);
+            const auto isInTriangle = IsPointInPolygonNodes(m_locations[n], triangle, 0, 3, m_projection, ComputeAverageCoordinate(triangle, 3, m_projection));
+            triangle.resize(3);
+            if (!isInTriangle)
             {
-                const auto edge = triangulationWrapper.m_faceEdges[triangle][i];
-                if (triangulationWrapper.m_edgesFaces[edge][1] == 0)
-                {
-                    continue;
-                }
-
-                // there is no valid other triangle
-                const auto otherTriangle = triangulationWrapper.m_edgesFaces[edge][0] + triangulationWrapper.m_edgesFaces[edge][1] - triangle;
-                const auto k1 = triangulationWrapper.m_edgeNodes[edge][0];
-                const auto k2 = triangulationWrapper.m_edgeNodes[edge][1];
-                Point intersection;
-                double crossProduct;
-                double firstRatio;
-                double secondRatio;
-                const auto areCrossing = AreLinesCrossing(trianglesCircumcenters[triangle],
-                                                          m_locations[n],
-                                                          {m_samples[k1].x, m_samples[k1].y},
-                                                          {m_samples[k2].x, m_samples[k2].y},
-                                                          false,
-                                                          intersection,
-                                                          crossProduct,
-                                                          firstRatio,
-                                                          secondRatio,
-                                                          m_projection);
-
-                if (areCrossing)
-                {
-                    triangle = otherTriangle;
-                    break;
-                }
+                continue;
             }
         }
 
-        if (isInTriangle && triangle >= 0 && triangle < triangulationWrapper.m_numFaces)
-        {
-            // Perform linear interpolation
-            m_results[n] = LinearInterpolationInTriangle(m_locations[n], triangles[triangle], values[triangle], m_projection);
-        }
+        // Perform linear interpolation
+        m_results[n] = LinearInterpolationInTriangle(m_locations[n], triangle, values, m_projection);
     }
 }
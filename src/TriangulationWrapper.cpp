@@ -0,0 +1,540 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+
+#include <MeshKernel/Constants.hpp>
+#include <MeshKernel/Entities.hpp>
+#include <MeshKernel/TriangulationWrapper.hpp>
+
+#define REAL double
+#define VOID void
+#define ANSI_DECLARATORS
+extern "C"
+{
+#include <triangle.h>
+}
+#undef ANSI_DECLARATORS
+#undef VOID
+#undef REAL
+
+namespace
+{
+    /// @brief Frees the arrays allocated by the triangle library
+    void FreeTriangulateIO(triangulateio& io)
+    {
+        free(io.pointlist);
+        free(io.pointattributelist);
+        free(io.pointmarkerlist);
+        free(io.trianglelist);
+        free(io.triangleattributelist);
+        free(io.neighborlist);
+        free(io.segmentlist);
+        free(io.segmentmarkerlist);
+        free(io.edgelist);
+        free(io.edgemarkerlist);
+        free(io.normlist);
+    }
+
+    /// @brief The minimum number of points in a slab, with fewer points the triangulation is not split
+    constexpr int minNumPointsPerSlab = 100;
+
+    /// @brief The relative margin between a circumcircle and the slab boundaries for accepting a slab triangle
+    constexpr double slabBoundaryRelativeMargin = 1e-8;
+
+    /// @brief Computes a key for an edge, independent of the order of its nodes
+    long long EdgeKey(int firstNode, int secondNode)
+    {
+        const auto minNode = static_cast<long long>(std::min(firstNode, secondNode));
+        const auto maxNode = static_cast<long long>(std::max(firstNode, secondNode));
+        return (minNode << 32) | maxNode;
+    }
+} // namespace
+
+void meshkernel::TriangulationWrapper::ComputeFromPointList(std::vector<double>& pointList,
+                                                            TriangulationOptions triangulationOption,
+                                                            double averageTriangleArea)
+{
+    const auto numPoints = static_cast<int>(pointList.size()) / 2;
+
+    triangulateio in;
+    triangulateio out;
+    triangulateio voronoiOut;
+    std::memset(&in, 0, sizeof(triangulateio));
+    std::memset(&out, 0, sizeof(triangulateio));
+    std::memset(&voronoiOut, 0, sizeof(triangulateio));
+
+    in.numberofpoints = numPoints;
+    in.pointlist = pointList.data();
+
+    std::vector<int> segmentList;
+    std::string switches;
+    if (triangulationOption == TriangulationOptions::TriangulatePoints)
+    {
+        switches = "Qpc";
+    }
+    else if (triangulationOption == TriangulationOptions::TriangulatePointsAndGenerateFaces)
+    {
+        switches = "Qpcev";
+    }
+    else
+    {
+        // the polygon segments, as passed to triangle before
+        segmentList.resize(2 * numPoints);
+        for (int i = 0; i < numPoints; ++i)
+        {
+            segmentList[2 * i] = i;
+            segmentList[2 * i + 1] = i + 1;
+        }
+        segmentList.back() = 0;
+        in.numberofsegments = numPoints;
+        in.segmentlist = segmentList.data();
+
+        switches = "QYq30.0Da" + std::to_string(averageTriangleArea);
+    }
+
+    triangulate(&switches[0], &in, &out, &voronoiOut);
+
+    // the output arrays are numbered from one
+    m_numFaces = out.numberoftriangles;
+    m_faceNodes.resize(3 * m_numFaces);
+    std::transform(out.trianglelist, out.trianglelist + 3 * m_numFaces, m_faceNodes.begin(), [](int node) { return node - 1; });
+
+    m_numNodes = 0;
+    m_nodes.clear();
+    if (triangulationOption == TriangulationOptions::GeneratePoints)
+    {
+        m_numNodes = out.numberofpoints;
+        m_nodes.resize(m_numNodes);
+        for (int n = 0; n < m_numNodes; ++n)
+        {
+            m_nodes[n] = {out.pointlist[2 * n], out.pointlist[2 * n + 1]};
+        }
+    }
+
+    m_numEdges = 0;
+    m_edgeNodes.clear();
+    m_faceEdges.clear();
+    m_edgesFaces.clear();
+    if (triangulationOption == TriangulationOptions::TriangulatePointsAndGenerateFaces)
+    {
+        m_numEdges = out.numberofedges;
+        m_edgeNodes.resize(2 * m_numEdges);
+        std::transform(out.edgelist, out.edgelist + 2 * m_numEdges, m_edgeNodes.begin(), [](int node) { return node - 1; });
+
+        // the ends of each Voronoi edge are the two faces sharing the Delaunay edge with the same index
+        m_faceEdges.resize(3 * m_numFaces, intMissingValue);
+        m_edgesFaces.resize(2 * m_numEdges, intMissingValue);
+        std::vector<int> numFaceEdges(m_numFaces, 0);
+        for (int e = 0; e < m_numEdges; ++e)
+        {
+            int numEdgeFaces = 0;
+            for (int j = 0; j < 2; ++j)
+            {
+                const auto face = voronoiOut.edgelist[2 * e + j] - 1;
+                if (face < 0)
+                {
+                    continue;
+                }
+                m_faceEdges[3 * face + numFaceEdges[face]] = e;
+                numFaceEdges[face]++;
+                m_edgesFaces[2 * e + numEdgeFaces] = face;
+                numEdgeFaces++;
+            }
+            if (numEdgeFaces == 2 && m_edgesFaces[2 * e] > m_edgesFaces[2 * e + 1])
+            {
+                std::swap(m_edgesFaces[2 * e], m_edgesFaces[2 * e + 1]);
+            }
+        }
+    }
+
+    // the input arrays are owned by the caller
+    FreeTriangulateIO(out);
+    FreeTriangulateIO(voronoiOut);
+}
+
+void meshkernel::TriangulationWrapper::ComputeFromPointListInSlabs(std::vector<double>& pointList, int numSlabs)
+{
+    const auto numPoints = static_cast<int>(pointList.size()) / 2;
+    if (numSlabs < 2 || numPoints < numSlabs * minNumPointsPerSlab)
+    {
+        ComputeFromPointList(pointList, TriangulationOptions::TriangulatePointsAndGenerateFaces, 0.0);
+        return;
+    }
+
+    // partition the points in slabs along x
+    std::vector<int> order(numPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<int> slabStart(numSlabs + 1);
+    for (int s = 0; s <= numSlabs; ++s)
+    {
+        slabStart[s] = static_cast<int>(static_cast<long long>(numPoints) * s / numSlabs);
+    }
+    for (int s = 1; s < numSlabs; ++s)
+    {
+        std::nth_element(order.begin() + slabStart[s - 1], order.begin() + slabStart[s], order.end(), [&pointList](int first, int second) {
+            return pointList[2 * first] < pointList[2 * second];
+        });
+    }
+
+    // triangulate the slabs
+    std::vector<TriangulationWrapper> slabTriangulations(numSlabs);
+    std::vector<double> slabMinX(numSlabs, std::numeric_limits<double>::max());
+    std::vector<double> slabMaxX(numSlabs, std::numeric_limits<double>::lowest());
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        std::vector<double> slabPointList(2 * (slabStart[s + 1] - slabStart[s]));
+        for (int i = slabStart[s]; i < slabStart[s + 1]; ++i)
+        {
+            const auto x = pointList[2 * order[i]];
+            slabPointList[2 * (i - slabStart[s])] = x;
+            slabPointList[2 * (i - slabStart[s]) + 1] = pointList[2 * order[i] + 1];
+            slabMinX[s] = std::min(slabMinX[s], x);
+            slabMaxX[s] = std::max(slabMaxX[s], x);
+        }
+        slabTriangulations[s].ComputeFromPointList(slabPointList, TriangulationOptions::TriangulatePointsAndGenerateFaces, 0.0);
+    }
+
+    // A slab triangle is a triangle of the whole triangulation if its circumcircle lies strictly between the neighbouring slabs.
+    // The remaining triangles, and the edges on the boundary of a slab triangulation, mark the seam nodes.
+    // The slab edges with one accepted face are the segments constraining the seam triangulation.
+    std::vector<std::vector<char>> isAcceptedFace(numSlabs);
+    std::vector<std::vector<int>> slabGlobalEdges(numSlabs);
+    std::vector<std::vector<int>> slabSegments(numSlabs);
+    std::vector<int> numSlabFaces(numSlabs, 0);
+    std::vector<int> numSlabEdges(numSlabs, 0);
+    std::vector<char> isSeamNode(numPoints, false);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        const auto& slabTriangulation = slabTriangulations[s];
+        const auto* slabNodes = &order[slabStart[s]];
+        const auto leftBoundary = s > 0 ? slabMaxX[s - 1] : std::numeric_limits<double>::lowest();
+        const auto rightBoundary = s < numSlabs - 1 ? slabMinX[s + 1] : std::numeric_limits<double>::max();
+
+        auto& accepted = isAcceptedFace[s];
+        accepted.assign(slabTriangulation.m_numFaces, false);
+        for (int f = 0; f < slabTriangulation.m_numFaces; ++f)
+        {
+            const auto firstNode = slabNodes[slabTriangulation.GetFaceNode(f, 0)];
+            const auto secondNode = slabNodes[slabTriangulation.GetFaceNode(f, 1)];
+            const auto thirdNode = slabNodes[slabTriangulation.GetFaceNode(f, 2)];
+
+            const auto x0 = pointList[2 * firstNode];
+            const auto y0 = pointList[2 * firstNode + 1];
+            const auto bx = pointList[2 * secondNode] - x0;
+            const auto by = pointList[2 * secondNode + 1] - y0;
+            const auto cx = pointList[2 * thirdNode] - x0;
+            const auto cy = pointList[2 * thirdNode + 1] - y0;
+            const auto denominator = 2.0 * (bx * cy - by * cx);
+            if (std::abs(denominator) > 0.0)
+            {
+                const auto squaredB = bx * bx + by * by;
+                const auto squaredC = cx * cx + cy * cy;
+                const auto ux = (cy * squaredB - by * squaredC) / denominator;
+                const auto uy = (bx * squaredC - cx * squaredB) / denominator;
+                const auto radius = std::sqrt(ux * ux + uy * uy);
+                const auto centerX = x0 + ux;
+                const auto margin = slabBoundaryRelativeMargin * (radius + std::abs(centerX));
+                accepted[f] = centerX - radius - margin > leftBoundary && centerX + radius + margin < rightBoundary;
+            }
+
+            if (accepted[f])
+            {
+                numSlabFaces[s]++;
+                continue;
+            }
+            isSeamNode[firstNode] = true;
+            isSeamNode[secondNode] = true;
+            isSeamNode[thirdNode] = true;
+        }
+
+        auto& globalEdges = slabGlobalEdges[s];
+        globalEdges.assign(slabTriangulation.m_numEdges, -1);
+        for (int e = 0; e < slabTriangulation.m_numEdges; ++e)
+        {
+            const auto firstFace = slabTriangulation.GetEdgeFace(e, 0);
+            const auto secondFace = slabTriangulation.GetEdgeFace(e, 1);
+            if (secondFace < 0)
+            {
+                isSeamNode[slabNodes[slabTriangulation.GetEdgeNode(e, 0)]] = true;
+                isSeamNode[slabNodes[slabTriangulation.GetEdgeNode(e, 1)]] = true;
+            }
+
+            const auto isFirstFaceAccepted = firstFace >= 0 && accepted[firstFace];
+            const auto isSecondFaceAccepted = secondFace >= 0 && accepted[secondFace];
+            if (!isFirstFaceAccepted && !isSecondFaceAccepted)
+            {
+                continue;
+            }
+            globalEdges[e] = numSlabEdges[s];
+            numSlabEdges[s]++;
+            if (isFirstFaceAccepted != isSecondFaceAccepted)
+            {
+                slabSegments[s].push_back(e);
+            }
+        }
+    }
+
+    std::vector<int> faceOffsets(numSlabs + 1, 0);
+    std::vector<int> edgeOffsets(numSlabs + 1, 0);
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        faceOffsets[s + 1] = faceOffsets[s] + numSlabFaces[s];
+        edgeOffsets[s + 1] = edgeOffsets[s] + numSlabEdges[s];
+    }
+
+    // the seam triangulation input: the seam nodes, the segments and a hole in each accepted face along the segments
+    std::vector<int> seamNodes;
+    std::vector<int> seamNodeIndices(numPoints, -1);
+    std::vector<double> seamPointList;
+    for (int n = 0; n < numPoints; ++n)
+    {
+        if (!isSeamNode[n])
+        {
+            continue;
+        }
+        seamNodeIndices[n] = static_cast<int>(seamNodes.size());
+        seamNodes.push_back(n);
+        seamPointList.push_back(pointList[2 * n]);
+        seamPointList.push_back(pointList[2 * n + 1]);
+    }
+
+    std::vector<int> segmentList;
+    std::vector<double> holeList;
+    std::unordered_map<long long, int> segmentEdges;
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        const auto& slabTriangulation = slabTriangulations[s];
+        const auto* slabNodes = &order[slabStart[s]];
+        for (const auto e : slabSegments[s])
+        {
+            const auto firstNode = slabNodes[slabTriangulation.GetEdgeNode(e, 0)];
+            const auto secondNode = slabNodes[slabTriangulation.GetEdgeNode(e, 1)];
+            segmentList.push_back(seamNodeIndices[firstNode]);
+            segmentList.push_back(seamNodeIndices[secondNode]);
+            segmentEdges[EdgeKey(firstNode, secondNode)] = edgeOffsets[s] + slabGlobalEdges[s][e];
+
+            const auto firstFace = slabTriangulation.GetEdgeFace(e, 0);
+            const auto acceptedFace = firstFace >= 0 && isAcceptedFace[s][firstFace] ? firstFace : slabTriangulation.GetEdgeFace(e, 1);
+            double centerX = 0.0;
+            double centerY = 0.0;
+            for (int n = 0; n < 3; ++n)
+            {
+                const auto node = slabNodes[slabTriangulation.GetFaceNode(acceptedFace, n)];
+                centerX += pointList[2 * node];
+                centerY += pointList[2 * node + 1];
+            }
+            holeList.push_back(centerX / 3.0);
+            holeList.push_back(centerY / 3.0);
+        }
+    }
+
+    triangulateio in;
+    triangulateio out;
+    triangulateio voronoiOut;
+    std::memset(&in, 0, sizeof(triangulateio));
+    std::memset(&out, 0, sizeof(triangulateio));
+    std::memset(&voronoiOut, 0, sizeof(triangulateio));
+    in.numberofpoints = static_cast<int>(seamNodes.size());
+    in.pointlist = seamPointList.data();
+    in.numberofsegments = static_cast<int>(segmentList.size()) / 2;
+    in.segmentlist = segmentList.data();
+    in.numberofholes = static_cast<int>(holeList.size()) / 2;
+    in.holelist = holeList.data();
+
+    // no Steiner points, the segments are edges of a Delaunay triangulation of the seam nodes
+    std::string switches = "pczQYYn";
+    triangulate(&switches[0], &in, &out, &voronoiOut);
+
+    const auto numSeamFaces = out.numberoftriangles;
+    const auto isSeamTriangulationValid = out.numberofpoints == in.numberofpoints;
+
+    // the seam edges: the segments are slab edges, the other edges are created by the face with the smallest index
+    std::vector<int> seamFaceEdges(3 * numSeamFaces, -1);
+    std::vector<int> seamEdgeNodes;
+    auto numEdges = edgeOffsets[numSlabs];
+    for (int f = 0; f < numSeamFaces && isSeamTriangulationValid; ++f)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            const auto neighbour = out.neighborlist[3 * f + n];
+            if (neighbour >= 0 && neighbour < f)
+            {
+                continue;
+            }
+            const auto firstNode = seamNodes[out.trianglelist[3 * f + (n + 1) % 3]];
+            const auto secondNode = seamNodes[out.trianglelist[3 * f + (n + 2) % 3]];
+            if (neighbour < 0)
+            {
+                const auto segmentEdge = segmentEdges.find(EdgeKey(firstNode, secondNode));
+                if (segmentEdge != segmentEdges.end())
+                {
+                    seamFaceEdges[3 * f + n] = segmentEdge->second;
+                    continue;
+                }
+            }
+            seamFaceEdges[3 * f + n] = numEdges;
+            seamEdgeNodes.push_back(firstNode);
+            seamEdgeNodes.push_back(secondNode);
+            numEdges++;
+        }
+    }
+    for (int f = 0; f < numSeamFaces && isSeamTriangulationValid; ++f)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            const auto neighbour = out.neighborlist[3 * f + n];
+            if (neighbour < 0 || neighbour > f)
+            {
+                continue;
+            }
+            for (int m = 0; m < 3; ++m)
+            {
+                if (out.neighborlist[3 * neighbour + m] == f)
+                {
+                    seamFaceEdges[3 * f + n] = seamFaceEdges[3 * neighbour + m];
+                }
+            }
+        }
+    }
+
+    // assemble the accepted slab faces and the seam faces
+    m_numNodes = 0;
+    m_nodes.clear();
+    m_numFaces = faceOffsets[numSlabs] + numSeamFaces;
+    m_numEdges = numEdges;
+    m_faceNodes.resize(3 * m_numFaces);
+    m_faceEdges.resize(3 * m_numFaces);
+    m_edgeNodes.resize(2 * m_numEdges);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        const auto& slabTriangulation = slabTriangulations[s];
+        const auto* slabNodes = &order[slabStart[s]];
+        auto face = faceOffsets[s];
+        for (int f = 0; f < slabTriangulation.m_numFaces; ++f)
+        {
+            if (!isAcceptedFace[s][f])
+            {
+                continue;
+            }
+            for (int n = 0; n < 3; ++n)
+            {
+                m_faceNodes[3 * face + n] = slabNodes[slabTriangulation.GetFaceNode(f, n)];
+                m_faceEdges[3 * face + n] = edgeOffsets[s] + slabGlobalEdges[s][slabTriangulation.GetFaceEdge(f, n)];
+            }
+            face++;
+        }
+        for (int e = 0; e < slabTriangulation.m_numEdges; ++e)
+        {
+            const auto edge = slabGlobalEdges[s][e];
+            if (edge < 0)
+            {
+                continue;
+            }
+            m_edgeNodes[2 * (edgeOffsets[s] + edge)] = slabNodes[slabTriangulation.GetEdgeNode(e, 0)];
+            m_edgeNodes[2 * (edgeOffsets[s] + edge) + 1] = slabNodes[slabTriangulation.GetEdgeNode(e, 1)];
+        }
+    }
+    for (int f = 0; f < numSeamFaces && isSeamTriangulationValid; ++f)
+    {
+        const auto face = faceOffsets[numSlabs] + f;
+        for (int n = 0; n < 3; ++n)
+        {
+            m_faceNodes[3 * face + n] = seamNodes[out.trianglelist[3 * f + n]];
+            m_faceEdges[3 * face + n] = seamFaceEdges[3 * f + n];
+        }
+    }
+    std::copy(seamEdgeNodes.begin(), seamEdgeNodes.end(), m_edgeNodes.begin() + 2 * edgeOffsets[numSlabs]);
+
+    // the input arrays are owned by this function
+    FreeTriangulateIO(out);
+    FreeTriangulateIO(voronoiOut);
+
+    // the merged triangulation is checked, in degenerate cases triangulate the points at once
+    if (!isSeamTriangulationValid || !SetEdgesFacesAndValidate())
+    {
+        ComputeFromPointList(pointList, TriangulationOptions::TriangulatePointsAndGenerateFaces, 0.0);
+    }
+}
+
+bool meshkernel::TriangulationWrapper::SetEdgesFacesAndValidate()
+{
+    m_edgesFaces.assign(2 * m_numEdges, intMissingValue);
+    for (int f = 0; f < m_numFaces; ++f)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            const auto edge = m_faceEdges[3 * f + n];
+            if (edge < 0 || edge >= m_numEdges)
+            {
+                return false;
+            }
+            if (m_edgesFaces[2 * edge] == intMissingValue)
+            {
+                m_edgesFaces[2 * edge] = f;
+            }
+            else if (m_edgesFaces[2 * edge + 1] == intMissingValue)
+            {
+                m_edgesFaces[2 * edge + 1] = f;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    int maxNode = -1;
+    for (int e = 0; e < m_numEdges; ++e)
+    {
+        if (m_edgesFaces[2 * e] == intMissingValue)
+        {
+            return false;
+        }
+        maxNode = std::max(maxNode, std::max(m_edgeNodes[2 * e], m_edgeNodes[2 * e + 1]));
+    }
+
+    std::vector<char> isUsedNode(maxNode + 1, false);
+    for (const auto node : m_faceNodes)
+    {
+        isUsedNode[node] = true;
+    }
+    const auto numUsedNodes = std::count(isUsedNode.begin(), isUsedNode.end(), true);
+
+    return numUsedNodes - m_numEdges + m_numFaces == 1;
+}
@@ -0,0 +1,453 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2020.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <stdexcept>
+#include <string>
+
+#include <MeshKernel/UGridFile.hpp>
+
+#ifdef MESHKERNEL_WITH_NETCDF
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <netcdf.h>
+
+#include <MeshKernel/Constants.hpp>
+#include <MeshKernel/Entities.hpp>
+#include <MeshKernel/Mesh.hpp>
+
+namespace
+{
+    // The number of nodes, edges or faces transferred with one NetCDF call
+    const size_t chunkSize = 1 << 16;
+
+    // Throws if a NetCDF call failed
+    void CheckNetCdf(int status, const std::string& context)
+    {
+        if (status != NC_NOERR)
+        {
+            throw std::invalid_argument(context + ": " + nc_strerror(status));
+        }
+    }
+
+    // Closes the NetCDF file, the destructor closes it if Close was not called (for example after an exception)
+    class NetCdfFile
+    {
+    public:
+        explicit NetCdfFile(int ncid) : m_ncid(ncid) {}
+        ~NetCdfFile()
+        {
+            if (m_isOpen)
+            {
+                nc_close(m_ncid);
+            }
+        }
+        NetCdfFile(const NetCdfFile&) = delete;
+        NetCdfFile& operator=(const NetCdfFile&) = delete;
+
+        // Closes the file, throws if the data could not be flushed or the file could not be closed
+        void Close(const std::string& context)
+        {
+            m_isOpen = false;
+            CheckNetCdf(nc_close(m_ncid), context);
+        }
+
+    private:
+        int m_ncid;
+        bool m_isOpen = true;
+    };
+
+    // Gets a text attribute, an empty string if the attribute does not exist
+    std::string GetTextAttribute(int ncid, int varid, const char* name)
+    {
+        size_t length = 0;
+        if (nc_inq_attlen(ncid, varid, name, &length) != NC_NOERR)
+        {
+            return "";
+        }
+        std::string value(length, '\0');
+        CheckNetCdf(nc_get_att_text(ncid, varid, name, &value[0]), std::string("ReadUGridMesh: Could not read the attribute ") + name);
+        // some writers include the terminating null character
+        value.erase(std::find(value.begin(), value.end(), '\0'), value.end());
+        return value;
+    }
+
+    // Gets an integer attribute, the default value if the attribute does not exist
+    int GetIntAttribute(int ncid, int varid, const char* name, int defaultValue)
+    {
+        int value = defaultValue;
+        if (nc_get_att_int(ncid, varid, name, &value) != NC_NOERR)
+        {
+            return defaultValue;
+        }
+        return value;
+    }
+
+    void PutTextAttribute(int ncid, int varid, const char* name, const std::string& value)
+    {
+        CheckNetCdf(nc_put_att_text(ncid, varid, name, value.size(), value.c_str()), std::string("WriteUGridMesh: Could not write the attribute ") + name);
+    }
+
+    void PutIntAttribute(int ncid, int varid, const char* name, int value)
+    {
+        CheckNetCdf(nc_put_att_int(ncid, varid, name, NC_INT, 1, &value), std::string("WriteUGridMesh: Could not write the attribute ") + name);
+    }
+
+    // Gets the length of the first dimension of a variable
+    size_t GetFirstDimensionLength(int ncid, int varid)
+    {
+        int numDimensions = 0;
+        CheckNetCdf(nc_inq_varndims(ncid, varid, &numDimensions), "ReadUGridMesh: Could not inquire the variable dimensions");
+        if (numDimensions < 1)
+        {
+            throw std::invalid_argument("ReadUGridMesh: A mesh variable has no dimensions.");
+        }
+        std::vector<int> dimensionIds(numDimensions);
+        CheckNetCdf(nc_inq_vardimid(ncid, varid, dimensionIds.data()), "ReadUGridMesh: Could not inquire the variable dimensions");
+        size_t length = 0;
+        CheckNetCdf(nc_inq_dimlen(ncid, dimensionIds[0], &length), "ReadUGridMesh: Could not inquire the dimension length");
+        return length;
+    }
+
+    // Finds the 2D mesh topology variable, -1 if the file does not contain one
+    int FindMeshTopology(int ncid)
+    {
+        int numVariables = 0;
+        CheckNetCdf(nc_inq_nvars(ncid, &numVariables), "ReadUGridMesh: Could not inquire the variables");
+        for (int v = 0; v < numVariables; ++v)
+        {
+            if (GetTextAttribute(ncid, v, "cf_role") == "mesh_topology" && GetIntAttribute(ncid, v, "topology_dimension", 0) == 2)
+            {
+                return v;
+            }
+        }
+        return -1;
+    }
+
+    // Reads the node coordinates in chunks
+    std::vector<meshkernel::Point> ReadNodes(int ncid, int xVariable, int yVariable)
+    {
+        const auto numNodes = GetFirstDimensionLength(ncid, xVariable);
+        const auto numNodesY = GetFirstDimensionLength(ncid, yVariable);
+        if (numNodesY != numNodes)
+        {
+            throw std::invalid_argument("ReadUGridMesh: The node x coordinates have " + std::to_string(numNodes) +
+                                        " values and the node y coordinates " + std::to_string(numNodesY) + ".");
+        }
+        std::vector<meshkernel::Point> nodes(numNodes);
+        std::vector<double> buffer(std::min(numNodes, chunkSize));
+        for (size_t start = 0; start < numNodes; start += chunkSize)
+        {
+            const auto count = std::min(chunkSize, numNodes - start);
+
+            CheckNetCdf(nc_get_vara_double(ncid, xVariable, &start, &count, buffer.data()), "ReadUGridMesh: Could not read the node x coordinates");
+            for (size_t n = 0; n < count; ++n)
+            {
+                nodes[start + n].x = buffer[n];
+            }
+
+            CheckNetCdf(nc_get_vara_double(ncid, yVariable, &start, &count, buffer.data()), "ReadUGridMesh: Could not read the node y coordinates");
+            for (size_t n = 0; n < count; ++n)
+            {
+                nodes[start + n].y = buffer[n];
+            }
+        }
+        return nodes;
+    }
+
+    // Converts an edge node read from the file to a 0-based index, fill values become invalid indices
+    int ToNodeIndex(int node, int fillValue, int startIndex, size_t numNodes, size_t edge)
+    {
+        if (node == fillValue)
+        {
+            return meshkernel::intMissingValue;
+        }
+        const auto nodeIndex = static_cast<long long>(node) - startIndex;
+        if (nodeIndex < 0 || nodeIndex >= static_cast<long long>(numNodes))
+        {
+            throw std::invalid_argument("ReadUGridMesh: The edge " + std::to_string(edge) + " has the node " + std::to_string(node) +
+                                        ", outside the " + std::to_string(numNodes) + " nodes with start index " + std::to_string(startIndex) + ".");
+        }
+        return static_cast<int>(nodeIndex);
+    }
+
+    // Reads the edge nodes in chunks, converting them to 0-based indices (fill values become invalid indices)
+    std::vector<meshkernel::Edge> ReadEdges(int ncid, int edgeNodesVariable, int startIndex, size_t numNodes)
+    {
+        const auto numEdges = GetFirstDimensionLength(ncid, edgeNodesVariable);
+        const auto fillValue = GetIntAttribute(ncid, edgeNodesVariable, "_FillValue", NC_FILL_INT);
+
+        std::vector<meshkernel::Edge> edges(numEdges);
+        std::vector<int> buffer(std::min(numEdges, chunkSize) * 2);
+        for (size_t start = 0; start < numEdges; start += chunkSize)
+        {
+            const size_t starts[]{start, 0};
+            const size_t counts[]{std::min(chunkSize, numEdges - start), 2};
+
+            CheckNetCdf(nc_get_vara_int(ncid, edgeNodesVariable, starts, counts, buffer.data()), "ReadUGridMesh: Could not read the edge nodes");
+            for (size_t e = 0; e < counts[0]; ++e)
+            {
+                edges[start + e].first = ToNodeIndex(buffer[2 * e], fillValue, startIndex, numNodes, start + e);
+                edges[start + e].second = ToNodeIndex(buffer[2 * e + 1], fillValue, startIndex, numNodes, start + e);
+            }
+        }
+        return edges;
+    }
+} // namespace
+
+void meshkernel::ReadUGridMesh(const std::string& filePath, Mesh& mesh)
+{
+    int ncid = 0;
+    CheckNetCdf(nc_open(filePath.c_str(), NC_NOWRITE, &ncid), "ReadUGridMesh: Could not open " + filePath);
+    NetCdfFile file(ncid);
+
+    int xVariable = -1;
+    int yVariable = -1;
+    int edgeNodesVariable = -1;
+    int startIndex = 0;
+
+    const auto meshVariable = FindMeshTopology(ncid);
+    if (meshVariable >= 0)
+    {
+        std::istringstream nodeCoordinates(GetTextAttribute(ncid, meshVariable, "node_coordinates"));
+        std::string xName;
+        std::string yName;
+        if (!(nodeCoordinates >> xName >> yName))
+        {
+            throw std::invalid_argument("ReadUGridMesh: The mesh topology has no node_coordinates attribute.");
+        }
+        CheckNetCdf(nc_inq_varid(ncid, xName.c_str(), &xVariable), "ReadUGridMesh: Could not find the variable " + xName);
+        CheckNetCdf(nc_inq_varid(ncid, yName.c_str(), &yVariable), "ReadUGridMesh: Could not find the variable " + yName);
+
+        const auto edgeNodesName = GetTextAttribute(ncid, meshVariable, "edge_node_connectivity");
+        if (!edgeNodesName.empty())
+        {
+            CheckNetCdf(nc_inq_varid(ncid, edgeNodesName.c_str(), &edgeNodesVariable), "ReadUGridMesh: Could not find the variable " + edgeNodesName);
+            startIndex = GetIntAttribute(ncid, edgeNodesVariable, "start_index", 0);
+        }
+    }
+    else
+    {
+        // legacy network files, with 1-based edge nodes
+        CheckNetCdf(nc_inq_varid(ncid, "NetNode_x", &xVariable), "ReadUGridMesh: " + filePath + " contains no 2D mesh");
+        CheckNetCdf(nc_inq_varid(ncid, "NetNode_y", &yVariable), "ReadUGridMesh: " + filePath + " contains no 2D mesh");
+        CheckNetCdf(nc_inq_varid(ncid, "NetLink", &edgeNodesVariable), "ReadUGridMesh: " + filePath + " contains no 2D mesh");
+        startIndex = 1;
+    }
+
+    auto nodes = ReadNodes(ncid, xVariable, yVariable);
+
+    std::vector<Edge> edges;
+    if (edgeNodesVariable >= 0)
+    {
+        edges = ReadEdges(ncid, edgeNodesVariable, startIndex, nodes.size());
+    }
+
+    const auto projection = GetTextAttribute(ncid, xVariable, "standard_name") == "longitude" ? Projections::spherical : Projections::cartesian;
+
+    mesh.Set(std::move(edges), std::move(nodes), projection);
+}
+
+void meshkernel::WriteUGridMesh(const std::string& filePath, const Mesh& mesh)
+{
+    const size_t numNodes = mesh.GetNumNodes();
+    const size_t numEdges = mesh.GetNumEdges();
+    const size_t numFaces = mesh.GetNumFaces();
+    if (numNodes == 0)
+    {
+        throw std::invalid_argument("WriteUGridMesh: The mesh is empty.");
+    }
+
+    size_t maxNumFaceNodes = 0;
+    for (size_t f = 0; f < numFaces; ++f)
+    {
+        maxNumFaceNodes = std::max(maxNumFaceNodes, static_cast<size_t>(mesh.GetNumFaceEdges(static_cast<int>(f))));
+    }
+
+    int ncid = 0;
+    CheckNetCdf(nc_create(filePath.c_str(), NC_CLOBBER | NC_64BIT_OFFSET, &ncid), "WriteUGridMesh: Could not create " + filePath);
+    NetCdfFile file(ncid);
+
+    // zero length dimensions are unlimited in NetCDF, so empty edge and face sets are not written
+    const bool hasEdges = numEdges > 0;
+    const bool hasFaces = numFaces > 0 && maxNumFaceNodes > 0;
+
+    int nodeDimension = -1;
+    int edgeDimension = -1;
+    int twoDimension = -1;
+    int faceDimension = -1;
+    int maxFaceNodesDimension = -1;
+    CheckNetCdf(nc_def_dim(ncid, "nmesh2d_node", numNodes, &nodeDimension), "WriteUGridMesh: Could not define the node dimension");
+    if (hasEdges)
+    {
+        CheckNetCdf(nc_def_dim(ncid, "nmesh2d_edge", numEdges, &edgeDimension), "WriteUGridMesh: Could not define the edge dimension");
+        CheckNetCdf(nc_def_dim(ncid, "Two", 2, &twoDimension), "WriteUGridMesh: Could not define the Two dimension");
+    }
+    if (hasFaces)
+    {
+        CheckNetCdf(nc_def_dim(ncid, "nmesh2d_face", numFaces, &faceDimension), "WriteUGridMesh: Could not define the face dimension");
+        CheckNetCdf(nc_def_dim(ncid, "max_nmesh2d_face_nodes", maxNumFaceNodes, &maxFaceNodesDimension), "WriteUGridMesh: Could not define the max face nodes dimension");
+    }
+
+    PutTextAttribute(ncid, NC_GLOBAL, "Conventions", "CF-1.8 UGRID-1.0");
+
+    // the mesh topology
+    int meshVariable = -1;
+    CheckNetCdf(nc_def_var(ncid, "mesh2d", NC_INT, 0, nullptr, &meshVariable), "WriteUGridMesh: Could not define the mesh topology");
+    PutTextAttribute(ncid, meshVariable, "cf_role", "mesh_topology");
+    PutTextAttribute(ncid, meshVariable, "long_name", "Topology data of 2D mesh");
+    PutIntAttribute(ncid, meshVariable, "topology_dimension", 2);
+    PutTextAttribute(ncid, meshVariable, "node_coordinates", "mesh2d_node_x mesh2d_node_y");
+    PutTextAttribute(ncid, meshVariable, "node_dimension", "nmesh2d_node");
+    if (hasEdges)
+    {
+        PutTextAttribute(ncid, meshVariable, "edge_node_connectivity", "mesh2d_edge_nodes");
+        PutTextAttribute(ncid, meshVariable, "edge_dimension", "nmesh2d_edge");
+    }
+    if (hasFaces)
+    {
+        PutTextAttribute(ncid, meshVariable, "face_node_connectivity", "mesh2d_face_nodes");
+        PutTextAttribute(ncid, meshVariable, "face_dimension", "nmesh2d_face");
+        PutTextAttribute(ncid, meshVariable, "max_face_nodes_dimension", "max_nmesh2d_face_nodes");
+    }
+
+    // the node coordinates
+    const bool isSpherical = mesh.m_projection == Projections::spherical;
+    int xVariable = -1;
+    int yVariable = -1;
+    CheckNetCdf(nc_def_var(ncid, "mesh2d_node_x", NC_DOUBLE, 1, &nodeDimension, &xVariable), "WriteUGridMesh: Could not define the node x coordinates");
+    CheckNetCdf(nc_def_var(ncid, "mesh2d_node_y", NC_DOUBLE, 1, &nodeDimension, &yVariable), "WriteUGridMesh: Could not define the node y coordinates");
+    PutTextAttribute(ncid, xVariable, "standard_name", isSpherical ? "longitude" : "projection_x_coordinate");
+    PutTextAttribute(ncid, yVariable, "standard_name", isSpherical ? "latitude" : "projection_y_coordinate");
+    PutTextAttribute(ncid, xVariable, "units", isSpherical ? "degrees_east" : "m");
+    PutTextAttribute(ncid, yVariable, "units", isSpherical ? "degrees_north" : "m");
+    for (const auto variable : {xVariable, yVariable})
+    {
+        PutTextAttribute(ncid, variable, "mesh", "mesh2d");
+        PutTextAttribute(ncid, variable, "location", "node");
+    }
+
+    // the connectivities, 0-based with fill values for the missing entries
+    int edgeNodesVariable = -1;
+    if (hasEdges)
+    {
+        const int dimensions[]{edgeDimension, twoDimension};
+        CheckNetCdf(nc_def_var(ncid, "mesh2d_edge_nodes", NC_INT, 2, dimensions, &edgeNodesVariable), "WriteUGridMesh: Could not define the edge nodes");
+        PutTextAttribute(ncid, edgeNodesVariable, "cf_role", "edge_node_connectivity");
+        PutTextAttribute(ncid, edgeNodesVariable, "mesh", "mesh2d");
+        PutIntAttribute(ncid, edgeNodesVariable, "start_index", 0);
+        PutIntAttribute(ncid, edgeNodesVariable, "_FillValue", intMissingValue);
+    }
+    int faceNodesVariable = -1;
+    if (hasFaces)
+    {
+        const int dimensions[]{faceDimension, maxFaceNodesDimension};
+        CheckNetCdf(nc_def_var(ncid, "mesh2d_face_nodes", NC_INT, 2, dimensions, &faceNodesVariable), "WriteUGridMesh: Could not define the face nodes");
+        PutTextAttribute(ncid, faceNodesVariable, "cf_role", "face_node_connectivity");
+        PutTextAttribute(ncid, faceNodesVariable, "mesh", "mesh2d");
+        PutIntAttribute(ncid, faceNodesVariable, "start_index", 0);
+        PutIntAttribute(ncid, faceNodesVariable, "_FillValue", intMissingValue);
+    }
+
+    CheckNetCdf(nc_enddef(ncid), "WriteUGridMesh: Could not end the definition mode");
+
+    // write the data in chunks
+    std::vector<double> coordinates(std::min(numNodes, chunkSize));
+    for (size_t start = 0; start < numNodes; start += chunkSize)
+    {
+        const auto count = std::min(chunkSize, numNodes - start);
+
+        for (size_t n = 0; n < count; ++n)
+        {
+            coordinates[n] = mesh.m_nodes[start + n].x;
+        }
+        CheckNetCdf(nc_put_vara_double(ncid, xVariable, &start, &count, coordinates.data()), "WriteUGridMesh: Could not write the node x coordinates");
+
+        for (size_t n = 0; n < count; ++n)
+        {
+            coordinates[n] = mesh.m_nodes[start + n].y;
+        }
+        CheckNetCdf(nc_put_vara_double(ncid, yVariable, &start, &count, coordinates.data()), "WriteUGridMesh: Could not write the node y coordinates");
+    }
+
+    std::vector<int> indices;
+    if (hasEdges)
+    {
+        indices.resize(std::min(numEdges, chunkSize) * 2);
+        for (size_t start = 0; start < numEdges; start += chunkSize)
+        {
+            const size_t starts[]{start, 0};
+            const size_t counts[]{std::min(chunkSize, numEdges - start), 2};
+            for (size_t e = 0; e < counts[0]; ++e)
+            {
+                const auto& edge = mesh.m_edges[start + e];
+                const bool isValid = edge.first >= 0 && edge.second >= 0;
+                indices[2 * e] = isValid ? edge.first : intMissingValue;
+                indices[2 * e + 1] = isValid ? edge.second : intMissingValue;
+            }
+            CheckNetCdf(nc_put_vara_int(ncid, edgeNodesVariable, starts, counts, indices.data()), "WriteUGridMesh: Could not write the edge nodes");
+        }
+    }
+
+    if (hasFaces)
+    {
+        indices.resize(std::min(numFaces, chunkSize) * maxNumFaceNodes);
+        for (size_t start = 0; start < numFaces; start += chunkSize)
+        {
+            const size_t starts[]{start, 0};
+            const size_t counts[]{std::min(chunkSize, numFaces - start), maxNumFaceNodes};
+            std::fill(indices.begin(), indices.end(), intMissingValue);
+            for (size_t f = 0; f < counts[0]; ++f)
+            {
+                const auto& faceNodes = mesh.m_facesNodes[start + f];
+                const auto numFaceNodes = static_cast<size_t>(mesh.GetNumFaceEdges(static_cast<int>(start + f)));
+                std::copy(faceNodes.begin(), faceNodes.begin() + numFaceNodes, indices.begin() + f * maxNumFaceNodes);
+            }
+            CheckNetCdf(nc_put_vara_int(ncid, faceNodesVariable, starts, counts, indices.data()), "WriteUGridMesh: Could not write the face nodes");
+        }
+    }
+
+    // the data are flushed on closing, a failure leaves a truncated file
+    file.Close("WriteUGridMesh: Could not close " + filePath);
+}
+
+#else
+
+void meshkernel::ReadUGridMesh([[maybe_unused]] const std::string& filePath, [[maybe_unused]] Mesh& mesh)
+{
+    throw std::invalid_argument("ReadUGridMesh: MeshKernel has been built without NetCDF support.");
+}
+
+void meshkernel::WriteUGridMesh([[maybe_unused]] const std::string& filePath, [[maybe_unused]] const Mesh& mesh)
+{
+    throw std::invalid_argument("WriteUGridMesh: MeshKernel has been built without NetCDF support.");
+}
+
+#endif
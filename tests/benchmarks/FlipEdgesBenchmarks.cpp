@@ -0,0 +1,30 @@
+#include <memory>
+
+#include <MeshKernel/FlipEdges.hpp>
+#include <MeshKernel/LandBoundaries.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/Polygons.hpp>
+#include <benchmark/benchmark.h>
+
+#include "SyntheticMeshes.hpp"
+
+// triangulates the faces of a distorted curvilinear mesh with state.range(0) x state.range(0) nodes and flips the edges
+static void BM_FlipEdges(benchmark::State& state)
+{
+    const auto baseMesh = MakeDistortedCurvilinearMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    const auto polygon = std::make_shared<meshkernel::Polygons>();
+    std::vector<meshkernel::Point> landBoundary;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto mesh = std::make_shared<meshkernel::Mesh>(*baseMesh);
+        const auto landBoundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+        meshkernel::FlipEdges flipEdges(mesh, landBoundaries, true, false);
+        state.ResumeTiming();
+
+        flipEdges.Compute();
+    }
+    state.counters["nodes"] = baseMesh->GetNumNodes();
+}
+BENCHMARK(BM_FlipEdges)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(64, 512);
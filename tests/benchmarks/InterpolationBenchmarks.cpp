@@ -0,0 +1,55 @@
+#include <MeshKernel/AveragingInterpolation.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/TriangulationInterpolation.hpp>
+#include <benchmark/benchmark.h>
+
+#include "SyntheticMeshes.hpp"
+
+namespace
+{
+    constexpr double meshSize = 1000.0; // the size of the square covered by the meshes and the samples
+} // namespace
+
+// averages state.range(1) samples on the faces of a rectangular mesh with state.range(0) x state.range(0) faces,
+// in parallel if state.range(2) is not zero
+static void BM_AveragingInterpolation(benchmark::State& state)
+{
+    const auto numColumns = static_cast<int>(state.range(0));
+    const auto mesh = MakeRectangularMesh(numColumns, numColumns, meshSize / numColumns);
+    auto samples = MakeSamples(static_cast<int>(state.range(1)), meshSize);
+
+    for (auto _ : state)
+    {
+        meshkernel::AveragingInterpolation averaging(mesh,
+                                                     samples,
+                                                     meshkernel::AveragingInterpolation::Method::SimpleAveraging,
+                                                     meshkernel::InterpolationLocation::Faces,
+                                                     1.01,
+                                                     false,
+                                                     false);
+        averaging.SetParallel(state.range(2) != 0);
+        averaging.Compute();
+        benchmark::DoNotOptimize(averaging.GetResults().data());
+    }
+    state.counters["faces"] = mesh->GetNumFaces();
+    state.counters["samples"] = static_cast<double>(samples.size());
+}
+BENCHMARK(BM_AveragingInterpolation)->Unit(benchmark::kMillisecond)->ArgsProduct({{64, 256}, {100000, 1000000}, {0, 1}});
+
+// interpolates state.range(1) triangulated samples on the nodes of a rectangular mesh with state.range(0) x state.range(0) faces
+static void BM_TriangulationInterpolation(benchmark::State& state)
+{
+    const auto numColumns = static_cast<int>(state.range(0));
+    const auto mesh = MakeRectangularMesh(numColumns, numColumns, meshSize / numColumns);
+    const auto samples = MakeSamples(static_cast<int>(state.range(1)), meshSize);
+
+    for (auto _ : state)
+    {
+        meshkernel::TriangulationInterpolation triangulationInterpolation(mesh->m_nodes, samples, meshkernel::Projections::cartesian);
+        triangulationInterpolation.Compute();
+        benchmark::DoNotOptimize(triangulationInterpolation.GetResults().data());
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+    state.counters["samples"] = static_cast<double>(samples.size());
+}
+BENCHMARK(BM_TriangulationInterpolation)->Unit(benchmark::kMillisecond)->ArgsProduct({{64, 256}, {10000, 100000}});
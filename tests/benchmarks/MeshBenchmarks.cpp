@@ -0,0 +1,155 @@
+#include <MeshKernel/GeometryKernels.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/Polygons.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+
+#include "SyntheticMeshes.hpp"
+
+// the edges and faces administration of a rectangular mesh with state.range(0) x state.range(0) faces
+static void BM_Administrate(benchmark::State& state)
+{
+    const auto mesh = MakeRectangularMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    for (auto _ : state)
+    {
+        mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+}
+BENCHMARK(BM_Administrate)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+
+// loading a snapshot of a rectangular mesh with state.range(0) x state.range(0) faces, to compare with BM_Administrate
+static void BM_LoadSnapshot(benchmark::State& state)
+{
+    const auto mesh = MakeRectangularMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    const std::string filePath = "MeshBenchmarks_snapshot.bin";
+    mesh->SaveSnapshot(filePath);
+
+    meshkernel::Mesh loadedMesh;
+    for (auto _ : state)
+    {
+        loadedMesh.LoadSnapshot(filePath);
+    }
+    std::remove(filePath.c_str());
+    state.counters["nodes"] = loadedMesh.GetNumNodes();
+}
+BENCHMARK(BM_LoadSnapshot)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+
+// interactive editing of a rectangular mesh with state.range(0) x state.range(0) faces:
+// a node is inserted and connected to the previous one, the edges are administrated and the node is searched
+static void BM_InsertNodeAndGetNodeIndex(benchmark::State& state)
+{
+    const auto mesh = MakeRectangularMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdges);
+    benchmark::DoNotOptimize(mesh->GetNodeIndex({0.0, 0.0}, 1.0));
+
+    int previousNodeIndex = 0;
+    for (auto _ : state)
+    {
+        const meshkernel::Point newNode{mesh->m_nodes[previousNodeIndex].x - 10.0, -10.0};
+        int newNodeIndex;
+        mesh->InsertNode(newNode, newNodeIndex);
+        int newEdgeIndex;
+        mesh->ConnectNodes(previousNodeIndex, newNodeIndex, newEdgeIndex);
+        mesh->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdges);
+        benchmark::DoNotOptimize(mesh->GetNodeIndex(newNode, 1.0));
+        previousNodeIndex = newNodeIndex;
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+}
+BENCHMARK(BM_InsertNodeAndGetNodeIndex)->Unit(benchmark::kMicrosecond)->RangeMultiplier(4)->Range(64, 1024);
+
+// the face detection of a rectangular mesh with state.range(0) x state.range(0) faces,
+// all faces are traced again and recognized as existing ones (the face reset is part of BM_Administrate)
+static void BM_FindFaces(benchmark::State& state)
+{
+    const auto mesh = MakeRectangularMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    for (auto _ : state)
+    {
+        mesh->FindFaces();
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+    state.counters["faces"] = mesh->GetNumFaces();
+}
+BENCHMARK(BM_FindFaces)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+
+// the face detection of a triangular mesh with state.range(0) nodes, as in BM_FindFaces
+static void BM_FindFacesTriangularMesh(benchmark::State& state)
+{
+    const auto mesh = MakeTriangularMesh(static_cast<int>(state.range(0)), 1000.0);
+    for (auto _ : state)
+    {
+        mesh->FindFaces();
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+    state.counters["faces"] = mesh->GetNumFaces();
+}
+BENCHMARK(BM_FindFacesTriangularMesh)->Unit(benchmark::kMillisecond)->RangeMultiplier(8)->Range(4096, 262144);
+
+// the triangulation of state.range(0) random points, Mesh(nodes, polygons, projection), in parallel if state.range(1) is 1
+static void BM_TriangulateNodes(benchmark::State& state)
+{
+    const auto samples = MakeSamples(static_cast<int>(state.range(0)), 1000.0);
+    std::vector<meshkernel::Point> points;
+    points.reserve(samples.size());
+    for (const auto& sample : samples)
+    {
+        points.push_back({sample.x, sample.y});
+    }
+    const meshkernel::Polygons polygons;
+
+    for (auto _ : state)
+    {
+        meshkernel::Mesh mesh(points, polygons, meshkernel::Projections::cartesian, state.range(1) == 1);
+        benchmark::DoNotOptimize(mesh.GetNumEdges());
+    }
+    state.counters["nodes"] = static_cast<double>(points.size());
+}
+BENCHMARK(BM_TriangulateNodes)->Unit(benchmark::kMillisecond)->ArgsProduct({{4096, 32768, 262144}, {0, 1}});
+
+namespace
+{
+    // Runs a geometry benchmark on a triangular mesh with state.range(0) nodes,
+    // with the batched kernels of the instruction set state.range(1) (0 default, 1 AVX2, 2 AVX-512)
+    template <typename Compute>
+    void RunGeometryBenchmark(benchmark::State& state, Compute compute)
+    {
+        const auto instructionSet = static_cast<meshkernel::InstructionSet>(state.range(1));
+        if (!meshkernel::IsInstructionSetSupported(instructionSet))
+        {
+            state.SkipWithError("The instruction set is not supported by this build or cpu");
+            return;
+        }
+        const auto previousInstructionSet = meshkernel::GetInstructionSet();
+        meshkernel::SetInstructionSet(instructionSet);
+
+        const auto mesh = MakeTriangularMesh(static_cast<int>(state.range(0)), 1000.0);
+        for (auto _ : state)
+        {
+            compute(*mesh);
+        }
+        state.counters["edges"] = mesh->GetNumEdges();
+        state.counters["faces"] = mesh->GetNumFaces();
+
+        meshkernel::SetInstructionSet(previousInstructionSet);
+    }
+} // namespace
+
+static void BM_ComputeEdgeLengths(benchmark::State& state)
+{
+    RunGeometryBenchmark(state, [](meshkernel::Mesh& mesh) { mesh.ComputeEdgeLengths(); });
+}
+BENCHMARK(BM_ComputeEdgeLengths)->Unit(benchmark::kMillisecond)->ArgsProduct({{65536, 1048576}, {0, 1, 2}});
+
+static void BM_ComputeEdgesCenters(benchmark::State& state)
+{
+    RunGeometryBenchmark(state, [](meshkernel::Mesh& mesh) { mesh.ComputeEdgesCenters(); });
+}
+BENCHMARK(BM_ComputeEdgesCenters)->Unit(benchmark::kMillisecond)->ArgsProduct({{65536, 1048576}, {0, 1, 2}});
+
+static void BM_ComputeFaceCircumcenters(benchmark::State& state)
+{
+    RunGeometryBenchmark(state, [](meshkernel::Mesh& mesh) { mesh.ComputeFaceCircumcentersMassCentersAndAreas(); });
+}
+BENCHMARK(BM_ComputeFaceCircumcenters)->Unit(benchmark::kMillisecond)->ArgsProduct({{65536, 1048576}, {0, 1, 2}});
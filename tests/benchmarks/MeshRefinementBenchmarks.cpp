@@ -0,0 +1,42 @@
+#include <MeshKernel/InterpolationParametersNative.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/MeshRefinement.hpp>
+#include <MeshKernel/Polygons.hpp>
+#include <MeshKernel/SampleRefineParametersNative.hpp>
+#include <benchmark/benchmark.h>
+
+#include "SyntheticMeshes.hpp"
+
+// refines once all faces of a rectangular mesh with state.range(0) x state.range(0) faces
+static void BM_MeshRefinement(benchmark::State& state)
+{
+    const auto baseMesh = MakeRectangularMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    const meshkernel::Polygons polygon;
+
+    meshkernelapi::SampleRefineParametersNative sampleRefineParametersNative;
+    sampleRefineParametersNative.MaxNumberOfRefinementIterations = 1;
+    sampleRefineParametersNative.MinimumCellSize = 1.0;
+    sampleRefineParametersNative.RefinementType = 2;
+    sampleRefineParametersNative.ConnectHangingNodes = 1;
+    sampleRefineParametersNative.MaximumTimeStepInCourantGrid = 1.0;
+    sampleRefineParametersNative.AccountForSamplesOutside = false;
+
+    meshkernelapi::InterpolationParametersNative interpolationParametersNative;
+    interpolationParametersNative.MaxNumberOfRefinementIterations = 1;
+    interpolationParametersNative.RefineIntersected = false;
+
+    int numRefinedNodes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto mesh = std::make_shared<meshkernel::Mesh>(*baseMesh);
+        meshkernel::MeshRefinement meshRefinement(mesh);
+        state.ResumeTiming();
+
+        meshRefinement.Refine(polygon, sampleRefineParametersNative, interpolationParametersNative);
+        numRefinedNodes = mesh->GetNumNodes();
+    }
+    state.counters["nodes"] = baseMesh->GetNumNodes();
+    state.counters["refinedNodes"] = numRefinedNodes;
+}
+BENCHMARK(BM_MeshRefinement)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(64, 512);
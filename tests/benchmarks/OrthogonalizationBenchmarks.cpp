@@ -0,0 +1,115 @@
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include <MeshKernel/LandBoundaries.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/OrthogonalizationAndSmoothing.hpp>
+#include <MeshKernel/OrthogonalizationParametersNative.hpp>
+#include <MeshKernel/Orthogonalizer.hpp>
+#include <MeshKernel/Polygons.hpp>
+#include <MeshKernel/Smoother.hpp>
+#include <benchmark/benchmark.h>
+
+#include "SyntheticMeshes.hpp"
+
+namespace
+{
+    // orthogonalizes a copy of baseMesh in every benchmark iteration, the setup is not timed
+    void RunOrthogonalization(benchmark::State& state,
+                              const meshkernel::Mesh& baseMesh,
+                              meshkernel::OrthogonalizationAndSmoothing::LinearSolver linearSolver)
+    {
+        meshkernelapi::OrthogonalizationParametersNative orthogonalizationParametersNative;
+        orthogonalizationParametersNative.OuterIterations = 2;
+        orthogonalizationParametersNative.BoundaryIterations = 25;
+        orthogonalizationParametersNative.InnerIterations = 25;
+        orthogonalizationParametersNative.OrthogonalizationToSmoothingFactor = 0.975;
+        orthogonalizationParametersNative.OrthogonalizationToSmoothingFactorBoundary = 1.0;
+        orthogonalizationParametersNative.Smoothorarea = 1.0;
+
+        const auto polygon = std::make_shared<meshkernel::Polygons>();
+        std::vector<meshkernel::Point> landBoundary;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            const auto mesh = std::make_shared<meshkernel::Mesh>(baseMesh);
+            const auto orthogonalizer = std::make_shared<meshkernel::Orthogonalizer>(mesh);
+            const auto smoother = std::make_shared<meshkernel::Smoother>(mesh);
+            const auto landBoundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+            meshkernel::OrthogonalizationAndSmoothing orthogonalization(mesh,
+                                                                        smoother,
+                                                                        orthogonalizer,
+                                                                        polygon,
+                                                                        landBoundaries,
+                                                                        0,
+                                                                        orthogonalizationParametersNative);
+            orthogonalization.SetLinearSolver(linearSolver);
+            state.ResumeTiming();
+
+            orthogonalization.Initialize();
+            orthogonalization.Compute();
+        }
+        state.counters["nodes"] = baseMesh.GetNumNodes();
+    }
+
+    int GetMaxNumThreads()
+    {
+#if defined(_OPENMP)
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+} // namespace
+
+// orthogonalizes a distorted curvilinear mesh with state.range(0) x state.range(0) nodes,
+// state.range(1) selects the linear solver (0 Jacobi, 1 BiCGStab)
+static void BM_Orthogonalization(benchmark::State& state)
+{
+    const auto baseMesh = MakeDistortedCurvilinearMesh(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), 10.0);
+    RunOrthogonalization(state, *baseMesh, static_cast<meshkernel::OrthogonalizationAndSmoothing::LinearSolver>(state.range(1)));
+}
+BENCHMARK(BM_Orthogonalization)->Unit(benchmark::kMillisecond)->ArgsProduct({{64, 128, 256}, {0, 1}});
+
+// the threads scaling of the Jacobi orthogonalization of a 256 x 256 distorted curvilinear mesh, with state.range(0) threads.
+// Compare the wall-clock times of the runs: the inner iterations are Jacobi sweeps, so the results do not depend on the number of threads
+static void BM_OrthogonalizationThreads(benchmark::State& state)
+{
+    const auto baseMesh = MakeDistortedCurvilinearMesh(256, 256, 10.0);
+    const auto maxNumThreads = GetMaxNumThreads();
+#if defined(_OPENMP)
+    omp_set_num_threads(static_cast<int>(state.range(0)));
+#endif
+
+    RunOrthogonalization(state, *baseMesh, meshkernel::OrthogonalizationAndSmoothing::LinearSolver::Jacobi);
+
+#if defined(_OPENMP)
+    omp_set_num_threads(maxNumThreads);
+#endif
+    state.counters["threads"] = static_cast<double>(state.range(0));
+}
+// 1, 2, 4, ... threads, up to the maximum number of threads
+BENCHMARK(BM_OrthogonalizationThreads)->Unit(benchmark::kMillisecond)->UseRealTime()->Apply([](benchmark::internal::Benchmark* benchmark) {
+    const auto maxNumThreads = GetMaxNumThreads();
+    for (int numThreads = 1; numThreads < maxNumThreads; numThreads *= 2)
+    {
+        benchmark->Arg(numThreads);
+    }
+    benchmark->Arg(maxNumThreads);
+});
+
+// the smoother weights of the triangulation of state.range(0) random points, where most nodes have a topology of their own
+static void BM_SmootherTriangularMesh(benchmark::State& state)
+{
+    const auto mesh = MakeTriangularMesh(static_cast<int>(state.range(0)), 1000.0);
+
+    for (auto _ : state)
+    {
+        meshkernel::Smoother smoother(mesh);
+        smoother.Compute();
+    }
+    state.counters["nodes"] = mesh->GetNumNodes();
+}
+BENCHMARK(BM_SmootherTriangularMesh)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(4096, 65536);
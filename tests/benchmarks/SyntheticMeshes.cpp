@@ -0,0 +1,90 @@
+#include <cmath>
+#include <random>
+
+#include <MeshKernel/Constants.hpp>
+#include <MeshKernel/CurvilinearGrid.hpp>
+#include <MeshKernel/MakeGridParametersNative.hpp>
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/Polygons.hpp>
+
+#include "SyntheticMeshes.hpp"
+
+namespace
+{
+    // the same random sequence on every run, so the timings of different builds can be compared
+    constexpr unsigned int randomSeed = 42;
+} // namespace
+
+std::shared_ptr<meshkernel::Mesh> MakeRectangularMesh(int numColumns, int numRows, double delta)
+{
+    meshkernelapi::MakeGridParametersNative makeGridParametersNative;
+    makeGridParametersNative.GridType = 0;
+    makeGridParametersNative.GridAngle = 0.0;
+    makeGridParametersNative.OriginXCoordinate = 0.0;
+    makeGridParametersNative.OriginYCoordinate = 0.0;
+    makeGridParametersNative.OriginZCoordinate = 0.0;
+    makeGridParametersNative.NumberOfColumns = numColumns;
+    makeGridParametersNative.NumberOfRows = numRows;
+    makeGridParametersNative.XGridBlockSize = delta;
+    makeGridParametersNative.YGridBlockSize = delta;
+
+    const meshkernel::Polygons polygons;
+    auto mesh = std::make_shared<meshkernel::Mesh>();
+    mesh->MakeMesh(makeGridParametersNative, polygons);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    return mesh;
+}
+
+std::shared_ptr<meshkernel::Mesh> MakeTriangularMesh(int numPoints, double size)
+{
+    std::mt19937 generator(randomSeed);
+    std::uniform_real_distribution<double> distribution(0.0, size);
+
+    std::vector<meshkernel::Point> points(numPoints);
+    for (auto& point : points)
+    {
+        point.x = distribution(generator);
+        point.y = distribution(generator);
+    }
+
+    const meshkernel::Polygons polygons;
+    auto mesh = std::make_shared<meshkernel::Mesh>(points, polygons, meshkernel::Projections::cartesian);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    return mesh;
+}
+
+std::shared_ptr<meshkernel::Mesh> MakeDistortedCurvilinearMesh(int numM, int numN, double delta)
+{
+    const double amplitude = 0.3 * delta;
+    meshkernel::CurvilinearGrid curvilinearGrid;
+    curvilinearGrid.Set(numM - 1, numN - 1);
+    for (int m = 0; m < numM; ++m)
+    {
+        for (int n = 0; n < numN; ++n)
+        {
+            const bool isBoundary = m == 0 || n == 0 || m == numM - 1 || n == numN - 1;
+            const double waveX = isBoundary ? 0.0 : amplitude * std::sin(2.0 * M_PI * n / (numN - 1)) * std::sin(M_PI * m / (numM - 1));
+            const double waveY = isBoundary ? 0.0 : amplitude * std::sin(2.0 * M_PI * m / (numM - 1)) * std::sin(M_PI * n / (numN - 1));
+            curvilinearGrid.m_grid[m][n] = {m * delta + waveX, n * delta + waveY};
+        }
+    }
+
+    auto mesh = std::make_shared<meshkernel::Mesh>(curvilinearGrid, meshkernel::Projections::cartesian);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    return mesh;
+}
+
+std::vector<meshkernel::Sample> MakeSamples(int numSamples, double size)
+{
+    std::mt19937 generator(randomSeed);
+    std::uniform_real_distribution<double> distribution(0.0, size);
+
+    std::vector<meshkernel::Sample> samples(numSamples);
+    for (auto& sample : samples)
+    {
+        sample.x = distribution(generator);
+        sample.y = distribution(generator);
+        sample.value = std::sin(sample.x / size * M_PI) * std::cos(sample.y / size * M_PI);
+    }
+    return samples;
+}
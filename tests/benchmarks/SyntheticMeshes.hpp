@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <MeshKernel/Entities.hpp>
+
+namespace meshkernel
+{
+    class Mesh;
+} // namespace meshkernel
+
+/// @brief Makes a rectangular mesh with Mesh::MakeMesh
+/// @param[in] numColumns The number of columns
+/// @param[in] numRows The number of rows
+/// @param[in] delta The size of the cells
+/// @returns The mesh, with edges and faces administrated
+std::shared_ptr<meshkernel::Mesh> MakeRectangularMesh(int numColumns, int numRows, double delta);
+
+/// @brief Makes a triangular mesh by triangulating random points in a square
+/// @param[in] numPoints The number of points to triangulate
+/// @param[in] size The size of the square
+/// @returns The mesh, with edges and faces administrated
+std::shared_ptr<meshkernel::Mesh> MakeTriangularMesh(int numPoints, double size);
+
+/// @brief Makes a mesh from a curvilinear grid whose internal nodes are displaced by a smooth wave
+/// @param[in] numM The number of grid lines in the m direction
+/// @param[in] numN The number of grid lines in the n direction
+/// @param[in] delta The size of the undisturbed cells
+/// @returns The mesh, with edges and faces administrated
+std::shared_ptr<meshkernel::Mesh> MakeDistortedCurvilinearMesh(int numM, int numN, double delta);
+
+/// @brief Makes random samples of a smooth field in a square
+/// @param[in] numSamples The number of samples
+/// @param[in] size The size of the square, with the lower left corner at the origin
+/// @returns The samples
+std::vector<meshkernel::Sample> MakeSamples(int numSamples, double size);
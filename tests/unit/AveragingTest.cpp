@@ -561,3 +561,73 @@ TEST(Averaging, InterpolateOnFacesMinAbsValue)
     ASSERT_NEAR(5.2240896000000001, interpolationResults[8], tolerance);
     ASSERT_NEAR(6.1764706000000000, interpolationResults[9], tolerance);
 }
+
+TEST(Averaging, ParallelInterpolationGivesTheSameResultsAsSerial)
+{
+    auto mesh = MakeRectangularMeshForTesting(31, 31, 10.0, meshkernel::Projections::cartesian);
+
+    std::vector<meshkernel::Sample> samples;
+    for (int i = 0; i < 150; ++i)
+    {
+        for (int j = 0; j < 150; ++j)
+        {
+            samples.push_back({i * 2.0 + 0.5, j * 2.0 + 0.5, std::sin(i * 0.1) + std::cos(j * 0.2)});
+        }
+    }
+
+    for (const auto location : {meshkernel::InterpolationLocation::Faces, meshkernel::InterpolationLocation::Nodes, meshkernel::InterpolationLocation::Edges})
+    {
+        meshkernel::AveragingInterpolation serialAveraging(mesh, samples, meshkernel::AveragingInterpolation::Method::InverseWeightedDistance, location, 1.01, false, false);
+        serialAveraging.Compute();
+
+        meshkernel::AveragingInterpolation parallelAveraging(mesh, samples, meshkernel::AveragingInterpolation::Method::InverseWeightedDistance, location, 1.01, false, false);
+        parallelAveraging.SetParallel(true);
+        parallelAveraging.Compute();
+
+        const auto& serialResults = serialAveraging.GetResults();
+        const auto& parallelResults = parallelAveraging.GetResults();
+        ASSERT_EQ(serialResults.size(), parallelResults.size());
+        for (int i = 0; i < static_cast<int>(serialResults.size()); ++i)
+        {
+            ASSERT_EQ(serialResults[i], parallelResults[i]);
+        }
+    }
+}
+
+TEST(Averaging, ParallelInterpolationDecrementsEachVisitedSampleOnce)
+{
+    auto mesh = MakeRectangularMeshForTesting(5, 5, 10.0, meshkernel::Projections::cartesian);
+
+    // two samples per face, one sample on a face corner shared by four faces
+    std::vector<meshkernel::Sample> samples;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            samples.push_back({i * 10.0 + 3.0, j * 10.0 + 3.0, 3.0});
+            samples.push_back({i * 10.0 + 7.0, j * 10.0 + 7.0, 3.0});
+        }
+    }
+    samples.push_back({20.0, 20.0, 5.0});
+
+    meshkernel::AveragingInterpolation averaging(mesh, samples, meshkernel::AveragingInterpolation::Method::Max, meshkernel::InterpolationLocation::Faces, 1.01, false, true);
+    averaging.SetParallel(true);
+    averaging.Compute();
+
+    // the results are computed before the samples are decremented
+    const auto& results = averaging.GetResults();
+    ASSERT_EQ(results.size(), 16);
+    int numFacesWithCornerSample = 0;
+    for (const auto result : results)
+    {
+        ASSERT_TRUE(result == 3.0 || result == 5.0);
+        numFacesWithCornerSample += result == 5.0 ? 1 : 0;
+    }
+    ASSERT_EQ(numFacesWithCornerSample, 4);
+
+    for (int s = 0; s < static_cast<int>(samples.size()) - 1; ++s)
+    {
+        ASSERT_EQ(samples[s].value, 2.0);
+    }
+    ASSERT_EQ(samples.back().value, 4.0);
+}
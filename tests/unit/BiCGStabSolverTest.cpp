@@ -0,0 +1,125 @@
+#include <MeshKernel/BiCGStabSolver.hpp>
+#include <MeshKernel/SparseMatrix.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(BiCGStabSolver, SolvesNonSymmetricSystem)
+{
+    // 1 Setup: a non symmetric, diagonally dominant, tridiagonal matrix
+    constexpr int size = 50;
+    meshkernel::SparseMatrix matrix;
+    for (int i = 0; i < size; ++i)
+    {
+        if (i > 0)
+        {
+            matrix.AddEntry(i - 1, -1.5);
+        }
+        matrix.AddEntry(i, 4.0);
+        if (i < size - 1)
+        {
+            matrix.AddEntry(i + 1, -0.5);
+        }
+        matrix.FinalizeRow();
+    }
+
+    std::vector<double> expectedSolution(size);
+    for (int i = 0; i < size; ++i)
+    {
+        expectedSolution[i] = 1.0 + 0.1 * i;
+    }
+    std::vector<double> rhs;
+    matrix.Multiply(expectedSolution, rhs);
+
+    // 2 Execute
+    meshkernel::BiCGStabSolver solver;
+    solver.SetPreconditioner(matrix);
+    std::vector<double> solution(size, 0.0);
+    const auto numIterations = solver.Solve(matrix, rhs, 1e-12, 0.0, 100, solution);
+
+    // 3 Validation
+    ASSERT_TRUE(solver.IsConverged());
+    ASSERT_GT(numIterations, 0);
+    ASSERT_LE(solver.GetRelativeResidual(), 1e-12);
+    for (int i = 0; i < size; ++i)
+    {
+        ASSERT_NEAR(solution[i], expectedSolution[i], 1e-9);
+    }
+}
+
+TEST(BiCGStabSolver, ExactInitialGuessNeedsNoIteration)
+{
+    // 1 Setup
+    meshkernel::SparseMatrix matrix;
+    matrix.AddEntry(0, 2.0);
+    matrix.AddEntry(1, -1.0);
+    matrix.FinalizeRow();
+    matrix.AddEntry(0, -0.5);
+    matrix.AddEntry(1, 2.0);
+    matrix.FinalizeRow();
+
+    std::vector<double> solution{1.0, 2.0};
+    std::vector<double> rhs;
+    matrix.Multiply(solution, rhs);
+
+    // 2 Execute
+    meshkernel::BiCGStabSolver solver;
+    solver.SetPreconditioner(matrix);
+    const auto numIterations = solver.Solve(matrix, rhs, 1e-12, 0.0, 100, solution);
+
+    // 3 Validation
+    ASSERT_EQ(numIterations, 0);
+    ASSERT_TRUE(solver.IsConverged());
+    ASSERT_EQ(solution[0], 1.0);
+    ASSERT_EQ(solution[1], 2.0);
+}
+
+TEST(BiCGStabSolver, StopsOnResidualReduction)
+{
+    // 1 Setup: a symmetric tridiagonal matrix with a weak diagonal, requiring several iterations
+    constexpr int size = 200;
+    meshkernel::SparseMatrix matrix;
+    for (int i = 0; i < size; ++i)
+    {
+        if (i > 0)
+        {
+            matrix.AddEntry(i - 1, -1.0);
+        }
+        matrix.AddEntry(i, 2.01);
+        if (i < size - 1)
+        {
+            matrix.AddEntry(i + 1, -1.0);
+        }
+        matrix.FinalizeRow();
+    }
+    const std::vector<double> rhs(size, 1.0);
+
+    // 2 Execute
+    meshkernel::BiCGStabSolver solver;
+    solver.SetPreconditioner(matrix);
+    std::vector<double> solution(size, 0.0);
+    const auto numIterations = solver.Solve(matrix, rhs, 1e-12, 1e-2, 1000, solution);
+    const auto isConverged = solver.IsConverged();
+    const auto relativeResidual = solver.GetRelativeResidual();
+
+    std::vector<double> fullSolution(size, 0.0);
+    const auto numIterationsFullSolve = solver.Solve(matrix, rhs, 1e-12, 0.0, 1000, fullSolution);
+
+    // 3 Validation: the initial residual is the right hand side
+    ASSERT_TRUE(isConverged);
+    ASSERT_LE(relativeResidual, 1e-2);
+    ASSERT_GT(relativeResidual, 1e-12);
+    ASSERT_LT(numIterations, numIterationsFullSolve);
+}
+
+TEST(BiCGStabSolver, SolveWithoutPreconditionerThrows)
+{
+    // 1 Setup
+    meshkernel::SparseMatrix matrix;
+    matrix.AddEntry(0, 2.0);
+    matrix.FinalizeRow();
+    std::vector<double> solution{0.0};
+
+    // 2 Execute and validation
+    meshkernel::BiCGStabSolver solver;
+    ASSERT_THROW(solver.Solve(matrix, {1.0}, 1e-12, 0.0, 100, solution), std::invalid_argument);
+}
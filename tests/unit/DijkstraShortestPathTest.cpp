@@ -0,0 +1,91 @@
+#include <MeshKernel/DijkstraShortestPath.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Runs a full search on a graph given as a list of weighted edges, all nodes can be settled
+    std::vector<int> RunSearch(meshkernel::DijkstraShortestPath& shortestPath,
+                               int numNodes,
+                               int sourceNode,
+                               const std::vector<std::pair<int, int>>& edges,
+                               const std::vector<double>& weights)
+    {
+        std::vector<int> settledNodes;
+        shortestPath.Initialize(numNodes, sourceNode);
+        int currentNode = sourceNode;
+        while (currentNode >= 0)
+        {
+            shortestPath.SetVisited(currentNode);
+            settledNodes.emplace_back(currentNode);
+            for (int e = 0; e < static_cast<int>(edges.size()); ++e)
+            {
+                if (edges[e].first != currentNode && edges[e].second != currentNode)
+                {
+                    continue;
+                }
+                const auto otherNode = edges[e].first + edges[e].second - currentNode;
+                shortestPath.Relax(otherNode, e, shortestPath.GetDistance(currentNode) + weights[e], true);
+            }
+            currentNode = shortestPath.PopNearestNode();
+        }
+        return settledNodes;
+    }
+} // namespace
+
+TEST(DijkstraShortestPath, ComputesShortestDistancesAndPredecessors)
+{
+    // 0 - 1 - 2
+    // |       |
+    // 3 ----- 4
+    const std::vector<std::pair<int, int>> edges{{0, 1}, {1, 2}, {0, 3}, {3, 4}, {2, 4}};
+    const std::vector<double> weights{1.0, 1.0, 0.5, 0.5, 5.0};
+
+    meshkernel::DijkstraShortestPath shortestPath;
+    const auto settledNodes = RunSearch(shortestPath, 5, 0, edges, weights);
+
+    ASSERT_EQ(settledNodes.size(), 5);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(0), 0.0);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(1), 1.0);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(2), 2.0);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(3), 0.5);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(4), 1.0);
+
+    ASSERT_EQ(shortestPath.GetPredecessorEdge(0), -1);
+    ASSERT_EQ(shortestPath.GetPredecessorEdge(2), 1);
+    ASSERT_EQ(shortestPath.GetPredecessorEdge(4), 3);
+}
+
+TEST(DijkstraShortestPath, TiesAreBrokenOnTheLowestNodeIndex)
+{
+    // star graph, all edges have the same weight
+    const std::vector<std::pair<int, int>> edges{{0, 4}, {0, 2}, {0, 3}, {0, 1}};
+    const std::vector<double> weights{1.0, 1.0, 1.0, 1.0};
+
+    meshkernel::DijkstraShortestPath shortestPath;
+    const auto settledNodes = RunSearch(shortestPath, 5, 0, edges, weights);
+
+    const std::vector<int> expectedOrder{0, 1, 2, 3, 4};
+    ASSERT_EQ(settledNodes, expectedOrder);
+}
+
+TEST(DijkstraShortestPath, BuffersAreResetBetweenSearches)
+{
+    // 0 - 1 - 2   3 (isolated)
+    const std::vector<std::pair<int, int>> edges{{0, 1}, {1, 2}};
+    const std::vector<double> weights{1.0, 2.0};
+
+    meshkernel::DijkstraShortestPath shortestPath;
+    RunSearch(shortestPath, 4, 0, edges, weights);
+    const auto settledNodes = RunSearch(shortestPath, 4, 2, edges, weights);
+
+    ASSERT_EQ(settledNodes.size(), 3);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(2), 0.0);
+    ASSERT_DOUBLE_EQ(shortestPath.GetDistance(0), 3.0);
+    ASSERT_EQ(shortestPath.GetPredecessorEdge(2), -1);
+    ASSERT_EQ(shortestPath.GetPredecessorEdge(0), 0);
+    ASSERT_FALSE(shortestPath.IsVisited(3));
+    ASSERT_EQ(shortestPath.GetDistance(3), std::numeric_limits<double>::max());
+}
@@ -65,3 +65,49 @@ TEST(FlipEdges, FlipEdgesMediumTriangularMesh)
     ASSERT_EQ(242, mesh->m_edges[68].first);
     ASSERT_EQ(148, mesh->m_edges[68].second);
 }
+
+TEST(FlipEdges, FlipEdgesMeshWithQuadrilateral)
+{
+    //1 Setup: a 4x4 faces mesh with triangles in the union jack pattern, except the first face that stays a quadrilateral
+    auto mesh = MakeRectangularMeshForTesting(5, 5, 10, meshkernel::Projections::cartesian, {0.0, 0.0});
+    auto edges = mesh->m_edges;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            if (i == 0 && j == 0)
+            {
+                continue;
+            }
+            if ((i + j) % 2 == 0)
+            {
+                edges.push_back({i * 5 + j, (i + 1) * 5 + j + 1});
+            }
+            else
+            {
+                edges.push_back({(i + 1) * 5 + j, i * 5 + j + 1});
+            }
+        }
+    }
+    mesh->Set(edges, mesh->m_nodes, meshkernel::Projections::cartesian);
+    ASSERT_EQ(8, mesh->m_nodesNumEdges[12]);
+
+    auto polygon = std::make_shared<meshkernel::Polygons>();
+    std::vector<meshkernel::Point> landBoundary;
+    auto landBoundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+
+    //execute flipedges, without triangulating the quadrilateral
+    meshkernel::FlipEdges flipEdges(mesh, landBoundaries, false, false);
+
+    flipEdges.Compute();
+
+    // the edges next to the quadrilateral do not stop the flipping of the other edges
+    ASSERT_EQ(55, mesh->GetNumEdges());
+    ASSERT_EQ(6, mesh->m_nodesNumEdges[12]);
+
+    ASSERT_EQ(6, mesh->m_edges[44].first);
+    ASSERT_EQ(12, mesh->m_edges[44].second);
+
+    ASSERT_EQ(12, mesh->m_edges[45].first);
+    ASSERT_EQ(8, mesh->m_edges[45].second);
+}
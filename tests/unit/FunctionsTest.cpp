@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <random>
+#include <stdexcept>
 
 TEST(FunctionsTest, NormalVectorInsideTestCartesian)
 {
@@ -21,3 +22,158 @@ TEST(FunctionsTest, NormalVectorInsideTestCartesian)
     ASSERT_EQ(normal.y, 1.0);
     ASSERT_EQ(flippedNormal, true);
 }
+
+TEST(FunctionsTest, ComputeDistancesMatchesComputeDistance)
+{
+    //1 Setup: regular pairs, invalid points, aligned points, points on the poles and across the date line
+    const std::vector<meshkernel::Point> firstPoints{{0.0, 0.0}, {1.5, -2.0}, {meshkernel::doubleMissingValue, 3.0}, {4.0, 5.0}, {10.0, 90.0}, {179.0, 10.0}, {-179.5, -45.0}, {2.0, 2.0}};
+    const std::vector<meshkernel::Point> secondPoints{{3.0, 4.0}, {1.5 + 1e-17, 7.0}, {1.0, 1.0}, {4.0, 5.0}, {20.0, 80.0}, {-178.0, 11.0}, {179.5, -46.0}, {2.5, 2.0 + 1e-17}};
+
+    meshkernel::PointsArrays firstPointsArrays;
+    meshkernel::PointsArrays secondPointsArrays;
+    firstPointsArrays.Resize(static_cast<int>(firstPoints.size()));
+    secondPointsArrays.Resize(static_cast<int>(secondPoints.size()));
+    for (int i = 0; i < firstPoints.size(); ++i)
+    {
+        firstPointsArrays.Set(i, firstPoints[i]);
+        secondPointsArrays.Set(i, secondPoints[i]);
+    }
+
+    for (const auto projection : {meshkernel::Projections::cartesian, meshkernel::Projections::spherical, meshkernel::Projections::sphericalAccurate})
+    {
+        // 2 Execute
+        std::vector<double> distances;
+        meshkernel::ComputeDistances(firstPointsArrays, secondPointsArrays, projection, distances);
+
+        // 3 Validation: the batched kernels give the same results as the scalar function
+        ASSERT_EQ(distances.size(), firstPoints.size());
+        for (int i = 0; i < firstPoints.size(); ++i)
+        {
+            ASSERT_EQ(distances[i], meshkernel::ComputeDistance(firstPoints[i], secondPoints[i], projection));
+        }
+    }
+}
+
+TEST(FunctionsTest, GeometryKernelsOfAllInstructionSetsMatchTheScalarFunctions)
+{
+    //1 Setup: regular pairs and triangles, invalid points, aligned points, near-zero deltas and degenerated triangles
+    std::vector<meshkernel::Point> firstPoints{{0.0, 0.0}, {1.5, -2.0}, {meshkernel::doubleMissingValue, 3.0}, {4.0, 5.0}, {2.0, 2.0}, {1.0, 1.0}};
+    std::vector<meshkernel::Point> secondPoints{{3.0, 4.0}, {1.5 + 1e-17, 7.0}, {1.0, 1.0}, {4.0, 5.0}, {2.5, 2.0 + 1e-17}, {2.0, 2.0}};
+    std::vector<meshkernel::Point> thirdPoints{{0.0, 5.0}, {-3.0, 1.0}, {2.0, 0.0}, {4.0, 5.0}, {3.0, 7.5}, {3.0, 3.0}};
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+    for (int i = 0; i < 37; ++i)
+    {
+        firstPoints.push_back({distribution(generator), distribution(generator)});
+        secondPoints.push_back({distribution(generator), distribution(generator)});
+        thirdPoints.push_back({distribution(generator), distribution(generator)});
+    }
+    const auto size = static_cast<int>(firstPoints.size());
+
+    meshkernel::PointsArrays first;
+    meshkernel::PointsArrays second;
+    meshkernel::PointsArrays third;
+    first.Resize(size);
+    second.Resize(size);
+    third.Resize(size);
+    for (int i = 0; i < size; ++i)
+    {
+        first.Set(i, firstPoints[i]);
+        second.Set(i, secondPoints[i]);
+        third.Set(i, thirdPoints[i]);
+    }
+
+    // the edges connect the first and the second points, the last edge is invalid
+    std::vector<meshkernel::Point> nodes(firstPoints);
+    nodes.insert(nodes.end(), secondPoints.begin(), secondPoints.end());
+    std::vector<meshkernel::Edge> edges;
+    for (int i = 0; i < size; ++i)
+    {
+        edges.emplace_back(i, size + i);
+    }
+    edges.emplace_back(-1, 0);
+
+    const auto defaultInstructionSet = meshkernel::GetInstructionSet();
+    for (const auto instructionSet : {meshkernel::InstructionSet::Default, meshkernel::InstructionSet::AVX2, meshkernel::InstructionSet::AVX512})
+    {
+        if (!meshkernel::IsInstructionSetSupported(instructionSet))
+        {
+            ASSERT_THROW(meshkernel::SetInstructionSet(instructionSet), std::invalid_argument);
+            continue;
+        }
+
+        // 2 Execute
+        meshkernel::SetInstructionSet(instructionSet);
+        std::vector<double> distances(size);
+        meshkernel::ComputeCartesianDistances(size, first.x.data(), first.y.data(), second.x.data(), second.y.data(), distances.data());
+        std::vector<meshkernel::Point> edgesCenters(edges.size());
+        meshkernel::ComputeEdgesCenters(static_cast<int>(edges.size()), &nodes[0].x, &edges[0].first, &edgesCenters[0].x);
+        meshkernel::PointsArrays circumcenters;
+        circumcenters.Resize(size);
+        meshkernel::ComputeCartesianTrianglesCircumcenters(size,
+                                                           first.x.data(),
+                                                           first.y.data(),
+                                                           second.x.data(),
+                                                           second.y.data(),
+                                                           third.x.data(),
+                                                           third.y.data(),
+                                                           circumcenters.x.data(),
+                                                           circumcenters.y.data());
+
+        // 3 Validation: all instruction sets give exactly the results of the scalar functions
+        for (int i = 0; i < size; ++i)
+        {
+            ASSERT_EQ(distances[i], meshkernel::ComputeDistance(firstPoints[i], secondPoints[i], meshkernel::Projections::cartesian));
+
+            const auto edgeCenter = (firstPoints[i] + secondPoints[i]) * 0.5;
+            ASSERT_EQ(edgesCenters[i].x, edgeCenter.x);
+            ASSERT_EQ(edgesCenters[i].y, edgeCenter.y);
+
+            // the invalid points are not part of faces
+            if (!firstPoints[i].IsValid())
+            {
+                continue;
+            }
+            meshkernel::Point circumcenter;
+            meshkernel::CircumcenterOfTriangle(firstPoints[i], secondPoints[i], thirdPoints[i], meshkernel::Projections::cartesian, circumcenter);
+            ASSERT_EQ(circumcenters.x[i], circumcenter.x);
+            ASSERT_EQ(circumcenters.y[i], circumcenter.y);
+        }
+        ASSERT_EQ(meshkernel::doubleMissingValue, edgesCenters.back().x);
+        ASSERT_EQ(meshkernel::doubleMissingValue, edgesCenters.back().y);
+    }
+    meshkernel::SetInstructionSet(defaultInstructionSet);
+}
+
+TEST(FunctionsTest, SortPointsAlongHilbertCurve)
+{
+    //1 Setup: a 4 by 4 grid of points and an invalid point
+    std::vector<meshkernel::Point> points;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            points.push_back({double(i), double(j)});
+        }
+    }
+    points.insert(points.begin() + 5, {meshkernel::doubleMissingValue, meshkernel::doubleMissingValue});
+
+    // 2 Execute
+    const auto indices = meshkernel::SortPointsAlongHilbertCurve(points);
+
+    // 3 Validation: all points are visited once, consecutive points are neighbours, the invalid point is last
+    ASSERT_EQ(indices.size(), points.size());
+    ASSERT_EQ(indices.back(), 5);
+    ASSERT_EQ(indices.front(), 0);
+    for (int i = 1; i < indices.size() - 1; ++i)
+    {
+        const auto distance = meshkernel::ComputeDistance(points[indices[i - 1]], points[indices[i]], meshkernel::Projections::cartesian);
+        ASSERT_DOUBLE_EQ(distance, 1.0);
+    }
+    auto sortedIndices = indices;
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+    for (int i = 0; i < sortedIndices.size(); ++i)
+    {
+        ASSERT_EQ(sortedIndices[i], i);
+    }
+}
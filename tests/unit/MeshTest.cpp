@@ -2,10 +2,17 @@
 #include <MeshKernel/Entities.hpp>
 #include <MeshKernel/Polygons.hpp>
 #include <MeshKernel/Constants.hpp>
+#include <MeshKernel/Exceptions.hpp>
+#include <MeshKernel/TriangulationWrapper.hpp>
 #include <TestUtils/MakeMeshes.hpp>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <random>
+#include <tuple>
 
 TEST(Mesh, OneQuadTestConstructor)
 {
@@ -688,3 +695,670 @@ TEST(Mesh, RemoveSmallTrianglesAtBoundaries)
     ASSERT_NEAR(295.33038330078125, mesh->m_nodes[2].y, tolerance);
     ASSERT_NEAR(398.59295654296875, mesh->m_nodes[3].y, tolerance);
 }
+
+namespace
+{
+    // Checks the compressed connectivity against the administrated mesh connectivity
+    void AssertCompressedConnectivityMatchesMesh(const meshkernel::Mesh& mesh)
+    {
+        ASSERT_TRUE(mesh.IsCompressedConnectivityConsistent());
+        ASSERT_EQ(mesh.GetNumNodes(), mesh.m_nodesEdgesCsr.GetNumRows());
+        for (int n = 0; n < mesh.GetNumNodes(); ++n)
+        {
+            ASSERT_EQ(mesh.m_nodesNumEdges[n], mesh.m_nodesEdgesCsr.GetRowSize(n));
+            for (int e = 0; e < mesh.m_nodesNumEdges[n]; ++e)
+            {
+                ASSERT_EQ(mesh.m_nodesEdges[n][e], mesh.m_nodesEdgesCsr(n, e));
+            }
+        }
+
+        // the missing edge faces are -1
+        for (int e = 0; e < mesh.GetNumEdges(); ++e)
+        {
+            for (int f = mesh.m_edgesNumFaces[e]; f < 2; ++f)
+            {
+                ASSERT_EQ(-1, mesh.m_edgesFaces[e][f]);
+            }
+        }
+
+        ASSERT_EQ(mesh.GetNumFaces(), mesh.m_facesNodesCsr.GetNumRows());
+        ASSERT_EQ(mesh.GetNumFaces(), mesh.m_facesEdgesCsr.GetNumRows());
+        for (int f = 0; f < mesh.GetNumFaces(); ++f)
+        {
+            ASSERT_EQ(mesh.GetNumFaceEdges(f), mesh.m_facesNodesCsr.GetRowSize(f));
+            ASSERT_EQ(mesh.GetNumFaceEdges(f), mesh.m_facesEdgesCsr.GetRowSize(f));
+            for (int n = 0; n < mesh.GetNumFaceEdges(f); ++n)
+            {
+                ASSERT_EQ(mesh.m_facesNodes[f][n], mesh.m_facesNodesCsr(f, n));
+                ASSERT_EQ(mesh.m_facesEdges[f][n], mesh.m_facesEdgesCsr(f, n));
+            }
+        }
+    }
+
+    // Compares two administrated meshes independently of the node, edge and face numbering
+    void AssertMeshAdministrationEqual(const meshkernel::Mesh& expected, const meshkernel::Mesh& actual)
+    {
+        ASSERT_EQ(expected.GetNumNodes(), actual.GetNumNodes());
+        ASSERT_EQ(expected.GetNumEdges(), actual.GetNumEdges());
+        ASSERT_EQ(expected.GetNumFaces(), actual.GetNumFaces());
+
+        const auto sortedFaces = [](const meshkernel::Mesh& mesh) {
+            std::vector<std::vector<double>> faces;
+            for (int f = 0; f < mesh.GetNumFaces(); ++f)
+            {
+                faces.push_back({mesh.m_facesMassCenters[f].x,
+                                 mesh.m_facesMassCenters[f].y,
+                                 mesh.m_faceArea[f],
+                                 mesh.m_facesCircumcenters[f].x,
+                                 mesh.m_facesCircumcenters[f].y,
+                                 double(mesh.GetNumFaceEdges(f))});
+            }
+            std::sort(faces.begin(), faces.end());
+            return faces;
+        };
+        const auto sortedNodes = [](const meshkernel::Mesh& mesh) {
+            std::vector<std::vector<double>> nodes;
+            for (int n = 0; n < mesh.GetNumNodes(); ++n)
+            {
+                nodes.push_back({mesh.m_nodes[n].x, mesh.m_nodes[n].y, double(mesh.m_nodesTypes[n]), double(mesh.m_nodesNumEdges[n])});
+            }
+            std::sort(nodes.begin(), nodes.end());
+            return nodes;
+        };
+
+        const auto expectedFaces = sortedFaces(expected);
+        const auto actualFaces = sortedFaces(actual);
+        const double tolerance = 1e-8;
+        for (int f = 0; f < expected.GetNumFaces(); ++f)
+        {
+            for (int i = 0; i < expectedFaces[f].size(); ++i)
+            {
+                ASSERT_NEAR(expectedFaces[f][i], actualFaces[f][i], tolerance);
+            }
+        }
+        ASSERT_EQ(sortedNodes(expected), sortedNodes(actual));
+        AssertCompressedConnectivityMatchesMesh(actual);
+
+        // the nodes and edges are numbered as by a full administration
+        for (int n = 0; n < expected.GetNumNodes(); ++n)
+        {
+            ASSERT_EQ(expected.m_nodes[n].x, actual.m_nodes[n].x);
+            ASSERT_EQ(expected.m_nodes[n].y, actual.m_nodes[n].y);
+            ASSERT_EQ(expected.m_nodesEdges[n], actual.m_nodesEdges[n]);
+        }
+        for (int e = 0; e < expected.GetNumEdges(); ++e)
+        {
+            ASSERT_EQ(expected.m_edges[e], actual.m_edges[e]);
+        }
+    }
+} // namespace
+
+TEST(Mesh, AdministrateModifiedRegionAfterInsertingAndConnectingNodes)
+{
+    // Setup
+    auto expected = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    auto actual = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+
+    // Execute: split a face in four triangles
+    for (auto& mesh : {expected, actual})
+    {
+        int newNode;
+        mesh->InsertNode({5.5, 5.5}, newNode);
+        int newEdge;
+        for (const auto& n : {5 * 20 + 5, 5 * 20 + 6, 6 * 20 + 5, 6 * 20 + 6})
+        {
+            mesh->ConnectNodes(newNode, n, newEdge);
+        }
+    }
+    expected->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    actual->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert
+    ASSERT_EQ(364, actual->GetNumFaces());
+    AssertMeshAdministrationEqual(*expected, *actual);
+}
+
+TEST(Mesh, AdministrateModifiedRegionAfterDeletingEdgesAndNodes)
+{
+    // Setup
+    auto expected = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    auto actual = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+
+    // Execute: delete an inner edge, an inner node and a corner node
+    for (auto& mesh : {expected, actual})
+    {
+        mesh->DeleteEdge(100);
+        mesh->DeleteNode(210);
+        mesh->DeleteNode(0);
+    }
+    expected->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    actual->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert
+    AssertMeshAdministrationEqual(*expected, *actual);
+}
+
+TEST(Mesh, AdministrateModifiedRegionAfterMergingAndMovingNodes)
+{
+    // Setup
+    auto expected = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    auto actual = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+
+    // Execute
+    for (auto& mesh : {expected, actual})
+    {
+        mesh->MergeTwoNodes(42, 43);
+        mesh->MoveNode({10.3, 10.2}, 210);
+    }
+    expected->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    actual->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert
+    AssertMeshAdministrationEqual(*expected, *actual);
+}
+
+TEST(Mesh, AdministrateModifiedRegionUpdatesCompressedConnectivityAfterRepeatedEdits)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+
+    // Execute: split faces in triangles and delete nodes, administrating the modified region after each edit
+    for (int i = 1; i < 18; ++i)
+    {
+        const auto corner = i * 20 + i;
+        int newNode;
+        mesh->InsertNode({i + 0.5, i + 0.5}, newNode);
+        int newEdge;
+        for (const auto& n : {corner, corner + 1, corner + 20, corner + 21})
+        {
+            mesh->ConnectNodes(newNode, n, newEdge);
+        }
+        mesh->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+        AssertCompressedConnectivityMatchesMesh(*mesh);
+
+        mesh->DeleteNode((19 - i) * 20 + 2);
+        mesh->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+        AssertCompressedConnectivityMatchesMesh(*mesh);
+    }
+}
+
+TEST(Mesh, FindFacesNumbersFacesByNumberOfEdgesThenByStartingNode)
+{
+    // Setup: a 3 x 3 mesh with the last quad split in two triangles
+    auto mesh = MakeRectangularMeshForTesting(3, 3, 1.0, meshkernel::Projections::cartesian);
+    int newEdge;
+    mesh->ConnectNodes(4, 8, newEdge);
+
+    // Execute
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert: the triangles come first, then the quads
+    ASSERT_EQ(5, mesh->GetNumFaces());
+    ASSERT_EQ(3, mesh->GetNumFaceEdges(0));
+    ASSERT_EQ(3, mesh->GetNumFaceEdges(1));
+    for (int f = 2; f < mesh->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(4, mesh->GetNumFaceEdges(f));
+    }
+
+    // each face starts from its lowest node
+    for (int f = 0; f < mesh->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(*std::min_element(mesh->m_facesNodes[f].begin(), mesh->m_facesNodes[f].end()), mesh->m_facesNodes[f][0]);
+        if (f > 2)
+        {
+            ASSERT_LT(mesh->m_facesNodes[f - 1][0], mesh->m_facesNodes[f][0]);
+        }
+    }
+}
+
+TEST(Mesh, AdministrateBuildsCompressedConnectivity)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(4, 5, 1.0, meshkernel::Projections::cartesian);
+    int newEdge;
+    mesh->ConnectNodes(0, 6, newEdge);
+
+    // Execute
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    mesh->ComputeNodeNeighbours();
+
+    // Assert
+    ASSERT_EQ(mesh->GetNumNodes(), mesh->m_nodesEdgesCsr.GetNumRows());
+    ASSERT_EQ(mesh->GetNumNodes(), mesh->m_nodesNodesCsr.GetNumRows());
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        ASSERT_EQ(mesh->m_nodesNumEdges[n], mesh->m_nodesEdgesCsr.GetRowSize(n));
+        ASSERT_EQ(mesh->m_nodesNumEdges[n], mesh->m_nodesNodesCsr.GetRowSize(n));
+        for (int e = 0; e < mesh->m_nodesNumEdges[n]; ++e)
+        {
+            ASSERT_EQ(mesh->m_nodesEdges[n][e], mesh->m_nodesEdgesCsr(n, e));
+            ASSERT_EQ(mesh->m_nodesNodes[n][e], mesh->m_nodesNodesCsr(n, e));
+        }
+    }
+
+    ASSERT_EQ(mesh->GetNumFaces(), mesh->m_facesNodesCsr.GetNumRows());
+    ASSERT_EQ(mesh->GetNumFaces(), mesh->m_facesEdgesCsr.GetNumRows());
+    for (int f = 0; f < mesh->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(mesh->GetNumFaceEdges(f), mesh->m_facesNodesCsr.GetRowSize(f));
+        for (int n = 0; n < mesh->GetNumFaceEdges(f); ++n)
+        {
+            ASSERT_EQ(mesh->m_facesNodes[f][n], mesh->m_facesNodesCsr(f, n));
+            ASSERT_EQ(mesh->m_facesEdges[f][n], mesh->m_facesEdgesCsr(f, n));
+            ASSERT_EQ(n, mesh->m_facesNodesCsr.FindIndex(f, mesh->m_facesNodes[f][n]));
+        }
+    }
+}
+
+TEST(Mesh, CompressedConnectivityFollowsTheRowsEditedInPlace)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(4, 5, 1.0, meshkernel::Projections::cartesian);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_TRUE(mesh->IsCompressedConnectivityConsistent());
+
+    // Execute, edit a face and a node in place as FlipEdges and MeshRefinement do
+    const int face = 2;
+    std::reverse(mesh->m_facesNodes[face].begin(), mesh->m_facesNodes[face].begin() + mesh->GetNumFaceEdges(face));
+    std::reverse(mesh->m_facesEdges[face].begin(), mesh->m_facesEdges[face].begin() + mesh->GetNumFaceEdges(face));
+    ASSERT_FALSE(mesh->IsCompressedConnectivityConsistent());
+    mesh->CopyFaceToCompressedRows(face);
+
+    const int node = 6;
+    mesh->m_nodesNumEdges[node]--;
+    ASSERT_FALSE(mesh->IsCompressedConnectivityConsistent());
+    mesh->CopyNodeEdgesToCompressedRow(node);
+
+    // Assert
+    ASSERT_TRUE(mesh->IsCompressedConnectivityConsistent());
+    ASSERT_EQ(mesh->m_nodesNumEdges[node], mesh->m_nodesEdgesCsr.GetRowSize(node));
+    ASSERT_EQ(mesh->m_facesNodes[face][0], mesh->m_facesNodesCsr(face, 0));
+}
+
+TEST(Mesh, SetFlatCopiesIsRefreshedOnlyWhenTheMeshChanges)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(3, 3, 1.0, meshkernel::Projections::cartesian);
+    mesh->SetFlatCopies(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_EQ(4, mesh->GetNumFaces());
+    ASSERT_DOUBLE_EQ(mesh->m_nodes[4].x, mesh->m_nodex[4]);
+
+    // Execute: the copies are not refreshed if nothing changed, so a modification of the flat copies is kept
+    mesh->m_nodex[4] = 10.0;
+    mesh->SetFlatCopies(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdges);
+    ASSERT_DOUBLE_EQ(10.0, mesh->m_nodex[4]);
+    ASSERT_EQ(4, mesh->GetNumFaces());
+
+    // Execute: moving a node refreshes the copies
+    mesh->MoveNode({1.2, 1.0}, 4);
+    mesh->SetFlatCopies(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert
+    ASSERT_DOUBLE_EQ(mesh->m_nodes[4].x, mesh->m_nodex[4]);
+    ASSERT_NEAR(1.2, mesh->m_nodex[4], 1e-12);
+    ASSERT_EQ(4, mesh->GetNumFaces());
+}
+
+TEST(Mesh, SetFlatCopiesKeepsTheNumberingOfAFullAdministration)
+{
+    // Setup
+    auto expected = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    auto actual = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    actual->SetFlatCopies(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Execute: the edits made through the api are followed by a refresh of the flat copies
+    for (auto& mesh : {expected, actual})
+    {
+        mesh->DeleteNode(210);
+        int newNode;
+        mesh->InsertNode({5.5, 5.5}, newNode);
+        int newEdge;
+        mesh->ConnectNodes(newNode, 5 * 20 + 5, newEdge);
+        mesh->ConnectNodes(newNode, 6 * 20 + 6, newEdge);
+    }
+    expected->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    actual->SetFlatCopies(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+
+    // Assert: the front-end sees the numbering of a full administration
+    AssertMeshAdministrationEqual(*expected, *actual);
+    ASSERT_EQ(actual->GetNumNodes(), actual->m_nodex.size());
+    ASSERT_EQ(actual->GetNumEdges() * 2, actual->m_edgeNodes.size());
+    for (int n = 0; n < actual->GetNumNodes(); ++n)
+    {
+        ASSERT_DOUBLE_EQ(actual->m_nodes[n].x, actual->m_nodex[n]);
+        ASSERT_DOUBLE_EQ(actual->m_nodes[n].y, actual->m_nodey[n]);
+    }
+    for (int f = 0; f < expected->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(expected->m_facesNodes[f], actual->m_facesNodes[f]);
+    }
+}
+
+TEST(Mesh, SnapshotRestoresTheAdministratedMesh)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(20, 20, 1.0, meshkernel::Projections::cartesian);
+    mesh->DeleteNode(210);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    const std::string filePath = "MeshTest_snapshot.bin";
+
+    // Execute
+    mesh->SaveSnapshot(filePath);
+    meshkernel::Mesh loadedMesh;
+    loadedMesh.LoadSnapshot(filePath);
+    std::remove(filePath.c_str());
+
+    // Assert: the same numbering and the same administration
+    AssertMeshAdministrationEqual(*mesh, loadedMesh);
+    ASSERT_EQ(mesh->m_projection, loadedMesh.m_projection);
+    for (int e = 0; e < mesh->GetNumEdges(); ++e)
+    {
+        ASSERT_EQ(mesh->m_edges[e], loadedMesh.m_edges[e]);
+        ASSERT_EQ(mesh->m_edgesFaces[e], loadedMesh.m_edgesFaces[e]);
+    }
+    for (int f = 0; f < mesh->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(mesh->m_facesNodes[f], loadedMesh.m_facesNodes[f]);
+        ASSERT_EQ(mesh->m_facesEdges[f], loadedMesh.m_facesEdges[f]);
+    }
+
+    // Execute: the loaded administration can be updated incrementally
+    for (auto* currentMesh : {mesh.get(), &loadedMesh})
+    {
+        currentMesh->DeleteNode(100);
+        currentMesh->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    }
+
+    // Assert
+    AssertMeshAdministrationEqual(*mesh, loadedMesh);
+}
+
+TEST(Mesh, SnapshotRequiresAnAdministratedMesh)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(3, 3, 1.0, meshkernel::Projections::cartesian);
+    mesh->DeleteNode(4);
+
+    // Execute and assert: the deletion is not administrated yet
+    ASSERT_THROW(mesh->SaveSnapshot("MeshTest_snapshot_not_administrated.bin"), std::invalid_argument);
+}
+
+TEST(Mesh, LoadSnapshotRejectsInvalidFiles)
+{
+    // Setup
+    auto mesh = MakeRectangularMeshForTesting(5, 5, 1.0, meshkernel::Projections::cartesian);
+    const std::string filePath = "MeshTest_snapshot_truncated.bin";
+    mesh->SaveSnapshot(filePath);
+
+    std::string content;
+    {
+        std::ifstream stream(filePath, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), content.size() / 2);
+    }
+
+    // Execute and assert
+    meshkernel::Mesh loadedMesh;
+    ASSERT_THROW(loadedMesh.LoadSnapshot(filePath), std::invalid_argument);
+    std::remove(filePath.c_str());
+    ASSERT_THROW(loadedMesh.LoadSnapshot(filePath), std::invalid_argument);
+}
+
+TEST(Mesh, NodesAndEdgesRTreesAreUpdatedByTheEditingMethods)
+{
+    // Setup: both trees built
+    auto mesh = MakeRectangularMeshForTesting(10, 10, 1.0, meshkernel::Projections::cartesian);
+    ASSERT_EQ(0, mesh->GetNodeIndex({0.0, 0.0}, 0.1));
+    const auto firstEdgeIndex = mesh->FindEdgeCloseToAPoint({0.0, 0.5});
+    ASSERT_EQ(0.0, mesh->m_nodes[mesh->m_edges[firstEdgeIndex].first].x);
+    ASSERT_EQ(0.0, mesh->m_nodes[mesh->m_edges[firstEdgeIndex].second].x);
+    ASSERT_EQ(1.0, mesh->m_nodes[mesh->m_edges[firstEdgeIndex].first].y + mesh->m_nodes[mesh->m_edges[firstEdgeIndex].second].y);
+
+    // Execute: the edits are visible to the searches without administration
+    int newNodeIndex;
+    mesh->InsertNode({20.0, 20.0}, newNodeIndex);
+    int newEdgeIndex;
+    mesh->ConnectNodes(99, newNodeIndex, newEdgeIndex);
+    ASSERT_EQ(newNodeIndex, mesh->GetNodeIndex({20.0, 20.0}, 0.1));
+    ASSERT_EQ(newEdgeIndex, mesh->FindEdgeCloseToAPoint({14.5, 14.5}));
+
+    mesh->MoveNode({30.0, 30.0}, newNodeIndex);
+    ASSERT_EQ(newNodeIndex, mesh->GetNodeIndex({30.0, 30.0}, 0.1));
+    ASSERT_THROW(static_cast<void>(mesh->GetNodeIndex({20.0, 20.0}, 0.1)), meshkernel::AlgorithmError);
+
+    mesh->DeleteEdge(newEdgeIndex);
+    ASSERT_NE(newEdgeIndex, mesh->FindEdgeCloseToAPoint({14.5, 14.5}));
+
+    // Execute: the incremental administration keeps the trees consistent with the new numbering
+    mesh->DeleteNode(0);
+    mesh->AdministrateModifiedRegion(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdges);
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        ASSERT_EQ(n, mesh->GetNodeIndex(mesh->m_nodes[n], 1e-6));
+    }
+    mesh->ComputeEdgesCenters();
+    for (int e = 0; e < mesh->GetNumEdges(); ++e)
+    {
+        ASSERT_EQ(e, mesh->FindEdgeCloseToAPoint(mesh->m_edgesCenters[e]));
+    }
+}
+
+namespace
+{
+    std::vector<std::pair<int, int>> SortedEdges(const meshkernel::TriangulationWrapper& triangulation)
+    {
+        std::vector<std::pair<int, int>> edges(triangulation.m_numEdges);
+        for (int e = 0; e < triangulation.m_numEdges; ++e)
+        {
+            const auto firstNode = triangulation.GetEdgeNode(e, 0);
+            const auto secondNode = triangulation.GetEdgeNode(e, 1);
+            edges[e] = {std::min(firstNode, secondNode), std::max(firstNode, secondNode)};
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+} // namespace
+
+TEST(Mesh, TriangulationInSlabsEqualsTriangulationAtOnce)
+{
+    // Setup: random points, the Delaunay triangulation is unique
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::vector<meshkernel::Point> nodes(20000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+
+    meshkernel::TriangulationWrapper triangulation;
+    triangulation.Compute(nodes, static_cast<int>(nodes.size()), meshkernel::TriangulationWrapper::TriangulationOptions::TriangulatePointsAndGenerateFaces, 0.0);
+
+    meshkernel::TriangulationWrapper slabsTriangulation;
+    slabsTriangulation.ComputeInSlabs(nodes, static_cast<int>(nodes.size()), 4);
+
+    // Assert: same edges, every face refers to edges joining its nodes
+    ASSERT_EQ(slabsTriangulation.m_numFaces, triangulation.m_numFaces);
+    ASSERT_EQ(SortedEdges(slabsTriangulation), SortedEdges(triangulation));
+    for (int f = 0; f < slabsTriangulation.m_numFaces; ++f)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            const auto edge = slabsTriangulation.GetFaceEdge(f, n);
+            const auto firstNode = slabsTriangulation.GetEdgeNode(edge, 0);
+            const auto secondNode = slabsTriangulation.GetEdgeNode(edge, 1);
+            ASSERT_TRUE(firstNode == slabsTriangulation.GetFaceNode(f, 0) || firstNode == slabsTriangulation.GetFaceNode(f, 1) || firstNode == slabsTriangulation.GetFaceNode(f, 2));
+            ASSERT_TRUE(secondNode == slabsTriangulation.GetFaceNode(f, 0) || secondNode == slabsTriangulation.GetFaceNode(f, 1) || secondNode == slabsTriangulation.GetFaceNode(f, 2));
+            ASSERT_TRUE(slabsTriangulation.GetEdgeFace(edge, 0) == f || slabsTriangulation.GetEdgeFace(edge, 1) == f);
+        }
+    }
+}
+
+TEST(Mesh, TriangulationInSlabsOfCocircularPoints)
+{
+    // Setup: the points of a regular grid, the diagonals of the Delaunay triangulation are not unique
+    std::vector<meshkernel::Point> nodes;
+    for (int i = 0; i < 120; ++i)
+    {
+        for (int j = 0; j < 100; ++j)
+        {
+            nodes.push_back({i * 10.0, j * 10.0});
+        }
+    }
+
+    meshkernel::TriangulationWrapper slabsTriangulation;
+    slabsTriangulation.ComputeInSlabs(nodes, static_cast<int>(nodes.size()), 3);
+
+    // Assert: a triangulation of all points, each grid cell is split in two triangles
+    ASSERT_EQ(slabsTriangulation.m_numFaces, 2 * 119 * 99);
+    ASSERT_EQ(slabsTriangulation.m_numEdges, 120 * 99 + 119 * 100 + 119 * 99);
+
+    // the mesh from the points has the grid edges and one diagonal per cell
+    meshkernel::Polygons polygons;
+    meshkernel::Mesh mesh(nodes, polygons, meshkernel::Projections::cartesian, true);
+    ASSERT_EQ(mesh.GetNumEdges(), 120 * 99 + 119 * 100 + 119 * 99);
+}
+
+TEST(Mesh, TriangulateSamplesInParallelInsideAPolygonGivesTheSerialEdges)
+{
+    // Setup: random samples and a concave polygon, so both the angle and the polygon checks reject triangles
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::vector<meshkernel::Point> nodes(20000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+    std::vector<meshkernel::Point> polygonNodes{{100.0, 100.0}, {900.0, 100.0}, {900.0, 900.0}, {500.0, 400.0}, {100.0, 900.0}, {100.0, 100.0}};
+    meshkernel::Polygons polygons(polygonNodes, meshkernel::Projections::cartesian);
+
+    // Execute
+    meshkernel::Mesh mesh(nodes, polygons, meshkernel::Projections::cartesian);
+    meshkernel::Mesh parallelMesh(nodes, polygons, meshkernel::Projections::cartesian, true);
+
+    // Assert: the same nodes and the same edges, compared by coordinates because the edges are numbered differently
+    ASSERT_GT(mesh.GetNumEdges(), 0);
+    ASSERT_EQ(mesh.GetNumNodes(), parallelMesh.GetNumNodes());
+    ASSERT_EQ(mesh.GetNumEdges(), parallelMesh.GetNumEdges());
+    auto sortedEdges = [](const meshkernel::Mesh& m) {
+        std::vector<std::pair<meshkernel::Point, meshkernel::Point>> edges(m.GetNumEdges());
+        for (int e = 0; e < m.GetNumEdges(); ++e)
+        {
+            auto first = m.m_nodes[m.m_edges[e].first];
+            auto second = m.m_nodes[m.m_edges[e].second];
+            if (second.x < first.x || (second.x == first.x && second.y < first.y))
+            {
+                std::swap(first, second);
+            }
+            edges[e] = {first, second};
+        }
+        using NodesPair = std::pair<meshkernel::Point, meshkernel::Point>;
+        std::sort(edges.begin(), edges.end(), [](const NodesPair& a, const NodesPair& b) {
+            return std::tie(a.first.x, a.first.y, a.second.x, a.second.y) < std::tie(b.first.x, b.first.y, b.second.x, b.second.y);
+        });
+        return edges;
+    };
+    ASSERT_EQ(sortedEdges(parallelMesh), sortedEdges(mesh));
+}
+
+TEST(Mesh, TriangulateSamplesKeepsTheSerialEdgeNumberingByDefault)
+{
+    // Setup
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::vector<meshkernel::Point> nodes(5000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+
+    meshkernel::TriangulationWrapper triangulation;
+    triangulation.Compute(nodes, static_cast<int>(nodes.size()), meshkernel::TriangulationWrapper::TriangulationOptions::TriangulatePointsAndGenerateFaces, 0.0);
+
+    // Execute
+    meshkernel::Polygons polygons;
+    meshkernel::Mesh mesh(nodes, polygons, meshkernel::Projections::cartesian);
+    meshkernel::Mesh parallelMesh(nodes, polygons, meshkernel::Projections::cartesian, true);
+
+    // Assert: by default the mesh edges follow the order of the serial triangulation edges,
+    // compared by coordinates because the nodes left unconnected by the rejected triangles are removed
+    int triangulationEdge = 0;
+    for (int e = 0; e < mesh.GetNumEdges(); ++e)
+    {
+        const auto& firstNode = mesh.m_nodes[mesh.m_edges[e].first];
+        const auto& secondNode = mesh.m_nodes[mesh.m_edges[e].second];
+        while (triangulationEdge < triangulation.m_numEdges &&
+               (nodes[triangulation.GetEdgeNode(triangulationEdge, 0)] != firstNode ||
+                nodes[triangulation.GetEdgeNode(triangulationEdge, 1)] != secondNode))
+        {
+            ++triangulationEdge;
+        }
+        ASSERT_LT(triangulationEdge, triangulation.m_numEdges);
+        ++triangulationEdge;
+    }
+
+    // the parallel triangulation numbers the edges differently, but has the same edges
+    auto sortedEdges = [](const meshkernel::Mesh& m) {
+        std::vector<std::pair<int, int>> edges(m.GetNumEdges());
+        for (int e = 0; e < m.GetNumEdges(); ++e)
+        {
+            edges[e] = {std::min(m.m_edges[e].first, m.m_edges[e].second), std::max(m.m_edges[e].first, m.m_edges[e].second)};
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    };
+    ASSERT_EQ(sortedEdges(parallelMesh), sortedEdges(mesh));
+}
+
+TEST(Mesh, BatchedTriangleCircumcentersAreTheOnesOfComputeFaceCircumenter)
+{
+    // Setup
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::vector<meshkernel::Point> nodes(2000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+    meshkernel::Mesh mesh(nodes, meshkernel::Polygons(), meshkernel::Projections::cartesian);
+    mesh.Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_GT(mesh.GetNumFaces(), 0);
+
+    for (const auto computeMassCenters : {false, true})
+    {
+        // Execute
+        mesh.ComputeFaceCircumcentersMassCentersAndAreas(computeMassCenters);
+
+        // Assert: the triangles with interior edges are computed by the batched kernel, with the results of the scalar path
+        std::vector<meshkernel::Point> polygon;
+        std::vector<meshkernel::Point> middlePoints(meshkernel::maximumNumberOfNodesPerFace);
+        std::vector<meshkernel::Point> normals(meshkernel::maximumNumberOfNodesPerFace);
+        std::vector<int> edgesNumFaces(meshkernel::maximumNumberOfEdgesPerFace);
+        for (int f = 0; f < mesh.GetNumFaces(); ++f)
+        {
+            if (mesh.GetNumFaceEdges(f) != 3)
+            {
+                continue;
+            }
+            int numInteriorEdges = 0;
+            for (int n = 0; n < 3; ++n)
+            {
+                edgesNumFaces[n] = mesh.m_edgesNumFaces[mesh.m_facesEdges[f][n]];
+                numInteriorEdges += mesh.IsEdgeOnBoundary(mesh.m_facesEdges[f][n]) ? 0 : 1;
+            }
+            if (numInteriorEdges == 0)
+            {
+                continue;
+            }
+
+            int numPolygonPoints;
+            mesh.FaceClosedPolygon(f, polygon, numPolygonPoints);
+            const auto circumcenter = mesh.ComputeFaceCircumenter(polygon, middlePoints, normals, 3, edgesNumFaces, meshkernel::weightCircumCenter);
+            ASSERT_EQ(circumcenter.x, mesh.m_facesCircumcenters[f].x);
+            ASSERT_EQ(circumcenter.y, mesh.m_facesCircumcenters[f].y);
+        }
+    }
+}
@@ -10,6 +10,10 @@
 #include <gtest/gtest.h>
 #include <chrono>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if defined(_WIN32)
 #include <Windows.h>
 #endif
@@ -590,3 +594,290 @@ TEST(OrthogonalizationAndSmoothing, OrthogonalizationMeshWithEdgeWithNoFaces)
     orthogonalization.Initialize();
     orthogonalization.Compute();
 }
+
+namespace
+{
+    // The parameters of the orthogonalization of the rectangular meshes with displaced internal nodes
+    meshkernelapi::OrthogonalizationParametersNative MakeDisplacedMeshOrthogonalizationParameters()
+    {
+        meshkernelapi::OrthogonalizationParametersNative orthogonalizationParametersNative;
+        orthogonalizationParametersNative.OuterIterations = 2;
+        orthogonalizationParametersNative.BoundaryIterations = 25;
+        orthogonalizationParametersNative.InnerIterations = 25;
+        orthogonalizationParametersNative.OrthogonalizationToSmoothingFactor = 0.975;
+        orthogonalizationParametersNative.OrthogonalizationToSmoothingFactorBoundary = 1.0;
+        orthogonalizationParametersNative.Smoothorarea = 1.0;
+        return orthogonalizationParametersNative;
+    }
+
+    // Orthogonalizes a mesh without polygon and land boundaries, the inner iterations stop at the convergence tolerance
+    std::shared_ptr<meshkernel::OrthogonalizationAndSmoothing> Orthogonalize(std::shared_ptr<meshkernel::Mesh> mesh,
+                                                                             const meshkernelapi::OrthogonalizationParametersNative& orthogonalizationParametersNative,
+                                                                             double convergenceTolerance,
+                                                                             meshkernel::OrthogonalizationAndSmoothing::LinearSolver linearSolver = meshkernel::OrthogonalizationAndSmoothing::LinearSolver::Jacobi)
+    {
+        auto orthogonalizer = std::make_shared<meshkernel::Orthogonalizer>(mesh);
+        auto smoother = std::make_shared<meshkernel::Smoother>(mesh);
+        auto polygon = std::make_shared<meshkernel::Polygons>();
+        std::vector<meshkernel::Point> landBoundary;
+        auto landBoundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+        auto orthogonalization = std::make_shared<meshkernel::OrthogonalizationAndSmoothing>(mesh,
+                                                                                             smoother,
+                                                                                             orthogonalizer,
+                                                                                             polygon,
+                                                                                             landBoundaries,
+                                                                                             0,
+                                                                                             orthogonalizationParametersNative);
+        orthogonalization->SetConvergenceTolerance(convergenceTolerance);
+        orthogonalization->SetLinearSolver(linearSolver);
+        orthogonalization->Initialize();
+        orthogonalization->Compute();
+        return orthogonalization;
+    }
+} // namespace
+
+TEST(OrthogonalizationAndSmoothing, OrthogonalizationStopsWhenNodeDisplacementsAreBelowTolerance)
+{
+    // 1 Setup: a rectangular mesh with two displaced internal nodes
+    const auto orthogonalizationParametersNative = MakeDisplacedMeshOrthogonalizationParameters();
+    auto mesh = MakeRectangularMeshForTesting(10, 10, 1.0, meshkernel::Projections::cartesian);
+    mesh->m_nodes[44].x += 0.3;
+    mesh->m_nodes[55].y -= 0.2;
+    auto referenceMesh = std::make_shared<meshkernel::Mesh>(*mesh);
+
+    // 2 Execute
+    constexpr double convergenceTolerance = 1e-6;
+    const auto orthogonalization = Orthogonalize(mesh, orthogonalizationParametersNative, convergenceTolerance);
+    const auto referenceOrthogonalization = Orthogonalize(referenceMesh, orthogonalizationParametersNative, 0.0);
+
+    // 3 Validation: fewer iterations than the fixed budget, the nodes are close to the ones obtained with the full budget
+    ASSERT_TRUE(orthogonalization->IsConverged());
+    ASSERT_FALSE(referenceOrthogonalization->IsConverged());
+    ASSERT_EQ(referenceOrthogonalization->GetNumInnerIterations(), 2 * 25 * 25);
+    ASSERT_LT(orthogonalization->GetNumInnerIterations(), referenceOrthogonalization->GetNumInnerIterations());
+    ASSERT_LE(orthogonalization->GetMaximumDisplacement(), convergenceTolerance);
+    ASSERT_LE(orthogonalization->GetRootMeanSquareDisplacement(), orthogonalization->GetMaximumDisplacement());
+
+    constexpr double tolerance = 1e-4;
+    for (int n = 0; n < mesh->GetNumNodes(); n++)
+    {
+        ASSERT_NEAR(mesh->m_nodes[n].x, referenceMesh->m_nodes[n].x, tolerance);
+        ASSERT_NEAR(mesh->m_nodes[n].y, referenceMesh->m_nodes[n].y, tolerance);
+    }
+}
+
+TEST(OrthogonalizationAndSmoothing, OrthogonalizationWithBiCGStabReachesTheJacobiSolution)
+{
+    // 1 Setup: a rectangular mesh with displaced internal nodes
+    const auto orthogonalizationParametersNative = MakeDisplacedMeshOrthogonalizationParameters();
+    auto mesh = MakeRectangularMeshForTesting(10, 10, 1.0, meshkernel::Projections::cartesian);
+    mesh->m_nodes[44].x += 0.3;
+    mesh->m_nodes[55].y -= 0.2;
+    mesh->m_nodes[63].x -= 0.25;
+    auto jacobiMesh = std::make_shared<meshkernel::Mesh>(*mesh);
+
+    // 2 Execute
+    constexpr double convergenceTolerance = 1e-9;
+    const auto orthogonalization = Orthogonalize(mesh, orthogonalizationParametersNative, convergenceTolerance, meshkernel::OrthogonalizationAndSmoothing::LinearSolver::BiCGStab);
+    const auto jacobiOrthogonalization = Orthogonalize(jacobiMesh, orthogonalizationParametersNative, convergenceTolerance, meshkernel::OrthogonalizationAndSmoothing::LinearSolver::Jacobi);
+
+    // 3 Validation: both methods reach the same nodes, BiCGStab with fewer inner iterations
+    ASSERT_TRUE(orthogonalization->IsConverged());
+    ASSERT_TRUE(jacobiOrthogonalization->IsConverged());
+    ASSERT_LT(orthogonalization->GetNumInnerIterations(), jacobiOrthogonalization->GetNumInnerIterations());
+
+    constexpr double tolerance = 1e-6;
+    for (int n = 0; n < mesh->GetNumNodes(); n++)
+    {
+        ASSERT_NEAR(mesh->m_nodes[n].x, jacobiMesh->m_nodes[n].x, tolerance);
+        ASSERT_NEAR(mesh->m_nodes[n].y, jacobiMesh->m_nodes[n].y, tolerance);
+    }
+}
+
+TEST(OrthogonalizationAndSmoothing, SmootherWeightsOfEqualStencilsAreEqualInTheWholeMesh)
+{
+    // more nodes than fit in one block of the smoother topologies computation
+    const int numRows = 50;
+    auto mesh = MakeRectangularMeshForTesting(numRows, numRows, 1.0, meshkernel::Projections::cartesian);
+
+    meshkernel::Smoother smoother(mesh);
+    smoother.Compute();
+
+    // the nodes at least two rows away from the boundary have the same stencil
+    const int referenceNode = 2 * numRows + 2;
+    for (int i = 2; i < numRows - 2; ++i)
+    {
+        for (int j = 2; j < numRows - 2; ++j)
+        {
+            const int node = i * numRows + j;
+            ASSERT_EQ(smoother.GetNumConnectedNodes(referenceNode), smoother.GetNumConnectedNodes(node));
+            for (int n = 0; n < smoother.GetNumConnectedNodes(node); ++n)
+            {
+                ASSERT_NEAR(smoother.GetWeight(referenceNode, n), smoother.GetWeight(node, n), 1e-12);
+            }
+        }
+    }
+}
+
+TEST(OrthogonalizationAndSmoothing, SmootherOperatorsAndWeightsInParallelAreTheSerialOnes)
+{
+    // a mixed mesh, with a diagonal in every third quad to get triangles and many distinct topologies
+    const int numRows = 40;
+    auto mesh = MakeRectangularMeshForTesting(numRows, numRows, 1.0, meshkernel::Projections::cartesian);
+    for (int i = 0; i < numRows - 1; ++i)
+    {
+        for (int j = 0; j < numRows - 1; ++j)
+        {
+            if ((i * numRows + j) % 3 == 0)
+            {
+                int newEdgeIndex;
+                mesh->ConnectNodes(i * numRows + j, (i + 1) * numRows + j + 1, newEdgeIndex);
+            }
+        }
+    }
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_GT(mesh->GetNumFaces(), (numRows - 1) * (numRows - 1));
+
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    meshkernel::Smoother serialSmoother(mesh);
+    serialSmoother.Compute();
+
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    meshkernel::Smoother parallelSmoother(mesh);
+    parallelSmoother.Compute();
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+
+    ASSERT_EQ(serialSmoother.GetTopologyOperators().size(), parallelSmoother.GetTopologyOperators().size());
+    for (size_t i = 0; i < serialSmoother.GetTopologyOperators().size(); ++i)
+    {
+        ASSERT_EQ(serialSmoother.GetTopologyOperators()[i], parallelSmoother.GetTopologyOperators()[i]);
+    }
+
+    for (int node = 0; node < mesh->GetNumNodes(); ++node)
+    {
+        ASSERT_EQ(serialSmoother.GetNodeTopology(node), parallelSmoother.GetNodeTopology(node));
+        ASSERT_EQ(serialSmoother.GetNumConnectedNodes(node), parallelSmoother.GetNumConnectedNodes(node));
+        for (int n = 0; n < serialSmoother.GetNumConnectedNodes(node); ++n)
+        {
+            ASSERT_EQ(serialSmoother.GetCoonectedNodeIndex(node, n), parallelSmoother.GetCoonectedNodeIndex(node, n));
+            ASSERT_EQ(serialSmoother.GetWeight(node, n), parallelSmoother.GetWeight(node, n));
+        }
+    }
+}
+
+TEST(OrthogonalizationAndSmoothing, SmoothingWithAdaptationSamplesClustersTheMeshAtTheSteepFeature)
+{
+    // a mesh of 20 columns, with a steep step of the sample values in the middle column
+    const int numRows = 21;
+    auto mesh = MakeRectangularMeshForTesting(numRows, numRows, 1.0, meshkernel::Projections::cartesian);
+
+    std::vector<meshkernel::Sample> samples;
+    for (int i = 0; i <= 80; ++i)
+    {
+        for (int j = 0; j <= 80; ++j)
+        {
+            const double x = i * 0.25;
+            samples.push_back({x, j * 0.25, std::tanh((x - 10.0) / 0.5)});
+        }
+    }
+
+    meshkernelapi::OrthogonalizationParametersNative orthogonalizationParametersNative;
+    orthogonalizationParametersNative.OuterIterations = 2;
+    orthogonalizationParametersNative.BoundaryIterations = 25;
+    orthogonalizationParametersNative.InnerIterations = 25;
+    orthogonalizationParametersNative.OrthogonalizationToSmoothingFactor = 0.0;
+    orthogonalizationParametersNative.OrthogonalizationToSmoothingFactorBoundary = 1.0;
+    orthogonalizationParametersNative.Smoothorarea = 1.0;
+
+    auto orthogonalizer = std::make_shared<meshkernel::Orthogonalizer>(mesh);
+    auto smoother = std::make_shared<meshkernel::Smoother>(mesh);
+    smoother->SetAdaptationSamples(samples, 10.0);
+    auto polygon = std::make_shared<meshkernel::Polygons>();
+    std::vector<meshkernel::Point> landBoundary;
+    auto landboundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+
+    meshkernel::OrthogonalizationAndSmoothing orthogonalization(mesh,
+                                                                smoother,
+                                                                orthogonalizer,
+                                                                polygon,
+                                                                landboundaries,
+                                                                0,
+                                                                orthogonalizationParametersNative);
+    orthogonalization.Initialize();
+    orthogonalization.Compute();
+
+    // the columns next to the step are narrower than the columns far from it
+    const int row = numRows / 2;
+    const auto columnWidth = [&](int i) { return mesh->m_nodes[(i + 1) * numRows + row].x - mesh->m_nodes[i * numRows + row].x; };
+    ASSERT_LT(columnWidth(9), 0.5);
+    ASSERT_LT(columnWidth(10), 0.5);
+    ASSERT_GT(columnWidth(0), 1.0);
+    ASSERT_GT(columnWidth(19), 1.0);
+    ASSERT_NEAR(columnWidth(9), columnWidth(10), 1e-3);
+}
+
+TEST(OrthogonalizationAndSmoothing, AdaptationSamplesWithTheStrengthOfTheParameters)
+{
+    // Setup: the samples of a steep step in the middle of the mesh
+    std::vector<meshkernel::Sample> samples;
+    for (int i = 0; i <= 40; ++i)
+    {
+        for (int j = 0; j <= 40; ++j)
+        {
+            const double x = i * 0.25;
+            samples.push_back({x, j * 0.25, std::tanh((x - 5.0) / 0.5)});
+        }
+    }
+
+    meshkernelapi::OrthogonalizationParametersNative orthogonalizationParametersNative{};
+    orthogonalizationParametersNative.OuterIterations = 2;
+    orthogonalizationParametersNative.BoundaryIterations = 10;
+    orthogonalizationParametersNative.InnerIterations = 10;
+    orthogonalizationParametersNative.OrthogonalizationToSmoothingFactor = 0.0;
+    orthogonalizationParametersNative.OrthogonalizationToSmoothingFactorBoundary = 1.0;
+    orthogonalizationParametersNative.Smoothorarea = 1.0;
+    orthogonalizationParametersNative.AdaptBeta = 10.0;
+
+    const auto makeOrthogonalization = [&](std::shared_ptr<meshkernel::Mesh> mesh, std::shared_ptr<meshkernel::Smoother> smoother) {
+        auto orthogonalizer = std::make_shared<meshkernel::Orthogonalizer>(mesh);
+        auto polygon = std::make_shared<meshkernel::Polygons>();
+        std::vector<meshkernel::Point> landBoundary;
+        auto landboundaries = std::make_shared<meshkernel::LandBoundaries>(landBoundary, mesh, polygon);
+        return meshkernel::OrthogonalizationAndSmoothing(mesh, smoother, orthogonalizer, polygon, landboundaries, 0, orthogonalizationParametersNative);
+    };
+
+    // Execute: the samples set on the smoother, or through the orthogonalization with the strength AdaptBeta
+    auto smootherMesh = MakeRectangularMeshForTesting(11, 11, 1.0, meshkernel::Projections::cartesian);
+    auto smoother = std::make_shared<meshkernel::Smoother>(smootherMesh);
+    smoother->SetAdaptationSamples(samples, orthogonalizationParametersNative.AdaptBeta);
+    auto smootherOrthogonalization = makeOrthogonalization(smootherMesh, smoother);
+    smootherOrthogonalization.Initialize();
+    smootherOrthogonalization.Compute();
+
+    auto mesh = MakeRectangularMeshForTesting(11, 11, 1.0, meshkernel::Projections::cartesian);
+    auto orthogonalization = makeOrthogonalization(mesh, std::make_shared<meshkernel::Smoother>(mesh));
+    orthogonalization.SetAdaptationSamples(samples);
+    orthogonalization.Initialize();
+    orthogonalization.Compute();
+
+    // Assert: the same adapted mesh, clustered at the step
+    ASSERT_LT(mesh->m_nodes[6 * 11 + 5].x - mesh->m_nodes[5 * 11 + 5].x, 0.5);
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        ASSERT_EQ(smootherMesh->m_nodes[n], mesh->m_nodes[n]);
+    }
+
+    // the node values refer to the initial mesh, removing a node requires a new initialization
+    mesh->DeleteNode(0);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_THROW(orthogonalization.PrepareOuterIteration(), std::invalid_argument);
+    orthogonalization.Initialize();
+    orthogonalization.PrepareOuterIteration();
+}
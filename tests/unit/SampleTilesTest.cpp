@@ -0,0 +1,206 @@
+#include <MeshKernel/AveragingInterpolation.hpp>
+#include <MeshKernel/SampleTiles.hpp>
+#include <TestUtils/MakeMeshes.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    std::vector<meshkernel::Sample> MakeGridSamples(int numSamplesPerDirection, double spacing)
+    {
+        std::vector<meshkernel::Sample> samples;
+        for (int i = 0; i < numSamplesPerDirection; ++i)
+        {
+            for (int j = 0; j < numSamplesPerDirection; ++j)
+            {
+                samples.push_back({i * spacing + 0.5, j * spacing + 0.5, std::sin(i * 0.1) + std::cos(j * 0.2)});
+            }
+        }
+        return samples;
+    }
+} // namespace
+
+TEST(SampleTiles, LoadSamplesOfTheOverlappingTiles)
+{
+    // a small buffer, so the tiles are written several times
+    meshkernel::SampleTiles sampleTiles("SampleTilesTest_load", 10.0, meshkernel::Projections::cartesian, 7);
+    const auto samples = MakeGridSamples(40, 1.0);
+    sampleTiles.AddSamples(samples);
+    sampleTiles.AddSamples({{meshkernel::doubleMissingValue, 1.0, 1.0}});
+
+    ASSERT_EQ(sampleTiles.GetNumSamples(), 1600);
+    ASSERT_EQ(sampleTiles.GetNumTiles(), 16);
+    meshkernel::Point lowerLeft;
+    meshkernel::Point upperRight;
+    sampleTiles.GetBoundingBox(lowerLeft, upperRight);
+    ASSERT_EQ(lowerLeft, (meshkernel::Point{0.5, 0.5}));
+    ASSERT_EQ(upperRight, (meshkernel::Point{39.5, 39.5}));
+
+    // the box overlaps two by two tiles
+    std::vector<meshkernel::Sample> loadedSamples;
+    sampleTiles.LoadSamples({15.0, 15.0}, {25.0, 25.0}, loadedSamples);
+    ASSERT_EQ(loadedSamples.size(), 400);
+    for (const auto& sample : loadedSamples)
+    {
+        ASSERT_GE(sample.x, 10.0);
+        ASSERT_LT(sample.x, 30.0);
+        ASSERT_GE(sample.y, 10.0);
+        ASSERT_LT(sample.y, 30.0);
+        const auto i = static_cast<int>(sample.x - 0.5);
+        const auto j = static_cast<int>(sample.y - 0.5);
+        ASSERT_EQ(sample.value, samples[i * 40 + j].value);
+    }
+
+    // samples added after a load are appended to the tile files
+    sampleTiles.AddSamples({{15.0, 15.0, 1.0}});
+    sampleTiles.LoadSamples({15.0, 15.0}, {15.0, 15.0}, loadedSamples);
+    ASSERT_EQ(loadedSamples.size(), 101);
+
+    sampleTiles.Clear();
+    ASSERT_EQ(sampleTiles.GetNumSamples(), 0);
+    ASSERT_FALSE(std::ifstream("SampleTilesTest_load_1_1.tile").good());
+}
+
+TEST(SampleTiles, LoadSamplesAcrossTheAntimeridian)
+{
+    // samples on both sides of the antimeridian and one in the middle of the globe
+    meshkernel::SampleTiles sphericalTiles("SampleTilesTest_spherical", 1.0, meshkernel::Projections::spherical);
+    sphericalTiles.AddSamples({{179.5, 10.5, 1.0}, {-179.5, 10.5, 2.0}, {0.5, 10.5, 3.0}});
+    meshkernel::SampleTiles cartesianTiles("SampleTilesTest_cartesian", 1.0, meshkernel::Projections::cartesian);
+    cartesianTiles.AddSamples({{179.5, 10.5, 1.0}, {-179.5, 10.5, 2.0}, {0.5, 10.5, 3.0}});
+
+    std::vector<meshkernel::Sample> loadedSamples;
+    const auto loadedValues = [&loadedSamples]() {
+        std::vector<double> values;
+        for (const auto& sample : loadedSamples)
+        {
+            values.emplace_back(sample.value);
+        }
+        std::sort(values.begin(), values.end());
+        return values;
+    };
+
+    // a box crossing the antimeridian, at its two sides
+    sphericalTiles.LoadSamples({179.0, 10.0}, {181.0, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{1.0, 2.0}));
+    sphericalTiles.LoadSamples({-181.0, 10.0}, {-179.0, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{1.0, 2.0}));
+
+    // a box shifted by 360 degrees, the samples keep their coordinates
+    sphericalTiles.LoadSamples({539.2, 10.0}, {539.8, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{1.0}));
+    ASSERT_EQ(loadedSamples[0].x, 179.5);
+    sphericalTiles.LoadSamples({-359.8, 10.0}, {-359.2, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{3.0}));
+
+    // a box spanning more than the globe and a box on other latitudes
+    sphericalTiles.LoadSamples({-200.0, 10.0}, {200.0, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{1.0, 2.0, 3.0}));
+    sphericalTiles.LoadSamples({179.0, 11.5}, {181.0, 12.0}, loadedSamples);
+    ASSERT_TRUE(loadedSamples.empty());
+
+    // longitudes are not wrapped in cartesian coordinates
+    cartesianTiles.LoadSamples({179.0, 10.0}, {181.0, 11.0}, loadedSamples);
+    ASSERT_EQ(loadedValues(), (std::vector<double>{1.0}));
+}
+
+TEST(SampleTiles, ReadXyzAndBinaryFiles)
+{
+    const auto samples = MakeGridSamples(20, 1.0);
+    {
+        std::ofstream xyzStream("SampleTilesTest.xyz");
+        xyzStream.precision(17);
+        for (const auto& sample : samples)
+        {
+            xyzStream << sample.x << " " << sample.y << " " << sample.value << "\n";
+        }
+        // a blank line is skipped, the malformed lines are rejected
+        xyzStream << "\n"
+                  << "x y z\n"
+                  << "1.0 2.0\n";
+        std::ofstream binaryStream("SampleTilesTest.bin", std::ios::binary);
+        binaryStream.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(meshkernel::Sample));
+    }
+
+    meshkernel::SampleTiles xyzTiles("SampleTilesTest_xyz", 5.0, meshkernel::Projections::cartesian);
+    ASSERT_EQ(xyzTiles.ReadXyzFile("SampleTilesTest.xyz"), 2);
+    ASSERT_EQ(xyzTiles.GetNumRejectedLines(), 2);
+    meshkernel::SampleTiles binaryTiles("SampleTilesTest_binary", 5.0, meshkernel::Projections::cartesian);
+    binaryTiles.ReadBinaryFile("SampleTilesTest.bin");
+    std::remove("SampleTilesTest.xyz");
+    std::remove("SampleTilesTest.bin");
+
+    std::vector<meshkernel::Sample> xyzSamples;
+    std::vector<meshkernel::Sample> binarySamples;
+    xyzTiles.LoadSamples({0.0, 0.0}, {20.0, 20.0}, xyzSamples);
+    binaryTiles.LoadSamples({0.0, 0.0}, {20.0, 20.0}, binarySamples);
+    xyzTiles.Clear();
+    binaryTiles.Clear();
+
+    ASSERT_EQ(xyzSamples.size(), samples.size());
+    ASSERT_EQ(binarySamples.size(), samples.size());
+    for (int s = 0; s < static_cast<int>(samples.size()); ++s)
+    {
+        ASSERT_EQ(xyzSamples[s].x, binarySamples[s].x);
+        ASSERT_EQ(xyzSamples[s].y, binarySamples[s].y);
+        ASSERT_EQ(xyzSamples[s].value, binarySamples[s].value);
+    }
+
+    ASSERT_THROW(xyzTiles.ReadXyzFile("SampleTilesTest_missing.xyz"), std::invalid_argument);
+}
+
+TEST(SampleTiles, TileFilesAreRemovedOnDestruction)
+{
+    {
+        meshkernel::SampleTiles sampleTiles("SampleTilesTest_destruction", 10.0, meshkernel::Projections::cartesian);
+        sampleTiles.AddSamples({{15.0, 15.0, 1.0}});
+        sampleTiles.Flush();
+        ASSERT_TRUE(std::ifstream("SampleTilesTest_destruction_1_1.tile").good());
+    }
+    ASSERT_FALSE(std::ifstream("SampleTilesTest_destruction_1_1.tile").good());
+
+    // also when an exception leaves the scope of the tiles
+    try
+    {
+        meshkernel::SampleTiles sampleTiles("SampleTilesTest_exception", 10.0, meshkernel::Projections::cartesian);
+        sampleTiles.AddSamples({{15.0, 15.0, 1.0}});
+        sampleTiles.Flush();
+        sampleTiles.ReadXyzFile("SampleTilesTest_missing.xyz");
+    }
+    catch (const std::invalid_argument&)
+    {
+    }
+    ASSERT_FALSE(std::ifstream("SampleTilesTest_exception_1_1.tile").good());
+}
+
+TEST(SampleTiles, AveragingOnTilesGivesTheSameResultsAsInMemory)
+{
+    auto mesh = MakeRectangularMeshForTesting(31, 31, 10.0, meshkernel::Projections::cartesian);
+    auto samples = MakeGridSamples(150, 2.0);
+
+    auto sampleTiles = std::make_shared<meshkernel::SampleTiles>("SampleTilesTest_averaging", 50.0, meshkernel::Projections::cartesian, 1000);
+    sampleTiles->AddSamples(samples);
+
+    for (const auto location : {meshkernel::InterpolationLocation::Faces, meshkernel::InterpolationLocation::Nodes, meshkernel::InterpolationLocation::Edges})
+    {
+        meshkernel::AveragingInterpolation inMemoryAveraging(mesh, samples, meshkernel::AveragingInterpolation::Method::InverseWeightedDistance, location, 1.01, false, false);
+        inMemoryAveraging.Compute();
+
+        meshkernel::AveragingInterpolation tilesAveraging(mesh, sampleTiles, meshkernel::AveragingInterpolation::Method::InverseWeightedDistance, location, 1.01, false);
+        tilesAveraging.SetParallel(true);
+        tilesAveraging.Compute();
+
+        const auto& inMemoryResults = inMemoryAveraging.GetResults();
+        const auto& tilesResults = tilesAveraging.GetResults();
+        ASSERT_EQ(inMemoryResults.size(), tilesResults.size());
+        for (int i = 0; i < static_cast<int>(inMemoryResults.size()); ++i)
+        {
+            ASSERT_NEAR(inMemoryResults[i], tilesResults[i], 1e-12);
+        }
+    }
+    sampleTiles->Clear();
+}
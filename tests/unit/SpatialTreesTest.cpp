@@ -92,3 +92,213 @@ TEST(SpatialTrees, FindNodesInSquare)
     rtree.NearestNeighboursOnSquaredDistance(pointToSearch[0], squaredDistance);
     ASSERT_EQ(rtree.GetQueryResultSize(), 0);
 }
+
+TEST(SpatialTrees, RTreeIncrementalUpdatesAreKeyedOnTheIndex)
+{
+    // a missing node at index 1
+    std::vector<meshkernel::Point> nodes{{0.0, 0.0}, {meshkernel::doubleMissingValue, meshkernel::doubleMissingValue}, {2.0, 0.0}};
+
+    meshkernel::SpatialTrees::RTree rtree;
+    rtree.BuildTree(nodes);
+    ASSERT_EQ(rtree.Size(), 2);
+    ASSERT_TRUE(rtree.Contains(2));
+    ASSERT_FALSE(rtree.Contains(1));
+
+    // move node 2, the old position is not found anymore
+    rtree.MoveNode(2, {5.0, 5.0});
+    ASSERT_EQ(rtree.Size(), 2);
+    rtree.NearestNeighboursOnSquaredDistance({2.0, 0.0}, 0.01);
+    ASSERT_EQ(rtree.GetQueryResultSize(), 0);
+    rtree.NearestNeighboursOnSquaredDistance({5.0, 5.0}, 0.01);
+    ASSERT_EQ(rtree.GetQueryResultSize(), 1);
+    ASSERT_EQ(rtree.GetQuerySampleIndex(0), 2);
+
+    // insert at the missing index and past the end
+    rtree.InsertNode(1, {1.0, 0.0});
+    rtree.InsertNode(6, {6.0, 0.0});
+    ASSERT_EQ(rtree.Size(), 4);
+    rtree.NearestNeighbour({6.1, 0.0});
+    ASSERT_EQ(rtree.GetQuerySampleIndex(0), 6);
+
+    // remove by index, moving to a missing value removes as well
+    rtree.RemoveNode(0);
+    rtree.MoveNode(1, {meshkernel::doubleMissingValue, meshkernel::doubleMissingValue});
+    ASSERT_EQ(rtree.Size(), 2);
+    ASSERT_FALSE(rtree.Contains(0));
+    ASSERT_FALSE(rtree.Contains(1));
+    ASSERT_THROW(rtree.RemoveNode(0), std::invalid_argument);
+}
+
+TEST(SpatialTrees, RTreeManyIncrementalUpdatesGiveTheSameQueriesAsABulkLoad)
+{
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::vector<meshkernel::Point> nodes(1000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+
+    meshkernel::SpatialTrees::RTree incrementalTree;
+    incrementalTree.BuildTree(nodes);
+
+    // enough moves to trigger the bulk loads of the incremental tree
+    std::uniform_int_distribution<int> index(0, static_cast<int>(nodes.size()) - 1);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const auto n = index(generator);
+        nodes[n] = {coordinate(generator), coordinate(generator)};
+        incrementalTree.MoveNode(n, nodes[n]);
+    }
+
+    meshkernel::SpatialTrees::RTree bulkLoadedTree;
+    bulkLoadedTree.BuildTree(nodes);
+
+    ASSERT_EQ(incrementalTree.Size(), bulkLoadedTree.Size());
+    for (int q = 0; q < 100; ++q)
+    {
+        const meshkernel::Point point{coordinate(generator), coordinate(generator)};
+        incrementalTree.NearestNeighbour(point);
+        bulkLoadedTree.NearestNeighbour(point);
+        ASSERT_EQ(incrementalTree.GetQuerySampleIndex(0), bulkLoadedTree.GetQuerySampleIndex(0));
+
+        incrementalTree.NearestNeighboursOnSquaredDistance(point, 25.0);
+        bulkLoadedTree.NearestNeighboursOnSquaredDistance(point, 25.0);
+        ASSERT_EQ(incrementalTree.GetQueryResultSize(), bulkLoadedTree.GetQueryResultSize());
+    }
+}
+
+TEST(SpatialTrees, SegmentsRTreeQueriesRestrictedToIndexRange)
+{
+    // two polylines, separated by a missing value
+    std::vector<meshkernel::Point> nodes{
+        {0.0, 0.0},
+        {1.0, 0.0},
+        {2.0, 0.0},
+        {meshkernel::doubleMissingValue, meshkernel::doubleMissingValue},
+        {0.0, 1.0},
+        {1.0, 1.0}};
+
+    meshkernel::SpatialTrees::SegmentsRTree rtree;
+    rtree.BuildTree(nodes);
+    ASSERT_EQ(rtree.Size(), 3);
+
+    // all segments crossing x = 0.5
+    rtree.SegmentsInBox({0.4, -1.0}, {0.6, 2.0}, 0, 5);
+    ASSERT_EQ(rtree.GetQueryResultSize(), 2);
+
+    // only the second polyline
+    rtree.SegmentsInBox({0.4, -1.0}, {0.6, 2.0}, 3, 5);
+    ASSERT_EQ(rtree.GetQueryResultSize(), 1);
+    ASSERT_EQ(rtree.GetQuerySegmentIndex(0), 4);
+
+    // the nearest segment to a point close to the first polyline
+    rtree.NearestSegments({1.8, 0.1}, 1, 0, 5);
+    ASSERT_EQ(rtree.GetQueryResultSize(), 1);
+    ASSERT_EQ(rtree.GetQuerySegmentIndex(0), 1);
+
+    rtree.InsertSegment(nodes, 0);
+    ASSERT_EQ(rtree.Size(), 4);
+}
+
+TEST(SpatialTrees, RTreeBatchQueriesGiveTheSameResultsAsSingleQueries)
+{
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::vector<meshkernel::Point> nodes(2000);
+    for (auto& node : nodes)
+    {
+        node = {coordinate(generator), coordinate(generator)};
+    }
+    std::vector<meshkernel::Point> points(1000);
+    for (auto& point : points)
+    {
+        point = {coordinate(generator), coordinate(generator)};
+    }
+    points[3] = {meshkernel::doubleMissingValue, meshkernel::doubleMissingValue};
+
+    meshkernel::SpatialTrees::RTree rtree;
+    rtree.BuildTree(nodes);
+
+    meshkernel::SpatialTrees::QueryResults serialResults;
+    meshkernel::SpatialTrees::QueryResults parallelResults;
+    rtree.NearestNeighboursOnSquaredDistance(points, 9.0, serialResults);
+    rtree.NearestNeighboursOnSquaredDistance(points, 9.0, parallelResults, true);
+    ASSERT_EQ(serialResults.GetNumQueries(), points.size());
+    ASSERT_EQ(serialResults.GetQueryResultSize(3), 0);
+
+    meshkernel::SpatialTrees::RTree::QueryContext context;
+    for (int q = 0; q < static_cast<int>(points.size()); ++q)
+    {
+        if (q == 3)
+        {
+            continue;
+        }
+        rtree.NearestNeighboursOnSquaredDistance(points[q], 9.0, context);
+        ASSERT_EQ(serialResults.GetQueryResultSize(q), context.GetQueryResultSize());
+        ASSERT_EQ(parallelResults.GetQueryResultSize(q), context.GetQueryResultSize());
+        for (int i = 0; i < serialResults.GetQueryResultSize(q); ++i)
+        {
+            ASSERT_EQ(serialResults.GetQuerySampleIndex(q, i), context.GetQuerySampleIndex(i));
+            ASSERT_EQ(parallelResults.GetQuerySampleIndex(q, i), context.GetQuerySampleIndex(i));
+        }
+    }
+
+    // the k nearest neighbours are sorted on increasing distance
+    rtree.NearestNeighbours(points, 4, parallelResults, true);
+    for (int q = 0; q < static_cast<int>(points.size()); ++q)
+    {
+        if (q == 3)
+        {
+            continue;
+        }
+        ASSERT_EQ(parallelResults.GetQueryResultSize(q), 4);
+        rtree.NearestNeighbour(points[q], context);
+        ASSERT_EQ(parallelResults.GetQuerySampleIndex(q, 0), context.GetQuerySampleIndex(0));
+        for (int i = 1; i < 4; ++i)
+        {
+            const auto previous = nodes[parallelResults.GetQuerySampleIndex(q, i - 1)];
+            const auto current = nodes[parallelResults.GetQuerySampleIndex(q, i)];
+            ASSERT_LE(std::hypot(previous.x - points[q].x, previous.y - points[q].y),
+                      std::hypot(current.x - points[q].x, current.y - points[q].y));
+        }
+    }
+}
+
+TEST(SpatialTrees, RTreeBatchBoxQueries)
+{
+    const int n = 4; // x
+    const int m = 4; // y
+
+    std::vector<meshkernel::Point> nodes(n * m);
+    std::size_t nodeIndex = 0;
+    for (int j = 0; j < m; ++j)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            nodes[nodeIndex] = {(double)i, (double)j};
+            nodeIndex++;
+        }
+    }
+
+    meshkernel::SpatialTrees::RTree rtree;
+    rtree.BuildTree(nodes);
+
+    // the nodes on the box boundary are included
+    std::vector<meshkernel::Point> lowerLeft{{0.5, 0.5}, {-1.0, -1.0}, {10.0, 10.0}};
+    std::vector<meshkernel::Point> upperRight{{2.5, 2.5}, {0.0, 3.0}, {11.0, 11.0}};
+    meshkernel::SpatialTrees::QueryResults results;
+    rtree.PointsInBox(lowerLeft, upperRight, results, true);
+
+    ASSERT_EQ(results.GetNumQueries(), 3);
+    ASSERT_EQ(results.GetQueryResultSize(0), 4);
+    ASSERT_EQ(results.GetQueryResultSize(1), 4);
+    ASSERT_EQ(results.GetQueryResultSize(2), 0);
+    for (int i = 0; i < results.GetQueryResultSize(1); ++i)
+    {
+        ASSERT_EQ(nodes[results.GetQuerySampleIndex(1, i)].x, 0.0);
+    }
+
+    upperRight.pop_back();
+    ASSERT_THROW(rtree.PointsInBox(lowerLeft, upperRight, results), std::invalid_argument);
+}
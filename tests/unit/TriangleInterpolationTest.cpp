@@ -1,10 +1,13 @@
 #include <MeshKernel/Mesh.hpp>
 #include "Meshkernel/Entities.hpp"
+#include <MeshKernel/SampleTriangulation.hpp>
 #include <MeshKernel/TriangulationInterpolation.hpp>
 #include <TestUtils/SampleFileReader.hpp>
 #include <TestUtils/MakeMeshes.hpp>
 #include <gtest/gtest.h>
 
+#include <random>
+
 TEST(TriangleInterpolation, InterpolateOnNodes)
 {
     // Set up
@@ -121,3 +124,97 @@ TEST(TriangleInterpolation, InterpolateOnFacesUsingSphericalAccurateOption)
     ASSERT_NEAR(-26.988893382269104, results[18], tolerance);
     ASSERT_NEAR(-29.549320886988440, results[19], tolerance);
 }
+
+TEST(TriangleInterpolation, ReusedTriangulationInterpolatesLinearFields)
+{
+    // Set up: samples of two linear fields at the same random coordinates
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::vector<meshkernel::Sample> firstSamples(500);
+    std::vector<meshkernel::Sample> secondSamples(500);
+    for (int s = 0; s < static_cast<int>(firstSamples.size()); ++s)
+    {
+        const auto x = coordinate(generator);
+        const auto y = coordinate(generator);
+        firstSamples[s] = {x, y, 2.0 * x + 3.0 * y};
+        secondSamples[s] = {x, y, -x + 0.5 * y + 1.0};
+    }
+    auto mesh = MakeRectangularMeshForTesting(30, 30, 4.0, meshkernel::Projections::cartesian, {-10.0, -10.0});
+
+    meshkernel::TriangulationInterpolation firstInterpolation(mesh->m_nodes, firstSamples, meshkernel::Projections::cartesian);
+    firstInterpolation.Compute();
+    const auto triangulation = firstInterpolation.GetTriangulation();
+    ASSERT_NE(triangulation, nullptr);
+
+    meshkernel::TriangulationInterpolation secondInterpolation(mesh->m_nodes, secondSamples, meshkernel::Projections::cartesian, triangulation);
+    secondInterpolation.Compute();
+    ASSERT_EQ(secondInterpolation.GetTriangulation(), triangulation);
+
+    // Assert: the linear fields are reproduced inside the triangulation, the nodes outside get no value
+    constexpr double tolerance = 1e-9;
+    int numInterpolatedNodes = 0;
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        const auto& node = mesh->m_nodes[n];
+        const auto firstResult = firstInterpolation.GetResults()[n];
+        const auto secondResult = secondInterpolation.GetResults()[n];
+        if (node.x < 0.0 || node.y < 0.0 || node.x > 100.0 || node.y > 100.0)
+        {
+            ASSERT_EQ(firstResult, meshkernel::doubleMissingValue);
+            continue;
+        }
+        if (firstResult == meshkernel::doubleMissingValue)
+        {
+            ASSERT_EQ(secondResult, meshkernel::doubleMissingValue);
+            continue;
+        }
+        numInterpolatedNodes++;
+        ASSERT_NEAR(firstResult, 2.0 * node.x + 3.0 * node.y, tolerance);
+        ASSERT_NEAR(secondResult, -node.x + 0.5 * node.y + 1.0, tolerance);
+    }
+    ASSERT_GT(numInterpolatedNodes, 500);
+
+    // the triangulation must belong to samples at the same coordinates
+    std::vector<meshkernel::Sample> otherSamples(firstSamples.begin(), firstSamples.begin() + 100);
+    meshkernel::TriangulationInterpolation otherInterpolation(mesh->m_nodes, otherSamples, meshkernel::Projections::cartesian, triangulation);
+    ASSERT_THROW(otherInterpolation.Compute(), std::invalid_argument);
+}
+
+TEST(TriangleInterpolation, SampleTriangulationFindsTheFaceFromAnyStartFace)
+{
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<double> coordinate(0.0, 10.0);
+    std::vector<meshkernel::Sample> samples(200);
+    for (auto& sample : samples)
+    {
+        sample = {coordinate(generator), coordinate(generator), 0.0};
+    }
+    const meshkernel::SampleTriangulation triangulation(samples);
+    ASSERT_GT(triangulation.GetNumFaces(), 0);
+
+    meshkernel::SpatialTrees::RTree::QueryContext queryContext;
+    const meshkernel::Point point{5.1, 4.9};
+    const auto face = triangulation.FindFace(point, -1, queryContext);
+    ASSERT_GE(face, 0);
+    for (int f = 0; f < triangulation.GetNumFaces(); f += 7)
+    {
+        ASSERT_EQ(triangulation.FindFace(point, f, queryContext), face);
+    }
+    ASSERT_EQ(triangulation.FindFace({20.0, 5.0}, face, queryContext), -1);
+
+    // the neighbours are symmetric
+    for (int f = 0; f < triangulation.GetNumFaces(); ++f)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            const auto neighbour = triangulation.GetFaceNeighbour(f, n);
+            if (neighbour < 0)
+            {
+                continue;
+            }
+            ASSERT_TRUE(triangulation.GetFaceNeighbour(neighbour, 0) == f ||
+                        triangulation.GetFaceNeighbour(neighbour, 1) == f ||
+                        triangulation.GetFaceNeighbour(neighbour, 2) == f);
+        }
+    }
+}
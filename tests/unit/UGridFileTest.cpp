@@ -0,0 +1,163 @@
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <MeshKernel/Mesh.hpp>
+#include <MeshKernel/UGridFile.hpp>
+#include <TestUtils/MakeMeshes.hpp>
+#include <gtest/gtest.h>
+
+#ifdef MESHKERNEL_WITH_NETCDF
+
+#include <netcdf.h>
+
+namespace
+{
+    // Writes a legacy network file with the given node coordinates and 1-based edge nodes
+    void WriteLegacyNetworkFile(const std::string& filePath, const std::vector<double>& x, const std::vector<double>& y, const std::vector<int>& edgeNodes)
+    {
+        int ncid = 0;
+        ASSERT_EQ(NC_NOERR, nc_create(filePath.c_str(), NC_CLOBBER, &ncid));
+        int xDimension = 0;
+        int yDimension = 0;
+        int linksDimension = 0;
+        int twoDimension = 0;
+        ASSERT_EQ(NC_NOERR, nc_def_dim(ncid, "nNetNode", x.size(), &xDimension));
+        ASSERT_EQ(NC_NOERR, nc_def_dim(ncid, "nNetNodeY", y.size(), &yDimension));
+        ASSERT_EQ(NC_NOERR, nc_def_dim(ncid, "nNetLink", edgeNodes.size() / 2, &linksDimension));
+        ASSERT_EQ(NC_NOERR, nc_def_dim(ncid, "nNetLinkPts", 2, &twoDimension));
+        int xVariable = 0;
+        int yVariable = 0;
+        int edgeNodesVariable = 0;
+        const int edgeNodesDimensions[]{linksDimension, twoDimension};
+        ASSERT_EQ(NC_NOERR, nc_def_var(ncid, "NetNode_x", NC_DOUBLE, 1, &xDimension, &xVariable));
+        ASSERT_EQ(NC_NOERR, nc_def_var(ncid, "NetNode_y", NC_DOUBLE, 1, &yDimension, &yVariable));
+        ASSERT_EQ(NC_NOERR, nc_def_var(ncid, "NetLink", NC_INT, 2, edgeNodesDimensions, &edgeNodesVariable));
+        ASSERT_EQ(NC_NOERR, nc_enddef(ncid));
+        ASSERT_EQ(NC_NOERR, nc_put_var_double(ncid, xVariable, x.data()));
+        ASSERT_EQ(NC_NOERR, nc_put_var_double(ncid, yVariable, y.data()));
+        ASSERT_EQ(NC_NOERR, nc_put_var_int(ncid, edgeNodesVariable, edgeNodes.data()));
+        ASSERT_EQ(NC_NOERR, nc_close(ncid));
+    }
+} // namespace
+
+TEST(UGridFile, WriteAndReadRectangularMesh)
+{
+    // Setup
+    const auto mesh = MakeRectangularMeshForTesting(4, 3, 10.0, meshkernel::Projections::cartesian);
+    const std::string filePath = "UGridFileTest_rectangular_net.nc";
+
+    // Execute
+    meshkernel::WriteUGridMesh(filePath, *mesh);
+    meshkernel::Mesh readMesh;
+    meshkernel::ReadUGridMesh(filePath, readMesh);
+    std::remove(filePath.c_str());
+
+    // Assert
+    ASSERT_EQ(mesh->GetNumNodes(), readMesh.GetNumNodes());
+    ASSERT_EQ(mesh->GetNumEdges(), readMesh.GetNumEdges());
+    ASSERT_EQ(mesh->GetNumFaces(), readMesh.GetNumFaces());
+    ASSERT_EQ(meshkernel::Projections::cartesian, readMesh.m_projection);
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        ASSERT_DOUBLE_EQ(mesh->m_nodes[n].x, readMesh.m_nodes[n].x);
+        ASSERT_DOUBLE_EQ(mesh->m_nodes[n].y, readMesh.m_nodes[n].y);
+    }
+    for (int e = 0; e < mesh->GetNumEdges(); ++e)
+    {
+        ASSERT_EQ(mesh->m_edges[e], readMesh.m_edges[e]);
+    }
+}
+
+TEST(UGridFile, WriteAndReadSphericalMesh)
+{
+    // Setup
+    const auto mesh = MakeRectangularMeshForTesting(3, 3, 1.0, meshkernel::Projections::spherical, {10.0, 50.0});
+    const std::string filePath = "UGridFileTest_spherical_net.nc";
+
+    // Execute
+    meshkernel::WriteUGridMesh(filePath, *mesh);
+    meshkernel::Mesh readMesh;
+    meshkernel::ReadUGridMesh(filePath, readMesh);
+    std::remove(filePath.c_str());
+
+    // Assert
+    ASSERT_EQ(meshkernel::Projections::spherical, readMesh.m_projection);
+    ASSERT_EQ(mesh->GetNumFaces(), readMesh.GetNumFaces());
+}
+
+TEST(UGridFile, WriteAndReadMeshLargerThanOneChunk)
+{
+    // Setup: more nodes, edges and faces than written and read in one chunk
+    const auto mesh = MakeRectangularMeshForTesting(300, 300, 1.0, meshkernel::Projections::cartesian);
+    mesh->Administrate(meshkernel::Mesh::AdministrationOptions::AdministrateMeshEdgesAndFaces);
+    ASSERT_GT(mesh->GetNumNodes(), 1 << 16);
+    const std::string filePath = "UGridFileTest_large_net.nc";
+
+    // Execute
+    meshkernel::WriteUGridMesh(filePath, *mesh);
+    meshkernel::Mesh readMesh;
+    meshkernel::ReadUGridMesh(filePath, readMesh);
+    std::remove(filePath.c_str());
+
+    // Assert: the faces are computed again from the edges, in the same order
+    ASSERT_EQ(mesh->GetNumNodes(), readMesh.GetNumNodes());
+    ASSERT_EQ(mesh->GetNumEdges(), readMesh.GetNumEdges());
+    ASSERT_EQ(mesh->GetNumFaces(), readMesh.GetNumFaces());
+    for (int n = 0; n < mesh->GetNumNodes(); ++n)
+    {
+        ASSERT_DOUBLE_EQ(mesh->m_nodes[n].x, readMesh.m_nodes[n].x);
+        ASSERT_DOUBLE_EQ(mesh->m_nodes[n].y, readMesh.m_nodes[n].y);
+    }
+    for (int e = 0; e < mesh->GetNumEdges(); ++e)
+    {
+        ASSERT_EQ(mesh->m_edges[e], readMesh.m_edges[e]);
+    }
+    for (int f = 0; f < mesh->GetNumFaces(); ++f)
+    {
+        ASSERT_EQ(mesh->m_facesNodes[f], readMesh.m_facesNodes[f]);
+    }
+}
+
+TEST(UGridFile, ReadMissingFileThrows)
+{
+    meshkernel::Mesh mesh;
+    ASSERT_THROW(meshkernel::ReadUGridMesh("UGridFileTest_missing_net.nc", mesh), std::invalid_argument);
+}
+
+TEST(UGridFile, ReadMalformedNetworkFileThrows)
+{
+    const std::string filePath = "UGridFileTest_malformed_net.nc";
+    meshkernel::Mesh mesh;
+
+    // a valid legacy file is read, with 1-based edge nodes
+    WriteLegacyNetworkFile(filePath, {0.0, 1.0, 1.0}, {0.0, 0.0, 1.0}, {1, 2, 2, 3});
+    meshkernel::ReadUGridMesh(filePath, mesh);
+    ASSERT_EQ(3, mesh.GetNumNodes());
+    ASSERT_EQ(2, mesh.GetNumEdges());
+    ASSERT_EQ((meshkernel::Edge{1, 2}), mesh.m_edges[1]);
+
+    // edge nodes outside the nodes
+    WriteLegacyNetworkFile(filePath, {0.0, 1.0, 1.0}, {0.0, 0.0, 1.0}, {1, 2, 2, 4});
+    ASSERT_THROW(meshkernel::ReadUGridMesh(filePath, mesh), std::invalid_argument);
+    WriteLegacyNetworkFile(filePath, {0.0, 1.0, 1.0}, {0.0, 0.0, 1.0}, {0, 2, 2, 3});
+    ASSERT_THROW(meshkernel::ReadUGridMesh(filePath, mesh), std::invalid_argument);
+
+    // different numbers of x and y coordinates
+    WriteLegacyNetworkFile(filePath, {0.0, 1.0, 1.0}, {0.0, 0.0}, {1, 2});
+    ASSERT_THROW(meshkernel::ReadUGridMesh(filePath, mesh), std::invalid_argument);
+    std::remove(filePath.c_str());
+}
+
+#else
+
+TEST(UGridFile, ReadAndWriteThrowWithoutNetCdf)
+{
+    const auto mesh = MakeRectangularMeshForTesting(3, 3, 1.0, meshkernel::Projections::cartesian);
+    meshkernel::Mesh readMesh;
+    ASSERT_THROW(meshkernel::WriteUGridMesh("UGridFileTest_net.nc", *mesh), std::invalid_argument);
+    ASSERT_THROW(meshkernel::ReadUGridMesh("UGridFileTest_net.nc", readMesh), std::invalid_argument);
+}
+
+#endif